@@ -1,5 +1,78 @@
 #include "hashmap_benchmark.h"
 
+// Writes PKLE_BENCH_OUTPUT and compares against PKLE_BENCH_BASELINE once all tests ran
+static ::testing::Environment* const s_pBenchmarkOutputEnvironment = ::testing::AddGlobalTestEnvironment(new BenchmarkOutputEnvironment);
+
+// ============================================================================
+// HEAP ALLOCATION HOOK
+// Interposes the malloc family of this process to count allocations and frees for the results, see HeapHookState.
+// operator new/delete end up here too. The real work is done by glibc's __libc_ entry points.
+// ============================================================================
+extern "C"
+{
+void* __libc_malloc(size_t size);
+void __libc_free(void* pBlock);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* pBlock, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+
+void* malloc(size_t size) noexcept
+{
+    void* pBlock = __libc_malloc(size);
+    CountHeapAllocation(pBlock);
+    return pBlock;
+}
+
+void free(void* pBlock) noexcept
+{
+    CountHeapFree(pBlock);
+    __libc_free(pBlock);
+}
+
+void* calloc(size_t count, size_t size) noexcept
+{
+    void* pBlock = __libc_calloc(count, size);
+    CountHeapAllocation(pBlock);
+    return pBlock;
+}
+
+// Counted as a free of the old block and an allocation of the new one
+void* realloc(void* pBlock, size_t size) noexcept
+{
+    CountHeapFree(pBlock);
+    void* pNewBlock = __libc_realloc(pBlock, size);
+    //On failure the old block stays allocated
+    CountHeapAllocation((pNewBlock != nullptr || size == 0) ? pNewBlock : pBlock);
+    return pNewBlock;
+}
+
+void* memalign(size_t alignment, size_t size) noexcept
+{
+    void* pBlock = __libc_memalign(alignment, size);
+    CountHeapAllocation(pBlock);
+    return pBlock;
+}
+
+void* aligned_alloc(size_t alignment, size_t size) noexcept
+{
+    return memalign(alignment, size);
+}
+
+int posix_memalign(void** ppBlock, size_t alignment, size_t size) noexcept
+{
+    if(alignment < sizeof(void*) || (alignment & (alignment - 1)) != 0)
+    {
+        return EINVAL;
+    }
+    void* pBlock = memalign(alignment, size);
+    if(pBlock == nullptr)
+    {
+        return ENOMEM;
+    }
+    *ppBlock = pBlock;
+    return 0;
+}
+} //extern "C"
 
 // ============================================================================
 // HELPER FUNCTIONS
@@ -351,1709 +424,4486 @@ void RunIteratorTest(const KeyGenFunc& keyGen)
     ASSERT_GT(iterationCounter.load(), 0u);
 }
 
-
-// ============================================================================
-// STD::UNORDERED_MAP LOCKED WRAPPER
-// ============================================================================
-TEST_F(HashmapInsertTest, StdUnorderedMapLocked_InsertSequential)
+// Insert/lookup/erase mix over a fixed table of string keys of the given length
+// Half of the table is preloaded, so lookups hit roughly half of the time
+template<typename KeyType, typename HashmapType>
+void RunStringKeyTest(uint32_t keyLength, uint32_t insertPercent, uint32_t lookupPercent, uint32_t erasePercent)
 {
-    RunInsertTest<uint64_t, uint64_t, StdUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
-}
+    constexpr uint32_t c_numKeys = HashmapBenchmarkTest::PRELOAD_KEYS * 2;
 
-TEST_F(HashmapInsertTest, StdUnorderedMapLocked_InsertSequentialBigValue)
-{
-    RunInsertTest<uint64_t, TestValueStruct, StdUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
-}
+    // ArenaStringKey views these strings, std::string keys copy them
+    std::vector<std::string> keyStrings;
+    keyStrings.reserve(c_numKeys);
+    for(uint32_t i = 0; i < c_numKeys; ++i)
+    {
+        keyStrings.push_back(MakeFixedLengthStringKey(i, keyLength));
+    }
+    std::vector<KeyType> keys(keyStrings.begin(), keyStrings.end());
 
-TEST_F(HashmapInsertTest, StdUnorderedMapLocked_InsertRandom)
-{
-    RunInsertTest<uint64_t, uint64_t, StdUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
-}
+    HashmapType hashmap;
+    std::atomic<uint64_t> lookupCounter{0};
 
-TEST_F(HashmapInsertTest, StdUnorderedMapLocked_InsertRandomBigValue)
-{
-    RunInsertTest<uint64_t, TestValueStruct, StdUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
-}
+    auto setupFunc = [&keys, &lookupCounter](auto& map)
+    {
+        map.clear();
+        for(uint32_t i = 0; i < HashmapBenchmarkTest::PRELOAD_KEYS; ++i)
+        {
+            map.insert(keys[i], static_cast<uint64_t>(i));
+        }
+        lookupCounter = 0;
+    };
 
-TEST_F(HashmapBatchInsertTest, StdUnorderedMapLocked_BatchInsertSequential)
-{
-    RunBatchInsertTest<uint64_t, uint64_t, StdUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
-}
+    auto testLogic = [&hashmap, &keys, &lookupCounter, insertPercent, lookupPercent](uint32_t index)
+    {
+        const KeyType& key = keys[(static_cast<uint64_t>(index) * 2654435761ULL) % c_numKeys];
+        const uint32_t opSelector = index % 100;
+        if(opSelector < insertPercent)
+        {
+            hashmap.insert(key, static_cast<uint64_t>(index));
+        }
+        else if(opSelector < (insertPercent + lookupPercent))
+        {
+            const uint64_t* pValue = nullptr;
+            if(hashmap.find(key, pValue))
+            {
+                lookupCounter.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        else
+        {
+            hashmap.erase(key);
+        }
+    };
 
-TEST_F(HashmapBatchInsertTest, StdUnorderedMapLocked_BatchInsertSequentialBigValue)
-{
-    RunBatchInsertTest<uint64_t, TestValueStruct, StdUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
-}
+    std::string baseTestLabel = std::to_string(insertPercent) + "i" +
+                            std::to_string(lookupPercent) + "l" +
+                            std::to_string(erasePercent) + "e";
+    std::string testLabel = baseTestLabel + "StringKey" + std::to_string(keyLength) + "B";
+    std::string labeledTestName = std::string(HashmapType::GetMapTypeName()) + GetStringKeyTypeName<KeyType>() + "_" + testLabel;
 
-TEST_F(HashmapBatchInsertTest, StdUnorderedMapLocked_BatchInsertRandom)
-{
-    RunBatchInsertTest<uint64_t, uint64_t, StdUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
-}
+    HashmapBenchmarkTest::RunThreadScalingBenchmark(
+        labeledTestName.c_str(),
+        hashmap,
+        setupFunc,
+        testLogic,
+        HashmapBenchmarkTest::OPERATIONS_PER_THREAD,
+        baseTestLabel.c_str());
 
-TEST_F(HashmapBatchInsertTest, StdUnorderedMapLocked_BatchInsertRandomBigValue)
-{
-    RunBatchInsertTest<uint64_t, TestValueStruct, StdUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
+    ASSERT_GT(lookupCounter.load(), 0u);
 }
 
-TEST_F(HashmapLookupTest, StdUnorderedMapLocked_LookupSequential)
+// Hammers a single list with inserts, lookups and erases on a tiny key set, then checks the list is consistent
+template<typename ListBucketType>
+void RunSimpleLinkedListStressTest()
 {
-    RunLookupTest<uint64_t, uint64_t, StdUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
-}
+    constexpr uint32_t c_numKeys = 64;
+    constexpr uint32_t c_numRounds = 8;
 
-TEST_F(HashmapLookupTest, StdUnorderedMapLocked_LookupSequentialBigValue)
-{
-    RunLookupTest<uint64_t, TestValueStruct, StdUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
-}
+    ListBucketType bucket;
+    std::atomic<uint64_t> insertCounter{0};
+    std::atomic<uint64_t> lookupCounter{0};
+    std::atomic<uint64_t> eraseCounter{0};
 
-TEST_F(HashmapLookupTest, StdUnorderedMapLocked_LookupRandom)
-{
-    RunLookupTest<uint64_t, uint64_t, StdUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
-}
+    auto testLogic = [&bucket, &insertCounter, &lookupCounter, &eraseCounter](uint32_t index)
+    {
+        const uint64_t key = (static_cast<uint64_t>(index) * 2654435761ULL) % c_numKeys;
+        const uint32_t opSelector = index % 3;
+        if(opSelector == 0)
+        {
+            if(bucket.insert(key, key * 2))
+            {
+                insertCounter.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        else if(opSelector == 1)
+        {
+            const typename ListBucketType::HashMapValueType* pValue = nullptr;
+            if(bucket.find(key, pValue))
+            {
+                lookupCounter.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        else
+        {
+            if(bucket.erase(key))
+            {
+                eraseCounter.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    };
 
-TEST_F(HashmapLookupTest, StdUnorderedMapLocked_LookupRandomBigValue)
-{
-    RunLookupTest<uint64_t, TestValueStruct, StdUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
-}
+    std::string labeledTestName = std::string(ListBucketType::GetMapTypeName()) + "_stress";
+    for(uint32_t round = 0; round < c_numRounds; ++round)
+    {
+        HashmapBenchmarkTest::RunWithThreadCount(16, ThreadPlacement::None, labeledTestName.c_str(), testLogic, HashmapBenchmarkTest::OPERATIONS_PER_THREAD, "stress");
+    }
 
-TEST_F(HashmapBatchedLookupTest, StdUnorderedMapLocked_BatchedLookupSequential)
-{
-    RunBatchedLookupTest<uint64_t, uint64_t, StdUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
-}
+    // No threads are running anymore, walk the list
+    uint64_t numLive = 0;
+    bool bHasDuplicate = false;
+    bool bHasForeignKey = false;
+    std::vector<bool> seenKeys(c_numKeys, false);
+    bucket.for_each([&](const uint64_t& key, const uint64_t& value)
+    {
+        ++numLive;
+        if(key >= c_numKeys || value != key * 2)
+        {
+            bHasForeignKey = true;
+            return;
+        }
+        bHasDuplicate = bHasDuplicate || seenKeys[key];
+        seenKeys[key] = true;
+    });
+
+    EXPECT_FALSE(bHasDuplicate);
+    EXPECT_FALSE(bHasForeignKey);
+    EXPECT_EQ(numLive, insertCounter.load() - eraseCounter.load());
+    EXPECT_EQ(bucket.size(), numLive);
+
+    // Erased nodes must come back while the threads are running, not only once the list is quiescent
+    EXPECT_GT(bucket.GetNumReclaimed(), 0u);
+
+    bucket.ReclaimAll();
+    EXPECT_EQ(bucket.GetNumReclaimed(), eraseCounter.load());
 
-TEST_F(HashmapBatchedLookupTest, StdUnorderedMapLocked_BatchedLookupSequentialBigValue)
-{
-    RunBatchedLookupTest<uint64_t, TestValueStruct, StdUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+    ASSERT_GT(insertCounter.load(), 0u);
+    ASSERT_GT(lookupCounter.load(), 0u);
+    ASSERT_GT(eraseCounter.load(), 0u);
 }
 
-TEST_F(HashmapBatchedLookupTest, StdUnorderedMapLocked_BatchedLookupRandom)
+// Insert/lookup/erase mix where every operation lands in the same bucket list
+template<typename ListBucketType>
+void RunContendedBucketTest(uint32_t numKeys, uint32_t insertPercent, uint32_t lookupPercent)
 {
-    RunBatchedLookupTest<uint64_t, uint64_t, StdUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
-}
+    ListBucketType bucket;
+    std::atomic<uint64_t> lookupCounter{0};
 
-TEST_F(HashmapBatchedLookupTest, StdUnorderedMapLocked_BatchedLookupRandomBigValue)
-{
-    RunBatchedLookupTest<uint64_t, TestValueStruct, StdUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
-}
+    auto setupFunc = [numKeys, &lookupCounter](auto& list)
+    {
+        list.clear();
+        for(uint32_t i = 0; i < numKeys; i += 2)
+        {
+            list.insert(i, i * 2);
+        }
+        lookupCounter = 0;
+    };
 
-TEST_F(HashmapEraseTest, StdUnorderedMapLocked_EraseSequential)
-{
-    RunEraseTest<uint64_t, uint64_t, StdUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
-}
+    auto testLogic = [&bucket, numKeys, insertPercent, lookupPercent, &lookupCounter](uint32_t index)
+    {
+        const uint64_t key = (static_cast<uint64_t>(index) * 2654435761ULL) % numKeys;
+        const uint32_t opSelector = (index / numKeys) % 100;
+        if(opSelector < insertPercent)
+        {
+            bucket.insert(key, key * 2);
+        }
+        else if(opSelector < (insertPercent + lookupPercent))
+        {
+            const typename ListBucketType::HashMapValueType* pValue = nullptr;
+            if(bucket.find(key, pValue))
+            {
+                lookupCounter.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        else
+        {
+            bucket.erase(key);
+        }
+    };
 
-TEST_F(HashmapEraseTest, StdUnorderedMapLocked_EraseSequentialBigValue)
-{
-    RunEraseTest<uint64_t, TestValueStruct, StdUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
-}
+    const uint32_t erasePercent = 100 - insertPercent - lookupPercent;
+    std::string baseTestLabel = std::to_string(insertPercent) + "i" +
+                            std::to_string(lookupPercent) + "l" +
+                            std::to_string(erasePercent) + "e";
+    std::string labeledTestName = std::string(ListBucketType::GetMapTypeName()) + "_contendedBucket" + std::to_string(numKeys) + "Keys";
 
-TEST_F(HashmapMixedTest, StdUnorderedMapLocked_90r10w)
-{
-    RunMixedReadWriteTest<uint64_t, uint64_t, StdUnorderedMapLocked<uint64_t, uint64_t>>(
-        KeyGenerator::Sequential,
-        90,
-        10);
-}
+    HashmapBenchmarkTest::RunThreadScalingBenchmark(
+        labeledTestName.c_str(),
+        bucket,
+        setupFunc,
+        testLogic,
+        HashmapBenchmarkTest::OPERATIONS_PER_THREAD,
+        baseTestLabel.c_str());
 
-TEST_F(HashmapMixedTest, StdUnorderedMapLocked_90r10wBigValue)
-{
-    RunMixedReadWriteTest<uint64_t, TestValueStruct, StdUnorderedMapLocked<uint64_t, TestValueStruct>>(
-        KeyGenerator::Sequential,
-        90,
-        10);
+    ASSERT_GT(lookupCounter.load(), 0u);
 }
 
-TEST_F(HashmapMixedTest, StdUnorderedMapLocked_50r50w)
-{
-    RunMixedReadWriteTest<uint64_t, uint64_t, StdUnorderedMapLocked<uint64_t, uint64_t>>(
-        KeyGenerator::Sequential,
-        50,
-        50);
-}
 
-TEST_F(HashmapMixedTest, StdUnorderedMapLocked_50r50wBigValue)
+// 40i50l10e on PklEHashMap with a change feed attached and numSubscribers threads polling it for the whole run
+// bAttachFeed = false is the baseline without a feed
+template<typename HashmapType>
+void RunChangeFeedTest(bool bAttachFeed, uint32_t numSubscribers)
 {
-    RunMixedReadWriteTest<uint64_t, TestValueStruct, StdUnorderedMapLocked<uint64_t, TestValueStruct>>(
-        KeyGenerator::Sequential,
-        50,
-        50);
-}
+    using ChangeFeedType = typename std::remove_reference_t<decltype(std::declval<HashmapType&>().GetMap())>::ChangeFeedType;
+    constexpr uint32_t c_pollBatchSize = 256;
 
-TEST_F(HashmapMixedTest, StdUnorderedMapLocked_40i50l10e)
-{
-    RunMixedWithEraseTest<uint64_t, uint64_t, StdUnorderedMapLocked<uint64_t, uint64_t>>(
-        KeyGenerator::Sequential,
-        40,
-        50,
-        10);
-}
+    HashmapType hashmap;
+    std::unique_ptr<ChangeFeedType> pFeed = std::make_unique<ChangeFeedType>();
+    std::atomic<uint64_t> insertCounter{0};
+    std::atomic<uint64_t> lookupCounter{0};
+    std::atomic<uint64_t> eraseCounter{0};
 
-TEST_F(HashmapMixedTest, StdUnorderedMapLocked_40i50l10eBigValue)
-{
-    RunMixedWithEraseTest<uint64_t, TestValueStruct, StdUnorderedMapLocked<uint64_t, TestValueStruct>>(
-        KeyGenerator::Sequential,
-        40,
-        50,
-        10);
-}
+    auto setupFunc = [&insertCounter, &lookupCounter, &eraseCounter, &pFeed, bAttachFeed](auto& map)
+    {
+        map.clear();
+        HashmapBenchmarkTest::PreloadHashmap(map, HashmapBenchmarkTest::PRELOAD_KEYS, KeyGenerator::Sequential);
+        //clear() rebuilds the map, so the feed is attached again for every run
+        map.GetMap().SetChangeFeed(bAttachFeed ? pFeed.get() : nullptr);
+        insertCounter = 0;
+        lookupCounter = 0;
+        eraseCounter = 0;
+    };
 
-TEST_F(HashmapContendedTest, StdUnorderedMapLocked_ContendedInsert)
-{
-    RunInsertTest<uint64_t, uint64_t, StdUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Contended, "contendedInsert");
-}
+    auto testLogic = CreateComplexMixedOperation<uint64_t, uint64_t>(
+        hashmap, KeyGenerator::Sequential, 16,
+        insertCounter, lookupCounter, eraseCounter,
+        40, 50, 10);
 
-TEST_F(HashmapContendedTest, StdUnorderedMapLocked_ContendedInsertBigValue)
-{
-    RunInsertTest<uint64_t, TestValueStruct, StdUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Contended, "contendedInsert");
-}
+    std::atomic<bool> bStopSubscribers{false};
+    std::atomic<uint64_t> numRecordsPolled{0};
+    std::atomic<uint64_t> numRecordsLost{0};
+    std::vector<std::thread> subscribers;
+    for(uint32_t i = 0; i < numSubscribers; ++i)
+    {
+        subscribers.emplace_back([&pFeed, &bStopSubscribers, &numRecordsPolled, &numRecordsLost]()
+        {
+            typename ChangeFeedType::Cursor cursor = pFeed->Subscribe();
+            typename ChangeFeedType::RecordType records[c_pollBatchSize];
+            uint64_t numPolled = 0;
+            while(!bStopSubscribers.load(std::memory_order_relaxed))
+            {
+                const uint32_t numRead = pFeed->Poll(cursor, records, c_pollBatchSize);
+                numPolled += numRead;
+                if(numRead == 0)
+                {
+                    std::this_thread::yield();
+                }
+            }
+            numRecordsPolled += numPolled;
+            numRecordsLost += cursor.numLost;
+        });
+    }
 
-TEST_F(HashmapRekeyTest, StdUnorderedMapLocked_RekeySequential)
-{
-    RunRekeyTest<uint64_t, uint64_t, StdUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
-}
+    std::string baseTestLabel = "40i50l10e";
+    std::string testLabel = bAttachFeed ? ("changeFeed" + std::to_string(numSubscribers) + "Subscribers") : std::string("changeFeedOff");
+    std::string labeledTestName = std::string(HashmapType::GetMapTypeName()) + "_" + testLabel;
 
-TEST_F(HashmapRekeyTest, StdUnorderedMapLocked_RekeySequentialBigValue)
-{
-    RunRekeyTest<uint64_t, TestValueStruct, StdUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
-}
+    HashmapBenchmarkTest::RunThreadScalingBenchmark(
+        labeledTestName.c_str(),
+        hashmap,
+        setupFunc,
+        testLogic,
+        HashmapBenchmarkTest::OPERATIONS_PER_THREAD,
+        baseTestLabel.c_str());
 
-TEST_F(HashmapIteratorTest, StdUnorderedMapLocked_IteratorsSequential)
-{
-    RunIteratorTest<uint64_t, uint64_t, StdUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
-}
+    bStopSubscribers = true;
+    for(std::thread& subscriber : subscribers)
+    {
+        subscriber.join();
+    }
+    hashmap.GetMap().SetChangeFeed(nullptr);
 
-TEST_F(HashmapIteratorTest, StdUnorderedMapLocked_IteratorsSequentialBigValue)
-{
-    RunIteratorTest<uint64_t, TestValueStruct, StdUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+    if(numSubscribers > 0)
+    {
+        printf("%-70s subscribers polled %llu records, lost %llu to overflow\n", labeledTestName.c_str(),
+               (unsigned long long)numRecordsPolled.load(), (unsigned long long)numRecordsLost.load());
+        ASSERT_GT(numRecordsPolled.load(), 0u);
+    }
+    ASSERT_GT(insertCounter.load(), 0u);
+    ASSERT_GT(eraseCounter.load(), 0u);
 }
 
-TEST_F(HashmapIteratorTest, StdUnorderedMapLocked_IteratorsRandom)
+// Single threaded inserts, rekeys and removes with a feed attached, then checks the key and newKey of every polled record.
+// A rekey within a shard is one ReKey record, across shards a Remove of the old key plus an Insert of the new one.
+template<typename HashmapType>
+void RunChangeFeedRecordTest()
 {
-    RunIteratorTest<uint64_t, uint64_t, StdUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
-}
+    using ChangeFeedType = typename std::remove_reference_t<decltype(std::declval<HashmapType&>().GetMap())>::ChangeFeedType;
+    using RecordType = typename ChangeFeedType::RecordType;
+    constexpr uint64_t c_numKeys = 2048;
+    constexpr uint64_t c_newKeyOffset = 1000000;
 
-TEST_F(HashmapIteratorTest, StdUnorderedMapLocked_IteratorsRandomBigValue)
-{
-    RunIteratorTest<uint64_t, TestValueStruct, StdUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
-}
+    HashmapType hashmap;
+    std::unique_ptr<ChangeFeedType> pFeed = std::make_unique<ChangeFeedType>();
+    hashmap.GetMap().SetChangeFeed(pFeed.get());
+    typename ChangeFeedType::Cursor cursor = pFeed->Subscribe();
 
+    for(uint64_t key = 0; key < c_numKeys; ++key)
+    {
+        ASSERT_TRUE(hashmap.insert(key, key * 2));
+    }
+    for(uint64_t key = 0; key < (c_numKeys / 2); ++key)
+    {
+        ASSERT_TRUE(hashmap.GetMap().ReKey_Concurrent(key, key + c_newKeyOffset));
+    }
+    for(uint64_t key = (c_numKeys / 2); key < c_numKeys; ++key)
+    {
+        ASSERT_TRUE(hashmap.GetMap().Remove_Concurrent(key));
+    }
 
+    std::vector<RecordType> records(c_numKeys * 4);
+    const uint32_t numRecords = pFeed->Poll(cursor, records.data(), static_cast<uint32_t>(records.size()));
+    hashmap.GetMap().SetChangeFeed(nullptr);
+    EXPECT_EQ(cursor.numLost, 0u);
 
+    std::map<uint64_t, uint32_t> insertedKeys;
+    std::map<uint64_t, uint32_t> removedKeys;
+    std::map<uint64_t, uint64_t> rekeyedKeys;
+    for(uint32_t i = 0; i < numRecords; ++i)
+    {
+        const RecordType& record = records[i];
+        if(record.type == PklE::ThreadsafeContainers::ChangeType::Insert)
+        {
+            EXPECT_EQ(record.newKey, record.key);
+            ++insertedKeys[record.key];
+        }
+        else if(record.type == PklE::ThreadsafeContainers::ChangeType::Remove)
+        {
+            EXPECT_EQ(record.newKey, record.key);
+            ++removedKeys[record.key];
+        }
+        else if(record.type == PklE::ThreadsafeContainers::ChangeType::ReKey)
+        {
+            EXPECT_EQ(rekeyedKeys.count(record.key), 0u);
+            rekeyedKeys[record.key] = record.newKey;
+        }
+        else
+        {
+            ADD_FAILURE() << "Unexpected change type " << static_cast<uint32_t>(record.type);
+        }
+    }
+
+    uint64_t numCrossShardRekeys = 0;
+    for(uint64_t key = 0; key < (c_numKeys / 2); ++key)
+    {
+        const bool bRekeyedInShard = (rekeyedKeys.count(key) == 1) && (rekeyedKeys[key] == (key + c_newKeyOffset));
+        const bool bRekeyedAcrossShards = (removedKeys[key] == 1) && (insertedKeys[key + c_newKeyOffset] == 1);
+        EXPECT_NE(bRekeyedInShard, bRekeyedAcrossShards) << "key " << key;
+        EXPECT_EQ(insertedKeys[key], 1u) << "key " << key;
+        numCrossShardRekeys += bRekeyedAcrossShards ? 1 : 0;
+    }
+    for(uint64_t key = (c_numKeys / 2); key < c_numKeys; ++key)
+    {
+        EXPECT_EQ(insertedKeys[key], 1u) << "key " << key;
+        EXPECT_EQ(removedKeys[key], 1u) << "key " << key;
+    }
+    EXPECT_EQ(numRecords, (c_numKeys * 2) + numCrossShardRekeys);
+    EXPECT_EQ(hashmap.size(), c_numKeys / 2);
+}
+
+// Lookups on PklEHashMap with a hot key sketch sampling 1 in samplingInterval calls, 0 runs without a sketch.
+// A quarter of the lookups go to a handful of hot keys, which GetHotKeys() has to report at the top.
+template<typename HashmapType>
+void RunHotKeySketchTest(uint32_t samplingInterval)
+{
+    using HotKeySketchType = typename std::remove_reference_t<decltype(std::declval<HashmapType&>().GetMap())>::HotKeySketchType;
+    using HotKeyType = typename HotKeySketchType::HotKeyType;
+    constexpr uint32_t c_numHotKeys = 8;
+    constexpr uint64_t c_hotKeyStride = 1237;
+
+    HashmapType hashmap;
+    std::unique_ptr<HotKeySketchType> pSketch = std::make_unique<HotKeySketchType>();
+    pSketch->SetSamplingInterval(samplingInterval);
+    std::atomic<uint64_t> lookupCounter{0};
+
+    auto setupFunc = [&lookupCounter, &pSketch, samplingInterval](auto& map)
+    {
+        map.clear();
+        HashmapBenchmarkTest::PreloadHashmap(map, HashmapBenchmarkTest::PRELOAD_KEYS, KeyGenerator::Sequential);
+        //clear() rebuilds the map, so the sketch is attached again for every run and keeps collecting
+        map.GetMap().SetHotKeySketch((samplingInterval > 0) ? pSketch.get() : nullptr);
+        lookupCounter = 0;
+    };
+
+    auto skewedKeyGen = [](uint32_t threadId, uint32_t iteration, uint32_t totalThreads) -> uint64_t
+    {
+        if((iteration & 3) == 0)
+        {
+            return ((iteration >> 2) % c_numHotKeys) * c_hotKeyStride;
+        }
+        return KeyGenerator::Random(threadId, iteration, totalThreads) % HashmapBenchmarkTest::PRELOAD_KEYS;
+    };
+
+    auto testLogic = CreateLookupOperation<uint64_t, uint64_t>(hashmap, skewedKeyGen, 16, lookupCounter);
+
+    std::string testLabel = (samplingInterval > 0) ? ("hotKeySketch1in" + std::to_string(samplingInterval)) : std::string("hotKeySketchOff");
+    std::string labeledTestName = std::string(HashmapType::GetMapTypeName()) + "_" + testLabel;
+
+    HashmapBenchmarkTest::RunThreadScalingBenchmark(
+        labeledTestName.c_str(),
+        hashmap,
+        setupFunc,
+        testLogic,
+        HashmapBenchmarkTest::OPERATIONS_PER_THREAD,
+        "skewedLookup");
+
+    ASSERT_GT(lookupCounter.load(), 0u);
+    if(samplingInterval > 0)
+    {
+        HotKeyType hotKeys[c_numHotKeys];
+        const uint32_t numHotKeys = hashmap.GetMap().GetHotKeys(hotKeys, c_numHotKeys);
+        hashmap.GetMap().SetHotKeySketch(nullptr);
+
+        uint64_t shardLoad[HotKeySketchType::c_numShards];
+        pSketch->GetShardLoad(shardLoad);
+        printf("%-70s %llu samples, hottest key %llu (~%llu calls), shard load:", labeledTestName.c_str(),
+               (unsigned long long)pSketch->GetNumSamples(),
+               (unsigned long long)((numHotKeys > 0) ? hotKeys[0].key : 0), (unsigned long long)((numHotKeys > 0) ? hotKeys[0].estimatedCount : 0));
+        for(uint32_t shardIndex = 0; shardIndex < HotKeySketchType::c_numShards; ++shardIndex)
+        {
+            printf(" %llu", (unsigned long long)shardLoad[shardIndex]);
+        }
+        printf("\n");
+
+        ASSERT_GT(numHotKeys, 0u);
+        ASSERT_EQ(hotKeys[0].key % c_hotKeyStride, 0u);
+        ASSERT_LT(hotKeys[0].key / c_hotKeyStride, c_numHotKeys);
+    }
+}
+
+// String key stored by value inside the node, so it can be sampled by a hot key sketch unlike ArenaStringKey
+struct InlineStringKey
+{
+    inline static constexpr uint32_t c_capacity = 30;
+
+    char bytes[c_capacity] = {};
+    uint16_t length = 0;
+
+    InlineStringKey() = default;
+
+    explicit InlineStringKey(std::string_view view) : length(static_cast<uint16_t>(std::min<size_t>(view.size(), c_capacity)))
+    {
+        memcpy(bytes, view.data(), length);
+    }
+
+    std::string_view View() const
+    {
+        return std::string_view(bytes, length);
+    }
+
+    friend bool operator==(const InlineStringKey& a, const InlineStringKey& b) { return a.View() == b.View(); }
+};
+
+namespace PklE
+{
+namespace ThreadsafeContainers
+{
+    template<>
+    struct HashMapKeyStorage<InlineStringKey>
+    {
+        using ArenaType = NoKeyArena;
+
+        static uint64_t Hash(const InlineStringKey& key)
+        {
+            return ArenaStringKey::Hash(ArenaStringKey(key.bytes, key.length));
+        }
+
+        static int Compare(const InlineStringKey& a, const InlineStringKey& b)
+        {
+            const int result = a.View().compare(b.View());
+            return (result < 0) ? -1 : ((result > 0) ? 1 : 0);
+        }
+
+        static const InlineStringKey& Persist(ArenaType& /*arena*/, const InlineStringKey& key)
+        {
+            return key;
+        }
+    };
+} // end namespace ThreadsafeContainers
+} // end namespace PklE
+
+// Samples every lookup of string keys built in one reused buffer, then checks the sketch reports the hot strings.
+// Arena stored keys only point at caller or arena bytes, which the sketch would outlive, so maps with them can not attach one.
+template<typename HashmapType>
+void RunHotKeySketchStringKeyTest()
+{
+    static_assert(!PklE::ThreadsafeContainers::HashMap<PklE::ThreadsafeContainers::ArenaStringKey, uint64_t>::c_supportsHotKeySketch,
+                  "Arena stored keys must not be sampled by a hot key sketch");
+
+    using HotKeySketchType = typename std::remove_reference_t<decltype(std::declval<HashmapType&>().GetMap())>::HotKeySketchType;
+    using HotKeyType = typename HotKeySketchType::HotKeyType;
+    constexpr uint32_t c_numKeys = 4096;
+    constexpr uint32_t c_numHotKeys = 4;
+    constexpr uint32_t c_numLookups = 200000;
+
+    HashmapType hashmap;
+    std::unique_ptr<HotKeySketchType> pSketch = std::make_unique<HotKeySketchType>();
+    pSketch->SetSamplingInterval(1);
+
+    char keyBuffer[InlineStringKey::c_capacity];
+    auto makeKey = [&keyBuffer](uint32_t keyIndex)
+    {
+        const int length = snprintf(keyBuffer, sizeof(keyBuffer), "user:%08u:profile", keyIndex);
+        return InlineStringKey(std::string_view(keyBuffer, static_cast<size_t>(length)));
+    };
+
+    for(uint32_t i = 0; i < c_numKeys; ++i)
+    {
+        ASSERT_TRUE(hashmap.insert(makeKey(i), static_cast<uint64_t>(i)));
+    }
+    hashmap.GetMap().SetHotKeySketch(pSketch.get());
+
+    uint64_t numFound = 0;
+    for(uint32_t i = 0; i < c_numLookups; ++i)
+    {
+        //Half the lookups go to the first c_numHotKeys keys
+        const uint32_t keyIndex = ((i & 1) == 0) ? ((i >> 1) % c_numHotKeys) : (c_numHotKeys + ((i * 2654435761U) % (c_numKeys - c_numHotKeys)));
+        const uint64_t* pValue = nullptr;
+        if(hashmap.find(makeKey(keyIndex), pValue) && (*pValue == keyIndex))
+        {
+            ++numFound;
+        }
+    }
+    //Leave different bytes in the buffer the keys were built in, the sketch has to hold its own copies
+    memset(keyBuffer, 'x', sizeof(keyBuffer));
+
+    HotKeyType hotKeys[c_numHotKeys];
+    const uint32_t numHotKeys = hashmap.GetMap().GetHotKeys(hotKeys, c_numHotKeys);
+    hashmap.GetMap().SetHotKeySketch(nullptr);
+
+    EXPECT_EQ(numFound, c_numLookups);
+    ASSERT_EQ(numHotKeys, c_numHotKeys);
+    std::vector<bool> bSeenHotKey(c_numHotKeys, false);
+    for(uint32_t i = 0; i < numHotKeys; ++i)
+    {
+        const std::string key(hotKeys[i].key.View());
+        uint32_t keyIndex = UINT32_MAX;
+        ASSERT_EQ(sscanf(key.c_str(), "user:%08u:profile", &keyIndex), 1) << key;
+        ASSERT_LT(keyIndex, c_numHotKeys) << key;
+        EXPECT_FALSE(bSeenHotKey[keyIndex]) << key;
+        bSeenHotKey[keyIndex] = true;
+        EXPECT_GE(hotKeys[i].estimatedCount, c_numLookups / (2 * c_numHotKeys)) << key;
+    }
+}
+
+enum class TieredStorageMode
+{
+    InNodeValues, //Plain HashMap, values inside the pool nodes
+    TieringOff, //TieredHashMap that never migrates, every value stays on the heap
+    TieringOn, //TieredHashMap with background migration and compaction
+};
+
+// 512 byte payload, words[0] holds the key so lookups can check they got the right value back
+struct TieredStoragePayload
+{
+    uint64_t words[64];
+};
+
+// 90/10 hot/cold access mix over c_numKeys 512 byte values: 90% of the accesses go to the hot 10% of the keys,
+// 5% of all accesses are updates. Reports throughput and RSS after a warm up long enough for tiering to settle.
+void RunTieredStorageTest(TieredStorageMode mode)
+{
+    using InNodeMapType = PklE::ThreadsafeContainers::HashMap<uint64_t, TieredStoragePayload, 8, 16>;
+    using TieredMapType = PklE::ThreadsafeContainers::TieredHashMap<uint64_t, TieredStoragePayload>;
+    constexpr uint64_t c_numKeys = HashmapBenchmarkTest::PRELOAD_KEYS * 20;
+    constexpr uint32_t c_numThreads = 4;
+    constexpr uint32_t c_tieringPeriodMs = 50;
+    constexpr uint32_t c_maxIdleEpochs = 4;
+    constexpr auto c_warmupDuration = std::chrono::milliseconds(600);
+
+    //glibc keeps freed chunks in its arenas, hand whole free pages back before every RSS reading
+    //so RSS shows what the map holds rather than what earlier tests left behind
+    malloc_trim(0);
+    const uint64_t rssBeforePopulate = GetResidentSetBytes();
+    std::unique_ptr<InNodeMapType> pInNodeMap;
+    std::unique_ptr<TieredMapType> pTieredMap;
+    if(mode == TieredStorageMode::InNodeValues)
+    {
+        pInNodeMap = std::make_unique<InNodeMapType>();
+    }
+    else
+    {
+        pTieredMap = std::make_unique<TieredMapType>();
+        ASSERT_TRUE(pTieredMap->Open());
+    }
+
+    TieredStoragePayload payload = {};
+    for(uint64_t key = 0; key < c_numKeys; ++key)
+    {
+        payload.words[0] = key;
+        if(pInNodeMap)
+        {
+            pInNodeMap->Insert_Concurrent(key, payload);
+        }
+        else
+        {
+            pTieredMap->Insert(key, payload);
+        }
+    }
+    const uint64_t rssAfterPopulate = GetResidentSetBytes();
+
+    //Hot keys are every 10th key, so the hot set is spread over all stripes and pages
+    auto accessMix = [&pInNodeMap, &pTieredMap](uint32_t threadIndex, uint64_t numOps, std::atomic<bool>* pStop, std::atomic<uint64_t>& numMisses) -> uint64_t
+    {
+        std::mt19937_64 rng(threadIndex + 1);
+        uint64_t numDone = 0;
+        uint64_t numLocalMisses = 0;
+        TieredStoragePayload value = {};
+        while((numDone < numOps) && (!pStop || !pStop->load(std::memory_order_relaxed)))
+        {
+            const uint64_t random = rng();
+            const bool bHot = (random % 100) < 90;
+            const uint64_t key = bHot ? (((random >> 8) % (c_numKeys / 10)) * 10) : (((random >> 8) % c_numKeys) | 1);
+            const bool bUpdate = ((random >> 40) % 100) < 5;
+            if(pInNodeMap)
+            {
+                if(bUpdate)
+                {
+                    pInNodeMap->Modify_Concurrent(key, [](TieredStoragePayload& payload) { ++payload.words[1]; });
+                }
+                else
+                {
+                    const auto* pPair = pInNodeMap->Find_Concurrent(key);
+                    numLocalMisses += (pPair && (pPair->value.words[0] == key)) ? 0 : 1;
+                }
+            }
+            else
+            {
+                const bool bFound = pTieredMap->Find(key, value) && (value.words[0] == key);
+                numLocalMisses += bFound ? 0 : 1;
+                if(bUpdate)
+                {
+                    ++value.words[1];
+                    pTieredMap->Update(key, value);
+                }
+            }
+            ++numDone;
+        }
+        numMisses += numLocalMisses;
+        return numDone;
+    };
+
+    auto runThreads = [&accessMix](uint64_t numOpsPerThread, std::atomic<bool>* pStop, std::atomic<uint64_t>& numMisses) -> uint64_t
+    {
+        std::atomic<uint64_t> numOps{0};
+        RunOnBenchmarkThreads(c_numThreads, [&accessMix, &numOps, &numMisses, numOpsPerThread, pStop](uint32_t threadIndex)
+        {
+            numOps += accessMix(threadIndex, numOpsPerThread, pStop, numMisses);
+        });
+        return numOps.load();
+    };
+
+    if(mode == TieredStorageMode::TieringOn)
+    {
+        pTieredMap->StartBackgroundTiering(c_tieringPeriodMs, c_maxIdleEpochs);
+    }
+
+    //Warm up until tiering has settled on the hot set
+    std::atomic<uint64_t> numMisses{0};
+    std::atomic<bool> bStopWarmup{false};
+    std::thread warmupTimer([&bStopWarmup, c_warmupDuration]()
+    {
+        std::this_thread::sleep_for(c_warmupDuration);
+        bStopWarmup = true;
+    });
+    runThreads(UINT64_MAX, &bStopWarmup, numMisses);
+    warmupTimer.join();
+
+    malloc_trim(0);
+    const uint64_t rssAfterWarmup = GetResidentSetBytes();
+
+    auto start = std::chrono::high_resolution_clock::now();
+    const uint64_t numOps = runThreads(HashmapBenchmarkTest::OPERATIONS_PER_THREAD, nullptr, numMisses);
+    auto end = std::chrono::high_resolution_clock::now();
+    malloc_trim(0);
+    const uint64_t rssAfterRun = GetResidentSetBytes();
+
+    const char* c_modeLabels[] = {"PklEHashMap_inNodeValues", "TieredHashMap_tieringOff", "TieredHashMap_tieringOn"};
+    std::string testName = std::string(c_modeLabels[static_cast<uint32_t>(mode)]) + "_512B";
+    HashmapBenchmarkTest::CreateResult(testName.c_str(), std::chrono::duration_cast<std::chrono::nanoseconds>(end - start), numOps, c_numThreads, "90hot10cold").Print();
+    printf("%-70s RSS populated %llu MB, after warm up %llu MB, after run %llu MB\n", testName.c_str(),
+           (unsigned long long)((rssAfterPopulate > rssBeforePopulate ? rssAfterPopulate - rssBeforePopulate : 0) >> 20),
+           (unsigned long long)((rssAfterWarmup > rssBeforePopulate ? rssAfterWarmup - rssBeforePopulate : 0) >> 20),
+           (unsigned long long)((rssAfterRun > rssBeforePopulate ? rssAfterRun - rssBeforePopulate : 0) >> 20));
+
+    if(pTieredMap)
+    {
+        pTieredMap->StopBackgroundTiering();
+        printf("%-70s %llu hot, %llu cold values, file %llu MB in use, %llu MB live\n", testName.c_str(),
+               (unsigned long long)pTieredMap->GetNumHotValues(), (unsigned long long)pTieredMap->GetNumColdValues(),
+               (unsigned long long)(pTieredMap->GetFileBytesInUse() >> 20), (unsigned long long)(pTieredMap->GetFileBytesLive() >> 20));
+        ASSERT_EQ(pTieredMap->size(), c_numKeys);
+        if(mode == TieredStorageMode::TieringOn)
+        {
+            ASSERT_GT(pTieredMap->GetNumColdValues(), 0u);
+        }
+    }
+    ASSERT_EQ(numMisses.load(), 0u);
+}
+
+// Checkpoint stream target: collects the bytes in memory so only the map's cost is measured
+struct CheckpointByteSink
+{
+    std::vector<char> bytes;
+
+    void write(const char* pData, size_t size)
+    {
+        bytes.insert(bytes.end(), pData, pData + size);
+    }
+};
+
+// Applies a checkpoint stream to per-page images, returns the number of pages read
+template<typename MapType>
+uint32_t ApplyCheckpoint(const CheckpointByteSink& sink, std::unordered_map<uint32_t, std::vector<typename MapType::CheckpointEntry>>& pageImages)
+{
+    const char* pRead = sink.bytes.data();
+    typename MapType::CheckpointHeader header;
+    memcpy(&header, pRead, sizeof(header));
+    pRead += sizeof(header);
+    if(header.bFullCheckpoint)
+    {
+        pageImages.clear();
+    }
+
+    for(uint32_t i = 0; i < header.numPages; ++i)
+    {
+        typename MapType::CheckpointPageHeader pageHeader;
+        memcpy(&pageHeader, pRead, sizeof(pageHeader));
+        pRead += sizeof(pageHeader);
+
+        std::vector<typename MapType::CheckpointEntry>& image = pageImages[pageHeader.pageIndex];
+        image.resize(pageHeader.numEntries);
+        memcpy(image.data(), pRead, sizeof(typename MapType::CheckpointEntry) * pageHeader.numEntries);
+        pRead += sizeof(typename MapType::CheckpointEntry) * pageHeader.numEntries;
+    }
+    return header.numPages;
+}
+
+// Incremental vs full checkpoints of a PklE HashMap with churnPercent of the entries modified per interval.
+// - Duration: checkpoints run between intervals of single threaded modifications, the images restored from the
+//   checkpoint streams must match the map.
+// - Writer slowdown: writer threads modify values in a hot range of churnPercent of the keys while another thread
+//   checkpoints back to back, compared to writers without a checkpointer.
+void RunCheckpointTest(uint32_t churnPercent)
+{
+    using HashmapType = PklEHashMap<uint64_t, uint64_t, false>;
+    using MapType = std::remove_reference_t<decltype(std::declval<HashmapType&>().GetMap())>;
+    constexpr uint64_t c_numKeys = HashmapBenchmarkTest::PRELOAD_KEYS * 10;
+    constexpr uint32_t c_numIntervals = 8;
+    constexpr uint32_t c_numWriters = 4;
+    const uint64_t numChurnKeys = std::max<uint64_t>(1, (c_numKeys * churnPercent) / 100);
+
+    HashmapType hashmap;
+    MapType& map = hashmap.GetMap();
+    for(uint64_t i = 0; i < c_numKeys; ++i)
+    {
+        map.Insert_Lockless(i, i);
+    }
+
+    CheckpointByteSink sink;
+    std::unordered_map<uint32_t, std::vector<MapType::CheckpointEntry>> pageImages;
+    map.Checkpoint(sink);
+    const uint32_t numMapPages = ApplyCheckpoint<MapType>(sink, pageImages);
+
+    //Checkpoint duration
+    std::mt19937_64 rng(churnPercent);
+    std::chrono::nanoseconds incrementalDuration{0};
+    std::chrono::nanoseconds fullDuration{0};
+    uint64_t incrementalBytes = 0;
+    uint64_t incrementalPages = 0;
+    uint64_t fullBytes = 0;
+    for(uint32_t interval = 0; interval < c_numIntervals; ++interval)
+    {
+        for(uint64_t i = 0; i < numChurnKeys; ++i)
+        {
+            map.Modify_Concurrent(rng() % c_numKeys, [interval](uint64_t& value) { value += interval + 1; });
+        }
+
+        sink.bytes.clear();
+        auto incrementalStart = std::chrono::high_resolution_clock::now();
+        map.Checkpoint(sink);
+        auto incrementalEnd = std::chrono::high_resolution_clock::now();
+        incrementalDuration += std::chrono::duration_cast<std::chrono::nanoseconds>(incrementalEnd - incrementalStart);
+        incrementalBytes += sink.bytes.size();
+        incrementalPages += ApplyCheckpoint<MapType>(sink, pageImages);
+
+        //The full checkpoint is only timed, it is not applied so the next incremental image still builds on this one
+        CheckpointByteSink fullSink;
+        fullSink.bytes.reserve(sink.bytes.capacity());
+        auto fullStart = std::chrono::high_resolution_clock::now();
+        map.Checkpoint(fullSink, true);
+        auto fullEnd = std::chrono::high_resolution_clock::now();
+        fullDuration += std::chrono::duration_cast<std::chrono::nanoseconds>(fullEnd - fullStart);
+        fullBytes += fullSink.bytes.size();
+    }
+
+    uint64_t numRestored = 0;
+    for(const auto& [pageIndex, image] : pageImages)
+    {
+        for(const MapType::CheckpointEntry& entry : image)
+        {
+            const uint64_t* pValue = nullptr;
+            ASSERT_TRUE(map.find_lockless(entry.key, pValue));
+            ASSERT_EQ(*pValue, entry.value);
+            ++numRestored;
+        }
+    }
+    ASSERT_EQ(numRestored, c_numKeys);
+
+    std::string churnLabel = std::to_string(churnPercent) + "pctChurn";
+    std::string incrementalTestName = std::string("PklEHashMap_checkpointIncremental_") + churnLabel;
+    std::string fullTestName = std::string("PklEHashMap_checkpointFull_") + churnLabel;
+    HashmapBenchmarkTest::CreateResult(incrementalTestName.c_str(), incrementalDuration, c_numIntervals, 1, "checkpoint").Print();
+    HashmapBenchmarkTest::CreateResult(fullTestName.c_str(), fullDuration, c_numIntervals, 1, "checkpoint").Print();
+    printf("%-70s %llu of %u pages, %llu KB per checkpoint (full: %llu KB)\n", incrementalTestName.c_str(),
+           (unsigned long long)(incrementalPages / c_numIntervals), numMapPages,
+           (unsigned long long)(incrementalBytes / c_numIntervals / 1024), (unsigned long long)(fullBytes / c_numIntervals / 1024));
+
+    //Writer slowdown
+    enum class CheckpointMode { None, Incremental, Full };
+    auto runWriters = [&map, numChurnKeys](CheckpointMode mode, uint64_t& outNumCheckpoints)
+    {
+        std::atomic<bool> bWritersDone{false};
+        std::atomic<uint64_t> numCheckpoints{0};
+        std::thread checkpointer([&map, &bWritersDone, &numCheckpoints, mode]()
+        {
+            CheckpointByteSink checkpointSink;
+            while((mode != CheckpointMode::None) && !bWritersDone.load(std::memory_order_relaxed))
+            {
+                checkpointSink.bytes.clear();
+                map.Checkpoint(checkpointSink, mode == CheckpointMode::Full);
+                ++numCheckpoints;
+            }
+        });
+
+        std::vector<std::thread> writers;
+        auto writeStart = std::chrono::high_resolution_clock::now();
+        for(uint32_t writerIndex = 0; writerIndex < c_numWriters; ++writerIndex)
+        {
+            writers.emplace_back([&map, numChurnKeys, writerIndex]()
+            {
+                std::mt19937_64 writerRng(writerIndex);
+                for(uint64_t i = 0; i < HashmapBenchmarkTest::OPERATIONS_PER_THREAD; ++i)
+                {
+                    map.Modify_Concurrent(writerRng() % numChurnKeys, [](uint64_t& value) { ++value; });
+                }
+            });
+        }
+        for(std::thread& writer : writers)
+        {
+            writer.join();
+        }
+        auto writeEnd = std::chrono::high_resolution_clock::now();
+        bWritersDone = true;
+        checkpointer.join();
+        outNumCheckpoints = numCheckpoints.load();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(writeEnd - writeStart);
+    };
+
+    const char* c_modeLabels[] = {"writersNoCheckpoint", "writersIncrementalCheckpoint", "writersFullCheckpoint"};
+    const CheckpointMode c_modes[] = {CheckpointMode::None, CheckpointMode::Incremental, CheckpointMode::Full};
+    for(uint32_t i = 0; i < 3; ++i)
+    {
+        uint64_t numCheckpoints = 0;
+        const std::chrono::nanoseconds writeDuration = runWriters(c_modes[i], numCheckpoints);
+        std::string writerTestName = std::string("PklEHashMap_") + c_modeLabels[i] + "_" + churnLabel;
+        HashmapBenchmarkTest::CreateResult(writerTestName.c_str(), writeDuration,
+            static_cast<uint64_t>(HashmapBenchmarkTest::OPERATIONS_PER_THREAD) * c_numWriters, c_numWriters, "modify").Print();
+        if(c_modes[i] != CheckpointMode::None)
+        {
+            printf("%-70s %llu checkpoints during the run\n", writerTestName.c_str(), (unsigned long long)numCheckpoints);
+        }
+    }
+    ASSERT_EQ(map.size(), c_numKeys);
+}
+
+// Build side key of a join row: two build rows per key. Multiplying by an odd constant is a bijection,
+// so key ids map to distinct, well spread keys.
+inline uint64_t GetJoinKey(uint64_t keyId)
+{
+    return keyId * 0x9E3779B97F4A7C15ULL;
+}
+
+// Equi-join of c_numBuildRows build rows (2 rows per key) with c_numProbeRows probe rows of which
+// selectivityPercent hit a build key. Compares HashJoin (partitioned lock-free build, batched probe) against
+// building the same multi-entry table with per-row Insert_Concurrent/Modify_Concurrent and probing it with
+// per-row Find_Concurrent. Reports build and probe cost per row.
+void RunHashJoinTest(uint32_t selectivityPercent)
+{
+    using JoinType = PklE::ThreadsafeContainers::HashJoin<uint64_t, 16, 8>;
+    using MultiEntry = JoinType::MultiEntry;
+    constexpr uint32_t c_numBuildRows = 1u << 20;
+    constexpr uint32_t c_numBuildKeys = c_numBuildRows / 2;
+    constexpr uint64_t c_numProbeRows = 10000000; //1M x 10M, scaled down from 100M probe rows to fit the benchmark's run time
+    constexpr uint32_t c_numThreads = 8;
+
+    std::vector<uint64_t> buildKeys(c_numBuildRows);
+    for(uint32_t row = 0; row < c_numBuildRows; ++row)
+    {
+        buildKeys[row] = GetJoinKey(row / 2);
+    }
+    std::shuffle(buildKeys.begin(), buildKeys.end(), std::mt19937_64(c_numBuildRows));
+
+    std::vector<uint64_t> probeKeys(c_numProbeRows);
+    std::mt19937_64 rng(selectivityPercent);
+    uint64_t expectedMatches = 0;
+    for(uint64_t row = 0; row < c_numProbeRows; ++row)
+    {
+        if((rng() % 100) < selectivityPercent)
+        {
+            probeKeys[row] = GetJoinKey(rng() % c_numBuildKeys);
+            expectedMatches += 2;
+        }
+        else
+        {
+            probeKeys[row] = GetJoinKey(c_numBuildKeys + (rng() % c_numBuildKeys));
+        }
+    }
+
+    std::string selectivityLabel = std::to_string(selectivityPercent) + "pctSelectivity";
+    uint64_t joinChecksum = 0; //Over all (build row, probe row) pairs, both joins have to produce the same pairs
+
+    //HashJoin operator
+    {
+        JoinType join;
+        auto buildStart = std::chrono::high_resolution_clock::now();
+        join.Build(buildKeys.data(), c_numBuildRows, c_numThreads);
+        auto buildEnd = std::chrono::high_resolution_clock::now();
+        ASSERT_EQ(join.GetNumBuildKeys(), c_numBuildKeys);
+
+        uint64_t checksums[JoinType::c_maxThreads] = {};
+        auto probeStart = std::chrono::high_resolution_clock::now();
+        const uint64_t numMatches = join.Probe(probeKeys.data(), c_numProbeRows, c_numThreads,
+            [&checksums](uint32_t workerIndex, const PklE::ThreadsafeContainers::JoinMatch* pMatches, uint32_t numMatches)
+            {
+                uint64_t checksum = 0;
+                for(uint32_t i = 0; i < numMatches; ++i)
+                {
+                    checksum += pMatches[i].buildRow ^ pMatches[i].probeRow;
+                }
+                checksums[workerIndex] += checksum;
+            });
+        auto probeEnd = std::chrono::high_resolution_clock::now();
+        ASSERT_EQ(numMatches, expectedMatches);
+        for(uint64_t checksum : checksums)
+        {
+            joinChecksum += checksum;
+        }
+
+        std::string buildTestName = std::string("HashJoin_partitionedBuild_") + selectivityLabel;
+        std::string probeTestName = std::string("HashJoin_batchedProbe_") + selectivityLabel;
+        HashmapBenchmarkTest::CreateResult(buildTestName.c_str(), std::chrono::duration_cast<std::chrono::nanoseconds>(buildEnd - buildStart),
+            c_numBuildRows, c_numThreads, "build row").Print();
+        HashmapBenchmarkTest::CreateResult(probeTestName.c_str(), std::chrono::duration_cast<std::chrono::nanoseconds>(probeEnd - probeStart),
+            c_numProbeRows, c_numThreads, "probe row").Print();
+        printf("%-70s %llu matches\n", probeTestName.c_str(), (unsigned long long)numMatches);
+    }
+
+    //Baseline: same multi-entry layout built and probed one row at a time through the locking interface
+    {
+        PklE::ThreadsafeContainers::HashMap<uint64_t, MultiEntry, 8, 16> map;
+        std::vector<uint32_t> nextRow(c_numBuildRows);
+        map.Reserve(c_numBuildRows);
+
+        const std::chrono::nanoseconds buildDuration = RunOnBenchmarkThreads(c_numThreads, [&](uint32_t threadIndex)
+        {
+            const uint32_t rowsPerThread = c_numBuildRows / c_numThreads;
+            for(uint32_t row = threadIndex * rowsPerThread; row < (threadIndex + 1) * rowsPerThread; ++row)
+            {
+                const uint64_t key = buildKeys[row];
+                nextRow[row] = JoinType::c_invalidRow;
+                if(!map.Insert_Concurrent(key, MultiEntry{row, 1}))
+                {
+                    map.Modify_Concurrent(key, [&nextRow, row](MultiEntry& entry)
+                    {
+                        nextRow[row] = entry.headRow;
+                        entry.headRow = row;
+                        ++entry.numRows;
+                    });
+                }
+            }
+        });
+        ASSERT_EQ(map.Size(), c_numBuildKeys);
+
+        std::atomic<uint64_t> numMatches{0};
+        std::atomic<uint64_t> checksumTotal{0};
+        const std::chrono::nanoseconds probeDuration = RunOnBenchmarkThreads(c_numThreads, [&](uint32_t threadIndex)
+        {
+            const uint64_t rowsPerThread = c_numProbeRows / c_numThreads;
+            uint64_t threadMatches = 0;
+            uint64_t checksum = 0;
+            for(uint64_t row = threadIndex * rowsPerThread; row < (threadIndex + 1) * rowsPerThread; ++row)
+            {
+                const auto* pPair = map.Find_Concurrent(probeKeys[row]);
+                if(pPair)
+                {
+                    for(uint32_t buildRow = pPair->value.headRow; buildRow != JoinType::c_invalidRow; buildRow = nextRow[buildRow])
+                    {
+                        checksum += buildRow ^ row;
+                        ++threadMatches;
+                    }
+                }
+            }
+            numMatches += threadMatches;
+            checksumTotal += checksum;
+        });
+        ASSERT_EQ(numMatches.load(), expectedMatches);
+        ASSERT_EQ(checksumTotal.load(), joinChecksum);
+
+        std::string buildTestName = std::string("PklEHashMap_perRowInsertBuild_") + selectivityLabel;
+        std::string probeTestName = std::string("PklEHashMap_perRowFindProbe_") + selectivityLabel;
+        HashmapBenchmarkTest::CreateResult(buildTestName.c_str(), buildDuration,
+            c_numBuildRows, c_numThreads, "build row").Print();
+        HashmapBenchmarkTest::CreateResult(probeTestName.c_str(), probeDuration,
+            c_numProbeRows, c_numThreads, "probe row").Print();
+    }
+}
+
+enum class PublishMode
+{
+    NoSwaps, //Readers only, one version for the whole run
+    PublishedSwaps, //PublishedHashMap, readers pin versions with guards
+    GlobalLockSwaps, //Baseline: readers take a global write priority read lock, the writer swaps the map pointer under the write lock
+};
+
+// Reader throughput on a reference data map of c_numKeys entries that a writer rebuilds and replaces every 100ms.
+// Values are key + version, so every read checks it sees one consistent version.
+void RunPublishedHashMapTest(PublishMode mode)
+{
+    using MapType = PklE::ThreadsafeContainers::HashMap<uint64_t, uint64_t, 8, 16>;
+    constexpr uint64_t c_numKeys = HashmapBenchmarkTest::PRELOAD_KEYS * 10;
+    constexpr uint32_t c_numReaders = 4;
+    constexpr uint32_t c_lookupsPerGuard = 16;
+    const std::chrono::milliseconds c_runDuration(2000);
+    const std::chrono::milliseconds c_swapInterval(100);
+
+    auto fillVersion = [](MapType& map, uint64_t version)
+    {
+        map.Reserve(static_cast<uint32_t>(c_numKeys));
+        for(uint64_t key = 0; key < c_numKeys; ++key)
+        {
+            map.Insert_Lockless(key, key + version);
+        }
+    };
+
+    PklE::ThreadsafeContainers::PublishedHashMap<MapType> publishedMap;
+    fillVersion(publishedMap.BeginNextVersion(), 1);
+    publishedMap.PublishNextVersion();
+
+    PklE::CoreTypes::CountingSpinlock globalLock;
+    MapType* pLockedMap = new MapType();
+    uint64_t lockedVersion = 1;
+    fillVersion(*pLockedMap, lockedVersion);
+
+    std::atomic<bool> bStop{false};
+    std::atomic<uint64_t> numReads{0};
+    std::atomic<uint64_t> numBadReads{0};
+    std::vector<std::thread> readers;
+    for(uint32_t readerIndex = 0; readerIndex < c_numReaders; ++readerIndex)
+    {
+        readers.emplace_back([&, readerIndex]()
+        {
+            std::mt19937_64 rng(readerIndex);
+            uint64_t readerReads = 0;
+            uint64_t readerBadReads = 0;
+            while(!bStop.load(std::memory_order_relaxed))
+            {
+                if(mode == PublishMode::GlobalLockSwaps)
+                {
+                    for(uint32_t i = 0; i < c_lookupsPerGuard; ++i)
+                    {
+                        const uint64_t key = rng() % c_numKeys;
+                        PklE::CoreTypes::ScopedWritePriorityReadSpinLock readLock(globalLock);
+                        const MapType::KeyValuePair* pPair = static_cast<const MapType*>(pLockedMap)->Find_Lockless(key);
+                        readerBadReads += (!pPair || (pPair->value != (key + lockedVersion))) ? 1 : 0;
+                    }
+                }
+                else
+                {
+                    auto guard = publishedMap.Acquire();
+                    for(uint32_t i = 0; i < c_lookupsPerGuard; ++i)
+                    {
+                        const uint64_t key = rng() % c_numKeys;
+                        const MapType::KeyValuePair* pPair = guard->Find_Lockless(key);
+                        readerBadReads += (!pPair || (pPair->value != (key + guard.GetVersion()))) ? 1 : 0;
+                    }
+                }
+                readerReads += c_lookupsPerGuard;
+            }
+            numReads += readerReads;
+            numBadReads += readerBadReads;
+        });
+    }
+
+    uint64_t numSwaps = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    auto nextSwap = start + c_swapInterval;
+    while((std::chrono::high_resolution_clock::now() - start) < c_runDuration)
+    {
+        std::this_thread::sleep_until(nextSwap);
+        nextSwap += c_swapInterval;
+        if(mode == PublishMode::PublishedSwaps)
+        {
+            fillVersion(publishedMap.BeginNextVersion(), publishedMap.GetVersion() + 1);
+            publishedMap.PublishNextVersion();
+            ++numSwaps;
+        }
+        else if(mode == PublishMode::GlobalLockSwaps)
+        {
+            MapType* pNextMap = new MapType();
+            fillVersion(*pNextMap, lockedVersion + 1);
+            MapType* pOldMap = nullptr;
+            {
+                PklE::CoreTypes::ScopedWritePriorityWriteSpinLock writeLock(globalLock);
+                pOldMap = pLockedMap;
+                pLockedMap = pNextMap;
+                ++lockedVersion;
+            }
+            delete pOldMap;
+            ++numSwaps;
+        }
+    }
+    bStop = true;
+    for(std::thread& reader : readers)
+    {
+        reader.join();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    delete pLockedMap;
+
+    ASSERT_EQ(numBadReads.load(), 0u);
+    const char* c_modeLabels[] = {"noSwaps", "publishedSwaps", "globalLockSwaps"};
+    std::string testName = std::string("PklEHashMap_referenceData_") + c_modeLabels[static_cast<uint32_t>(mode)];
+    HashmapBenchmarkTest::CreateResult(testName.c_str(), std::chrono::duration_cast<std::chrono::nanoseconds>(end - start),
+        numReads.load(), c_numReaders, "lookup").Print();
+    printf("%-70s %llu swaps\n", testName.c_str(), (unsigned long long)numSwaps);
+}
+
+// Reserve/release churn on one PagingObjectPool from numThreads threads, every thread keeps a window of up to
+// c_maxHeldObjects live objects so pages keep moving on and off the lock-free free list.
+// bUseMalloc runs the same pattern against Util::Malloc/Free as a reference.
+void RunObjectPoolContentionTest(uint32_t numThreads, bool bUseMalloc)
+{
+    struct PoolObject
+    {
+        uint64_t owner;
+        uint64_t payload[3];
+    };
+    using PoolType = PklE::CoreTypes::PagingObjectPool<PoolObject, 8>;
+    constexpr uint32_t c_maxHeldObjects = 16;
+    constexpr uint64_t c_opsPerThread = HashmapBenchmarkTest::OPERATIONS_PER_THREAD / 2;
+
+    PoolType pool;
+    std::atomic<bool> bStart{false};
+    std::atomic<uint64_t> numBadObjects{0};
+    std::vector<std::thread> threads;
+    for(uint32_t threadIndex = 0; threadIndex < numThreads; ++threadIndex)
+    {
+        threads.emplace_back([&, threadIndex]()
+        {
+            std::mt19937 rng(threadIndex);
+            PoolObject* pHeld[c_maxHeldObjects];
+            uint32_t numHeld = 0;
+            uint64_t threadBadObjects = 0;
+            while(!bStart.load(std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+            for(uint64_t i = 0; i < c_opsPerThread; ++i)
+            {
+                if((numHeld == 0) || ((numHeld < c_maxHeldObjects) && (rng() & 1)))
+                {
+                    PoolObject* pObject = bUseMalloc ? static_cast<PoolObject*>(PklE::Util::Malloc(sizeof(PoolObject))) : pool.Reserve();
+                    pObject->owner = threadIndex;
+                    pHeld[numHeld++] = pObject;
+                }
+                else
+                {
+                    const uint32_t heldIndex = rng() % numHeld;
+                    PoolObject* pObject = pHeld[heldIndex];
+                    threadBadObjects += (pObject->owner != threadIndex) ? 1 : 0;
+                    if(bUseMalloc)
+                    {
+                        PklE::Util::Free(pObject);
+                    }
+                    else
+                    {
+                        pool.Release(pObject);
+                    }
+                    pHeld[heldIndex] = pHeld[--numHeld];
+                }
+            }
+            for(uint32_t i = 0; i < numHeld; ++i)
+            {
+                threadBadObjects += (pHeld[i]->owner != threadIndex) ? 1 : 0;
+                if(bUseMalloc)
+                {
+                    PklE::Util::Free(pHeld[i]);
+                }
+                else
+                {
+                    pool.Release(pHeld[i]);
+                }
+            }
+            numBadObjects += threadBadObjects;
+        });
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    bStart.store(true, std::memory_order_release);
+    for(std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    ASSERT_EQ(numBadObjects.load(), 0u);
+    ASSERT_EQ(pool.Size(), 0u);
+    std::string testName = std::string(bUseMalloc ? "UtilMalloc" : "PagingObjectPool") + "_reserveRelease";
+    HashmapBenchmarkTest::CreateResult(testName.c_str(), std::chrono::duration_cast<std::chrono::nanoseconds>(end - start),
+        c_opsPerThread * numThreads, numThreads, "reserve/release").Print();
+    if(!bUseMalloc)
+    {
+        printf("%-70s %u pages\n", testName.c_str(), pool.GetCapacity() / PoolType::c_PageSize);
+    }
+}
+
+// Counter updates alone: NumStripes_T = 1 is the single shared atomic the containers used before
+template<uint32_t NumStripes_T>
+void RunStripedCounterTest(uint32_t numThreads)
+{
+    PklE::Util::StripedCounter<NumStripes_T> counter;
+    const std::chrono::nanoseconds duration = RunOnBenchmarkThreads(numThreads, [&counter](uint32_t threadIndex)
+    {
+        for(uint32_t i = 0; i < HashmapBenchmarkTest::OPERATIONS_PER_THREAD; ++i)
+        {
+            if((i & 3) == 3)
+            {
+                counter.Decrement();
+            }
+            else
+            {
+                counter.Increment();
+            }
+        }
+    });
+    ASSERT_EQ(counter.Read(), static_cast<int64_t>(numThreads) * (HashmapBenchmarkTest::OPERATIONS_PER_THREAD / 2));
+
+    std::string testName = std::string("StripedCounter_") + std::to_string(NumStripes_T) + "stripes";
+    HashmapBenchmarkTest::CreateResult(testName.c_str(), duration,
+        static_cast<uint64_t>(HashmapBenchmarkTest::OPERATIONS_PER_THREAD) * numThreads, numThreads, "update").Print();
+}
+
+// Insert/remove of thread private keys on a map with 64 inner maps, so threads rarely meet on a shard lock and the
+// remaining shared writes are the element counts of the map and its node pool
+void RunWriteScalingTest(uint32_t numThreads)
+{
+    using MapType = PklE::ThreadsafeContainers::HashMap<uint64_t, uint64_t, 8, 64>;
+    constexpr uint64_t c_keysPerThread = 1024;
+    MapType map;
+    map.Reserve(static_cast<uint32_t>(c_keysPerThread * numThreads));
+
+    const std::chrono::nanoseconds duration = RunOnBenchmarkThreads(numThreads, [&map](uint32_t threadIndex)
+    {
+        const uint64_t firstKey = static_cast<uint64_t>(threadIndex) * c_keysPerThread;
+        for(uint32_t i = 0; i < HashmapBenchmarkTest::OPERATIONS_PER_THREAD; ++i)
+        {
+            const uint64_t key = firstKey + ((i >> 1) % c_keysPerThread);
+            if((i & 1) == 0)
+            {
+                map.Insert_Concurrent(key, key);
+            }
+            else
+            {
+                map.Remove_Concurrent(key);
+            }
+        }
+    });
+    ASSERT_EQ(map.Size(), 0u);
+
+    const char* countMode = (PklE::Util::c_containerCountStripes == 1) ? "exactCounts" : "stripedCounts";
+    std::string testName = std::string("PklEHashMap_writeScaling64Shards_") + countMode;
+    HashmapBenchmarkTest::CreateResult(testName.c_str(), duration,
+        static_cast<uint64_t>(HashmapBenchmarkTest::OPERATIONS_PER_THREAD) * numThreads, numThreads, "insert/remove").Print();
+}
+
+// Per insert latency of Insert_Concurrent while c_numThreads threads fill a map and then churn on it.
+// Growable mode starts from an empty map, so bucket tables resize and pool pages get allocated on the insert path.
+// Fixed mode reserves the final size up front and switches to fixed capacity, the run must not allocate at all.
+void RunFixedCapacityLatencyTest(bool bFixedCapacity)
+{
+    using MapType = PklE::ThreadsafeContainers::HashMap<uint64_t, uint64_t, 8, 16>;
+    constexpr uint32_t c_numThreads = 4;
+    constexpr uint32_t c_keysPerThread = 50000;
+    constexpr uint32_t c_churnOpsPerThread = HashmapBenchmarkTest::OPERATIONS_PER_THREAD;
+    constexpr uint32_t c_insertsPerThread = c_keysPerThread + (c_churnOpsPerThread / 2);
+
+    MapType map;
+    if(bFixedCapacity)
+    {
+        map.Reserve(c_keysPerThread * c_numThreads);
+        map.SetFixedCapacity(true);
+    }
+
+    std::vector<LatencyHistogram> latencies(c_numThreads);
+    const uint64_t timerOverheadNs = GetTimerOverheadNs();
+    std::atomic<uint64_t> numFailedInserts{0};
+
+    const PklE::Util::ContainerAllocationCounters allocationsBefore = PklE::Util::GetContainerAllocationCounters();
+    const std::chrono::nanoseconds duration = RunOnBenchmarkThreads(c_numThreads, [&](uint32_t threadIndex)
+    {
+        LatencyHistogram& threadLatencies = latencies[threadIndex];
+        const uint64_t firstKey = static_cast<uint64_t>(threadIndex) * c_keysPerThread;
+        uint64_t threadFailedInserts = 0;
+        auto timedInsert = [&](uint64_t key)
+        {
+            MapType::KeyValuePair* pPair = nullptr;
+            auto start = std::chrono::steady_clock::now();
+            const MapType::InsertStatus status = map.TryInsert_Concurrent(key, pPair, key);
+            auto end = std::chrono::steady_clock::now();
+            const uint64_t elapsedNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+            threadLatencies.Record((elapsedNs > timerOverheadNs) ? (elapsedNs - timerOverheadNs) : 0);
+            threadFailedInserts += (status != MapType::InsertStatus::Inserted) ? 1 : 0;
+        };
+
+        for(uint32_t i = 0; i < c_keysPerThread; ++i)
+        {
+            timedInsert(firstKey + i);
+        }
+        std::mt19937_64 rng(threadIndex);
+        for(uint32_t i = 0; i < (c_churnOpsPerThread / 2); ++i)
+        {
+            const uint64_t key = firstKey + (rng() % c_keysPerThread);
+            map.Remove_Concurrent(key);
+            timedInsert(key);
+        }
+        numFailedInserts += threadFailedInserts;
+    });
+    const PklE::Util::ContainerAllocationCounters allocationsAfter = PklE::Util::GetContainerAllocationCounters();
+    const uint64_t numAllocations = allocationsAfter.numAllocations - allocationsBefore.numAllocations;
+
+    ASSERT_EQ(numFailedInserts.load(), 0u);
+    ASSERT_EQ(map.Size(), c_keysPerThread * c_numThreads);
+    if(bFixedCapacity)
+    {
+        ASSERT_EQ(numAllocations, 0u);
+        MapType::KeyValuePair* pPair = nullptr;
+        ASSERT_EQ(map.TryInsert_Concurrent(UINT64_MAX, pPair, 0), MapType::InsertStatus::CapacityExhausted);
+    }
+
+    LatencyHistogram allLatencies;
+    for(const LatencyHistogram& threadLatencies : latencies)
+    {
+        allLatencies.Merge(threadLatencies);
+    }
+    ASSERT_EQ(allLatencies.GetNumSamples(), static_cast<uint64_t>(c_insertsPerThread) * c_numThreads);
+
+    std::string testName = std::string("PklEHashMap_insertLatency_") + (bFixedCapacity ? "fixedCapacity" : "growable");
+    HashmapBenchmarkResult result = HashmapBenchmarkTest::CreateResult(testName.c_str(), duration, allLatencies.GetNumSamples(), c_numThreads, "insert");
+    result.SetLatencies(allLatencies);
+    result.Print();
+    printf("%-70s p99.99 %llu ns, %llu allocations (%llu KB)\n", testName.c_str(),
+           (unsigned long long)allLatencies.GetValueAtPercentile(99.99),
+           (unsigned long long)numAllocations, (unsigned long long)((allocationsAfter.numBytes - allocationsBefore.numBytes) / 1024));
+}
+
+// Clear and teardown cost of a PklE HashMap holding numEntries values, against the time to fill it.
+// Clear_Lockless() is a generation bump, the reset work moves to the refill that reuses the pages and buckets.
+// Teardown is timed once with the single threaded destructor and once with ReleaseMemory_Parallel() before it.
+template<typename Value_T, typename MakeValue_T>
+void RunClearTest(const char* valueName, uint32_t numEntries, MakeValue_T&& makeValue)
+{
+    using MapType = PklE::ThreadsafeContainers::HashMap<uint64_t, Value_T, 8, 16>;
+    const uint32_t numReleaseThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    auto fill = [&](MapType& map, uint64_t firstKey)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        for(uint32_t i = 0; i < numEntries; ++i)
+        {
+            map.Insert_Lockless(firstKey + i, makeValue(firstKey + i));
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+    };
+    auto printPhase = [&](const char* phase, std::chrono::nanoseconds duration, uint32_t numThreads)
+    {
+        std::string testName = std::string("PklEHashMap_") + phase + "_" + valueName + "_" + std::to_string(numEntries);
+        HashmapBenchmarkTest::CreateResult(testName.c_str(), duration, numEntries, numThreads, phase).Print();
+    };
+
+    {
+        MapType* pMap = new MapType();
+        printPhase("fill", fill(*pMap, 0), 1);
+
+        auto clearStart = std::chrono::high_resolution_clock::now();
+        pMap->Clear_Lockless();
+        auto clearEnd = std::chrono::high_resolution_clock::now();
+        ASSERT_EQ(pMap->Size(), 0u);
+        ASSERT_EQ(pMap->Find_Lockless(static_cast<uint64_t>(numEntries / 2)), nullptr);
+        printPhase("clear", std::chrono::duration_cast<std::chrono::nanoseconds>(clearEnd - clearStart), 1);
+
+        //The cleared pages are still there to be reused, reserving the same size must not add any
+        const uint32_t capacityAfterClear = pMap->GetCapacity();
+        pMap->Reserve(numEntries);
+        ASSERT_EQ(pMap->GetCapacity(), capacityAfterClear);
+
+        printPhase("refillAfterClear", fill(*pMap, numEntries), 1);
+        ASSERT_EQ(pMap->Size(), numEntries);
+        ASSERT_NE(pMap->Find_Lockless(static_cast<uint64_t>(numEntries) + (numEntries / 2)), nullptr);
+        ASSERT_EQ(pMap->Find_Lockless(static_cast<uint64_t>(numEntries / 2)), nullptr);
+
+        auto destroyStart = std::chrono::high_resolution_clock::now();
+        delete pMap;
+        auto destroyEnd = std::chrono::high_resolution_clock::now();
+        printPhase("destroy", std::chrono::duration_cast<std::chrono::nanoseconds>(destroyEnd - destroyStart), 1);
+    }
+
+    {
+        MapType* pMap = new MapType();
+        fill(*pMap, 0);
+
+        auto releaseStart = std::chrono::high_resolution_clock::now();
+        pMap->ReleaseMemory_Parallel(numReleaseThreads);
+        delete pMap;
+        auto releaseEnd = std::chrono::high_resolution_clock::now();
+        printPhase("releaseParallelAndDestroy", std::chrono::duration_cast<std::chrono::nanoseconds>(releaseEnd - releaseStart), numReleaseThreads);
+    }
+}
+
+// Forking a map and merging a delta map back, HashMap::Clone/Merge against the insert loop they replace.
+// The delta holds numEntries / 10 keys, half of them already in the main map. Every key's value is checked
+// after Clone and after Merge with both conflict policies.
+template<bool UnrolledBuckets_T>
+void RunCloneMergeTest(uint32_t numEntries, uint32_t numThreads)
+{
+    using MapType = PklE::ThreadsafeContainers::HashMap<uint64_t, uint64_t, 8, 16, UnrolledBuckets_T>;
+    const uint32_t numDeltaEntries = numEntries / 10;
+    const uint64_t firstDeltaKey = numEntries - (numDeltaEntries / 2);
+    const uint64_t endDeltaKey = firstDeltaKey + numDeltaEntries;
+    auto timeIt = [](auto&& func)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        func();
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+    };
+    auto fillDelta = [&](MapType& delta)
+    {
+        for(uint32_t i = 0; i < numDeltaEntries; ++i)
+        {
+            delta.Insert_Lockless(firstDeltaKey + i, i);
+        }
+    };
+    auto mainValue = [](uint64_t key) { return key * 2; };
+    auto deltaValue = [firstDeltaKey](uint64_t key) { return key - firstDeltaKey; };
+    // Keys in [firstKey, endKey) that are missing or do not hold expectedValue(key)
+    auto countMismatches = [](MapType& checkedMap, uint64_t firstKey, uint64_t endKey, auto&& expectedValue)
+    {
+        uint64_t numMismatches = 0;
+        for(uint64_t key = firstKey; key < endKey; ++key)
+        {
+            const auto* pPair = checkedMap.Find_Lockless(key);
+            numMismatches += ((pPair == nullptr) || (pPair->value != expectedValue(key))) ? 1 : 0;
+        }
+        return numMismatches;
+    };
+
+    MapType map;
+    for(uint32_t i = 0; i < numEntries; ++i)
+    {
+        map.Insert_Lockless(i, mainValue(i));
+    }
+
+    std::string prefix = (UnrolledBuckets_T) ? "PklEHashMapUnrolled_" : "PklEHashMap_";
+    std::string suffix = "_" + std::to_string(numEntries);
+    {
+        MapType copy;
+        std::chrono::nanoseconds duration = timeIt([&]()
+        {
+            for(auto& pair : map)
+            {
+                copy.Insert_Lockless(pair.key, pair.value);
+            }
+        });
+        ASSERT_EQ(copy.Size(), map.Size());
+        HashmapBenchmarkTest::CreateResult((prefix + "cloneInsertLoop" + suffix).c_str(), duration, numEntries, 1, "clone").Print();
+    }
+    {
+        MapType copy;
+        std::chrono::nanoseconds duration = timeIt([&]() { map.Clone(copy, numThreads); });
+        ASSERT_EQ(copy.Size(), map.Size());
+        EXPECT_EQ(countMismatches(copy, 0, numEntries, mainValue), 0u);
+        EXPECT_EQ(countMismatches(map, 0, numEntries, mainValue), 0u);
+
+        //The clone owns its entries, writing to it must leave the source alone
+        copy.Insert_Lockless(static_cast<uint64_t>(numEntries), 0);
+        ASSERT_TRUE(copy.Remove_Lockless(static_cast<uint64_t>(0)));
+        EXPECT_EQ(map.Find_Lockless(static_cast<uint64_t>(numEntries)), nullptr);
+        EXPECT_NE(map.Find_Lockless(static_cast<uint64_t>(0)), nullptr);
+        HashmapBenchmarkTest::CreateResult((prefix + "clone" + suffix).c_str(), duration, numEntries, numThreads, "clone").Print();
+    }
+
+    const uint32_t expectedMergedSize = numEntries + (numDeltaEntries - (numDeltaEntries / 2));
+    {
+        MapType target;
+        map.Clone(target, numThreads);
+        MapType delta;
+        fillDelta(delta);
+        std::chrono::nanoseconds duration = timeIt([&]()
+        {
+            for(auto& pair : delta)
+            {
+                target.Insert_Lockless(pair.key, pair.value);
+            }
+            delta.Clear_Lockless();
+        });
+        ASSERT_EQ(target.Size(), expectedMergedSize);
+        HashmapBenchmarkTest::CreateResult((prefix + "mergeInsertLoop" + suffix).c_str(), duration, numDeltaEntries, 1, "merge").Print();
+    }
+    {
+        MapType target;
+        map.Clone(target, numThreads);
+        MapType delta;
+        fillDelta(delta);
+        std::chrono::nanoseconds duration = timeIt([&]() { target.Merge(delta, MapType::MergeConflictPolicy::KeepExisting, numThreads); });
+        ASSERT_EQ(target.Size(), expectedMergedSize);
+        ASSERT_EQ(delta.Size(), 0u);
+        //Overlapping keys keep the target's value, the rest of the delta is added
+        EXPECT_EQ(countMismatches(target, 0, numEntries, mainValue), 0u);
+        EXPECT_EQ(countMismatches(target, numEntries, endDeltaKey, deltaValue), 0u);
+        HashmapBenchmarkTest::CreateResult((prefix + "merge" + suffix).c_str(), duration, numDeltaEntries, numThreads, "merge").Print();
+    }
+    {
+        MapType target;
+        map.Clone(target, numThreads);
+        MapType delta;
+        fillDelta(delta);
+        std::chrono::nanoseconds duration = timeIt([&]() { target.Merge(delta, MapType::MergeConflictPolicy::Overwrite, numThreads); });
+        ASSERT_EQ(target.Size(), expectedMergedSize);
+        ASSERT_EQ(delta.Size(), 0u);
+        //Overlapping keys take the delta's value
+        EXPECT_EQ(countMismatches(target, 0, firstDeltaKey, mainValue), 0u);
+        EXPECT_EQ(countMismatches(target, firstDeltaKey, endDeltaKey, deltaValue), 0u);
+        HashmapBenchmarkTest::CreateResult((prefix + "mergeOverwrite" + suffix).c_str(), duration, numDeltaEntries, numThreads, "merge").Print();
+    }
+}
+
+// All key pattern workloads of one map type with each skewed key generator, small values
+template<typename HashmapType>
+void RunSkewedKeyWorkloads()
+{
+    using KeyGenFunc = uint64_t (*)(uint32_t, uint32_t, uint32_t);
+    for(KeyGenFunc keyGen : {&KeyGenerator::Zipfian, &KeyGenerator::ScrambledZipfian, &KeyGenerator::HotSet, &KeyGenerator::MovingHotSpot})
+    {
+        RunInsertTest<uint64_t, uint64_t, HashmapType>(keyGen);
+        RunBatchInsertTest<uint64_t, uint64_t, HashmapType>(keyGen);
+        RunLookupTest<uint64_t, uint64_t, HashmapType>(keyGen);
+        RunBatchedLookupTest<uint64_t, uint64_t, HashmapType>(keyGen);
+        RunEraseTest<uint64_t, uint64_t, HashmapType>(keyGen);
+        RunMixedReadWriteTest<uint64_t, uint64_t, HashmapType>(keyGen, 90, 10);
+        RunMixedReadWriteTest<uint64_t, uint64_t, HashmapType>(keyGen, 50, 50);
+        RunMixedWithEraseTest<uint64_t, uint64_t, HashmapType>(keyGen, 40, 50, 10);
+        RunRekeyTest<uint64_t, uint64_t, HashmapType>(keyGen);
+        RunIteratorTest<uint64_t, uint64_t, HashmapType>(keyGen);
+    }
+}
+
+// One YCSB core workload: untimed load phase before every pass, then the timed run phase
+template<typename HashmapType>
+void RunYcsbWorkload(YcsbWorkload workload)
+{
+    HashmapType hashmap;
+    const YcsbWorkloadSpec& spec = GetYcsbWorkloadSpec(workload);
+    YcsbRunState state;
+
+    auto setupFunc = [&state](auto& map)
+    {
+        map.clear();
+        LoadYcsbRecords(map);
+        state.Reset();
+    };
+
+    auto testLogic = CreateYcsbOperation<uint64_t, uint64_t>(hashmap, spec, 16, state);
+
+    std::string baseTestLabel = spec.name;
+    std::string testLabel = baseTestLabel + (spec.bReadLatest ? "Latest" : "ScrambledZipfian");
+    std::string labeledTestName = std::string(HashmapType::GetMapTypeName()) + "_" + testLabel;
+
+    HashmapBenchmarkTest::RunThreadScalingBenchmark(
+        labeledTestName.c_str(),
+        hashmap,
+        setupFunc,
+        testLogic,
+        HashmapBenchmarkTest::OPERATIONS_PER_THREAD,
+        baseTestLabel.c_str());
+
+    if(spec.readPercent > 0)
+    {
+        ASSERT_GT(state.readHits.load(), 0u);
+    }
+    if(spec.updatePercent > 0 || spec.readModifyWritePercent > 0)
+    {
+        ASSERT_GT(state.updates.load(), 0u);
+    }
+    if(spec.insertPercent > 0)
+    {
+        ASSERT_GT(state.inserts.load(), 0u);
+    }
+    if(spec.scanPercent > 0)
+    {
+        ASSERT_GT(state.scannedRecords.load(), 0u);
+    }
+}
+
+// YCSB workloads A-F of one map type
+template<typename HashmapType>
+void RunYcsbSuite()
+{
+    for(YcsbWorkload workload : {YcsbWorkload::A, YcsbWorkload::B, YcsbWorkload::C, YcsbWorkload::D, YcsbWorkload::E, YcsbWorkload::F})
+    {
+        RunYcsbWorkload<HashmapType>(workload);
+    }
+}
+
+// Trace every replay test runs: PKLE_BENCH_TRACE when it is set, otherwise a synthetic trace recorded once from
+// the 40i50l10e workload with scrambled Zipfian keys on 8 threads. Not open if the trace could not be read or recorded.
+const MappedTrace& GetReplayTrace()
+{
+    static MappedTrace s_trace;
+    static const bool s_bInitialized = []()
+    {
+        const char* pTracePath = GetBenchmarkSettingString("PKLE_BENCH_TRACE");
+        if(pTracePath != nullptr)
+        {
+            s_trace.Open(pTracePath);
+            return true;
+        }
+
+        constexpr uint32_t c_numThreads = 8;
+        TraceRecordingMap<PklEHashMap<uint64_t, uint64_t, false>> recordingMap;
+        //The preload is single threaded setup, the replay applies it untimed instead of racing it against the workload
+        recordingMap.SetLoadPhase(true);
+        HashmapBenchmarkTest::PreloadHashmap(recordingMap, HashmapBenchmarkTest::PRELOAD_KEYS, KeyGenerator::ScrambledZipfian);
+        recordingMap.SetLoadPhase(false);
+
+        std::atomic<uint64_t> insertCounter{0};
+        std::atomic<uint64_t> lookupCounter{0};
+        std::atomic<uint64_t> eraseCounter{0};
+        auto testLogic = CreateComplexMixedOperation<uint64_t, uint64_t>(
+            recordingMap, KeyGenerator::ScrambledZipfian, c_numThreads,
+            insertCounter, lookupCounter, eraseCounter, 40, 50, 10);
+
+        RunOnBenchmarkThreads(c_numThreads, [&testLogic](uint32_t threadId)
+        {
+            const uint32_t firstIndex = threadId * HashmapBenchmarkTest::OPERATIONS_PER_THREAD;
+            for(uint32_t index = firstIndex; index < firstIndex + HashmapBenchmarkTest::OPERATIONS_PER_THREAD; ++index)
+            {
+                testLogic(index);
+            }
+        });
+
+        const char* pDirectory = getenv("TMPDIR");
+        std::string path = std::string((pDirectory && pDirectory[0]) ? pDirectory : "/tmp") + "/pkle_trace_XXXXXX";
+        const int fd = mkstemp(path.data());
+        if(fd >= 0)
+        {
+            close(fd);
+            if(recordingMap.Save(path))
+            {
+                s_trace.Open(path.c_str());
+            }
+            unlink(path.c_str());
+        }
+        return true;
+    }();
+    (void)s_bInitialized;
+    return s_trace;
+}
+
+// Replays the trace on an empty map with PKLE_BENCH_REPLAY_THREADS threads (default: as many as were recorded).
+// Only the workload records are timed and counted, the load phase runs before.
+template<typename HashmapType>
+void RunTraceReplayTest(bool bPaced)
+{
+    const MappedTrace& trace = GetReplayTrace();
+    ASSERT_GT(trace.GetNumRecords(), 0u);
+    const uint32_t numThreads = static_cast<uint32_t>(std::max<uint64_t>(1, GetBenchmarkSettingU64("PKLE_BENCH_REPLAY_THREADS", trace.GetNumThreads())));
+
+    HashmapType hashmap;
+    std::atomic<uint64_t> successCounter{0};
+    uint64_t numReplayed = 0;
+    const std::chrono::nanoseconds duration = ReplayTrace<uint64_t>(hashmap, trace, numThreads, bPaced, successCounter, numReplayed);
+    ASSERT_GT(numReplayed, 0u);
+
+    const char* pOperationType = bPaced ? "traceReplayPaced" : "traceReplay";
+    std::string labeledTestName = std::string(HashmapType::GetMapTypeName()) + "_" + pOperationType;
+    auto result = HashmapBenchmarkTest::CreateResult(labeledTestName.c_str(), duration, numReplayed, numThreads, pOperationType);
+    result.Print();
+
+    ASSERT_GT(successCounter.load(), 0u);
+}
+
+// Inserts keys [0, numKeys) on all hardware threads
+template<typename HashmapType>
+void PreloadWorkingSet(HashmapType& hashmap, uint64_t numKeys)
+{
+    const uint32_t numThreads = std::max(1u, std::thread::hardware_concurrency());
+    RunOnBenchmarkThreads(numThreads, [&hashmap, numKeys, numThreads](uint32_t threadId)
+    {
+        for(uint64_t key = threadId; key < numKeys; key += numThreads)
+        {
+            hashmap.insert(key, key * 2);
+        }
+    });
+}
+
+// Lookup, insert, 90r10w mixed and iteration over one working set of numKeys preloaded keys.
+// Lookups and reads are uniform over the working set, inserts add key numKeys + index and are erased again before every pass.
+// Returns the measured bytes per entry (RSS delta of the preload / numKeys).
+template<typename HashmapType>
+double RunWorkingSetPoint(uint64_t numKeys)
+{
+    const uint32_t numOperations = HashmapBenchmarkTest::OPERATIONS_PER_THREAD;
+    auto randomKey = [numKeys](uint32_t threadId, uint32_t iteration, uint32_t totalThreads) -> uint64_t
+    {
+        //splitmix64 finalizer, cheap enough not to show in the timings
+        uint64_t x = (static_cast<uint64_t>(threadId) << 32) + iteration + 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return (x ^ (x >> 31)) % numKeys;
+    };
+    auto newKey = [numKeys](uint32_t threadId, uint32_t iteration, uint32_t totalThreads) -> uint64_t
+    {
+        return numKeys + iteration;
+    };
+
+    std::unique_ptr<HashmapType> pHashmap = std::make_unique<HashmapType>();
+    HashmapType& hashmap = *pHashmap;
+
+    malloc_trim(0);
+    const uint64_t rssBefore = GetResidentSetBytes();
+    PreloadWorkingSet(hashmap, numKeys);
+    const uint64_t rssAfter = GetResidentSetBytes();
+    const double bytesPerEntry = static_cast<double>((rssAfter > rssBefore) ? (rssAfter - rssBefore) : 0) / static_cast<double>(numKeys);
+
+    const std::string setLabel = std::to_string(numKeys);
+    printf("%-70s %llu keys, %.1f bytes/entry (RSS delta)\n",
+           (std::string(HashmapType::GetMapTypeName()) + "_workingSet" + setLabel).c_str(),
+           (unsigned long long)numKeys,
+           bytesPerEntry);
+
+    // Lookups and iteration leave the map as it is, inserts are taken out again
+    auto noSetup = [](auto& map) {};
+    auto eraseInserted = [&newKey, numOperations](auto& map)
+    {
+        for(uint32_t index = 0; index < numOperations; ++index)
+        {
+            map.erase(newKey(0, index, 1));
+        }
+    };
+
+    std::atomic<uint64_t> successCounter{0};
+    std::atomic<uint64_t> readCounter{0};
+    std::atomic<uint64_t> writeCounter{0};
+    std::atomic<uint64_t> iterationCounter{0};
+
+    auto runPoint = [&hashmap, &setLabel](const char* pWorkload, auto&& setupFunc, auto&& testLogic, uint64_t expectedCount)
+    {
+        std::string labeledTestName = std::string(HashmapType::GetMapTypeName()) + "_" + pWorkload + setLabel;
+        HashmapBenchmarkTest::RunThreadScalingBenchmark(
+            labeledTestName.c_str(),
+            hashmap,
+            setupFunc,
+            testLogic,
+            expectedCount,
+            pWorkload);
+    };
+
+    runPoint("wsLookup", noSetup, CreateLookupOperation<uint64_t, uint64_t>(hashmap, randomKey, 16, successCounter), numOperations);
+    runPoint("wsInsert", eraseInserted, CreateInsertOperation<uint64_t, uint64_t>(hashmap, newKey, 16), numOperations);
+
+    // 90% uniform reads of the working set, 10% inserts of new keys
+    auto mixedLogic = [&hashmap, &randomKey, &newKey, &readCounter, &writeCounter](uint32_t index)
+    {
+        const uint32_t threadId = index % 16;
+        const uint64_t* pValue = nullptr;
+        if((index % 100) < 90)
+        {
+            if(hashmap.find(randomKey(threadId, index, 16), pValue))
+            {
+                readCounter.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        else if(hashmap.insert(newKey(threadId, index, 16), index))
+        {
+            writeCounter.fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+    runPoint("ws90r10w", eraseInserted, mixedLogic, numOperations);
+    runPoint("wsIteration", noSetup, CreateIteratorOperation<uint64_t, uint64_t>(hashmap, iterationCounter), HashmapBenchmarkTest::ITERATOR_OPERATIONS);
+
+    EXPECT_GT(successCounter.load(), 0u);
+    EXPECT_GT(readCounter.load(), 0u);
+    EXPECT_GT(writeCounter.load(), 0u);
+    EXPECT_GT(iterationCounter.load(), 0u);
+
+    //Give the memory back before the next, larger point measures its RSS
+    pHashmap.reset();
+    malloc_trim(0);
+    return bytesPerEntry;
+}
+
+// Working set sweep over PKLE_BENCH_WORKING_SET_KEYS (default 10K, 1M, 10M keys; add 100000000,1000000000 for the
+// large points). A point is skipped when its estimated footprint, from the bytes per entry of the previous point,
+// does not fit in half of the available memory.
+template<typename HashmapType>
+void RunWorkingSetSweep()
+{
+    constexpr double c_initialBytesPerEntryEstimate = 64.0;
+    const std::vector<uint64_t> workingSetSizes = GetBenchmarkSettingU64List("PKLE_BENCH_WORKING_SET_KEYS", {10000, 1000000, 10000000});
+
+    double bytesPerEntryEstimate = c_initialBytesPerEntryEstimate;
+    for(uint64_t numKeys : workingSetSizes)
+    {
+        if(numKeys == 0)
+        {
+            continue;
+        }
+        const double estimatedBytes = bytesPerEntryEstimate * static_cast<double>(numKeys);
+        const uint64_t availableBytes = GetAvailableMemoryBytes();
+        if(availableBytes > 0 && estimatedBytes > static_cast<double>(availableBytes) / 2.0)
+        {
+            printf("%-70s skipped, needs ~%.0f MiB of %llu MiB available\n",
+                   (std::string(HashmapType::GetMapTypeName()) + "_workingSet" + std::to_string(numKeys)).c_str(),
+                   estimatedBytes / (1024.0 * 1024.0),
+                   (unsigned long long)(availableBytes / (1024 * 1024)));
+            continue;
+        }
+        const double measuredBytesPerEntry = RunWorkingSetPoint<HashmapType>(numKeys);
+        if(measuredBytesPerEntry > 0.0)
+        {
+            bytesPerEntryEstimate = measuredBytesPerEntry;
+        }
+    }
+}
+
+// Per reader process results, written into an anonymous shared mapping the parent reads after waitpid()
+struct SharedMemoryReaderResult
+{
+    uint64_t attachNs;
+    uint64_t lookupNs;
+    uint64_t numHits;
+    uint32_t bSucceeded;
+    uint32_t bDone;
+};
+
+// One writer (this process) populates a SharedMemoryHashMap, then forks reader processes that attach to the segment
+// and run lookups in place. Reports read throughput across processes and the average attach time per process.
+// bNamedSegment: attach through shm_open by name instead of the inherited memfd.
+// bConcurrentWriter: readers attach writable and use the cross-process read lock while the writer keeps updating.
+void RunSharedMemoryForkReadTest(bool bNamedSegment, bool bConcurrentWriter)
+{
+    using SharedMapType = PklE::ThreadsafeContainers::SharedMemoryHashMap<uint64_t, uint64_t>;
+    constexpr uint32_t c_numKeys = HashmapBenchmarkTest::PRELOAD_KEYS * 10;
+    constexpr uint32_t c_readerCounts[] = {16, 8, 4, 2, 1};
+    constexpr uint32_t c_maxReaders = 16;
+
+    const std::string segmentName = "/pkle_shm_bench_" + std::to_string(getpid());
+    SharedMapType writerMap;
+    ASSERT_TRUE(writerMap.Create(c_numKeys, bNamedSegment ? segmentName.c_str() : nullptr));
+
+    auto populateStart = std::chrono::high_resolution_clock::now();
+    for(uint64_t i = 0; i < c_numKeys; ++i)
+    {
+        writerMap.Insert_Lockless(i, i * 2);
+    }
+    auto populateEnd = std::chrono::high_resolution_clock::now();
+    ASSERT_EQ(writerMap.size(), c_numKeys);
+
+    std::string baseTestLabel = bConcurrentWriter ? "sharedConcurrentRead" : "sharedRead";
+    std::string testLabel = baseTestLabel + (bNamedSegment ? "NamedShm" : "Memfd");
+    std::string labeledTestName = std::string("SharedMemoryHashMap_") + testLabel;
+    std::string populateTestName = std::string("SharedMemoryHashMap_populate") + (bNamedSegment ? "NamedShm" : "Memfd");
+    std::string attachTestName = std::string("SharedMemoryHashMap_attach") + (bNamedSegment ? "NamedShm" : "Memfd");
+
+    HashmapBenchmarkTest::CreateResult(populateTestName.c_str(),
+        std::chrono::duration_cast<std::chrono::nanoseconds>(populateEnd - populateStart), c_numKeys, 1, "populate").Print();
+
+    void* pResultsMapping = mmap(nullptr, sizeof(SharedMemoryReaderResult) * c_maxReaders, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    ASSERT_NE(pResultsMapping, MAP_FAILED);
+    SharedMemoryReaderResult* pResults = static_cast<SharedMemoryReaderResult*>(pResultsMapping);
+
+    for(const uint32_t numReaders : c_readerCounts)
+    {
+        memset(pResults, 0, sizeof(SharedMemoryReaderResult) * c_maxReaders);
+
+        pid_t readerPids[c_maxReaders] = {};
+        for(uint32_t readerIndex = 0; readerIndex < numReaders; ++readerIndex)
+        {
+            readerPids[readerIndex] = fork();
+            ASSERT_GE(readerPids[readerIndex], 0);
+            if(readerPids[readerIndex] == 0)
+            {
+                //Reader process: never returns into gtest, leaves through _exit()
+                SharedMemoryReaderResult& result = pResults[readerIndex];
+                const bool bReadOnly = !bConcurrentWriter;
+
+                auto attachStart = std::chrono::high_resolution_clock::now();
+                SharedMapType readerMap;
+                const bool bAttached = bNamedSegment ? readerMap.Attach(segmentName.c_str(), bReadOnly) : readerMap.Attach(writerMap.GetFd(), bReadOnly);
+                auto attachEnd = std::chrono::high_resolution_clock::now();
+                if(!bAttached)
+                {
+                    PklE::Util::AtomicStoreU32(result.bDone, 1, PklE::Util::MemoryOrder::RELEASE);
+                    _exit(1);
+                }
+
+                uint64_t numHits = 0;
+                auto lookupStart = std::chrono::high_resolution_clock::now();
+                for(uint64_t i = 0; i < HashmapBenchmarkTest::OPERATIONS_PER_THREAD; ++i)
+                {
+                    //Half of the probed keys are present
+                    const uint64_t key = ((i + readerIndex) * 2654435761ULL) % (static_cast<uint64_t>(c_numKeys) * 2);
+                    if(bConcurrentWriter)
+                    {
+                        uint64_t value = 0;
+                        numHits += readerMap.find(key, value) ? 1 : 0;
+                    }
+                    else
+                    {
+                        numHits += (readerMap.find_lockless(key) != nullptr) ? 1 : 0;
+                    }
+                }
+                auto lookupEnd = std::chrono::high_resolution_clock::now();
+
+                result.attachNs = std::chrono::duration_cast<std::chrono::nanoseconds>(attachEnd - attachStart).count();
+                result.lookupNs = std::chrono::duration_cast<std::chrono::nanoseconds>(lookupEnd - lookupStart).count();
+                result.numHits = numHits;
+                result.bSucceeded = 1;
+                PklE::Util::AtomicStoreU32(result.bDone, 1, PklE::Util::MemoryOrder::RELEASE);
+                readerMap.Detach();
+                _exit(0);
+            }
+        }
+
+        if(bConcurrentWriter)
+        {
+            //Keep overwriting values while the readers run, under the same cross-process locks
+            bool bReadersRunning = true;
+            for(uint64_t i = 0; bReadersRunning; ++i)
+            {
+                writerMap.insert(i % c_numKeys, i);
+                if((i % 1024) == 0)
+                {
+                    bReadersRunning = false;
+                    for(uint32_t readerIndex = 0; readerIndex < numReaders; ++readerIndex)
+                    {
+                        bReadersRunning |= (PklE::Util::AtomicLoadU32(pResults[readerIndex].bDone, PklE::Util::MemoryOrder::ACQUIRE) == 0);
+                    }
+                }
+            }
+        }
+
+        uint64_t maxLookupNs = 0;
+        uint64_t totalAttachNs = 0;
+        uint64_t totalHits = 0;
+        for(uint32_t readerIndex = 0; readerIndex < numReaders; ++readerIndex)
+        {
+            int status = 0;
+            waitpid(readerPids[readerIndex], &status, 0);
+            ASSERT_TRUE(WIFEXITED(status) && (WEXITSTATUS(status) == 0));
+            ASSERT_EQ(pResults[readerIndex].bSucceeded, 1u);
+
+            maxLookupNs = std::max(maxLookupNs, pResults[readerIndex].lookupNs);
+            totalAttachNs += pResults[readerIndex].attachNs;
+            totalHits += pResults[readerIndex].numHits;
+        }
+        ASSERT_GT(totalHits, 0u);
+
+        //Readers run side by side, so throughput is all lookups over the slowest reader's time
+        HashmapBenchmarkTest::CreateResult(labeledTestName.c_str(), std::chrono::nanoseconds(maxLookupNs),
+            static_cast<uint64_t>(HashmapBenchmarkTest::OPERATIONS_PER_THREAD) * numReaders, numReaders, baseTestLabel.c_str()).Print();
+        //ns/op is the average attach time per reader process
+        HashmapBenchmarkTest::CreateResult(attachTestName.c_str(), std::chrono::nanoseconds(totalAttachNs),
+            numReaders, numReaders, "attach").Print();
+    }
+
+    munmap(pResultsMapping, sizeof(SharedMemoryReaderResult) * c_maxReaders);
+}
+
+// ============================================================================
+// STD::UNORDERED_MAP LOCKED WRAPPER
+// ============================================================================
+TEST_F(HashmapInsertTest, StdUnorderedMapLocked_InsertSequential)
+{
+    RunInsertTest<uint64_t, uint64_t, StdUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapInsertTest, StdUnorderedMapLocked_InsertSequentialBigValue)
+{
+    RunInsertTest<uint64_t, TestValueStruct, StdUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapInsertTest, StdUnorderedMapLocked_InsertRandom)
+{
+    RunInsertTest<uint64_t, uint64_t, StdUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapInsertTest, StdUnorderedMapLocked_InsertRandomBigValue)
+{
+    RunInsertTest<uint64_t, TestValueStruct, StdUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapBatchInsertTest, StdUnorderedMapLocked_BatchInsertSequential)
+{
+    RunBatchInsertTest<uint64_t, uint64_t, StdUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapBatchInsertTest, StdUnorderedMapLocked_BatchInsertSequentialBigValue)
+{
+    RunBatchInsertTest<uint64_t, TestValueStruct, StdUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapBatchInsertTest, StdUnorderedMapLocked_BatchInsertRandom)
+{
+    RunBatchInsertTest<uint64_t, uint64_t, StdUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapBatchInsertTest, StdUnorderedMapLocked_BatchInsertRandomBigValue)
+{
+    RunBatchInsertTest<uint64_t, TestValueStruct, StdUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapLookupTest, StdUnorderedMapLocked_LookupSequential)
+{
+    RunLookupTest<uint64_t, uint64_t, StdUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapLookupTest, StdUnorderedMapLocked_LookupSequentialBigValue)
+{
+    RunLookupTest<uint64_t, TestValueStruct, StdUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapLookupTest, StdUnorderedMapLocked_LookupRandom)
+{
+    RunLookupTest<uint64_t, uint64_t, StdUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapLookupTest, StdUnorderedMapLocked_LookupRandomBigValue)
+{
+    RunLookupTest<uint64_t, TestValueStruct, StdUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapBatchedLookupTest, StdUnorderedMapLocked_BatchedLookupSequential)
+{
+    RunBatchedLookupTest<uint64_t, uint64_t, StdUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapBatchedLookupTest, StdUnorderedMapLocked_BatchedLookupSequentialBigValue)
+{
+    RunBatchedLookupTest<uint64_t, TestValueStruct, StdUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapBatchedLookupTest, StdUnorderedMapLocked_BatchedLookupRandom)
+{
+    RunBatchedLookupTest<uint64_t, uint64_t, StdUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapBatchedLookupTest, StdUnorderedMapLocked_BatchedLookupRandomBigValue)
+{
+    RunBatchedLookupTest<uint64_t, TestValueStruct, StdUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapEraseTest, StdUnorderedMapLocked_EraseSequential)
+{
+    RunEraseTest<uint64_t, uint64_t, StdUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapEraseTest, StdUnorderedMapLocked_EraseSequentialBigValue)
+{
+    RunEraseTest<uint64_t, TestValueStruct, StdUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapMixedTest, StdUnorderedMapLocked_90r10w)
+{
+    RunMixedReadWriteTest<uint64_t, uint64_t, StdUnorderedMapLocked<uint64_t, uint64_t>>(
+        KeyGenerator::Sequential,
+        90,
+        10);
+}
+
+TEST_F(HashmapMixedTest, StdUnorderedMapLocked_90r10wBigValue)
+{
+    RunMixedReadWriteTest<uint64_t, TestValueStruct, StdUnorderedMapLocked<uint64_t, TestValueStruct>>(
+        KeyGenerator::Sequential,
+        90,
+        10);
+}
+
+TEST_F(HashmapMixedTest, StdUnorderedMapLocked_50r50w)
+{
+    RunMixedReadWriteTest<uint64_t, uint64_t, StdUnorderedMapLocked<uint64_t, uint64_t>>(
+        KeyGenerator::Sequential,
+        50,
+        50);
+}
+
+TEST_F(HashmapMixedTest, StdUnorderedMapLocked_50r50wBigValue)
+{
+    RunMixedReadWriteTest<uint64_t, TestValueStruct, StdUnorderedMapLocked<uint64_t, TestValueStruct>>(
+        KeyGenerator::Sequential,
+        50,
+        50);
+}
+
+TEST_F(HashmapMixedTest, StdUnorderedMapLocked_40i50l10e)
+{
+    RunMixedWithEraseTest<uint64_t, uint64_t, StdUnorderedMapLocked<uint64_t, uint64_t>>(
+        KeyGenerator::Sequential,
+        40,
+        50,
+        10);
+}
+
+TEST_F(HashmapMixedTest, StdUnorderedMapLocked_40i50l10eBigValue)
+{
+    RunMixedWithEraseTest<uint64_t, TestValueStruct, StdUnorderedMapLocked<uint64_t, TestValueStruct>>(
+        KeyGenerator::Sequential,
+        40,
+        50,
+        10);
+}
+
+TEST_F(HashmapContendedTest, StdUnorderedMapLocked_ContendedInsert)
+{
+    RunInsertTest<uint64_t, uint64_t, StdUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Contended, "contendedInsert");
+}
+
+TEST_F(HashmapContendedTest, StdUnorderedMapLocked_ContendedInsertBigValue)
+{
+    RunInsertTest<uint64_t, TestValueStruct, StdUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Contended, "contendedInsert");
+}
+
+TEST_F(HashmapRekeyTest, StdUnorderedMapLocked_RekeySequential)
+{
+    RunRekeyTest<uint64_t, uint64_t, StdUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapRekeyTest, StdUnorderedMapLocked_RekeySequentialBigValue)
+{
+    RunRekeyTest<uint64_t, TestValueStruct, StdUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapIteratorTest, StdUnorderedMapLocked_IteratorsSequential)
+{
+    RunIteratorTest<uint64_t, uint64_t, StdUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapIteratorTest, StdUnorderedMapLocked_IteratorsSequentialBigValue)
+{
+    RunIteratorTest<uint64_t, TestValueStruct, StdUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapIteratorTest, StdUnorderedMapLocked_IteratorsRandom)
+{
+    RunIteratorTest<uint64_t, uint64_t, StdUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapIteratorTest, StdUnorderedMapLocked_IteratorsRandomBigValue)
+{
+    RunIteratorTest<uint64_t, TestValueStruct, StdUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
+}
+
+
+
+// ============================================================================
+// PKLE HASHMAP TESTS LOCKLESS - PklE::ThreadsafeContainers::HashMap without using internal locking
+// ============================================================================
+TEST_F(HashmapInsertTest, PklEHashMapLockless_InsertSequential)
+{
+    RunInsertTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, true>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapInsertTest, PklEHashMapLockless_InsertSequentialBigValue)
+{
+    RunInsertTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, true>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapInsertTest, PklEHashMapLockless_InsertRandom)
+{
+    RunInsertTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, true>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapInsertTest, PklEHashMapLockless_InsertRandomBigValue)
+{
+    RunInsertTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, true>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapBatchInsertTest, PklEHashMapLockless_BatchInsertSequential)
+{
+    RunBatchInsertTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, true>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapBatchInsertTest, PklEHashMapLockless_BatchInsertSequentialBigValue)
+{
+    RunBatchInsertTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, true>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapBatchInsertTest, PklEHashMapLockless_BatchInsertRandom)
+{
+    RunBatchInsertTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, true>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapBatchInsertTest, PklEHashMapLockless_BatchInsertRandomBigValue)
+{
+    RunBatchInsertTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, true>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapLookupTest, PklEHashMapLockless_LookupSequential)
+{
+    RunLookupTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, true>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapLookupTest, PklEHashMapLockless_LookupSequentialBigValue)
+{
+    RunLookupTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, true>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapLookupTest, PklEHashMapLockless_LookupRandom)
+{
+    RunLookupTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, true>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapLookupTest, PklEHashMapLockless_LookupRandomBigValue)
+{
+    RunLookupTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, true>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapBatchedLookupTest, PklEHashMapLockless_BatchedLookupSequential)
+{
+    RunBatchedLookupTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, true>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapBatchedLookupTest, PklEHashMapLockless_BatchedLookupSequentialBigValue)
+{
+    RunBatchedLookupTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, true>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapBatchedLookupTest, PklEHashMapLockless_BatchedLookupRandom)
+{
+    RunBatchedLookupTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, true>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapBatchedLookupTest, PklEHashMapLockless_BatchedLookupRandomBigValue)
+{
+    RunBatchedLookupTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, true>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapEraseTest, PklEHashMapLockless_EraseSequential)
+{
+    RunEraseTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, true>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapEraseTest, PklEHashMapLockless_EraseSequentialBigValue)
+{
+    RunEraseTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, true>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapMixedTest, PklEHashMapLockless_90r10w)
+{
+    RunMixedReadWriteTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, true>>(KeyGenerator::Sequential, 90, 10);
+}
+
+TEST_F(HashmapMixedTest, PklEHashMapLockless_90r10wBigValue)
+{
+    RunMixedReadWriteTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, true>>(KeyGenerator::Sequential, 90, 10);
+}
+
+TEST_F(HashmapMixedTest, PklEHashMapLockless_50r50w)
+{
+    RunMixedReadWriteTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, true>>(KeyGenerator::Sequential, 50, 50);
+}
+
+TEST_F(HashmapMixedTest, PklEHashMapLockless_50r50wBigValue)
+{
+    RunMixedReadWriteTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, true>>(KeyGenerator::Sequential, 50, 50);
+}
+
+TEST_F(HashmapMixedTest, PklEHashMapLockless_40i50l10e)
+{
+    RunMixedWithEraseTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, true>>(KeyGenerator::Sequential, 40, 50, 10);
+}
+
+TEST_F(HashmapMixedTest, PklEHashMapLockless_40i50l10eBigValue)
+{
+    RunMixedWithEraseTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, true>>(KeyGenerator::Sequential, 40, 50, 10);
+}
+
+TEST_F(HashmapContendedTest, PklEHashMapLockless_ContendedInsert)
+{
+    RunInsertTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, true>>(KeyGenerator::Contended, "contendedInsert");
+}
+
+TEST_F(HashmapContendedTest, PklEHashMapLockless_ContendedInsertBigValue)
+{
+    RunInsertTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, true>>(KeyGenerator::Contended, "contendedInsert");
+}
+
+TEST_F(HashmapRekeyTest, PklEHashMapLockless_RekeySequential)
+{
+    RunRekeyTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, true>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapRekeyTest, PklEHashMapLockless_RekeySequentialBigValue)
+{
+    RunRekeyTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, true>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapIteratorTest, PklEHashMapLockless_IteratorsSequential)
+{
+    RunIteratorTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, true>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapIteratorTest, PklEHashMapLockless_IteratorsSequentialBigValue)
+{
+    RunIteratorTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, true>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapIteratorTest, PklEHashMapLockless_IteratorsRandom)
+{
+    RunIteratorTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, true>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapIteratorTest, PklEHashMapLockless_IteratorsRandomBigValue)
+{
+    RunIteratorTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, true>>(KeyGenerator::Random);
+}
+
+// ============================================================================
+// PKLE HASHMAP TESTS CONCURRENT - PklE::ThreadsafeContainers::HashMap using internal locking
+// ============================================================================
+TEST_F(HashmapInsertTest, PklEHashMap_InsertSequential)
+{
+    RunInsertTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapInsertTest, PklEHashMap_InsertSequentialBigValue)
+{
+    RunInsertTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapInsertTest, PklEHashMap_InsertRandom)
+{
+    RunInsertTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapInsertTest, PklEHashMap_InsertRandomBigValue)
+{
+    RunInsertTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapBatchInsertTest, PklEHashMap_BatchInsertSequential)
+{
+    RunBatchInsertTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapBatchInsertTest, PklEHashMap_BatchInsertSequentialBigValue)
+{
+    RunBatchInsertTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapBatchInsertTest, PklEHashMap_BatchInsertRandom)
+{
+    RunBatchInsertTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapBatchInsertTest, PklEHashMap_BatchInsertRandomBigValue)
+{
+    RunBatchInsertTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapLookupTest, PklEHashMap_LookupSequential)
+{
+    RunLookupTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapLookupTest, PklEHashMap_LookupSequentialBigValue)
+{
+    RunLookupTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapLookupTest, PklEHashMap_LookupRandom)
+{
+    RunLookupTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapLookupTest, PklEHashMap_LookupRandomBigValue)
+{
+    RunLookupTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapBatchedLookupTest, PklEHashMap_BatchedLookupSequential)
+{
+    RunBatchedLookupTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapBatchedLookupTest, PklEHashMap_BatchedLookupSequentialBigValue)
+{
+    RunBatchedLookupTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapBatchedLookupTest, PklEHashMap_BatchedLookupRandom)
+{
+    RunBatchedLookupTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapBatchedLookupTest, PklEHashMap_BatchedLookupRandomBigValue)
+{
+    RunBatchedLookupTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapEraseTest, PklEHashMap_EraseSequential)
+{
+    RunEraseTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapEraseTest, PklEHashMap_EraseSequentialBigValue)
+{
+    RunEraseTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false>>(KeyGenerator::Sequential);
+}
+
+
+TEST_F(HashmapMixedTest, PklEHashMap_90r10w)
+{
+    RunMixedReadWriteTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false>>(KeyGenerator::Sequential, 90, 10);
+}
+
+TEST_F(HashmapMixedTest, PklEHashMap_90r10wBigValue)
+{
+    RunMixedReadWriteTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false>>(KeyGenerator::Sequential, 90, 10);
+}
+
+TEST_F(HashmapMixedTest, PklEHashMap_50r50w)
+{
+    RunMixedReadWriteTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false>>(KeyGenerator::Sequential, 50, 50);
+}
+
+TEST_F(HashmapMixedTest, PklEHashMap_50r50wBigValue)
+{
+    RunMixedReadWriteTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false>>(KeyGenerator::Sequential, 50, 50);
+}
+
+TEST_F(HashmapMixedTest, PklEHashMap_40i50l10e)
+{
+    RunMixedWithEraseTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false>>(KeyGenerator::Sequential, 40, 50, 10);
+}
+
+TEST_F(HashmapMixedTest, PklEHashMap_40i50l10eBigValue)
+{
+    RunMixedWithEraseTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false>>(KeyGenerator::Sequential, 40, 50, 10);
+}
+
+TEST_F(HashmapContendedTest, PklEHashMap_ContendedInsert)
+{
+    RunInsertTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false>>(KeyGenerator::Contended, "contendedInsert");
+}
+
+TEST_F(HashmapContendedTest, PklEHashMap_ContendedInsertBigValue)
+{
+    RunInsertTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false>>(KeyGenerator::Contended, "contendedInsert");
+}
+
+TEST_F(HashmapRekeyTest, PklEHashMap_RekeySequential)
+{
+    RunRekeyTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapRekeyTest, PklEHashMap_RekeySequentialBigValue)
+{
+    RunRekeyTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapIteratorTest, PklEHashMap_IteratorsSequential)
+{
+    RunIteratorTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapIteratorTest, PklEHashMap_IteratorsSequentialBigValue)
+{
+    RunIteratorTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapIteratorTest, PklEHashMap_IteratorsRandom)
+{
+    RunIteratorTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapIteratorTest, PklEHashMap_IteratorsRandomBigValue)
+{
+    RunIteratorTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false>>(KeyGenerator::Random);
+}
+
+// ============================================================================
+// PKLE HASHMAP TESTS UNROLLED - PklE::ThreadsafeContainers::HashMap with cache-line bucket blocks
+// ============================================================================
+TEST_F(HashmapInsertTest, PklEHashMapUnrolled_InsertSequential)
+{
+    RunInsertTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false, true>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapInsertTest, PklEHashMapUnrolled_InsertSequentialBigValue)
+{
+    RunInsertTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false, true>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapInsertTest, PklEHashMapUnrolled_InsertRandom)
+{
+    RunInsertTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false, true>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapInsertTest, PklEHashMapUnrolled_InsertRandomBigValue)
+{
+    RunInsertTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false, true>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapLookupTest, PklEHashMapUnrolled_LookupSequential)
+{
+    RunLookupTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false, true>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapLookupTest, PklEHashMapUnrolled_LookupSequentialBigValue)
+{
+    RunLookupTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false, true>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapLookupTest, PklEHashMapUnrolled_LookupRandom)
+{
+    RunLookupTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false, true>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapLookupTest, PklEHashMapUnrolled_LookupRandomBigValue)
+{
+    RunLookupTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false, true>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapBatchedLookupTest, PklEHashMapUnrolled_BatchedLookupSequential)
+{
+    RunBatchedLookupTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false, true>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapBatchedLookupTest, PklEHashMapUnrolled_BatchedLookupSequentialBigValue)
+{
+    RunBatchedLookupTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false, true>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapBatchedLookupTest, PklEHashMapUnrolled_BatchedLookupRandom)
+{
+    RunBatchedLookupTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false, true>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapBatchedLookupTest, PklEHashMapUnrolled_BatchedLookupRandomBigValue)
+{
+    RunBatchedLookupTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false, true>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapEraseTest, PklEHashMapUnrolled_EraseSequential)
+{
+    RunEraseTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false, true>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapEraseTest, PklEHashMapUnrolled_EraseSequentialBigValue)
+{
+    RunEraseTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false, true>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapMixedTest, PklEHashMapUnrolled_90r10w)
+{
+    RunMixedReadWriteTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false, true>>(KeyGenerator::Sequential, 90, 10);
+}
+
+TEST_F(HashmapMixedTest, PklEHashMapUnrolled_90r10wBigValue)
+{
+    RunMixedReadWriteTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false, true>>(KeyGenerator::Sequential, 90, 10);
+}
+
+TEST_F(HashmapMixedTest, PklEHashMapUnrolled_50r50w)
+{
+    RunMixedReadWriteTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false, true>>(KeyGenerator::Sequential, 50, 50);
+}
+
+TEST_F(HashmapMixedTest, PklEHashMapUnrolled_50r50wBigValue)
+{
+    RunMixedReadWriteTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false, true>>(KeyGenerator::Sequential, 50, 50);
+}
+
+TEST_F(HashmapMixedTest, PklEHashMapUnrolled_40i50l10e)
+{
+    RunMixedWithEraseTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false, true>>(KeyGenerator::Sequential, 40, 50, 10);
+}
+
+TEST_F(HashmapMixedTest, PklEHashMapUnrolled_40i50l10eBigValue)
+{
+    RunMixedWithEraseTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false, true>>(KeyGenerator::Sequential, 40, 50, 10);
+}
+
+TEST_F(HashmapRekeyTest, PklEHashMapUnrolled_RekeySequential)
+{
+    RunRekeyTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false, true>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapRekeyTest, PklEHashMapUnrolled_RekeySequentialBigValue)
+{
+    RunRekeyTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false, true>>(KeyGenerator::Sequential);
+}
+
+// ============================================================================
+// PHMAP SPINLOCK TESTS - Parallel Flat Hash Map with Spinlock (Standard R/W Lock)
+// ============================================================================
+
+TEST_F(HashmapInsertTest, PhmapSpinlock_InsertSequential)
+{
+    RunInsertTest<uint64_t, uint64_t, PhmapParallelFlatHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapInsertTest, PhmapSpinlock_InsertSequentialBigValue)
+{
+    RunInsertTest<uint64_t, TestValueStruct, PhmapParallelFlatHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapInsertTest, PhmapSpinlock_InsertRandom)
+{
+    RunInsertTest<uint64_t, uint64_t, PhmapParallelFlatHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapInsertTest, PhmapSpinlock_InsertRandomBigValue)
+{
+    RunInsertTest<uint64_t, TestValueStruct, PhmapParallelFlatHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapBatchInsertTest, PhmapSpinlock_BatchInsertSequential)
+{
+    RunBatchInsertTest<uint64_t, uint64_t, PhmapParallelFlatHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapBatchInsertTest, PhmapSpinlock_BatchInsertSequentialBigValue)
+{
+    RunBatchInsertTest<uint64_t, TestValueStruct, PhmapParallelFlatHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapBatchInsertTest, PhmapSpinlock_BatchInsertRandom)
+{
+    RunBatchInsertTest<uint64_t, uint64_t, PhmapParallelFlatHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapBatchInsertTest, PhmapSpinlock_BatchInsertRandomBigValue)
+{
+    RunBatchInsertTest<uint64_t, TestValueStruct, PhmapParallelFlatHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapLookupTest, PhmapSpinlock_LookupSequential)
+{
+    RunLookupTest<uint64_t, uint64_t, PhmapParallelFlatHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapLookupTest, PhmapSpinlock_LookupSequentialBigValue)
+{
+    RunLookupTest<uint64_t, TestValueStruct, PhmapParallelFlatHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapLookupTest, PhmapSpinlock_LookupRandom)
+{
+    RunLookupTest<uint64_t, uint64_t, PhmapParallelFlatHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapLookupTest, PhmapSpinlock_LookupRandomBigValue)
+{
+    RunLookupTest<uint64_t, TestValueStruct, PhmapParallelFlatHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapBatchedLookupTest, PhmapSpinlock_BatchedLookupSequential)
+{
+    RunBatchedLookupTest<uint64_t, uint64_t, PhmapParallelFlatHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapBatchedLookupTest, PhmapSpinlock_BatchedLookupSequentialBigValue)
+{
+    RunBatchedLookupTest<uint64_t, TestValueStruct, PhmapParallelFlatHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapBatchedLookupTest, PhmapSpinlock_BatchedLookupRandom)
+{
+    RunBatchedLookupTest<uint64_t, uint64_t, PhmapParallelFlatHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapBatchedLookupTest, PhmapSpinlock_BatchedLookupRandomBigValue)
+{
+    RunBatchedLookupTest<uint64_t, TestValueStruct, PhmapParallelFlatHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapEraseTest, PhmapSpinlock_EraseSequential)
+{
+    RunEraseTest<uint64_t, uint64_t, PhmapParallelFlatHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapEraseTest, PhmapSpinlock_EraseSequentialBigValue)
+{
+    RunEraseTest<uint64_t, TestValueStruct, PhmapParallelFlatHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapMixedTest, PhmapSpinlock_90r10w)
+{
+    RunMixedReadWriteTest<uint64_t, uint64_t, PhmapParallelFlatHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential, 90, 10);
+}
+
+TEST_F(HashmapMixedTest, PhmapSpinlock_90r10wBigValue)
+{
+    RunMixedReadWriteTest<uint64_t, TestValueStruct, PhmapParallelFlatHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential, 90, 10);
+}
+
+TEST_F(HashmapMixedTest, PhmapSpinlock_50r50w)
+{
+    RunMixedReadWriteTest<uint64_t, uint64_t, PhmapParallelFlatHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential, 50, 50);
+}
+
+TEST_F(HashmapMixedTest, PhmapSpinlock_50r50wBigValue)
+{
+    RunMixedReadWriteTest<uint64_t, TestValueStruct, PhmapParallelFlatHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential, 50, 50);
+}
+
+TEST_F(HashmapMixedTest, PhmapSpinlock_40i50l10e)
+{
+    RunMixedWithEraseTest<uint64_t, uint64_t, PhmapParallelFlatHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential, 40, 50, 10);
+}
+
+TEST_F(HashmapMixedTest, PhmapSpinlock_40i50l10eBigValue)
+{
+    RunMixedWithEraseTest<uint64_t, TestValueStruct, PhmapParallelFlatHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential, 40, 50, 10);
+}
+
+TEST_F(HashmapContendedTest, PhmapSpinlock_ContendedInsert)
+{
+    RunInsertTest<uint64_t, uint64_t, PhmapParallelFlatHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Contended, "contendedInsert");
+}
+
+TEST_F(HashmapContendedTest, PhmapSpinlock_ContendedInsertBigValue)
+{
+    RunInsertTest<uint64_t, TestValueStruct, PhmapParallelFlatHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Contended, "contendedInsert");
+}
+
+TEST_F(HashmapRekeyTest, PhmapSpinlock_RekeySequential)
+{
+    RunRekeyTest<uint64_t, uint64_t, PhmapParallelFlatHashMapSpinlock<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapRekeyTest, PhmapSpinlock_RekeySequentialBigValue)
+{
+    RunRekeyTest<uint64_t, TestValueStruct, PhmapParallelFlatHashMapSpinlock<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapIteratorTest, PhmapSpinlock_IteratorsSequential)
+{
+    RunIteratorTest<uint64_t, uint64_t, PhmapParallelFlatHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapIteratorTest, PhmapSpinlock_IteratorsSequentialBigValue)
+{
+    RunIteratorTest<uint64_t, TestValueStruct, PhmapParallelFlatHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapIteratorTest, PhmapSpinlock_IteratorsRandom)
+{
+    RunIteratorTest<uint64_t, uint64_t, PhmapParallelFlatHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapIteratorTest, PhmapSpinlock_IteratorsRandomBigValue)
+{
+    RunIteratorTest<uint64_t, TestValueStruct, PhmapParallelFlatHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Random);
+}
+
+
+#if PKLE_INCLUDE_ABSEIL_HASHMAP
 // ============================================================================
-// PKLE HASHMAP TESTS LOCKLESS - PklE::ThreadsafeContainers::HashMap without using internal locking
-// ============================================================================
-TEST_F(HashmapInsertTest, PklEHashMapLockless_InsertSequential)
+// ABSEIL TESTS - Flat Hash Map with External Locking
+// ============================================================================
+
+TEST_F(HashmapInsertTest, AbseilFlatHashMapLocked_InsertSequential)
 {
-    RunInsertTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, true>>(KeyGenerator::Sequential);
+    RunInsertTest<uint64_t, uint64_t, AbseilFlatHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapInsertTest, PklEHashMapLockless_InsertSequentialBigValue)
+TEST_F(HashmapInsertTest, AbseilFlatHashMapLocked_InsertSequentialBigValue)
 {
-    RunInsertTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, true>>(KeyGenerator::Sequential);
+    RunInsertTest<uint64_t, TestValueStruct, AbseilFlatHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapInsertTest, PklEHashMapLockless_InsertRandom)
+TEST_F(HashmapInsertTest, AbseilFlatHashMapLocked_InsertRandom)
 {
-    RunInsertTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, true>>(KeyGenerator::Random);
+    RunInsertTest<uint64_t, uint64_t, AbseilFlatHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapInsertTest, PklEHashMapLockless_InsertRandomBigValue)
+TEST_F(HashmapInsertTest, AbseilFlatHashMapLocked_InsertRandomBigValue)
 {
-    RunInsertTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, true>>(KeyGenerator::Random);
+    RunInsertTest<uint64_t, TestValueStruct, AbseilFlatHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapBatchInsertTest, PklEHashMapLockless_BatchInsertSequential)
+TEST_F(HashmapBatchInsertTest, AbseilFlatHashMapLocked_BatchInsertSequential)
 {
-    RunBatchInsertTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, true>>(KeyGenerator::Sequential);
+    RunBatchInsertTest<uint64_t, uint64_t, AbseilFlatHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapBatchInsertTest, PklEHashMapLockless_BatchInsertSequentialBigValue)
+TEST_F(HashmapBatchInsertTest, AbseilFlatHashMapLocked_BatchInsertSequentialBigValue)
 {
-    RunBatchInsertTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, true>>(KeyGenerator::Sequential);
+    RunBatchInsertTest<uint64_t, TestValueStruct, AbseilFlatHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapBatchInsertTest, PklEHashMapLockless_BatchInsertRandom)
+TEST_F(HashmapBatchInsertTest, AbseilFlatHashMapLocked_BatchInsertRandom)
 {
-    RunBatchInsertTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, true>>(KeyGenerator::Random);
+    RunBatchInsertTest<uint64_t, uint64_t, AbseilFlatHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapBatchInsertTest, PklEHashMapLockless_BatchInsertRandomBigValue)
+TEST_F(HashmapBatchInsertTest, AbseilFlatHashMapLocked_BatchInsertRandomBigValue)
 {
-    RunBatchInsertTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, true>>(KeyGenerator::Random);
+    RunBatchInsertTest<uint64_t, TestValueStruct, AbseilFlatHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapLookupTest, PklEHashMapLockless_LookupSequential)
+TEST_F(HashmapLookupTest, AbseilFlatHashMapLocked_LookupSequential)
 {
-    RunLookupTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, true>>(KeyGenerator::Sequential);
+    RunLookupTest<uint64_t, uint64_t, AbseilFlatHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapLookupTest, PklEHashMapLockless_LookupSequentialBigValue)
+TEST_F(HashmapLookupTest, AbseilFlatHashMapLocked_LookupSequentialBigValue)
 {
-    RunLookupTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, true>>(KeyGenerator::Sequential);
+    RunLookupTest<uint64_t, TestValueStruct, AbseilFlatHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapLookupTest, PklEHashMapLockless_LookupRandom)
+TEST_F(HashmapLookupTest, AbseilFlatHashMapLocked_LookupRandom)
 {
-    RunLookupTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, true>>(KeyGenerator::Random);
+    RunLookupTest<uint64_t, uint64_t, AbseilFlatHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapLookupTest, PklEHashMapLockless_LookupRandomBigValue)
+TEST_F(HashmapLookupTest, AbseilFlatHashMapLocked_LookupRandomBigValue)
 {
-    RunLookupTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, true>>(KeyGenerator::Random);
+    RunLookupTest<uint64_t, TestValueStruct, AbseilFlatHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapBatchedLookupTest, PklEHashMapLockless_BatchedLookupSequential)
+TEST_F(HashmapBatchedLookupTest, AbseilFlatHashMapLocked_BatchedLookupSequential)
 {
-    RunBatchedLookupTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, true>>(KeyGenerator::Sequential);
+    RunBatchedLookupTest<uint64_t, uint64_t, AbseilFlatHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapBatchedLookupTest, PklEHashMapLockless_BatchedLookupSequentialBigValue)
+TEST_F(HashmapBatchedLookupTest, AbseilFlatHashMapLocked_BatchedLookupSequentialBigValue)
 {
-    RunBatchedLookupTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, true>>(KeyGenerator::Sequential);
+    RunBatchedLookupTest<uint64_t, TestValueStruct, AbseilFlatHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapBatchedLookupTest, PklEHashMapLockless_BatchedLookupRandom)
+TEST_F(HashmapBatchedLookupTest, AbseilFlatHashMapLocked_BatchedLookupRandom)
 {
-    RunBatchedLookupTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, true>>(KeyGenerator::Random);
+    RunBatchedLookupTest<uint64_t, uint64_t, AbseilFlatHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapBatchedLookupTest, PklEHashMapLockless_BatchedLookupRandomBigValue)
+TEST_F(HashmapBatchedLookupTest, AbseilFlatHashMapLocked_BatchedLookupRandomBigValue)
 {
-    RunBatchedLookupTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, true>>(KeyGenerator::Random);
+    RunBatchedLookupTest<uint64_t, TestValueStruct, AbseilFlatHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapEraseTest, PklEHashMapLockless_EraseSequential)
+TEST_F(HashmapEraseTest, AbseilFlatHashMapLocked_EraseSequential)
 {
-    RunEraseTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, true>>(KeyGenerator::Sequential);
+    RunEraseTest<uint64_t, uint64_t, AbseilFlatHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapEraseTest, PklEHashMapLockless_EraseSequentialBigValue)
+TEST_F(HashmapEraseTest, AbseilFlatHashMapLocked_EraseSequentialBigValue)
 {
-    RunEraseTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, true>>(KeyGenerator::Sequential);
+    RunEraseTest<uint64_t, TestValueStruct, AbseilFlatHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapMixedTest, PklEHashMapLockless_90r10w)
+TEST_F(HashmapMixedTest, AbseilFlatHashMapLocked_90r10w)
 {
-    RunMixedReadWriteTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, true>>(KeyGenerator::Sequential, 90, 10);
+    RunMixedReadWriteTest<uint64_t, uint64_t, AbseilFlatHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential, 90, 10);
 }
 
-TEST_F(HashmapMixedTest, PklEHashMapLockless_90r10wBigValue)
+TEST_F(HashmapMixedTest, AbseilFlatHashMapLocked_90r10wBigValue)
 {
-    RunMixedReadWriteTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, true>>(KeyGenerator::Sequential, 90, 10);
+    RunMixedReadWriteTest<uint64_t, TestValueStruct, AbseilFlatHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential, 90, 10);
 }
 
-TEST_F(HashmapMixedTest, PklEHashMapLockless_50r50w)
+TEST_F(HashmapMixedTest, AbseilFlatHashMapLocked_50r50w)
 {
-    RunMixedReadWriteTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, true>>(KeyGenerator::Sequential, 50, 50);
+    RunMixedReadWriteTest<uint64_t, uint64_t, AbseilFlatHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential, 50, 50);
 }
 
-TEST_F(HashmapMixedTest, PklEHashMapLockless_50r50wBigValue)
+TEST_F(HashmapMixedTest, AbseilFlatHashMapLocked_50r50wBigValue)
 {
-    RunMixedReadWriteTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, true>>(KeyGenerator::Sequential, 50, 50);
+    RunMixedReadWriteTest<uint64_t, TestValueStruct, AbseilFlatHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential, 50, 50);
+}
+
+TEST_F(HashmapMixedTest, AbseilFlatHashMapLocked_40i50l10e)
+{
+    RunMixedWithEraseTest<uint64_t, uint64_t, AbseilFlatHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential, 40, 50, 10);
+}
+
+TEST_F(HashmapMixedTest, AbseilFlatHashMapLocked_40i50l10eBigValue)
+{
+    RunMixedWithEraseTest<uint64_t, TestValueStruct, AbseilFlatHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential, 40, 50, 10);
+}
+
+TEST_F(HashmapContendedTest, AbseilFlatHashMapLocked_ContendedInsert)
+{
+    RunInsertTest<uint64_t, uint64_t, AbseilFlatHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Contended, "contendedInsert");
+}
+
+TEST_F(HashmapContendedTest, AbseilFlatHashMapLocked_ContendedInsertBigValue)
+{
+    RunInsertTest<uint64_t, TestValueStruct, AbseilFlatHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Contended, "contendedInsert");
+}
+
+TEST_F(HashmapRekeyTest, AbseilFlatHashMapLocked_RekeySequential)
+{
+    RunRekeyTest<uint64_t, uint64_t, AbseilFlatHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapRekeyTest, AbseilFlatHashMapLocked_RekeySequentialBigValue)
+{
+    RunRekeyTest<uint64_t, TestValueStruct, AbseilFlatHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapIteratorTest, AbseilFlatHashMapLocked_IteratorsSequential)
+{
+    RunIteratorTest<uint64_t, uint64_t, AbseilFlatHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapIteratorTest, AbseilFlatHashMapLocked_IteratorsSequentialBigValue)
+{
+    RunIteratorTest<uint64_t, TestValueStruct, AbseilFlatHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapIteratorTest, AbseilFlatHashMapLocked_IteratorsRandom)
+{
+    RunIteratorTest<uint64_t, uint64_t, AbseilFlatHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapIteratorTest, AbseilFlatHashMapLocked_IteratorsRandomBigValue)
+{
+    RunIteratorTest<uint64_t, TestValueStruct, AbseilFlatHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
+}
+
+// ============================================================================
+// ABSEIL NODE HASH MAP TESTS - Node Hash Map with External Locking
+// ============================================================================
+
+TEST_F(HashmapInsertTest, AbseilNodeHashMapLocked_InsertSequential)
+{
+    RunInsertTest<uint64_t, uint64_t, AbseilNodeHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapInsertTest, AbseilNodeHashMapLocked_InsertSequentialBigValue)
+{
+    RunInsertTest<uint64_t, TestValueStruct, AbseilNodeHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapInsertTest, AbseilNodeHashMapLocked_InsertRandom)
+{
+    RunInsertTest<uint64_t, uint64_t, AbseilNodeHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapInsertTest, AbseilNodeHashMapLocked_InsertRandomBigValue)
+{
+    RunInsertTest<uint64_t, TestValueStruct, AbseilNodeHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
+}
+
+TEST_F(HashmapBatchInsertTest, AbseilNodeHashMapLocked_BatchInsertSequential)
+{
+    RunBatchInsertTest<uint64_t, uint64_t, AbseilNodeHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapBatchInsertTest, AbseilNodeHashMapLocked_BatchInsertSequentialBigValue)
+{
+    RunBatchInsertTest<uint64_t, TestValueStruct, AbseilNodeHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+}
+
+TEST_F(HashmapBatchInsertTest, AbseilNodeHashMapLocked_BatchInsertRandom)
+{
+    RunBatchInsertTest<uint64_t, uint64_t, AbseilNodeHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapMixedTest, PklEHashMapLockless_40i50l10e)
+TEST_F(HashmapBatchInsertTest, AbseilNodeHashMapLocked_BatchInsertRandomBigValue)
 {
-    RunMixedWithEraseTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, true>>(KeyGenerator::Sequential, 40, 50, 10);
+    RunBatchInsertTest<uint64_t, TestValueStruct, AbseilNodeHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapMixedTest, PklEHashMapLockless_40i50l10eBigValue)
+TEST_F(HashmapLookupTest, AbseilNodeHashMapLocked_LookupSequential)
 {
-    RunMixedWithEraseTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, true>>(KeyGenerator::Sequential, 40, 50, 10);
+    RunLookupTest<uint64_t, uint64_t, AbseilNodeHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapContendedTest, PklEHashMapLockless_ContendedInsert)
+TEST_F(HashmapLookupTest, AbseilNodeHashMapLocked_LookupSequentialBigValue)
 {
-    RunInsertTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, true>>(KeyGenerator::Contended, "contendedInsert");
+    RunLookupTest<uint64_t, TestValueStruct, AbseilNodeHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapContendedTest, PklEHashMapLockless_ContendedInsertBigValue)
+TEST_F(HashmapLookupTest, AbseilNodeHashMapLocked_LookupRandom)
 {
-    RunInsertTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, true>>(KeyGenerator::Contended, "contendedInsert");
+    RunLookupTest<uint64_t, uint64_t, AbseilNodeHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapRekeyTest, PklEHashMapLockless_RekeySequential)
+TEST_F(HashmapLookupTest, AbseilNodeHashMapLocked_LookupRandomBigValue)
 {
-    RunRekeyTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, true>>(KeyGenerator::Sequential);
+    RunLookupTest<uint64_t, TestValueStruct, AbseilNodeHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapRekeyTest, PklEHashMapLockless_RekeySequentialBigValue)
+TEST_F(HashmapBatchedLookupTest, AbseilNodeHashMapLocked_BatchedLookupSequential)
 {
-    RunRekeyTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, true>>(KeyGenerator::Sequential);
+    RunBatchedLookupTest<uint64_t, uint64_t, AbseilNodeHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapIteratorTest, PklEHashMapLockless_IteratorsSequential)
+TEST_F(HashmapBatchedLookupTest, AbseilNodeHashMapLocked_BatchedLookupSequentialBigValue)
 {
-    RunIteratorTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, true>>(KeyGenerator::Sequential);
+    RunBatchedLookupTest<uint64_t, TestValueStruct, AbseilNodeHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapIteratorTest, PklEHashMapLockless_IteratorsSequentialBigValue)
+TEST_F(HashmapBatchedLookupTest, AbseilNodeHashMapLocked_BatchedLookupRandom)
 {
-    RunIteratorTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, true>>(KeyGenerator::Sequential);
+    RunBatchedLookupTest<uint64_t, uint64_t, AbseilNodeHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapIteratorTest, PklEHashMapLockless_IteratorsRandom)
+TEST_F(HashmapBatchedLookupTest, AbseilNodeHashMapLocked_BatchedLookupRandomBigValue)
 {
-    RunIteratorTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, true>>(KeyGenerator::Random);
+    RunBatchedLookupTest<uint64_t, TestValueStruct, AbseilNodeHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapIteratorTest, PklEHashMapLockless_IteratorsRandomBigValue)
+TEST_F(HashmapEraseTest, AbseilNodeHashMapLocked_EraseSequential)
 {
-    RunIteratorTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, true>>(KeyGenerator::Random);
+    RunEraseTest<uint64_t, uint64_t, AbseilNodeHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
 }
 
-// ============================================================================
-// PKLE HASHMAP TESTS CONCURRENT - PklE::ThreadsafeContainers::HashMap using internal locking
-// ============================================================================
-TEST_F(HashmapInsertTest, PklEHashMap_InsertSequential)
+TEST_F(HashmapEraseTest, AbseilNodeHashMapLocked_EraseSequentialBigValue)
 {
-    RunInsertTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false>>(KeyGenerator::Sequential);
+    RunEraseTest<uint64_t, TestValueStruct, AbseilNodeHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapInsertTest, PklEHashMap_InsertSequentialBigValue)
+TEST_F(HashmapMixedTest, AbseilNodeHashMapLocked_90r10w)
 {
-    RunInsertTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false>>(KeyGenerator::Sequential);
+    RunMixedReadWriteTest<uint64_t, uint64_t, AbseilNodeHashMapLocked<uint64_t, uint64_t>>(
+        KeyGenerator::Sequential,
+        90,
+        10);
 }
 
-TEST_F(HashmapInsertTest, PklEHashMap_InsertRandom)
+TEST_F(HashmapMixedTest, AbseilNodeHashMapLocked_90r10wBigValue)
 {
-    RunInsertTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false>>(KeyGenerator::Random);
+    RunMixedReadWriteTest<uint64_t, TestValueStruct, AbseilNodeHashMapLocked<uint64_t, TestValueStruct>>(
+        KeyGenerator::Sequential,
+        90,
+        10);
 }
 
-TEST_F(HashmapInsertTest, PklEHashMap_InsertRandomBigValue)
+TEST_F(HashmapMixedTest, AbseilNodeHashMapLocked_50r50w)
 {
-    RunInsertTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false>>(KeyGenerator::Random);
+    RunMixedReadWriteTest<uint64_t, uint64_t, AbseilNodeHashMapLocked<uint64_t, uint64_t>>(
+        KeyGenerator::Sequential,
+        50,
+        50);
 }
 
-TEST_F(HashmapBatchInsertTest, PklEHashMap_BatchInsertSequential)
+TEST_F(HashmapMixedTest, AbseilNodeHashMapLocked_50r50wBigValue)
 {
-    RunBatchInsertTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false>>(KeyGenerator::Sequential);
+    RunMixedReadWriteTest<uint64_t, TestValueStruct, AbseilNodeHashMapLocked<uint64_t, TestValueStruct>>(
+        KeyGenerator::Sequential,
+        50,
+        50);
 }
 
-TEST_F(HashmapBatchInsertTest, PklEHashMap_BatchInsertSequentialBigValue)
+TEST_F(HashmapMixedTest, AbseilNodeHashMapLocked_40i50l10e)
 {
-    RunBatchInsertTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false>>(KeyGenerator::Sequential);
+    RunMixedWithEraseTest<uint64_t, uint64_t, AbseilNodeHashMapLocked<uint64_t, uint64_t>>(
+        KeyGenerator::Sequential,
+        40,
+        50,
+        10);
 }
 
-TEST_F(HashmapBatchInsertTest, PklEHashMap_BatchInsertRandom)
+TEST_F(HashmapMixedTest, AbseilNodeHashMapLocked_40i50l10eBigValue)
 {
-    RunBatchInsertTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false>>(KeyGenerator::Random);
+    RunMixedWithEraseTest<uint64_t, TestValueStruct, AbseilNodeHashMapLocked<uint64_t, TestValueStruct>>(
+        KeyGenerator::Sequential,
+        40,
+        50,
+        10);
 }
 
-TEST_F(HashmapBatchInsertTest, PklEHashMap_BatchInsertRandomBigValue)
+TEST_F(HashmapContendedTest, AbseilNodeHashMapLocked_ContendedInsert)
 {
-    RunBatchInsertTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false>>(KeyGenerator::Random);
+    RunInsertTest<uint64_t, uint64_t, AbseilNodeHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Contended, "contendedInsert");
 }
 
-TEST_F(HashmapLookupTest, PklEHashMap_LookupSequential)
+TEST_F(HashmapContendedTest, AbseilNodeHashMapLocked_ContendedInsertBigValue)
 {
-    RunLookupTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false>>(KeyGenerator::Sequential);
+    RunInsertTest<uint64_t, TestValueStruct, AbseilNodeHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Contended, "contendedInsert");
 }
 
-TEST_F(HashmapLookupTest, PklEHashMap_LookupSequentialBigValue)
+TEST_F(HashmapRekeyTest, AbseilNodeHashMapLocked_RekeySequential)
 {
-    RunLookupTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false>>(KeyGenerator::Sequential);
+    RunRekeyTest<uint64_t, uint64_t, AbseilNodeHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapLookupTest, PklEHashMap_LookupRandom)
+TEST_F(HashmapRekeyTest, AbseilNodeHashMapLocked_RekeySequentialBigValue)
 {
-    RunLookupTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false>>(KeyGenerator::Random);
+    RunRekeyTest<uint64_t, TestValueStruct, AbseilNodeHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapLookupTest, PklEHashMap_LookupRandomBigValue)
+TEST_F(HashmapIteratorTest, AbseilNodeHashMapLocked_IteratorsSequential)
 {
-    RunLookupTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false>>(KeyGenerator::Random);
+    RunIteratorTest<uint64_t, uint64_t, AbseilNodeHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapBatchedLookupTest, PklEHashMap_BatchedLookupSequential)
+TEST_F(HashmapIteratorTest, AbseilNodeHashMapLocked_IteratorsSequentialBigValue)
 {
-    RunBatchedLookupTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false>>(KeyGenerator::Sequential);
+    RunIteratorTest<uint64_t, TestValueStruct, AbseilNodeHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapBatchedLookupTest, PklEHashMap_BatchedLookupSequentialBigValue)
+TEST_F(HashmapIteratorTest, AbseilNodeHashMapLocked_IteratorsRandom)
 {
-    RunBatchedLookupTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false>>(KeyGenerator::Sequential);
+    RunIteratorTest<uint64_t, uint64_t, AbseilNodeHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapBatchedLookupTest, PklEHashMap_BatchedLookupRandom)
+TEST_F(HashmapIteratorTest, AbseilNodeHashMapLocked_IteratorsRandomBigValue)
 {
-    RunBatchedLookupTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false>>(KeyGenerator::Random);
+    RunIteratorTest<uint64_t, TestValueStruct, AbseilNodeHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapBatchedLookupTest, PklEHashMap_BatchedLookupRandomBigValue)
+// ============================================================================
+// ABSEIL NODE HASH MAP WITH PAGING ALLOCATOR TESTS
+// ============================================================================
+
+TEST_F(HashmapInsertTest, AbseilNodeHashMapPagingAllocator_InsertSequential)
 {
-    RunBatchedLookupTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false>>(KeyGenerator::Random);
+    RunInsertTest<uint64_t, uint64_t, AbseilNodeHashMapPagingAllocator<uint64_t, uint64_t>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapEraseTest, PklEHashMap_EraseSequential)
+TEST_F(HashmapInsertTest, AbseilNodeHashMapPagingAllocator_InsertSequentialBigValue)
 {
-    RunEraseTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false>>(KeyGenerator::Sequential);
+    RunInsertTest<uint64_t, TestValueStruct, AbseilNodeHashMapPagingAllocator<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapEraseTest, PklEHashMap_EraseSequentialBigValue)
+TEST_F(HashmapInsertTest, AbseilNodeHashMapPagingAllocator_InsertRandom)
 {
-    RunEraseTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false>>(KeyGenerator::Sequential);
+    RunInsertTest<uint64_t, uint64_t, AbseilNodeHashMapPagingAllocator<uint64_t, uint64_t>>(KeyGenerator::Random);
 }
 
-
-TEST_F(HashmapMixedTest, PklEHashMap_90r10w)
+TEST_F(HashmapInsertTest, AbseilNodeHashMapPagingAllocator_InsertRandomBigValue)
 {
-    RunMixedReadWriteTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false>>(KeyGenerator::Sequential, 90, 10);
+    RunInsertTest<uint64_t, TestValueStruct, AbseilNodeHashMapPagingAllocator<uint64_t, TestValueStruct>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapMixedTest, PklEHashMap_90r10wBigValue)
+TEST_F(HashmapBatchInsertTest, AbseilNodeHashMapPagingAllocator_BatchInsertSequential)
 {
-    RunMixedReadWriteTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false>>(KeyGenerator::Sequential, 90, 10);
+    RunBatchInsertTest<uint64_t, uint64_t, AbseilNodeHashMapPagingAllocator<uint64_t, uint64_t>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapMixedTest, PklEHashMap_50r50w)
+TEST_F(HashmapBatchInsertTest, AbseilNodeHashMapPagingAllocator_BatchInsertSequentialBigValue)
 {
-    RunMixedReadWriteTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false>>(KeyGenerator::Sequential, 50, 50);
+    RunBatchInsertTest<uint64_t, TestValueStruct, AbseilNodeHashMapPagingAllocator<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapMixedTest, PklEHashMap_50r50wBigValue)
+TEST_F(HashmapBatchInsertTest, AbseilNodeHashMapPagingAllocator_BatchInsertRandom)
 {
-    RunMixedReadWriteTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false>>(KeyGenerator::Sequential, 50, 50);
+    RunBatchInsertTest<uint64_t, uint64_t, AbseilNodeHashMapPagingAllocator<uint64_t, uint64_t>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapMixedTest, PklEHashMap_40i50l10e)
+TEST_F(HashmapBatchInsertTest, AbseilNodeHashMapPagingAllocator_BatchInsertRandomBigValue)
 {
-    RunMixedWithEraseTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false>>(KeyGenerator::Sequential, 40, 50, 10);
+    RunBatchInsertTest<uint64_t, TestValueStruct, AbseilNodeHashMapPagingAllocator<uint64_t, TestValueStruct>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapMixedTest, PklEHashMap_40i50l10eBigValue)
+TEST_F(HashmapLookupTest, AbseilNodeHashMapPagingAllocator_LookupSequential)
 {
-    RunMixedWithEraseTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false>>(KeyGenerator::Sequential, 40, 50, 10);
+    RunLookupTest<uint64_t, uint64_t, AbseilNodeHashMapPagingAllocator<uint64_t, uint64_t>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapContendedTest, PklEHashMap_ContendedInsert)
+TEST_F(HashmapLookupTest, AbseilNodeHashMapPagingAllocator_LookupSequentialBigValue)
 {
-    RunInsertTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false>>(KeyGenerator::Contended, "contendedInsert");
+    RunLookupTest<uint64_t, TestValueStruct, AbseilNodeHashMapPagingAllocator<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapContendedTest, PklEHashMap_ContendedInsertBigValue)
+TEST_F(HashmapLookupTest, AbseilNodeHashMapPagingAllocator_LookupRandom)
 {
-    RunInsertTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false>>(KeyGenerator::Contended, "contendedInsert");
+    RunLookupTest<uint64_t, uint64_t, AbseilNodeHashMapPagingAllocator<uint64_t, uint64_t>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapRekeyTest, PklEHashMap_RekeySequential)
+TEST_F(HashmapLookupTest, AbseilNodeHashMapPagingAllocator_LookupRandomBigValue)
 {
-    RunRekeyTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false>>(KeyGenerator::Sequential);
+    RunLookupTest<uint64_t, TestValueStruct, AbseilNodeHashMapPagingAllocator<uint64_t, TestValueStruct>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapRekeyTest, PklEHashMap_RekeySequentialBigValue)
+TEST_F(HashmapBatchedLookupTest, AbseilNodeHashMapPagingAllocator_BatchedLookupSequential)
 {
-    RunRekeyTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false>>(KeyGenerator::Sequential);
+    RunBatchedLookupTest<uint64_t, uint64_t, AbseilNodeHashMapPagingAllocator<uint64_t, uint64_t>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapIteratorTest, PklEHashMap_IteratorsSequential)
+TEST_F(HashmapBatchedLookupTest, AbseilNodeHashMapPagingAllocator_BatchedLookupSequentialBigValue)
 {
-    RunIteratorTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false>>(KeyGenerator::Sequential);
+    RunBatchedLookupTest<uint64_t, TestValueStruct, AbseilNodeHashMapPagingAllocator<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapIteratorTest, PklEHashMap_IteratorsSequentialBigValue)
+TEST_F(HashmapBatchedLookupTest, AbseilNodeHashMapPagingAllocator_BatchedLookupRandom)
 {
-    RunIteratorTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false>>(KeyGenerator::Sequential);
+    RunBatchedLookupTest<uint64_t, uint64_t, AbseilNodeHashMapPagingAllocator<uint64_t, uint64_t>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapIteratorTest, PklEHashMap_IteratorsRandom)
+TEST_F(HashmapBatchedLookupTest, AbseilNodeHashMapPagingAllocator_BatchedLookupRandomBigValue)
 {
-    RunIteratorTest<uint64_t, uint64_t, PklEHashMap<uint64_t, uint64_t, false>>(KeyGenerator::Random);
+    RunBatchedLookupTest<uint64_t, TestValueStruct, AbseilNodeHashMapPagingAllocator<uint64_t, TestValueStruct>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapIteratorTest, PklEHashMap_IteratorsRandomBigValue)
+TEST_F(HashmapEraseTest, AbseilNodeHashMapPagingAllocator_EraseSequential)
 {
-    RunIteratorTest<uint64_t, TestValueStruct, PklEHashMap<uint64_t, TestValueStruct, false>>(KeyGenerator::Random);
+    RunEraseTest<uint64_t, uint64_t, AbseilNodeHashMapPagingAllocator<uint64_t, uint64_t>>(KeyGenerator::Sequential);
 }
 
-// ============================================================================
-// PHMAP SPINLOCK TESTS - Parallel Flat Hash Map with Spinlock (Standard R/W Lock)
-// ============================================================================
-
-TEST_F(HashmapInsertTest, PhmapSpinlock_InsertSequential)
+TEST_F(HashmapEraseTest, AbseilNodeHashMapPagingAllocator_EraseSequentialBigValue)
 {
-    RunInsertTest<uint64_t, uint64_t, PhmapParallelFlatHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
+    RunEraseTest<uint64_t, TestValueStruct, AbseilNodeHashMapPagingAllocator<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapInsertTest, PhmapSpinlock_InsertSequentialBigValue)
+TEST_F(HashmapMixedTest, AbseilNodeHashMapPagingAllocator_90r10w)
 {
-    RunInsertTest<uint64_t, TestValueStruct, PhmapParallelFlatHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
+    RunMixedReadWriteTest<uint64_t, uint64_t, AbseilNodeHashMapPagingAllocator<uint64_t, uint64_t>>(
+        KeyGenerator::Sequential,
+        90,
+        10);
 }
 
-TEST_F(HashmapInsertTest, PhmapSpinlock_InsertRandom)
+TEST_F(HashmapMixedTest, AbseilNodeHashMapPagingAllocator_90r10wBigValue)
 {
-    RunInsertTest<uint64_t, uint64_t, PhmapParallelFlatHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Random);
+    RunMixedReadWriteTest<uint64_t, TestValueStruct, AbseilNodeHashMapPagingAllocator<uint64_t, TestValueStruct>>(
+        KeyGenerator::Sequential,
+        90,
+        10);
 }
 
-TEST_F(HashmapInsertTest, PhmapSpinlock_InsertRandomBigValue)
+TEST_F(HashmapMixedTest, AbseilNodeHashMapPagingAllocator_50r50w)
 {
-    RunInsertTest<uint64_t, TestValueStruct, PhmapParallelFlatHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Random);
+    RunMixedReadWriteTest<uint64_t, uint64_t, AbseilNodeHashMapPagingAllocator<uint64_t, uint64_t>>(
+        KeyGenerator::Sequential,
+        50,
+        50);
 }
 
-TEST_F(HashmapBatchInsertTest, PhmapSpinlock_BatchInsertSequential)
+TEST_F(HashmapMixedTest, AbseilNodeHashMapPagingAllocator_50r50wBigValue)
 {
-    RunBatchInsertTest<uint64_t, uint64_t, PhmapParallelFlatHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
+    RunMixedReadWriteTest<uint64_t, TestValueStruct, AbseilNodeHashMapPagingAllocator<uint64_t, TestValueStruct>>(
+        KeyGenerator::Sequential,
+        50,
+        50);
 }
 
-TEST_F(HashmapBatchInsertTest, PhmapSpinlock_BatchInsertSequentialBigValue)
+TEST_F(HashmapMixedTest, AbseilNodeHashMapPagingAllocator_40i50l10e)
 {
-    RunBatchInsertTest<uint64_t, TestValueStruct, PhmapParallelFlatHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
+    RunMixedWithEraseTest<uint64_t, uint64_t, AbseilNodeHashMapPagingAllocator<uint64_t, uint64_t>>(
+        KeyGenerator::Sequential,
+        40,
+        50,
+        10);
 }
 
-TEST_F(HashmapBatchInsertTest, PhmapSpinlock_BatchInsertRandom)
+TEST_F(HashmapMixedTest, AbseilNodeHashMapPagingAllocator_40i50l10eBigValue)
 {
-    RunBatchInsertTest<uint64_t, uint64_t, PhmapParallelFlatHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Random);
+    RunMixedWithEraseTest<uint64_t, TestValueStruct, AbseilNodeHashMapPagingAllocator<uint64_t, TestValueStruct>>(
+        KeyGenerator::Sequential,
+        40,
+        50,
+        10);
 }
 
-TEST_F(HashmapBatchInsertTest, PhmapSpinlock_BatchInsertRandomBigValue)
+TEST_F(HashmapContendedTest, AbseilNodeHashMapPagingAllocator_ContendedInsert)
 {
-    RunBatchInsertTest<uint64_t, TestValueStruct, PhmapParallelFlatHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Random);
+    RunInsertTest<uint64_t, uint64_t, AbseilNodeHashMapPagingAllocator<uint64_t, uint64_t>>(KeyGenerator::Contended, "contendedInsert");
 }
 
-TEST_F(HashmapLookupTest, PhmapSpinlock_LookupSequential)
+TEST_F(HashmapContendedTest, AbseilNodeHashMapPagingAllocator_ContendedInsertBigValue)
 {
-    RunLookupTest<uint64_t, uint64_t, PhmapParallelFlatHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
+    RunInsertTest<uint64_t, TestValueStruct, AbseilNodeHashMapPagingAllocator<uint64_t, TestValueStruct>>(KeyGenerator::Contended, "contendedInsert");
 }
 
-TEST_F(HashmapLookupTest, PhmapSpinlock_LookupSequentialBigValue)
+TEST_F(HashmapRekeyTest, AbseilNodeHashMapPagingAllocator_RekeySequential)
 {
-    RunLookupTest<uint64_t, TestValueStruct, PhmapParallelFlatHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
+    RunRekeyTest<uint64_t, uint64_t, AbseilNodeHashMapPagingAllocator<uint64_t, uint64_t>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapLookupTest, PhmapSpinlock_LookupRandom)
+TEST_F(HashmapRekeyTest, AbseilNodeHashMapPagingAllocator_RekeySequentialBigValue)
 {
-    RunLookupTest<uint64_t, uint64_t, PhmapParallelFlatHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Random);
+    RunRekeyTest<uint64_t, TestValueStruct, AbseilNodeHashMapPagingAllocator<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapLookupTest, PhmapSpinlock_LookupRandomBigValue)
+TEST_F(HashmapIteratorTest, AbseilNodeHashMapPagingAllocator_IteratorsSequential)
 {
-    RunLookupTest<uint64_t, TestValueStruct, PhmapParallelFlatHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Random);
+    RunIteratorTest<uint64_t, uint64_t, AbseilNodeHashMapPagingAllocator<uint64_t, uint64_t>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapBatchedLookupTest, PhmapSpinlock_BatchedLookupSequential)
+TEST_F(HashmapIteratorTest, AbseilNodeHashMapPagingAllocator_IteratorsSequentialBigValue)
 {
-    RunBatchedLookupTest<uint64_t, uint64_t, PhmapParallelFlatHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
+    RunIteratorTest<uint64_t, TestValueStruct, AbseilNodeHashMapPagingAllocator<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapBatchedLookupTest, PhmapSpinlock_BatchedLookupSequentialBigValue)
+TEST_F(HashmapIteratorTest, AbseilNodeHashMapPagingAllocator_IteratorsRandom)
 {
-    RunBatchedLookupTest<uint64_t, TestValueStruct, PhmapParallelFlatHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
+    RunIteratorTest<uint64_t, uint64_t, AbseilNodeHashMapPagingAllocator<uint64_t, uint64_t>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapBatchedLookupTest, PhmapSpinlock_BatchedLookupRandom)
+TEST_F(HashmapIteratorTest, AbseilNodeHashMapPagingAllocator_IteratorsRandomBigValue)
 {
-    RunBatchedLookupTest<uint64_t, uint64_t, PhmapParallelFlatHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Random);
+    RunIteratorTest<uint64_t, TestValueStruct, AbseilNodeHashMapPagingAllocator<uint64_t, TestValueStruct>>(KeyGenerator::Random);
 }
+#endif //PKLE_INCLUDE_ABSEIL_HASHMAP
 
-TEST_F(HashmapBatchedLookupTest, PhmapSpinlock_BatchedLookupRandomBigValue)
+#if PKLE_INCLUDE_PARLAY_HASHMAP
+// ============================================================================
+// PARLAY HASH TESTS - Parlay Unordered Map with External Locking
+// ============================================================================
+
+TEST_F(HashmapInsertTest, ParlayUnorderedMapLocked_InsertSequential)
 {
-    RunBatchedLookupTest<uint64_t, TestValueStruct, PhmapParallelFlatHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Random);
+    RunInsertTest<uint64_t, uint64_t, ParlayUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapEraseTest, PhmapSpinlock_EraseSequential)
+TEST_F(HashmapInsertTest, ParlayUnorderedMapLocked_InsertSequentialBigValue)
 {
-    RunEraseTest<uint64_t, uint64_t, PhmapParallelFlatHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
+    RunInsertTest<uint64_t, TestValueStruct, ParlayUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapEraseTest, PhmapSpinlock_EraseSequentialBigValue)
+TEST_F(HashmapInsertTest, ParlayUnorderedMapLocked_InsertRandom)
 {
-    RunEraseTest<uint64_t, TestValueStruct, PhmapParallelFlatHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
+    RunInsertTest<uint64_t, uint64_t, ParlayUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapMixedTest, PhmapSpinlock_90r10w)
+TEST_F(HashmapInsertTest, ParlayUnorderedMapLocked_InsertRandomBigValue)
 {
-    RunMixedReadWriteTest<uint64_t, uint64_t, PhmapParallelFlatHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential, 90, 10);
+    RunInsertTest<uint64_t, TestValueStruct, ParlayUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapMixedTest, PhmapSpinlock_90r10wBigValue)
+TEST_F(HashmapBatchInsertTest, ParlayUnorderedMapLocked_BatchInsertSequential)
 {
-    RunMixedReadWriteTest<uint64_t, TestValueStruct, PhmapParallelFlatHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential, 90, 10);
+    RunBatchInsertTest<uint64_t, uint64_t, ParlayUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapMixedTest, PhmapSpinlock_50r50w)
+TEST_F(HashmapBatchInsertTest, ParlayUnorderedMapLocked_BatchInsertSequentialBigValue)
 {
-    RunMixedReadWriteTest<uint64_t, uint64_t, PhmapParallelFlatHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential, 50, 50);
+    RunBatchInsertTest<uint64_t, TestValueStruct, ParlayUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapMixedTest, PhmapSpinlock_50r50wBigValue)
+TEST_F(HashmapBatchInsertTest, ParlayUnorderedMapLocked_BatchInsertRandom)
 {
-    RunMixedReadWriteTest<uint64_t, TestValueStruct, PhmapParallelFlatHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential, 50, 50);
+    RunBatchInsertTest<uint64_t, uint64_t, ParlayUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapMixedTest, PhmapSpinlock_40i50l10e)
+TEST_F(HashmapBatchInsertTest, ParlayUnorderedMapLocked_BatchInsertRandomBigValue)
 {
-    RunMixedWithEraseTest<uint64_t, uint64_t, PhmapParallelFlatHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential, 40, 50, 10);
+    RunBatchInsertTest<uint64_t, TestValueStruct, ParlayUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapMixedTest, PhmapSpinlock_40i50l10eBigValue)
+TEST_F(HashmapLookupTest, ParlayUnorderedMapLocked_LookupSequential)
 {
-    RunMixedWithEraseTest<uint64_t, TestValueStruct, PhmapParallelFlatHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential, 40, 50, 10);
+    RunLookupTest<uint64_t, uint64_t, ParlayUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapContendedTest, PhmapSpinlock_ContendedInsert)
+TEST_F(HashmapLookupTest, ParlayUnorderedMapLocked_LookupSequentialBigValue)
 {
-    RunInsertTest<uint64_t, uint64_t, PhmapParallelFlatHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Contended, "contendedInsert");
+    RunLookupTest<uint64_t, TestValueStruct, ParlayUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapContendedTest, PhmapSpinlock_ContendedInsertBigValue)
+TEST_F(HashmapLookupTest, ParlayUnorderedMapLocked_LookupRandom)
 {
-    RunInsertTest<uint64_t, TestValueStruct, PhmapParallelFlatHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Contended, "contendedInsert");
+    RunLookupTest<uint64_t, uint64_t, ParlayUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapRekeyTest, PhmapSpinlock_RekeySequential)
+TEST_F(HashmapLookupTest, ParlayUnorderedMapLocked_LookupRandomBigValue)
 {
-    RunRekeyTest<uint64_t, uint64_t, PhmapParallelFlatHashMapSpinlock<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+    RunLookupTest<uint64_t, TestValueStruct, ParlayUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapRekeyTest, PhmapSpinlock_RekeySequentialBigValue)
+TEST_F(HashmapBatchedLookupTest, ParlayUnorderedMapLocked_BatchedLookupSequential)
 {
-    RunRekeyTest<uint64_t, TestValueStruct, PhmapParallelFlatHashMapSpinlock<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+    RunBatchedLookupTest<uint64_t, uint64_t, ParlayUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapIteratorTest, PhmapSpinlock_IteratorsSequential)
+TEST_F(HashmapBatchedLookupTest, ParlayUnorderedMapLocked_BatchedLookupSequentialBigValue)
 {
-    RunIteratorTest<uint64_t, uint64_t, PhmapParallelFlatHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
+    RunBatchedLookupTest<uint64_t, TestValueStruct, ParlayUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapIteratorTest, PhmapSpinlock_IteratorsSequentialBigValue)
+TEST_F(HashmapBatchedLookupTest, ParlayUnorderedMapLocked_BatchedLookupRandom)
 {
-    RunIteratorTest<uint64_t, TestValueStruct, PhmapParallelFlatHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
+    RunBatchedLookupTest<uint64_t, uint64_t, ParlayUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapIteratorTest, PhmapSpinlock_IteratorsRandom)
+TEST_F(HashmapBatchedLookupTest, ParlayUnorderedMapLocked_BatchedLookupRandomBigValue)
 {
-    RunIteratorTest<uint64_t, uint64_t, PhmapParallelFlatHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Random);
+    RunBatchedLookupTest<uint64_t, TestValueStruct, ParlayUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapIteratorTest, PhmapSpinlock_IteratorsRandomBigValue)
+TEST_F(HashmapEraseTest, ParlayUnorderedMapLocked_EraseSequential)
 {
-    RunIteratorTest<uint64_t, TestValueStruct, PhmapParallelFlatHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Random);
+    RunEraseTest<uint64_t, uint64_t, ParlayUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
 }
 
-
-#if PKLE_INCLUDE_ABSEIL_HASHMAP
-// ============================================================================
-// ABSEIL TESTS - Flat Hash Map with External Locking
-// ============================================================================
-
-TEST_F(HashmapInsertTest, AbseilFlatHashMapLocked_InsertSequential)
+TEST_F(HashmapEraseTest, ParlayUnorderedMapLocked_EraseSequentialBigValue)
 {
-    RunInsertTest<uint64_t, uint64_t, AbseilFlatHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+    RunEraseTest<uint64_t, TestValueStruct, ParlayUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapInsertTest, AbseilFlatHashMapLocked_InsertSequentialBigValue)
+TEST_F(HashmapMixedTest, ParlayUnorderedMapLocked_90r10w)
 {
-    RunInsertTest<uint64_t, TestValueStruct, AbseilFlatHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+    RunMixedReadWriteTest<uint64_t, uint64_t, ParlayUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential, 90, 10);
 }
 
-TEST_F(HashmapInsertTest, AbseilFlatHashMapLocked_InsertRandom)
+TEST_F(HashmapMixedTest, ParlayUnorderedMapLocked_90r10wBigValue)
 {
-    RunInsertTest<uint64_t, uint64_t, AbseilFlatHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
+    RunMixedReadWriteTest<uint64_t, TestValueStruct, ParlayUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential, 90, 10);
 }
 
-TEST_F(HashmapInsertTest, AbseilFlatHashMapLocked_InsertRandomBigValue)
+TEST_F(HashmapMixedTest, ParlayUnorderedMapLocked_50r50w)
 {
-    RunInsertTest<uint64_t, TestValueStruct, AbseilFlatHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
+    RunMixedReadWriteTest<uint64_t, uint64_t, ParlayUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential, 50, 50);
 }
 
-TEST_F(HashmapBatchInsertTest, AbseilFlatHashMapLocked_BatchInsertSequential)
+TEST_F(HashmapMixedTest, ParlayUnorderedMapLocked_50r50wBigValue)
 {
-    RunBatchInsertTest<uint64_t, uint64_t, AbseilFlatHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+    RunMixedReadWriteTest<uint64_t, TestValueStruct, ParlayUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential, 50, 50);
 }
 
-TEST_F(HashmapBatchInsertTest, AbseilFlatHashMapLocked_BatchInsertSequentialBigValue)
+TEST_F(HashmapMixedTest, ParlayUnorderedMapLocked_40i50l10e)
 {
-    RunBatchInsertTest<uint64_t, TestValueStruct, AbseilFlatHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+    RunMixedWithEraseTest<uint64_t, uint64_t, ParlayUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential, 40, 50, 10);
 }
 
-TEST_F(HashmapBatchInsertTest, AbseilFlatHashMapLocked_BatchInsertRandom)
+TEST_F(HashmapMixedTest, ParlayUnorderedMapLocked_40i50l10eBigValue)
 {
-    RunBatchInsertTest<uint64_t, uint64_t, AbseilFlatHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
+    RunMixedWithEraseTest<uint64_t, TestValueStruct, ParlayUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential, 40, 50, 10);
 }
 
-TEST_F(HashmapBatchInsertTest, AbseilFlatHashMapLocked_BatchInsertRandomBigValue)
+TEST_F(HashmapContendedTest, ParlayUnorderedMapLocked_ContendedInsert)
 {
-    RunBatchInsertTest<uint64_t, TestValueStruct, AbseilFlatHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
+    RunInsertTest<uint64_t, uint64_t, ParlayUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Contended, "contendedInsert");
 }
 
-TEST_F(HashmapLookupTest, AbseilFlatHashMapLocked_LookupSequential)
+TEST_F(HashmapContendedTest, ParlayUnorderedMapLocked_ContendedInsertBigValue)
 {
-    RunLookupTest<uint64_t, uint64_t, AbseilFlatHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+    RunInsertTest<uint64_t, TestValueStruct, ParlayUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Contended, "contendedInsert");
 }
 
-TEST_F(HashmapLookupTest, AbseilFlatHashMapLocked_LookupSequentialBigValue)
+TEST_F(HashmapRekeyTest, ParlayUnorderedMapLocked_RekeySequential)
 {
-    RunLookupTest<uint64_t, TestValueStruct, AbseilFlatHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+    RunRekeyTest<uint64_t, uint64_t, ParlayUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapLookupTest, AbseilFlatHashMapLocked_LookupRandom)
+TEST_F(HashmapRekeyTest, ParlayUnorderedMapLocked_RekeySequentialBigValue)
 {
-    RunLookupTest<uint64_t, uint64_t, AbseilFlatHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
+    RunRekeyTest<uint64_t, TestValueStruct, ParlayUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapLookupTest, AbseilFlatHashMapLocked_LookupRandomBigValue)
+TEST_F(HashmapIteratorTest, ParlayUnorderedMapLocked_IteratorsSequential)
 {
-    RunLookupTest<uint64_t, TestValueStruct, AbseilFlatHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
+    RunIteratorTest<uint64_t, uint64_t, ParlayUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapBatchedLookupTest, AbseilFlatHashMapLocked_BatchedLookupSequential)
+TEST_F(HashmapIteratorTest, ParlayUnorderedMapLocked_IteratorsSequentialBigValue)
 {
-    RunBatchedLookupTest<uint64_t, uint64_t, AbseilFlatHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+    RunIteratorTest<uint64_t, TestValueStruct, ParlayUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapBatchedLookupTest, AbseilFlatHashMapLocked_BatchedLookupSequentialBigValue)
+TEST_F(HashmapIteratorTest, ParlayUnorderedMapLocked_IteratorsRandom)
 {
-    RunBatchedLookupTest<uint64_t, TestValueStruct, AbseilFlatHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+    RunIteratorTest<uint64_t, uint64_t, ParlayUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapBatchedLookupTest, AbseilFlatHashMapLocked_BatchedLookupRandom)
+TEST_F(HashmapIteratorTest, ParlayUnorderedMapLocked_IteratorsRandomBigValue)
 {
-    RunBatchedLookupTest<uint64_t, uint64_t, AbseilFlatHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
+    RunIteratorTest<uint64_t, TestValueStruct, ParlayUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
 }
+#endif //PKLE_INCLUDE_PARLAY_HASHMAP
 
-TEST_F(HashmapBatchedLookupTest, AbseilFlatHashMapLocked_BatchedLookupRandomBigValue)
+// ============================================================================
+// PHMAP NODE HASH MAP SPINLOCK TESTS
+// ============================================================================
+
+TEST_F(HashmapInsertTest, PhmapNodeHashMapSpinlock_InsertSequential)
 {
-    RunBatchedLookupTest<uint64_t, TestValueStruct, AbseilFlatHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
+    RunInsertTest<uint64_t, uint64_t, PhmapParallelNodeHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapEraseTest, AbseilFlatHashMapLocked_EraseSequential)
+TEST_F(HashmapInsertTest, PhmapNodeHashMapSpinlock_InsertSequentialBigValue)
 {
-    RunEraseTest<uint64_t, uint64_t, AbseilFlatHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+    RunInsertTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapEraseTest, AbseilFlatHashMapLocked_EraseSequentialBigValue)
+TEST_F(HashmapInsertTest, PhmapNodeHashMapSpinlock_InsertRandom)
 {
-    RunEraseTest<uint64_t, TestValueStruct, AbseilFlatHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+    RunInsertTest<uint64_t, uint64_t, PhmapParallelNodeHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapMixedTest, AbseilFlatHashMapLocked_90r10w)
+TEST_F(HashmapInsertTest, PhmapNodeHashMapSpinlock_InsertRandomBigValue)
 {
-    RunMixedReadWriteTest<uint64_t, uint64_t, AbseilFlatHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential, 90, 10);
+    RunInsertTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapMixedTest, AbseilFlatHashMapLocked_90r10wBigValue)
+TEST_F(HashmapBatchInsertTest, PhmapNodeHashMapSpinlock_BatchInsertSequential)
 {
-    RunMixedReadWriteTest<uint64_t, TestValueStruct, AbseilFlatHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential, 90, 10);
+    RunBatchInsertTest<uint64_t, uint64_t, PhmapParallelNodeHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapMixedTest, AbseilFlatHashMapLocked_50r50w)
+TEST_F(HashmapBatchInsertTest, PhmapNodeHashMapSpinlock_BatchInsertSequentialBigValue)
 {
-    RunMixedReadWriteTest<uint64_t, uint64_t, AbseilFlatHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential, 50, 50);
+    RunBatchInsertTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapMixedTest, AbseilFlatHashMapLocked_50r50wBigValue)
+TEST_F(HashmapBatchInsertTest, PhmapNodeHashMapSpinlock_BatchInsertRandom)
 {
-    RunMixedReadWriteTest<uint64_t, TestValueStruct, AbseilFlatHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential, 50, 50);
+    RunBatchInsertTest<uint64_t, uint64_t, PhmapParallelNodeHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapMixedTest, AbseilFlatHashMapLocked_40i50l10e)
+TEST_F(HashmapBatchInsertTest, PhmapNodeHashMapSpinlock_BatchInsertRandomBigValue)
 {
-    RunMixedWithEraseTest<uint64_t, uint64_t, AbseilFlatHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential, 40, 50, 10);
+    RunBatchInsertTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapMixedTest, AbseilFlatHashMapLocked_40i50l10eBigValue)
+TEST_F(HashmapLookupTest, PhmapNodeHashMapSpinlock_LookupSequential)
 {
-    RunMixedWithEraseTest<uint64_t, TestValueStruct, AbseilFlatHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential, 40, 50, 10);
+    RunLookupTest<uint64_t, uint64_t, PhmapParallelNodeHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapContendedTest, AbseilFlatHashMapLocked_ContendedInsert)
+TEST_F(HashmapLookupTest, PhmapNodeHashMapSpinlock_LookupSequentialBigValue)
 {
-    RunInsertTest<uint64_t, uint64_t, AbseilFlatHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Contended, "contendedInsert");
+    RunLookupTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapContendedTest, AbseilFlatHashMapLocked_ContendedInsertBigValue)
+TEST_F(HashmapLookupTest, PhmapNodeHashMapSpinlock_LookupRandom)
 {
-    RunInsertTest<uint64_t, TestValueStruct, AbseilFlatHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Contended, "contendedInsert");
+    RunLookupTest<uint64_t, uint64_t, PhmapParallelNodeHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapRekeyTest, AbseilFlatHashMapLocked_RekeySequential)
+TEST_F(HashmapLookupTest, PhmapNodeHashMapSpinlock_LookupRandomBigValue)
 {
-    RunRekeyTest<uint64_t, uint64_t, AbseilFlatHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+    RunLookupTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapRekeyTest, AbseilFlatHashMapLocked_RekeySequentialBigValue)
+TEST_F(HashmapBatchedLookupTest, PhmapNodeHashMapSpinlock_BatchedLookupSequential)
 {
-    RunRekeyTest<uint64_t, TestValueStruct, AbseilFlatHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+    RunBatchedLookupTest<uint64_t, uint64_t, PhmapParallelNodeHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapIteratorTest, AbseilFlatHashMapLocked_IteratorsSequential)
+TEST_F(HashmapBatchedLookupTest, PhmapNodeHashMapSpinlock_BatchedLookupSequentialBigValue)
 {
-    RunIteratorTest<uint64_t, uint64_t, AbseilFlatHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+    RunBatchedLookupTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapIteratorTest, AbseilFlatHashMapLocked_IteratorsSequentialBigValue)
+TEST_F(HashmapBatchedLookupTest, PhmapNodeHashMapSpinlock_BatchedLookupRandom)
 {
-    RunIteratorTest<uint64_t, TestValueStruct, AbseilFlatHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+    RunBatchedLookupTest<uint64_t, uint64_t, PhmapParallelNodeHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapIteratorTest, AbseilFlatHashMapLocked_IteratorsRandom)
+TEST_F(HashmapBatchedLookupTest, PhmapNodeHashMapSpinlock_BatchedLookupRandomBigValue)
 {
-    RunIteratorTest<uint64_t, uint64_t, AbseilFlatHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
+    RunBatchedLookupTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapIteratorTest, AbseilFlatHashMapLocked_IteratorsRandomBigValue)
+TEST_F(HashmapEraseTest, PhmapNodeHashMapSpinlock_EraseSequential)
 {
-    RunIteratorTest<uint64_t, TestValueStruct, AbseilFlatHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
+    RunEraseTest<uint64_t, uint64_t, PhmapParallelNodeHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
 }
 
-// ============================================================================
-// ABSEIL NODE HASH MAP TESTS - Node Hash Map with External Locking
-// ============================================================================
-
-TEST_F(HashmapInsertTest, AbseilNodeHashMapLocked_InsertSequential)
+TEST_F(HashmapEraseTest, PhmapNodeHashMapSpinlock_EraseSequentialBigValue)
 {
-    RunInsertTest<uint64_t, uint64_t, AbseilNodeHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+    RunEraseTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapInsertTest, AbseilNodeHashMapLocked_InsertSequentialBigValue)
+TEST_F(HashmapMixedTest, PhmapNodeHashMapSpinlock_90r10w)
 {
-    RunInsertTest<uint64_t, TestValueStruct, AbseilNodeHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+    RunMixedReadWriteTest<uint64_t, uint64_t, PhmapParallelNodeHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential, 90, 10);
 }
 
-TEST_F(HashmapInsertTest, AbseilNodeHashMapLocked_InsertRandom)
+TEST_F(HashmapMixedTest, PhmapNodeHashMapSpinlock_90r10wBigValue)
 {
-    RunInsertTest<uint64_t, uint64_t, AbseilNodeHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
+    RunMixedReadWriteTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential, 90, 10);
 }
 
-TEST_F(HashmapInsertTest, AbseilNodeHashMapLocked_InsertRandomBigValue)
+TEST_F(HashmapMixedTest, PhmapNodeHashMapSpinlock_50r50w)
 {
-    RunInsertTest<uint64_t, TestValueStruct, AbseilNodeHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
+    RunMixedReadWriteTest<uint64_t, uint64_t, PhmapParallelNodeHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential, 50, 50);
 }
 
-TEST_F(HashmapBatchInsertTest, AbseilNodeHashMapLocked_BatchInsertSequential)
+TEST_F(HashmapMixedTest, PhmapNodeHashMapSpinlock_50r50wBigValue)
 {
-    RunBatchInsertTest<uint64_t, uint64_t, AbseilNodeHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+    RunMixedReadWriteTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential, 50, 50);
 }
 
-TEST_F(HashmapBatchInsertTest, AbseilNodeHashMapLocked_BatchInsertSequentialBigValue)
+TEST_F(HashmapMixedTest, PhmapNodeHashMapSpinlock_40i50l10e)
 {
-    RunBatchInsertTest<uint64_t, TestValueStruct, AbseilNodeHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+    RunMixedWithEraseTest<uint64_t, uint64_t, PhmapParallelNodeHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential, 40, 50, 10);
 }
 
-TEST_F(HashmapBatchInsertTest, AbseilNodeHashMapLocked_BatchInsertRandom)
+TEST_F(HashmapMixedTest, PhmapNodeHashMapSpinlock_40i50l10eBigValue)
 {
-    RunBatchInsertTest<uint64_t, uint64_t, AbseilNodeHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
+    RunMixedWithEraseTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential, 40, 50, 10);
 }
 
-TEST_F(HashmapBatchInsertTest, AbseilNodeHashMapLocked_BatchInsertRandomBigValue)
+TEST_F(HashmapContendedTest, PhmapNodeHashMapSpinlock_ContendedInsert)
 {
-    RunBatchInsertTest<uint64_t, TestValueStruct, AbseilNodeHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
+    RunInsertTest<uint64_t, uint64_t, PhmapParallelNodeHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Contended, "contendedInsert");
 }
 
-TEST_F(HashmapLookupTest, AbseilNodeHashMapLocked_LookupSequential)
+TEST_F(HashmapContendedTest, PhmapNodeHashMapSpinlock_ContendedInsertBigValue)
 {
-    RunLookupTest<uint64_t, uint64_t, AbseilNodeHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+    RunInsertTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Contended, "contendedInsert");
 }
 
-TEST_F(HashmapLookupTest, AbseilNodeHashMapLocked_LookupSequentialBigValue)
+TEST_F(HashmapRekeyTest, PhmapNodeHashMapSpinlock_RekeySequential)
 {
-    RunLookupTest<uint64_t, TestValueStruct, AbseilNodeHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+    RunRekeyTest<uint64_t, uint64_t, PhmapParallelNodeHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapLookupTest, AbseilNodeHashMapLocked_LookupRandom)
+TEST_F(HashmapRekeyTest, PhmapNodeHashMapSpinlock_RekeySequentialBigValue)
 {
-    RunLookupTest<uint64_t, uint64_t, AbseilNodeHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
+    RunRekeyTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapLookupTest, AbseilNodeHashMapLocked_LookupRandomBigValue)
+TEST_F(HashmapIteratorTest, PhmapNodeHashMapSpinlock_IteratorsSequential)
 {
-    RunLookupTest<uint64_t, TestValueStruct, AbseilNodeHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
+    RunIteratorTest<uint64_t, uint64_t, PhmapParallelNodeHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapBatchedLookupTest, AbseilNodeHashMapLocked_BatchedLookupSequential)
+TEST_F(HashmapIteratorTest, PhmapNodeHashMapSpinlock_IteratorsSequentialBigValue)
 {
-    RunBatchedLookupTest<uint64_t, uint64_t, AbseilNodeHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+    RunIteratorTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapBatchedLookupTest, AbseilNodeHashMapLocked_BatchedLookupSequentialBigValue)
+TEST_F(HashmapIteratorTest, PhmapNodeHashMapSpinlock_IteratorsRandom)
 {
-    RunBatchedLookupTest<uint64_t, TestValueStruct, AbseilNodeHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+    RunIteratorTest<uint64_t, uint64_t, PhmapParallelNodeHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapBatchedLookupTest, AbseilNodeHashMapLocked_BatchedLookupRandom)
+TEST_F(HashmapIteratorTest, PhmapNodeHashMapSpinlock_IteratorsRandomBigValue)
 {
-    RunBatchedLookupTest<uint64_t, uint64_t, AbseilNodeHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
+    RunIteratorTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapBatchedLookupTest, AbseilNodeHashMapLocked_BatchedLookupRandomBigValue)
+
+// ============================================================================
+// PHMAP NODE HASH MAP WITH PAGING ALLOCATOR TESTS
+// ============================================================================
+
+TEST_F(HashmapInsertTest, PhmapNodeHashMapPagingAllocator_InsertSequential)
 {
-    RunBatchedLookupTest<uint64_t, TestValueStruct, AbseilNodeHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
+    RunInsertTest<uint64_t, uint64_t, PhmapParallelNodeHashMapPagingAllocator<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapEraseTest, AbseilNodeHashMapLocked_EraseSequential)
+TEST_F(HashmapInsertTest, PhmapNodeHashMapPagingAllocator_InsertSequentialBigValue)
 {
-    RunEraseTest<uint64_t, uint64_t, AbseilNodeHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+    RunInsertTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapPagingAllocator<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapEraseTest, AbseilNodeHashMapLocked_EraseSequentialBigValue)
+TEST_F(HashmapInsertTest, PhmapNodeHashMapPagingAllocator_InsertRandom)
 {
-    RunEraseTest<uint64_t, TestValueStruct, AbseilNodeHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+    RunInsertTest<uint64_t, uint64_t, PhmapParallelNodeHashMapPagingAllocator<uint64_t, uint64_t, 4>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapMixedTest, AbseilNodeHashMapLocked_90r10w)
+TEST_F(HashmapInsertTest, PhmapNodeHashMapPagingAllocator_InsertRandomBigValue)
 {
-    RunMixedReadWriteTest<uint64_t, uint64_t, AbseilNodeHashMapLocked<uint64_t, uint64_t>>(
-        KeyGenerator::Sequential,
-        90,
-        10);
+    RunInsertTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapPagingAllocator<uint64_t, TestValueStruct, 4>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapMixedTest, AbseilNodeHashMapLocked_90r10wBigValue)
+TEST_F(HashmapBatchInsertTest, PhmapNodeHashMapPagingAllocator_BatchInsertSequential)
 {
-    RunMixedReadWriteTest<uint64_t, TestValueStruct, AbseilNodeHashMapLocked<uint64_t, TestValueStruct>>(
-        KeyGenerator::Sequential,
-        90,
-        10);
+    RunBatchInsertTest<uint64_t, uint64_t, PhmapParallelNodeHashMapPagingAllocator<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapMixedTest, AbseilNodeHashMapLocked_50r50w)
+TEST_F(HashmapBatchInsertTest, PhmapNodeHashMapPagingAllocator_BatchInsertSequentialBigValue)
 {
-    RunMixedReadWriteTest<uint64_t, uint64_t, AbseilNodeHashMapLocked<uint64_t, uint64_t>>(
-        KeyGenerator::Sequential,
-        50,
-        50);
+    RunBatchInsertTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapPagingAllocator<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapMixedTest, AbseilNodeHashMapLocked_50r50wBigValue)
+TEST_F(HashmapBatchInsertTest, PhmapNodeHashMapPagingAllocator_BatchInsertRandom)
 {
-    RunMixedReadWriteTest<uint64_t, TestValueStruct, AbseilNodeHashMapLocked<uint64_t, TestValueStruct>>(
-        KeyGenerator::Sequential,
-        50,
-        50);
+    RunBatchInsertTest<uint64_t, uint64_t, PhmapParallelNodeHashMapPagingAllocator<uint64_t, uint64_t, 4>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapMixedTest, AbseilNodeHashMapLocked_40i50l10e)
+TEST_F(HashmapBatchInsertTest, PhmapNodeHashMapPagingAllocator_BatchInsertRandomBigValue)
 {
-    RunMixedWithEraseTest<uint64_t, uint64_t, AbseilNodeHashMapLocked<uint64_t, uint64_t>>(
-        KeyGenerator::Sequential,
-        40,
-        50,
-        10);
+    RunBatchInsertTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapPagingAllocator<uint64_t, TestValueStruct, 4>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapMixedTest, AbseilNodeHashMapLocked_40i50l10eBigValue)
+TEST_F(HashmapLookupTest, PhmapNodeHashMapPagingAllocator_LookupSequential)
 {
-    RunMixedWithEraseTest<uint64_t, TestValueStruct, AbseilNodeHashMapLocked<uint64_t, TestValueStruct>>(
-        KeyGenerator::Sequential,
-        40,
-        50,
-        10);
+    RunLookupTest<uint64_t, uint64_t, PhmapParallelNodeHashMapPagingAllocator<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapContendedTest, AbseilNodeHashMapLocked_ContendedInsert)
+TEST_F(HashmapLookupTest, PhmapNodeHashMapPagingAllocator_LookupSequentialBigValue)
 {
-    RunInsertTest<uint64_t, uint64_t, AbseilNodeHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Contended, "contendedInsert");
+    RunLookupTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapPagingAllocator<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapContendedTest, AbseilNodeHashMapLocked_ContendedInsertBigValue)
+TEST_F(HashmapLookupTest, PhmapNodeHashMapPagingAllocator_LookupRandom)
 {
-    RunInsertTest<uint64_t, TestValueStruct, AbseilNodeHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Contended, "contendedInsert");
+    RunLookupTest<uint64_t, uint64_t, PhmapParallelNodeHashMapPagingAllocator<uint64_t, uint64_t, 4>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapRekeyTest, AbseilNodeHashMapLocked_RekeySequential)
+TEST_F(HashmapLookupTest, PhmapNodeHashMapPagingAllocator_LookupRandomBigValue)
 {
-    RunRekeyTest<uint64_t, uint64_t, AbseilNodeHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+    RunLookupTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapPagingAllocator<uint64_t, TestValueStruct, 4>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapRekeyTest, AbseilNodeHashMapLocked_RekeySequentialBigValue)
+TEST_F(HashmapBatchedLookupTest, PhmapNodeHashMapPagingAllocator_BatchedLookupSequential)
 {
-    RunRekeyTest<uint64_t, TestValueStruct, AbseilNodeHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+    RunBatchedLookupTest<uint64_t, uint64_t, PhmapParallelNodeHashMapPagingAllocator<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapIteratorTest, AbseilNodeHashMapLocked_IteratorsSequential)
+TEST_F(HashmapBatchedLookupTest, PhmapNodeHashMapPagingAllocator_BatchedLookupSequentialBigValue)
 {
-    RunIteratorTest<uint64_t, uint64_t, AbseilNodeHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+    RunBatchedLookupTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapPagingAllocator<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapIteratorTest, AbseilNodeHashMapLocked_IteratorsSequentialBigValue)
+TEST_F(HashmapBatchedLookupTest, PhmapNodeHashMapPagingAllocator_BatchedLookupRandom)
 {
-    RunIteratorTest<uint64_t, TestValueStruct, AbseilNodeHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+    RunBatchedLookupTest<uint64_t, uint64_t, PhmapParallelNodeHashMapPagingAllocator<uint64_t, uint64_t, 4>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapIteratorTest, AbseilNodeHashMapLocked_IteratorsRandom)
+TEST_F(HashmapBatchedLookupTest, PhmapNodeHashMapPagingAllocator_BatchedLookupRandomBigValue)
 {
-    RunIteratorTest<uint64_t, uint64_t, AbseilNodeHashMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
+    RunBatchedLookupTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapPagingAllocator<uint64_t, TestValueStruct, 4>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapIteratorTest, AbseilNodeHashMapLocked_IteratorsRandomBigValue)
+TEST_F(HashmapEraseTest, PhmapNodeHashMapPagingAllocator_EraseSequential)
 {
-    RunIteratorTest<uint64_t, TestValueStruct, AbseilNodeHashMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
+    RunEraseTest<uint64_t, uint64_t, PhmapParallelNodeHashMapPagingAllocator<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
 }
 
-// ============================================================================
-// ABSEIL NODE HASH MAP WITH PAGING ALLOCATOR TESTS
-// ============================================================================
-
-TEST_F(HashmapInsertTest, AbseilNodeHashMapPagingAllocator_InsertSequential)
+TEST_F(HashmapEraseTest, PhmapNodeHashMapPagingAllocator_EraseSequentialBigValue)
 {
-    RunInsertTest<uint64_t, uint64_t, AbseilNodeHashMapPagingAllocator<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+    RunEraseTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapPagingAllocator<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapInsertTest, AbseilNodeHashMapPagingAllocator_InsertSequentialBigValue)
+TEST_F(HashmapMixedTest, PhmapNodeHashMapPagingAllocator_90r10w)
 {
-    RunInsertTest<uint64_t, TestValueStruct, AbseilNodeHashMapPagingAllocator<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+    RunMixedReadWriteTest<uint64_t, uint64_t, PhmapParallelNodeHashMapPagingAllocator<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential, 90, 10);
 }
 
-TEST_F(HashmapInsertTest, AbseilNodeHashMapPagingAllocator_InsertRandom)
+TEST_F(HashmapMixedTest, PhmapNodeHashMapPagingAllocator_90r10wBigValue)
 {
-    RunInsertTest<uint64_t, uint64_t, AbseilNodeHashMapPagingAllocator<uint64_t, uint64_t>>(KeyGenerator::Random);
+    RunMixedReadWriteTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapPagingAllocator<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential, 90, 10);
 }
 
-TEST_F(HashmapInsertTest, AbseilNodeHashMapPagingAllocator_InsertRandomBigValue)
+TEST_F(HashmapMixedTest, PhmapNodeHashMapPagingAllocator_50r50w)
 {
-    RunInsertTest<uint64_t, TestValueStruct, AbseilNodeHashMapPagingAllocator<uint64_t, TestValueStruct>>(KeyGenerator::Random);
+    RunMixedReadWriteTest<uint64_t, uint64_t, PhmapParallelNodeHashMapPagingAllocator<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential, 50, 50);
 }
 
-TEST_F(HashmapBatchInsertTest, AbseilNodeHashMapPagingAllocator_BatchInsertSequential)
+TEST_F(HashmapMixedTest, PhmapNodeHashMapPagingAllocator_50r50wBigValue)
 {
-    RunBatchInsertTest<uint64_t, uint64_t, AbseilNodeHashMapPagingAllocator<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+    RunMixedReadWriteTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapPagingAllocator<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential, 50, 50);
 }
 
-TEST_F(HashmapBatchInsertTest, AbseilNodeHashMapPagingAllocator_BatchInsertSequentialBigValue)
+TEST_F(HashmapMixedTest, PhmapNodeHashMapPagingAllocator_40i50l10e)
 {
-    RunBatchInsertTest<uint64_t, TestValueStruct, AbseilNodeHashMapPagingAllocator<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+    RunMixedWithEraseTest<uint64_t, uint64_t, PhmapParallelNodeHashMapPagingAllocator<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential, 40, 50, 10);
 }
 
-TEST_F(HashmapBatchInsertTest, AbseilNodeHashMapPagingAllocator_BatchInsertRandom)
+TEST_F(HashmapMixedTest, PhmapNodeHashMapPagingAllocator_40i50l10eBigValue)
 {
-    RunBatchInsertTest<uint64_t, uint64_t, AbseilNodeHashMapPagingAllocator<uint64_t, uint64_t>>(KeyGenerator::Random);
+    RunMixedWithEraseTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapPagingAllocator<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential, 40, 50, 10);
 }
 
-TEST_F(HashmapBatchInsertTest, AbseilNodeHashMapPagingAllocator_BatchInsertRandomBigValue)
+TEST_F(HashmapContendedTest, PhmapNodeHashMapPagingAllocator_ContendedInsert)
 {
-    RunBatchInsertTest<uint64_t, TestValueStruct, AbseilNodeHashMapPagingAllocator<uint64_t, TestValueStruct>>(KeyGenerator::Random);
+    RunInsertTest<uint64_t, uint64_t, PhmapParallelNodeHashMapPagingAllocator<uint64_t, uint64_t, 4>>(KeyGenerator::Contended, "contendedInsert");
 }
 
-TEST_F(HashmapLookupTest, AbseilNodeHashMapPagingAllocator_LookupSequential)
+TEST_F(HashmapContendedTest, PhmapNodeHashMapPagingAllocator_ContendedInsertBigValue)
 {
-    RunLookupTest<uint64_t, uint64_t, AbseilNodeHashMapPagingAllocator<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+    RunInsertTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapPagingAllocator<uint64_t, TestValueStruct, 4>>(KeyGenerator::Contended, "contendedInsert");
 }
 
-TEST_F(HashmapLookupTest, AbseilNodeHashMapPagingAllocator_LookupSequentialBigValue)
+TEST_F(HashmapRekeyTest, PhmapNodeHashMapPagingAllocator_RekeySequential)
 {
-    RunLookupTest<uint64_t, TestValueStruct, AbseilNodeHashMapPagingAllocator<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+    RunRekeyTest<uint64_t, uint64_t, PhmapParallelNodeHashMapPagingAllocator<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapLookupTest, AbseilNodeHashMapPagingAllocator_LookupRandom)
+TEST_F(HashmapRekeyTest, PhmapNodeHashMapPagingAllocator_RekeySequentialBigValue)
 {
-    RunLookupTest<uint64_t, uint64_t, AbseilNodeHashMapPagingAllocator<uint64_t, uint64_t>>(KeyGenerator::Random);
+    RunRekeyTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapPagingAllocator<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapLookupTest, AbseilNodeHashMapPagingAllocator_LookupRandomBigValue)
+TEST_F(HashmapIteratorTest, PhmapNodeHashMapPagingAllocator_IteratorsSequential)
 {
-    RunLookupTest<uint64_t, TestValueStruct, AbseilNodeHashMapPagingAllocator<uint64_t, TestValueStruct>>(KeyGenerator::Random);
+    RunIteratorTest<uint64_t, uint64_t, PhmapParallelNodeHashMapPagingAllocator<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapBatchedLookupTest, AbseilNodeHashMapPagingAllocator_BatchedLookupSequential)
+TEST_F(HashmapIteratorTest, PhmapNodeHashMapPagingAllocator_IteratorsSequentialBigValue)
 {
-    RunBatchedLookupTest<uint64_t, uint64_t, AbseilNodeHashMapPagingAllocator<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+    RunIteratorTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapPagingAllocator<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
 }
 
-TEST_F(HashmapBatchedLookupTest, AbseilNodeHashMapPagingAllocator_BatchedLookupSequentialBigValue)
+TEST_F(HashmapIteratorTest, PhmapNodeHashMapPagingAllocator_IteratorsRandom)
 {
-    RunBatchedLookupTest<uint64_t, TestValueStruct, AbseilNodeHashMapPagingAllocator<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+    RunIteratorTest<uint64_t, uint64_t, PhmapParallelNodeHashMapPagingAllocator<uint64_t, uint64_t, 4>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapBatchedLookupTest, AbseilNodeHashMapPagingAllocator_BatchedLookupRandom)
+TEST_F(HashmapIteratorTest, PhmapNodeHashMapPagingAllocator_IteratorsRandomBigValue)
 {
-    RunBatchedLookupTest<uint64_t, uint64_t, AbseilNodeHashMapPagingAllocator<uint64_t, uint64_t>>(KeyGenerator::Random);
+    RunIteratorTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapPagingAllocator<uint64_t, TestValueStruct, 4>>(KeyGenerator::Random);
 }
 
-TEST_F(HashmapBatchedLookupTest, AbseilNodeHashMapPagingAllocator_BatchedLookupRandomBigValue)
+// ============================================================================
+// STRING KEY TESTS - PklEHashMap with std::string keys vs ArenaStringKey (arena stored bytes, prefix compare)
+// ============================================================================
+TEST_F(HashmapStringKeyTest, PklEHashMap_LookupStringKey16B)
 {
-    RunBatchedLookupTest<uint64_t, TestValueStruct, AbseilNodeHashMapPagingAllocator<uint64_t, TestValueStruct>>(KeyGenerator::Random);
+    RunStringKeyTest<std::string, PklEHashMap<std::string, uint64_t>>(16, 0, 100, 0);
 }
 
-TEST_F(HashmapEraseTest, AbseilNodeHashMapPagingAllocator_EraseSequential)
+TEST_F(HashmapStringKeyTest, PklEHashMap_40i50l10eStringKey16B)
 {
-    RunEraseTest<uint64_t, uint64_t, AbseilNodeHashMapPagingAllocator<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+    RunStringKeyTest<std::string, PklEHashMap<std::string, uint64_t>>(16, 40, 50, 10);
 }
 
-TEST_F(HashmapEraseTest, AbseilNodeHashMapPagingAllocator_EraseSequentialBigValue)
+TEST_F(HashmapStringKeyTest, PklEHashMap_LookupStringKey64B)
 {
-    RunEraseTest<uint64_t, TestValueStruct, AbseilNodeHashMapPagingAllocator<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+    RunStringKeyTest<std::string, PklEHashMap<std::string, uint64_t>>(64, 0, 100, 0);
 }
 
-TEST_F(HashmapMixedTest, AbseilNodeHashMapPagingAllocator_90r10w)
+TEST_F(HashmapStringKeyTest, PklEHashMap_40i50l10eStringKey64B)
 {
-    RunMixedReadWriteTest<uint64_t, uint64_t, AbseilNodeHashMapPagingAllocator<uint64_t, uint64_t>>(
-        KeyGenerator::Sequential,
-        90,
-        10);
+    RunStringKeyTest<std::string, PklEHashMap<std::string, uint64_t>>(64, 40, 50, 10);
 }
 
-TEST_F(HashmapMixedTest, AbseilNodeHashMapPagingAllocator_90r10wBigValue)
+TEST_F(HashmapStringKeyTest, PklEHashMap_LookupStringKey256B)
 {
-    RunMixedReadWriteTest<uint64_t, TestValueStruct, AbseilNodeHashMapPagingAllocator<uint64_t, TestValueStruct>>(
-        KeyGenerator::Sequential,
-        90,
-        10);
+    RunStringKeyTest<std::string, PklEHashMap<std::string, uint64_t>>(256, 0, 100, 0);
 }
 
-TEST_F(HashmapMixedTest, AbseilNodeHashMapPagingAllocator_50r50w)
+TEST_F(HashmapStringKeyTest, PklEHashMap_40i50l10eStringKey256B)
 {
-    RunMixedReadWriteTest<uint64_t, uint64_t, AbseilNodeHashMapPagingAllocator<uint64_t, uint64_t>>(
-        KeyGenerator::Sequential,
-        50,
-        50);
+    RunStringKeyTest<std::string, PklEHashMap<std::string, uint64_t>>(256, 40, 50, 10);
 }
 
-TEST_F(HashmapMixedTest, AbseilNodeHashMapPagingAllocator_50r50wBigValue)
+TEST_F(HashmapStringKeyTest, PklEHashMapArena_LookupStringKey16B)
 {
-    RunMixedReadWriteTest<uint64_t, TestValueStruct, AbseilNodeHashMapPagingAllocator<uint64_t, TestValueStruct>>(
-        KeyGenerator::Sequential,
-        50,
-        50);
+    RunStringKeyTest<PklE::ThreadsafeContainers::ArenaStringKey, PklEHashMap<PklE::ThreadsafeContainers::ArenaStringKey, uint64_t>>(16, 0, 100, 0);
 }
 
-TEST_F(HashmapMixedTest, AbseilNodeHashMapPagingAllocator_40i50l10e)
+TEST_F(HashmapStringKeyTest, PklEHashMapArena_40i50l10eStringKey16B)
 {
-    RunMixedWithEraseTest<uint64_t, uint64_t, AbseilNodeHashMapPagingAllocator<uint64_t, uint64_t>>(
-        KeyGenerator::Sequential,
-        40,
-        50,
-        10);
+    RunStringKeyTest<PklE::ThreadsafeContainers::ArenaStringKey, PklEHashMap<PklE::ThreadsafeContainers::ArenaStringKey, uint64_t>>(16, 40, 50, 10);
 }
 
-TEST_F(HashmapMixedTest, AbseilNodeHashMapPagingAllocator_40i50l10eBigValue)
+TEST_F(HashmapStringKeyTest, PklEHashMapArena_LookupStringKey64B)
 {
-    RunMixedWithEraseTest<uint64_t, TestValueStruct, AbseilNodeHashMapPagingAllocator<uint64_t, TestValueStruct>>(
-        KeyGenerator::Sequential,
-        40,
-        50,
-        10);
+    RunStringKeyTest<PklE::ThreadsafeContainers::ArenaStringKey, PklEHashMap<PklE::ThreadsafeContainers::ArenaStringKey, uint64_t>>(64, 0, 100, 0);
 }
 
-TEST_F(HashmapContendedTest, AbseilNodeHashMapPagingAllocator_ContendedInsert)
+TEST_F(HashmapStringKeyTest, PklEHashMapArena_40i50l10eStringKey64B)
 {
-    RunInsertTest<uint64_t, uint64_t, AbseilNodeHashMapPagingAllocator<uint64_t, uint64_t>>(KeyGenerator::Contended, "contendedInsert");
+    RunStringKeyTest<PklE::ThreadsafeContainers::ArenaStringKey, PklEHashMap<PklE::ThreadsafeContainers::ArenaStringKey, uint64_t>>(64, 40, 50, 10);
 }
 
-TEST_F(HashmapContendedTest, AbseilNodeHashMapPagingAllocator_ContendedInsertBigValue)
+TEST_F(HashmapStringKeyTest, PklEHashMapArena_LookupStringKey256B)
 {
-    RunInsertTest<uint64_t, TestValueStruct, AbseilNodeHashMapPagingAllocator<uint64_t, TestValueStruct>>(KeyGenerator::Contended, "contendedInsert");
+    RunStringKeyTest<PklE::ThreadsafeContainers::ArenaStringKey, PklEHashMap<PklE::ThreadsafeContainers::ArenaStringKey, uint64_t>>(256, 0, 100, 0);
 }
 
-TEST_F(HashmapRekeyTest, AbseilNodeHashMapPagingAllocator_RekeySequential)
+TEST_F(HashmapStringKeyTest, PklEHashMapArena_40i50l10eStringKey256B)
 {
-    RunRekeyTest<uint64_t, uint64_t, AbseilNodeHashMapPagingAllocator<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+    RunStringKeyTest<PklE::ThreadsafeContainers::ArenaStringKey, PklEHashMap<PklE::ThreadsafeContainers::ArenaStringKey, uint64_t>>(256, 40, 50, 10);
 }
 
-TEST_F(HashmapRekeyTest, AbseilNodeHashMapPagingAllocator_RekeySequentialBigValue)
+// ============================================================================
+// CHANGE FEED TESTS - Writer overhead of the HashMap change feed with 0, 1 and 4 polling subscribers
+// ============================================================================
+TEST_F(HashmapChangeFeedTest, PklEHashMap_40i50l10eChangeFeedOff)
 {
-    RunRekeyTest<uint64_t, TestValueStruct, AbseilNodeHashMapPagingAllocator<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+    RunChangeFeedTest<PklEHashMap<uint64_t, uint64_t, false>>(false, 0);
 }
 
-TEST_F(HashmapIteratorTest, AbseilNodeHashMapPagingAllocator_IteratorsSequential)
+TEST_F(HashmapChangeFeedTest, PklEHashMap_40i50l10eChangeFeed0Subscribers)
 {
-    RunIteratorTest<uint64_t, uint64_t, AbseilNodeHashMapPagingAllocator<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+    RunChangeFeedTest<PklEHashMap<uint64_t, uint64_t, false>>(true, 0);
 }
 
-TEST_F(HashmapIteratorTest, AbseilNodeHashMapPagingAllocator_IteratorsSequentialBigValue)
+TEST_F(HashmapChangeFeedTest, PklEHashMap_40i50l10eChangeFeed1Subscriber)
 {
-    RunIteratorTest<uint64_t, TestValueStruct, AbseilNodeHashMapPagingAllocator<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+    RunChangeFeedTest<PklEHashMap<uint64_t, uint64_t, false>>(true, 1);
 }
 
-TEST_F(HashmapIteratorTest, AbseilNodeHashMapPagingAllocator_IteratorsRandom)
+TEST_F(HashmapChangeFeedTest, PklEHashMap_40i50l10eChangeFeed4Subscribers)
 {
-    RunIteratorTest<uint64_t, uint64_t, AbseilNodeHashMapPagingAllocator<uint64_t, uint64_t>>(KeyGenerator::Random);
+    RunChangeFeedTest<PklEHashMap<uint64_t, uint64_t, false>>(true, 4);
 }
 
-TEST_F(HashmapIteratorTest, AbseilNodeHashMapPagingAllocator_IteratorsRandomBigValue)
+TEST_F(HashmapChangeFeedTest, PklEHashMap_ChangeFeedRecords)
 {
-    RunIteratorTest<uint64_t, TestValueStruct, AbseilNodeHashMapPagingAllocator<uint64_t, TestValueStruct>>(KeyGenerator::Random);
+    RunChangeFeedRecordTest<PklEHashMap<uint64_t, uint64_t, false>>();
 }
-#endif //PKLE_INCLUDE_ABSEIL_HASHMAP
 
-#if PKLE_INCLUDE_PARLAY_HASHMAP
 // ============================================================================
-// PARLAY HASH TESTS - Parlay Unordered Map with External Locking
+// HOT KEY SKETCH TESTS - Lookup overhead of the sampling hot key profiler at 1/16 to 1/4096
 // ============================================================================
+TEST_F(HashmapHotKeySketchTest, PklEHashMap_HotKeySketch_Off)
+{
+    RunHotKeySketchTest<PklEHashMap<uint64_t, uint64_t, false>>(0);
+}
 
-TEST_F(HashmapInsertTest, ParlayUnorderedMapLocked_InsertSequential)
+TEST_F(HashmapHotKeySketchTest, PklEHashMap_HotKeySketch_1in16)
 {
-    RunInsertTest<uint64_t, uint64_t, ParlayUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+    RunHotKeySketchTest<PklEHashMap<uint64_t, uint64_t, false>>(16);
 }
 
-TEST_F(HashmapInsertTest, ParlayUnorderedMapLocked_InsertSequentialBigValue)
+TEST_F(HashmapHotKeySketchTest, PklEHashMap_HotKeySketch_1in64)
 {
-    RunInsertTest<uint64_t, TestValueStruct, ParlayUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+    RunHotKeySketchTest<PklEHashMap<uint64_t, uint64_t, false>>(64);
 }
 
-TEST_F(HashmapInsertTest, ParlayUnorderedMapLocked_InsertRandom)
+TEST_F(HashmapHotKeySketchTest, PklEHashMap_HotKeySketch_1in256)
 {
-    RunInsertTest<uint64_t, uint64_t, ParlayUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
+    RunHotKeySketchTest<PklEHashMap<uint64_t, uint64_t, false>>(256);
 }
 
-TEST_F(HashmapInsertTest, ParlayUnorderedMapLocked_InsertRandomBigValue)
+TEST_F(HashmapHotKeySketchTest, PklEHashMap_HotKeySketch_1in1024)
 {
-    RunInsertTest<uint64_t, TestValueStruct, ParlayUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
+    RunHotKeySketchTest<PklEHashMap<uint64_t, uint64_t, false>>(1024);
 }
 
-TEST_F(HashmapBatchInsertTest, ParlayUnorderedMapLocked_BatchInsertSequential)
+TEST_F(HashmapHotKeySketchTest, PklEHashMap_HotKeySketch_1in4096)
 {
-    RunBatchInsertTest<uint64_t, uint64_t, ParlayUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+    RunHotKeySketchTest<PklEHashMap<uint64_t, uint64_t, false>>(4096);
 }
 
-TEST_F(HashmapBatchInsertTest, ParlayUnorderedMapLocked_BatchInsertSequentialBigValue)
+TEST_F(HashmapHotKeySketchTest, PklEHashMap_HotKeySketch_StringKeys)
 {
-    RunBatchInsertTest<uint64_t, TestValueStruct, ParlayUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+    RunHotKeySketchStringKeyTest<PklEHashMap<InlineStringKey, uint64_t, false>>();
 }
 
-TEST_F(HashmapBatchInsertTest, ParlayUnorderedMapLocked_BatchInsertRandom)
+// ============================================================================
+// TIERED STORAGE TESTS - Values in nodes vs TieredHashMap with cold values spilled to a memory mapped file
+// ============================================================================
+TEST_F(HashmapTieredStorageTest, PklEHashMap_InNodeValues_90Hot10Cold)
 {
-    RunBatchInsertTest<uint64_t, uint64_t, ParlayUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
+    RunTieredStorageTest(TieredStorageMode::InNodeValues);
 }
 
-TEST_F(HashmapBatchInsertTest, ParlayUnorderedMapLocked_BatchInsertRandomBigValue)
+TEST_F(HashmapTieredStorageTest, TieredHashMap_TieringOff_90Hot10Cold)
 {
-    RunBatchInsertTest<uint64_t, TestValueStruct, ParlayUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
+    RunTieredStorageTest(TieredStorageMode::TieringOff);
 }
 
-TEST_F(HashmapLookupTest, ParlayUnorderedMapLocked_LookupSequential)
+TEST_F(HashmapTieredStorageTest, TieredHashMap_TieringOn_90Hot10Cold)
 {
-    RunLookupTest<uint64_t, uint64_t, ParlayUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+    RunTieredStorageTest(TieredStorageMode::TieringOn);
 }
 
-TEST_F(HashmapLookupTest, ParlayUnorderedMapLocked_LookupSequentialBigValue)
+// ============================================================================
+// CHECKPOINT TESTS - Incremental (dirty page) vs full checkpoints at 1%, 10% and 50% churn per interval
+// ============================================================================
+TEST_F(HashmapCheckpointTest, PklEHashMap_Checkpoint_1PctChurn)
 {
-    RunLookupTest<uint64_t, TestValueStruct, ParlayUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+    RunCheckpointTest(1);
 }
 
-TEST_F(HashmapLookupTest, ParlayUnorderedMapLocked_LookupRandom)
+TEST_F(HashmapCheckpointTest, PklEHashMap_Checkpoint_10PctChurn)
 {
-    RunLookupTest<uint64_t, uint64_t, ParlayUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
+    RunCheckpointTest(10);
 }
 
-TEST_F(HashmapLookupTest, ParlayUnorderedMapLocked_LookupRandomBigValue)
+TEST_F(HashmapCheckpointTest, PklEHashMap_Checkpoint_50PctChurn)
 {
-    RunLookupTest<uint64_t, TestValueStruct, ParlayUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
+    RunCheckpointTest(50);
 }
 
-TEST_F(HashmapBatchedLookupTest, ParlayUnorderedMapLocked_BatchedLookupSequential)
+// ============================================================================
+// HASH JOIN TESTS - 1M build rows joined with 10M probe rows, partitioned HashJoin vs per-row map calls
+// ============================================================================
+TEST_F(HashmapHashJoinTest, HashJoin_1PctSelectivity)
 {
-    RunBatchedLookupTest<uint64_t, uint64_t, ParlayUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+    RunHashJoinTest(1);
 }
 
-TEST_F(HashmapBatchedLookupTest, ParlayUnorderedMapLocked_BatchedLookupSequentialBigValue)
+TEST_F(HashmapHashJoinTest, HashJoin_10PctSelectivity)
 {
-    RunBatchedLookupTest<uint64_t, TestValueStruct, ParlayUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+    RunHashJoinTest(10);
 }
 
-TEST_F(HashmapBatchedLookupTest, ParlayUnorderedMapLocked_BatchedLookupRandom)
+TEST_F(HashmapHashJoinTest, HashJoin_50PctSelectivity)
 {
-    RunBatchedLookupTest<uint64_t, uint64_t, ParlayUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
+    RunHashJoinTest(50);
 }
 
-TEST_F(HashmapBatchedLookupTest, ParlayUnorderedMapLocked_BatchedLookupRandomBigValue)
+TEST_F(HashmapHashJoinTest, HashJoin_100PctSelectivity)
 {
-    RunBatchedLookupTest<uint64_t, TestValueStruct, ParlayUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
+    RunHashJoinTest(100);
 }
 
-TEST_F(HashmapEraseTest, ParlayUnorderedMapLocked_EraseSequential)
+// ============================================================================
+// PUBLISHED HASHMAP TESTS - Reader throughput while the whole map is replaced every 100ms
+// ============================================================================
+TEST_F(HashmapPublishedMapTest, PklEHashMap_ReferenceData_NoSwaps)
 {
-    RunEraseTest<uint64_t, uint64_t, ParlayUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+    RunPublishedHashMapTest(PublishMode::NoSwaps);
 }
 
-TEST_F(HashmapEraseTest, ParlayUnorderedMapLocked_EraseSequentialBigValue)
+TEST_F(HashmapPublishedMapTest, PklEHashMap_ReferenceData_PublishedSwaps)
 {
-    RunEraseTest<uint64_t, TestValueStruct, ParlayUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+    RunPublishedHashMapTest(PublishMode::PublishedSwaps);
 }
 
-TEST_F(HashmapMixedTest, ParlayUnorderedMapLocked_90r10w)
+TEST_F(HashmapPublishedMapTest, PklEHashMap_ReferenceData_GlobalLockSwaps)
 {
-    RunMixedReadWriteTest<uint64_t, uint64_t, ParlayUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential, 90, 10);
+    RunPublishedHashMapTest(PublishMode::GlobalLockSwaps);
 }
 
-TEST_F(HashmapMixedTest, ParlayUnorderedMapLocked_90r10wBigValue)
+// ============================================================================
+// OBJECT POOL TESTS - PagingObjectPool reserve/release under contention (128-bit tagged free list head)
+// ============================================================================
+TEST_F(HashmapObjectPoolTest, PagingObjectPool_ReserveRelease_64Threads)
 {
-    RunMixedReadWriteTest<uint64_t, TestValueStruct, ParlayUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential, 90, 10);
+    RunObjectPoolContentionTest(64, false);
 }
 
-TEST_F(HashmapMixedTest, ParlayUnorderedMapLocked_50r50w)
+TEST_F(HashmapObjectPoolTest, PagingObjectPool_ReserveRelease_16Threads)
 {
-    RunMixedReadWriteTest<uint64_t, uint64_t, ParlayUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential, 50, 50);
+    RunObjectPoolContentionTest(16, false);
 }
 
-TEST_F(HashmapMixedTest, ParlayUnorderedMapLocked_50r50wBigValue)
+TEST_F(HashmapObjectPoolTest, PagingObjectPool_ReserveRelease_1Thread)
 {
-    RunMixedReadWriteTest<uint64_t, TestValueStruct, ParlayUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential, 50, 50);
+    RunObjectPoolContentionTest(1, false);
 }
 
-TEST_F(HashmapMixedTest, ParlayUnorderedMapLocked_40i50l10e)
+TEST_F(HashmapObjectPoolTest, UtilMalloc_ReserveRelease_64Threads)
 {
-    RunMixedWithEraseTest<uint64_t, uint64_t, ParlayUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential, 40, 50, 10);
+    RunObjectPoolContentionTest(64, true);
 }
 
-TEST_F(HashmapMixedTest, ParlayUnorderedMapLocked_40i50l10eBigValue)
+// ============================================================================
+// WRITE SCALING TESTS - Striped vs single atomic element counters
+// Build with -DPKLE_EXACT_CONTAINER_COUNTS=1 to run the map test with single atomic counts
+// ============================================================================
+TEST_F(HashmapWriteScalingTest, StripedCounter_1Stripe)
 {
-    RunMixedWithEraseTest<uint64_t, TestValueStruct, ParlayUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential, 40, 50, 10);
+    RunStripedCounterTest<1>(1);
+    RunStripedCounterTest<1>(4);
+    RunStripedCounterTest<1>(16);
 }
 
-TEST_F(HashmapContendedTest, ParlayUnorderedMapLocked_ContendedInsert)
+TEST_F(HashmapWriteScalingTest, StripedCounter_16Stripes)
 {
-    RunInsertTest<uint64_t, uint64_t, ParlayUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Contended, "contendedInsert");
+    RunStripedCounterTest<16>(1);
+    RunStripedCounterTest<16>(4);
+    RunStripedCounterTest<16>(16);
 }
 
-TEST_F(HashmapContendedTest, ParlayUnorderedMapLocked_ContendedInsertBigValue)
+TEST_F(HashmapWriteScalingTest, PklEHashMap_WriteScaling64Shards)
 {
-    RunInsertTest<uint64_t, TestValueStruct, ParlayUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Contended, "contendedInsert");
+    RunWriteScalingTest(1);
+    RunWriteScalingTest(4);
+    RunWriteScalingTest(16);
 }
 
-TEST_F(HashmapRekeyTest, ParlayUnorderedMapLocked_RekeySequential)
+// ============================================================================
+// FIXED CAPACITY TESTS - Insert tail latency, allocation-free fixed capacity vs growable
+// ============================================================================
+TEST_F(HashmapFixedCapacityTest, PklEHashMap_InsertLatency_Growable)
 {
-    RunRekeyTest<uint64_t, uint64_t, ParlayUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+    RunFixedCapacityLatencyTest(false);
 }
 
-TEST_F(HashmapRekeyTest, ParlayUnorderedMapLocked_RekeySequentialBigValue)
+TEST_F(HashmapFixedCapacityTest, PklEHashMap_InsertLatency_FixedCapacity)
 {
-    RunRekeyTest<uint64_t, TestValueStruct, ParlayUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+    RunFixedCapacityLatencyTest(true);
 }
 
-TEST_F(HashmapIteratorTest, ParlayUnorderedMapLocked_IteratorsSequential)
+// ============================================================================
+// CLEAR TESTS - Logical clear, refill and teardown time versus map size
+// ============================================================================
+TEST_F(HashmapClearTest, PklEHashMap_Clear_SmallValue)
 {
-    RunIteratorTest<uint64_t, uint64_t, ParlayUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Sequential);
+    auto makeValue = [](uint64_t key) { return key * 2; };
+    RunClearTest<uint64_t>("smallValue", 1000000, makeValue);
+    RunClearTest<uint64_t>("smallValue", 4000000, makeValue);
+    RunClearTest<uint64_t>("smallValue", 16000000, makeValue);
 }
 
-TEST_F(HashmapIteratorTest, ParlayUnorderedMapLocked_IteratorsSequentialBigValue)
+TEST_F(HashmapClearTest, PklEHashMap_Clear_StringValue)
 {
-    RunIteratorTest<uint64_t, TestValueStruct, ParlayUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Sequential);
+    //Heap allocated strings, so destroying the values is real work
+    auto makeValue = [](uint64_t key) { return std::string(48, static_cast<char>('a' + (key % 26))); };
+    RunClearTest<std::string>("stringValue", 1000000, makeValue);
+    RunClearTest<std::string>("stringValue", 4000000, makeValue);
 }
 
-TEST_F(HashmapIteratorTest, ParlayUnorderedMapLocked_IteratorsRandom)
+// ============================================================================
+// CLONE AND MERGE TESTS - Clone/Merge versus insert loops
+// ============================================================================
+TEST_F(HashmapCloneMergeTest, PklEHashMap_CloneMerge)
 {
-    RunIteratorTest<uint64_t, uint64_t, ParlayUnorderedMapLocked<uint64_t, uint64_t>>(KeyGenerator::Random);
+    const uint32_t numThreads = std::max(1u, std::thread::hardware_concurrency());
+    RunCloneMergeTest<false>(1000000, 1);
+    RunCloneMergeTest<false>(1000000, numThreads);
+    RunCloneMergeTest<false>(4000000, numThreads);
 }
 
-TEST_F(HashmapIteratorTest, ParlayUnorderedMapLocked_IteratorsRandomBigValue)
+TEST_F(HashmapCloneMergeTest, PklEHashMapUnrolled_CloneMerge)
 {
-    RunIteratorTest<uint64_t, TestValueStruct, ParlayUnorderedMapLocked<uint64_t, TestValueStruct>>(KeyGenerator::Random);
+    const uint32_t numThreads = std::max(1u, std::thread::hardware_concurrency());
+    RunCloneMergeTest<true>(1000000, 1);
+    RunCloneMergeTest<true>(1000000, numThreads);
 }
-#endif //PKLE_INCLUDE_PARLAY_HASHMAP
 
 // ============================================================================
-// PHMAP NODE HASH MAP SPINLOCK TESTS
+// SKEWED KEY TESTS - Every workload under Zipfian, scrambled Zipfian, hot set and moving hot spot keys
 // ============================================================================
-
-TEST_F(HashmapInsertTest, PhmapNodeHashMapSpinlock_InsertSequential)
+TEST_F(HashmapSkewedKeyTest, StdUnorderedMapLocked_SkewedKeys)
 {
-    RunInsertTest<uint64_t, uint64_t, PhmapParallelNodeHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
+    RunSkewedKeyWorkloads<StdUnorderedMapLocked<uint64_t, uint64_t>>();
 }
 
-TEST_F(HashmapInsertTest, PhmapNodeHashMapSpinlock_InsertSequentialBigValue)
+TEST_F(HashmapSkewedKeyTest, PklEHashMapLockless_SkewedKeys)
 {
-    RunInsertTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
+    RunSkewedKeyWorkloads<PklEHashMap<uint64_t, uint64_t, true>>();
 }
 
-TEST_F(HashmapInsertTest, PhmapNodeHashMapSpinlock_InsertRandom)
+TEST_F(HashmapSkewedKeyTest, PklEHashMap_SkewedKeys)
 {
-    RunInsertTest<uint64_t, uint64_t, PhmapParallelNodeHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Random);
+    RunSkewedKeyWorkloads<PklEHashMap<uint64_t, uint64_t, false>>();
 }
 
-TEST_F(HashmapInsertTest, PhmapNodeHashMapSpinlock_InsertRandomBigValue)
+TEST_F(HashmapSkewedKeyTest, PklEHashMapUnrolled_SkewedKeys)
 {
-    RunInsertTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Random);
+    RunSkewedKeyWorkloads<PklEHashMap<uint64_t, uint64_t, false, true>>();
 }
 
-TEST_F(HashmapBatchInsertTest, PhmapNodeHashMapSpinlock_BatchInsertSequential)
+TEST_F(HashmapSkewedKeyTest, PhmapSpinlock_SkewedKeys)
 {
-    RunBatchInsertTest<uint64_t, uint64_t, PhmapParallelNodeHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
+    RunSkewedKeyWorkloads<PhmapParallelFlatHashMapSpinlock<uint64_t, uint64_t, 4>>();
 }
 
-TEST_F(HashmapBatchInsertTest, PhmapNodeHashMapSpinlock_BatchInsertSequentialBigValue)
+TEST_F(HashmapSkewedKeyTest, PhmapNodeHashMapSpinlock_SkewedKeys)
 {
-    RunBatchInsertTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
+    RunSkewedKeyWorkloads<PhmapParallelNodeHashMapSpinlock<uint64_t, uint64_t, 4>>();
 }
 
-TEST_F(HashmapBatchInsertTest, PhmapNodeHashMapSpinlock_BatchInsertRandom)
+TEST_F(HashmapSkewedKeyTest, PhmapNodeHashMapPagingAllocator_SkewedKeys)
 {
-    RunBatchInsertTest<uint64_t, uint64_t, PhmapParallelNodeHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Random);
+    RunSkewedKeyWorkloads<PhmapParallelNodeHashMapPagingAllocator<uint64_t, uint64_t, 4>>();
 }
 
-TEST_F(HashmapBatchInsertTest, PhmapNodeHashMapSpinlock_BatchInsertRandomBigValue)
+#if PKLE_INCLUDE_ABSEIL_HASHMAP
+TEST_F(HashmapSkewedKeyTest, AbseilFlatHashMapLocked_SkewedKeys)
 {
-    RunBatchInsertTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Random);
+    RunSkewedKeyWorkloads<AbseilFlatHashMapLocked<uint64_t, uint64_t>>();
 }
 
-TEST_F(HashmapLookupTest, PhmapNodeHashMapSpinlock_LookupSequential)
+TEST_F(HashmapSkewedKeyTest, AbseilNodeHashMapLocked_SkewedKeys)
 {
-    RunLookupTest<uint64_t, uint64_t, PhmapParallelNodeHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
+    RunSkewedKeyWorkloads<AbseilNodeHashMapLocked<uint64_t, uint64_t>>();
 }
 
-TEST_F(HashmapLookupTest, PhmapNodeHashMapSpinlock_LookupSequentialBigValue)
+TEST_F(HashmapSkewedKeyTest, AbseilNodeHashMapPagingAllocator_SkewedKeys)
 {
-    RunLookupTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
+    RunSkewedKeyWorkloads<AbseilNodeHashMapPagingAllocator<uint64_t, uint64_t>>();
 }
+#endif //PKLE_INCLUDE_ABSEIL_HASHMAP
 
-TEST_F(HashmapLookupTest, PhmapNodeHashMapSpinlock_LookupRandom)
+#if PKLE_INCLUDE_PARLAY_HASHMAP
+TEST_F(HashmapSkewedKeyTest, ParlayUnorderedMapLocked_SkewedKeys)
 {
-    RunLookupTest<uint64_t, uint64_t, PhmapParallelNodeHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Random);
+    RunSkewedKeyWorkloads<ParlayUnorderedMapLocked<uint64_t, uint64_t>>();
 }
+#endif //PKLE_INCLUDE_PARLAY_HASHMAP
 
-TEST_F(HashmapLookupTest, PhmapNodeHashMapSpinlock_LookupRandomBigValue)
+// ============================================================================
+// YCSB TESTS - Core workloads A-F with load and run phases
+// ============================================================================
+TEST_F(HashmapYcsbTest, StdUnorderedMapLocked_Ycsb)
 {
-    RunLookupTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Random);
+    RunYcsbSuite<StdUnorderedMapLocked<uint64_t, uint64_t>>();
 }
 
-TEST_F(HashmapBatchedLookupTest, PhmapNodeHashMapSpinlock_BatchedLookupSequential)
+TEST_F(HashmapYcsbTest, PklEHashMapLockless_Ycsb)
 {
-    RunBatchedLookupTest<uint64_t, uint64_t, PhmapParallelNodeHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
+    RunYcsbSuite<PklEHashMap<uint64_t, uint64_t, true>>();
 }
 
-TEST_F(HashmapBatchedLookupTest, PhmapNodeHashMapSpinlock_BatchedLookupSequentialBigValue)
+TEST_F(HashmapYcsbTest, PklEHashMap_Ycsb)
 {
-    RunBatchedLookupTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
+    RunYcsbSuite<PklEHashMap<uint64_t, uint64_t, false>>();
 }
 
-TEST_F(HashmapBatchedLookupTest, PhmapNodeHashMapSpinlock_BatchedLookupRandom)
+TEST_F(HashmapYcsbTest, PklEHashMapUnrolled_Ycsb)
 {
-    RunBatchedLookupTest<uint64_t, uint64_t, PhmapParallelNodeHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Random);
+    RunYcsbSuite<PklEHashMap<uint64_t, uint64_t, false, true>>();
 }
 
-TEST_F(HashmapBatchedLookupTest, PhmapNodeHashMapSpinlock_BatchedLookupRandomBigValue)
+TEST_F(HashmapYcsbTest, PhmapSpinlock_Ycsb)
 {
-    RunBatchedLookupTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Random);
+    RunYcsbSuite<PhmapParallelFlatHashMapSpinlock<uint64_t, uint64_t, 4>>();
 }
 
-TEST_F(HashmapEraseTest, PhmapNodeHashMapSpinlock_EraseSequential)
+TEST_F(HashmapYcsbTest, PhmapNodeHashMapSpinlock_Ycsb)
 {
-    RunEraseTest<uint64_t, uint64_t, PhmapParallelNodeHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
+    RunYcsbSuite<PhmapParallelNodeHashMapSpinlock<uint64_t, uint64_t, 4>>();
 }
 
-TEST_F(HashmapEraseTest, PhmapNodeHashMapSpinlock_EraseSequentialBigValue)
+TEST_F(HashmapYcsbTest, PhmapNodeHashMapPagingAllocator_Ycsb)
 {
-    RunEraseTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
+    RunYcsbSuite<PhmapParallelNodeHashMapPagingAllocator<uint64_t, uint64_t, 4>>();
 }
 
-TEST_F(HashmapMixedTest, PhmapNodeHashMapSpinlock_90r10w)
+#if PKLE_INCLUDE_ABSEIL_HASHMAP
+TEST_F(HashmapYcsbTest, AbseilFlatHashMapLocked_Ycsb)
 {
-    RunMixedReadWriteTest<uint64_t, uint64_t, PhmapParallelNodeHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential, 90, 10);
+    RunYcsbSuite<AbseilFlatHashMapLocked<uint64_t, uint64_t>>();
 }
 
-TEST_F(HashmapMixedTest, PhmapNodeHashMapSpinlock_90r10wBigValue)
+TEST_F(HashmapYcsbTest, AbseilNodeHashMapLocked_Ycsb)
 {
-    RunMixedReadWriteTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential, 90, 10);
+    RunYcsbSuite<AbseilNodeHashMapLocked<uint64_t, uint64_t>>();
 }
 
-TEST_F(HashmapMixedTest, PhmapNodeHashMapSpinlock_50r50w)
+TEST_F(HashmapYcsbTest, AbseilNodeHashMapPagingAllocator_Ycsb)
 {
-    RunMixedReadWriteTest<uint64_t, uint64_t, PhmapParallelNodeHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential, 50, 50);
+    RunYcsbSuite<AbseilNodeHashMapPagingAllocator<uint64_t, uint64_t>>();
 }
+#endif //PKLE_INCLUDE_ABSEIL_HASHMAP
 
-TEST_F(HashmapMixedTest, PhmapNodeHashMapSpinlock_50r50wBigValue)
+#if PKLE_INCLUDE_PARLAY_HASHMAP
+TEST_F(HashmapYcsbTest, ParlayUnorderedMapLocked_Ycsb)
 {
-    RunMixedReadWriteTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential, 50, 50);
+    RunYcsbSuite<ParlayUnorderedMapLocked<uint64_t, uint64_t>>();
 }
+#endif //PKLE_INCLUDE_PARLAY_HASHMAP
 
-TEST_F(HashmapMixedTest, PhmapNodeHashMapSpinlock_40i50l10e)
+// ============================================================================
+// TRACE REPLAY TESTS - Recorded operation traces replayed as fast as possible and at recorded pacing
+// ============================================================================
+TEST_F(HashmapTraceReplayTest, StdUnorderedMapLocked_TraceReplay)
 {
-    RunMixedWithEraseTest<uint64_t, uint64_t, PhmapParallelNodeHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential, 40, 50, 10);
+    RunTraceReplayTest<StdUnorderedMapLocked<uint64_t, uint64_t>>(false);
 }
 
-TEST_F(HashmapMixedTest, PhmapNodeHashMapSpinlock_40i50l10eBigValue)
+TEST_F(HashmapTraceReplayTest, StdUnorderedMapLocked_TraceReplayPaced)
 {
-    RunMixedWithEraseTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential, 40, 50, 10);
+    RunTraceReplayTest<StdUnorderedMapLocked<uint64_t, uint64_t>>(true);
 }
 
-TEST_F(HashmapContendedTest, PhmapNodeHashMapSpinlock_ContendedInsert)
+TEST_F(HashmapTraceReplayTest, PklEHashMapLockless_TraceReplay)
 {
-    RunInsertTest<uint64_t, uint64_t, PhmapParallelNodeHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Contended, "contendedInsert");
+    RunTraceReplayTest<PklEHashMap<uint64_t, uint64_t, true>>(false);
 }
 
-TEST_F(HashmapContendedTest, PhmapNodeHashMapSpinlock_ContendedInsertBigValue)
+TEST_F(HashmapTraceReplayTest, PklEHashMapLockless_TraceReplayPaced)
 {
-    RunInsertTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Contended, "contendedInsert");
+    RunTraceReplayTest<PklEHashMap<uint64_t, uint64_t, true>>(true);
 }
 
-TEST_F(HashmapRekeyTest, PhmapNodeHashMapSpinlock_RekeySequential)
+TEST_F(HashmapTraceReplayTest, PklEHashMap_TraceReplay)
 {
-    RunRekeyTest<uint64_t, uint64_t, PhmapParallelNodeHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
+    RunTraceReplayTest<PklEHashMap<uint64_t, uint64_t, false>>(false);
 }
 
-TEST_F(HashmapRekeyTest, PhmapNodeHashMapSpinlock_RekeySequentialBigValue)
+TEST_F(HashmapTraceReplayTest, PklEHashMap_TraceReplayPaced)
 {
-    RunRekeyTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
+    RunTraceReplayTest<PklEHashMap<uint64_t, uint64_t, false>>(true);
 }
 
-TEST_F(HashmapIteratorTest, PhmapNodeHashMapSpinlock_IteratorsSequential)
+TEST_F(HashmapTraceReplayTest, PklEHashMapUnrolled_TraceReplay)
 {
-    RunIteratorTest<uint64_t, uint64_t, PhmapParallelNodeHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
+    RunTraceReplayTest<PklEHashMap<uint64_t, uint64_t, false, true>>(false);
 }
 
-TEST_F(HashmapIteratorTest, PhmapNodeHashMapSpinlock_IteratorsSequentialBigValue)
+TEST_F(HashmapTraceReplayTest, PklEHashMapUnrolled_TraceReplayPaced)
 {
-    RunIteratorTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
+    RunTraceReplayTest<PklEHashMap<uint64_t, uint64_t, false, true>>(true);
 }
 
-TEST_F(HashmapIteratorTest, PhmapNodeHashMapSpinlock_IteratorsRandom)
+TEST_F(HashmapTraceReplayTest, PhmapSpinlock_TraceReplay)
 {
-    RunIteratorTest<uint64_t, uint64_t, PhmapParallelNodeHashMapSpinlock<uint64_t, uint64_t, 4>>(KeyGenerator::Random);
+    RunTraceReplayTest<PhmapParallelFlatHashMapSpinlock<uint64_t, uint64_t, 4>>(false);
 }
 
-TEST_F(HashmapIteratorTest, PhmapNodeHashMapSpinlock_IteratorsRandomBigValue)
+TEST_F(HashmapTraceReplayTest, PhmapSpinlock_TraceReplayPaced)
 {
-    RunIteratorTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapSpinlock<uint64_t, TestValueStruct, 4>>(KeyGenerator::Random);
+    RunTraceReplayTest<PhmapParallelFlatHashMapSpinlock<uint64_t, uint64_t, 4>>(true);
 }
 
+TEST_F(HashmapTraceReplayTest, PhmapNodeHashMapSpinlock_TraceReplay)
+{
+    RunTraceReplayTest<PhmapParallelNodeHashMapSpinlock<uint64_t, uint64_t, 4>>(false);
+}
 
-// ============================================================================
-// PHMAP NODE HASH MAP WITH PAGING ALLOCATOR TESTS
-// ============================================================================
+TEST_F(HashmapTraceReplayTest, PhmapNodeHashMapSpinlock_TraceReplayPaced)
+{
+    RunTraceReplayTest<PhmapParallelNodeHashMapSpinlock<uint64_t, uint64_t, 4>>(true);
+}
 
-TEST_F(HashmapInsertTest, PhmapNodeHashMapPagingAllocator_InsertSequential)
+TEST_F(HashmapTraceReplayTest, PhmapNodeHashMapPagingAllocator_TraceReplay)
 {
-    RunInsertTest<uint64_t, uint64_t, PhmapParallelNodeHashMapPagingAllocator<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
+    RunTraceReplayTest<PhmapParallelNodeHashMapPagingAllocator<uint64_t, uint64_t, 4>>(false);
 }
 
-TEST_F(HashmapInsertTest, PhmapNodeHashMapPagingAllocator_InsertSequentialBigValue)
+TEST_F(HashmapTraceReplayTest, PhmapNodeHashMapPagingAllocator_TraceReplayPaced)
 {
-    RunInsertTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapPagingAllocator<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
+    RunTraceReplayTest<PhmapParallelNodeHashMapPagingAllocator<uint64_t, uint64_t, 4>>(true);
 }
 
-TEST_F(HashmapInsertTest, PhmapNodeHashMapPagingAllocator_InsertRandom)
+#if PKLE_INCLUDE_ABSEIL_HASHMAP
+TEST_F(HashmapTraceReplayTest, AbseilFlatHashMapLocked_TraceReplay)
 {
-    RunInsertTest<uint64_t, uint64_t, PhmapParallelNodeHashMapPagingAllocator<uint64_t, uint64_t, 4>>(KeyGenerator::Random);
+    RunTraceReplayTest<AbseilFlatHashMapLocked<uint64_t, uint64_t>>(false);
 }
 
-TEST_F(HashmapInsertTest, PhmapNodeHashMapPagingAllocator_InsertRandomBigValue)
+TEST_F(HashmapTraceReplayTest, AbseilFlatHashMapLocked_TraceReplayPaced)
 {
-    RunInsertTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapPagingAllocator<uint64_t, TestValueStruct, 4>>(KeyGenerator::Random);
+    RunTraceReplayTest<AbseilFlatHashMapLocked<uint64_t, uint64_t>>(true);
 }
 
-TEST_F(HashmapBatchInsertTest, PhmapNodeHashMapPagingAllocator_BatchInsertSequential)
+TEST_F(HashmapTraceReplayTest, AbseilNodeHashMapLocked_TraceReplay)
 {
-    RunBatchInsertTest<uint64_t, uint64_t, PhmapParallelNodeHashMapPagingAllocator<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
+    RunTraceReplayTest<AbseilNodeHashMapLocked<uint64_t, uint64_t>>(false);
 }
 
-TEST_F(HashmapBatchInsertTest, PhmapNodeHashMapPagingAllocator_BatchInsertSequentialBigValue)
+TEST_F(HashmapTraceReplayTest, AbseilNodeHashMapLocked_TraceReplayPaced)
 {
-    RunBatchInsertTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapPagingAllocator<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
+    RunTraceReplayTest<AbseilNodeHashMapLocked<uint64_t, uint64_t>>(true);
 }
 
-TEST_F(HashmapBatchInsertTest, PhmapNodeHashMapPagingAllocator_BatchInsertRandom)
+TEST_F(HashmapTraceReplayTest, AbseilNodeHashMapPagingAllocator_TraceReplay)
 {
-    RunBatchInsertTest<uint64_t, uint64_t, PhmapParallelNodeHashMapPagingAllocator<uint64_t, uint64_t, 4>>(KeyGenerator::Random);
+    RunTraceReplayTest<AbseilNodeHashMapPagingAllocator<uint64_t, uint64_t>>(false);
 }
 
-TEST_F(HashmapBatchInsertTest, PhmapNodeHashMapPagingAllocator_BatchInsertRandomBigValue)
+TEST_F(HashmapTraceReplayTest, AbseilNodeHashMapPagingAllocator_TraceReplayPaced)
 {
-    RunBatchInsertTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapPagingAllocator<uint64_t, TestValueStruct, 4>>(KeyGenerator::Random);
+    RunTraceReplayTest<AbseilNodeHashMapPagingAllocator<uint64_t, uint64_t>>(true);
 }
+#endif //PKLE_INCLUDE_ABSEIL_HASHMAP
 
-TEST_F(HashmapLookupTest, PhmapNodeHashMapPagingAllocator_LookupSequential)
+#if PKLE_INCLUDE_PARLAY_HASHMAP
+TEST_F(HashmapTraceReplayTest, ParlayUnorderedMapLocked_TraceReplay)
 {
-    RunLookupTest<uint64_t, uint64_t, PhmapParallelNodeHashMapPagingAllocator<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
+    RunTraceReplayTest<ParlayUnorderedMapLocked<uint64_t, uint64_t>>(false);
 }
 
-TEST_F(HashmapLookupTest, PhmapNodeHashMapPagingAllocator_LookupSequentialBigValue)
+TEST_F(HashmapTraceReplayTest, ParlayUnorderedMapLocked_TraceReplayPaced)
 {
-    RunLookupTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapPagingAllocator<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
+    RunTraceReplayTest<ParlayUnorderedMapLocked<uint64_t, uint64_t>>(true);
 }
+#endif //PKLE_INCLUDE_PARLAY_HASHMAP
 
-TEST_F(HashmapLookupTest, PhmapNodeHashMapPagingAllocator_LookupRandom)
+// ============================================================================
+// WORKING SET TESTS - Lookup, insert, mixed and iteration from 10K keys up to 1B keys
+// ============================================================================
+TEST_F(HashmapWorkingSetTest, StdUnorderedMapLocked_WorkingSet)
 {
-    RunLookupTest<uint64_t, uint64_t, PhmapParallelNodeHashMapPagingAllocator<uint64_t, uint64_t, 4>>(KeyGenerator::Random);
+    RunWorkingSetSweep<StdUnorderedMapLocked<uint64_t, uint64_t>>();
 }
 
-TEST_F(HashmapLookupTest, PhmapNodeHashMapPagingAllocator_LookupRandomBigValue)
+TEST_F(HashmapWorkingSetTest, PklEHashMapLockless_WorkingSet)
 {
-    RunLookupTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapPagingAllocator<uint64_t, TestValueStruct, 4>>(KeyGenerator::Random);
+    RunWorkingSetSweep<PklEHashMap<uint64_t, uint64_t, true>>();
 }
 
-TEST_F(HashmapBatchedLookupTest, PhmapNodeHashMapPagingAllocator_BatchedLookupSequential)
+TEST_F(HashmapWorkingSetTest, PklEHashMap_WorkingSet)
 {
-    RunBatchedLookupTest<uint64_t, uint64_t, PhmapParallelNodeHashMapPagingAllocator<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
+    RunWorkingSetSweep<PklEHashMap<uint64_t, uint64_t, false>>();
 }
 
-TEST_F(HashmapBatchedLookupTest, PhmapNodeHashMapPagingAllocator_BatchedLookupSequentialBigValue)
+TEST_F(HashmapWorkingSetTest, PklEHashMapUnrolled_WorkingSet)
 {
-    RunBatchedLookupTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapPagingAllocator<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
+    RunWorkingSetSweep<PklEHashMap<uint64_t, uint64_t, false, true>>();
 }
 
-TEST_F(HashmapBatchedLookupTest, PhmapNodeHashMapPagingAllocator_BatchedLookupRandom)
+TEST_F(HashmapWorkingSetTest, PhmapSpinlock_WorkingSet)
 {
-    RunBatchedLookupTest<uint64_t, uint64_t, PhmapParallelNodeHashMapPagingAllocator<uint64_t, uint64_t, 4>>(KeyGenerator::Random);
+    RunWorkingSetSweep<PhmapParallelFlatHashMapSpinlock<uint64_t, uint64_t, 4>>();
 }
 
-TEST_F(HashmapBatchedLookupTest, PhmapNodeHashMapPagingAllocator_BatchedLookupRandomBigValue)
+TEST_F(HashmapWorkingSetTest, PhmapNodeHashMapSpinlock_WorkingSet)
 {
-    RunBatchedLookupTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapPagingAllocator<uint64_t, TestValueStruct, 4>>(KeyGenerator::Random);
+    RunWorkingSetSweep<PhmapParallelNodeHashMapSpinlock<uint64_t, uint64_t, 4>>();
 }
 
-TEST_F(HashmapEraseTest, PhmapNodeHashMapPagingAllocator_EraseSequential)
+TEST_F(HashmapWorkingSetTest, PhmapNodeHashMapPagingAllocator_WorkingSet)
 {
-    RunEraseTest<uint64_t, uint64_t, PhmapParallelNodeHashMapPagingAllocator<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
+    RunWorkingSetSweep<PhmapParallelNodeHashMapPagingAllocator<uint64_t, uint64_t, 4>>();
 }
 
-TEST_F(HashmapEraseTest, PhmapNodeHashMapPagingAllocator_EraseSequentialBigValue)
+#if PKLE_INCLUDE_ABSEIL_HASHMAP
+TEST_F(HashmapWorkingSetTest, AbseilFlatHashMapLocked_WorkingSet)
 {
-    RunEraseTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapPagingAllocator<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
+    RunWorkingSetSweep<AbseilFlatHashMapLocked<uint64_t, uint64_t>>();
 }
 
-TEST_F(HashmapMixedTest, PhmapNodeHashMapPagingAllocator_90r10w)
+TEST_F(HashmapWorkingSetTest, AbseilNodeHashMapLocked_WorkingSet)
 {
-    RunMixedReadWriteTest<uint64_t, uint64_t, PhmapParallelNodeHashMapPagingAllocator<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential, 90, 10);
+    RunWorkingSetSweep<AbseilNodeHashMapLocked<uint64_t, uint64_t>>();
 }
 
-TEST_F(HashmapMixedTest, PhmapNodeHashMapPagingAllocator_90r10wBigValue)
+TEST_F(HashmapWorkingSetTest, AbseilNodeHashMapPagingAllocator_WorkingSet)
 {
-    RunMixedReadWriteTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapPagingAllocator<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential, 90, 10);
+    RunWorkingSetSweep<AbseilNodeHashMapPagingAllocator<uint64_t, uint64_t>>();
 }
+#endif //PKLE_INCLUDE_ABSEIL_HASHMAP
 
-TEST_F(HashmapMixedTest, PhmapNodeHashMapPagingAllocator_50r50w)
+#if PKLE_INCLUDE_PARLAY_HASHMAP
+TEST_F(HashmapWorkingSetTest, ParlayUnorderedMapLocked_WorkingSet)
 {
-    RunMixedReadWriteTest<uint64_t, uint64_t, PhmapParallelNodeHashMapPagingAllocator<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential, 50, 50);
+    RunWorkingSetSweep<ParlayUnorderedMapLocked<uint64_t, uint64_t>>();
 }
+#endif //PKLE_INCLUDE_PARLAY_HASHMAP
 
-TEST_F(HashmapMixedTest, PhmapNodeHashMapPagingAllocator_50r50wBigValue)
+// ============================================================================
+// SHARED MEMORY TESTS - SharedMemoryHashMap, one writer process and forked reader processes
+// ============================================================================
+TEST_F(HashmapSharedMemoryTest, SharedMemoryHashMap_ForkReadMemfd)
 {
-    RunMixedReadWriteTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapPagingAllocator<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential, 50, 50);
+    RunSharedMemoryForkReadTest(false, false);
 }
 
-TEST_F(HashmapMixedTest, PhmapNodeHashMapPagingAllocator_40i50l10e)
+TEST_F(HashmapSharedMemoryTest, SharedMemoryHashMap_ForkReadNamedShm)
 {
-    RunMixedWithEraseTest<uint64_t, uint64_t, PhmapParallelNodeHashMapPagingAllocator<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential, 40, 50, 10);
+    RunSharedMemoryForkReadTest(true, false);
 }
 
-TEST_F(HashmapMixedTest, PhmapNodeHashMapPagingAllocator_40i50l10eBigValue)
+TEST_F(HashmapSharedMemoryTest, SharedMemoryHashMap_ForkConcurrentReadMemfd)
 {
-    RunMixedWithEraseTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapPagingAllocator<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential, 40, 50, 10);
+    RunSharedMemoryForkReadTest(false, true);
 }
 
-TEST_F(HashmapContendedTest, PhmapNodeHashMapPagingAllocator_ContendedInsert)
+// ============================================================================
+// SIMPLE LINKED LIST TESTS - One bucket list, write-locked erase vs Harris-Michael lock-free paths
+// ============================================================================
+TEST_F(SimpleLinkedListStressTest, SimpleLinkedListLocked_Stress)
 {
-    RunInsertTest<uint64_t, uint64_t, PhmapParallelNodeHashMapPagingAllocator<uint64_t, uint64_t, 4>>(KeyGenerator::Contended, "contendedInsert");
+    RunSimpleLinkedListStressTest<SimpleLinkedListBucket<uint64_t, uint64_t, false>>();
 }
 
-TEST_F(HashmapContendedTest, PhmapNodeHashMapPagingAllocator_ContendedInsertBigValue)
+TEST_F(SimpleLinkedListStressTest, SimpleLinkedListLockFree_Stress)
 {
-    RunInsertTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapPagingAllocator<uint64_t, TestValueStruct, 4>>(KeyGenerator::Contended, "contendedInsert");
+    RunSimpleLinkedListStressTest<SimpleLinkedListBucket<uint64_t, uint64_t, true>>();
 }
 
-TEST_F(HashmapRekeyTest, PhmapNodeHashMapPagingAllocator_RekeySequential)
+TEST_F(SimpleLinkedListStressTest, SimpleLinkedListLocked_ContendedBucket8Keys)
 {
-    RunRekeyTest<uint64_t, uint64_t, PhmapParallelNodeHashMapPagingAllocator<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
+    RunContendedBucketTest<SimpleLinkedListBucket<uint64_t, uint64_t, false>>(8, 25, 50);
 }
 
-TEST_F(HashmapRekeyTest, PhmapNodeHashMapPagingAllocator_RekeySequentialBigValue)
+TEST_F(SimpleLinkedListStressTest, SimpleLinkedListLockFree_ContendedBucket8Keys)
 {
-    RunRekeyTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapPagingAllocator<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
+    RunContendedBucketTest<SimpleLinkedListBucket<uint64_t, uint64_t, true>>(8, 25, 50);
 }
 
-TEST_F(HashmapIteratorTest, PhmapNodeHashMapPagingAllocator_IteratorsSequential)
+TEST_F(SimpleLinkedListStressTest, SimpleLinkedListLocked_ContendedBucket64Keys)
 {
-    RunIteratorTest<uint64_t, uint64_t, PhmapParallelNodeHashMapPagingAllocator<uint64_t, uint64_t, 4>>(KeyGenerator::Sequential);
+    RunContendedBucketTest<SimpleLinkedListBucket<uint64_t, uint64_t, false>>(64, 25, 50);
 }
 
-TEST_F(HashmapIteratorTest, PhmapNodeHashMapPagingAllocator_IteratorsSequentialBigValue)
+TEST_F(SimpleLinkedListStressTest, SimpleLinkedListLockFree_ContendedBucket64Keys)
 {
-    RunIteratorTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapPagingAllocator<uint64_t, TestValueStruct, 4>>(KeyGenerator::Sequential);
+    RunContendedBucketTest<SimpleLinkedListBucket<uint64_t, uint64_t, true>>(64, 25, 50);
 }
 
-TEST_F(HashmapIteratorTest, PhmapNodeHashMapPagingAllocator_IteratorsRandom)
+TEST_F(SimpleLinkedListStressTest, SimpleLinkedListLocked_ContendedBucket64KeysReadHeavy)
 {
-    RunIteratorTest<uint64_t, uint64_t, PhmapParallelNodeHashMapPagingAllocator<uint64_t, uint64_t, 4>>(KeyGenerator::Random);
+    RunContendedBucketTest<SimpleLinkedListBucket<uint64_t, uint64_t, false>>(64, 5, 90);
 }
 
-TEST_F(HashmapIteratorTest, PhmapNodeHashMapPagingAllocator_IteratorsRandomBigValue)
+TEST_F(SimpleLinkedListStressTest, SimpleLinkedListLockFree_ContendedBucket64KeysReadHeavy)
 {
-    RunIteratorTest<uint64_t, TestValueStruct, PhmapParallelNodeHashMapPagingAllocator<uint64_t, TestValueStruct, 4>>(KeyGenerator::Random);
+    RunContendedBucketTest<SimpleLinkedListBucket<uint64_t, uint64_t, true>>(64, 5, 90);
 }
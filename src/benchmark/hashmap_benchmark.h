@@ -6,9 +6,41 @@
 #include <unordered_map>
 #include <vector>
 #include <random>
-#include "multithreader_pool.h"
+#include <string>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdlib>
+#include <cerrno>
+#include <type_traits>
+#include <memory>
+#include <map>
+#include <tuple>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <sys/utsname.h>
+#include <sched.h>
+#include <pthread.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include <malloc.h>
 #include "logging_util.h"
 #include "hash_map.h"
+#include "lock_free_linked_list.h"
+#include "striped_counter.h"
+#include "shared_memory_hash_map.h"
+#include "tiered_hash_map.h"
+#include "hash_join.h"
+#include "published_hash_map.h"
 #include "spin_lock.h"
 #include "phmap.h"
 #include "phmap_specialized.h"
@@ -25,95 +57,2059 @@
 #include "parlay_hash/unordered_map.h"
 #endif
 
+// Unsigned benchmark setting from the environment, defaultValue if it is unset or not a number
+inline uint64_t GetBenchmarkSettingU64(const char* name, uint64_t defaultValue)
+{
+    const char* pValue = getenv(name);
+    if(pValue == nullptr || *pValue == '\0')
+    {
+        return defaultValue;
+    }
+    char* pEnd = nullptr;
+    const unsigned long long value = strtoull(pValue, &pEnd, 10);
+    return (*pEnd == '\0') ? static_cast<uint64_t>(value) : defaultValue;
+}
+
+// Floating point benchmark setting from the environment, defaultValue if it is unset or not a number
+inline double GetBenchmarkSettingDouble(const char* name, double defaultValue)
+{
+    const char* pValue = getenv(name);
+    if(pValue == nullptr || *pValue == '\0')
+    {
+        return defaultValue;
+    }
+    char* pEnd = nullptr;
+    const double value = strtod(pValue, &pEnd);
+    return (*pEnd == '\0') ? value : defaultValue;
+}
+
+// String benchmark setting from the environment, nullptr if it is unset or empty
+inline const char* GetBenchmarkSettingString(const char* name)
+{
+    const char* pValue = getenv(name);
+    return (pValue != nullptr && *pValue != '\0') ? pValue : nullptr;
+}
+
+// RunWithThreadCount times every Nth operation of each thread into the latency histograms, 0 (the default) turns it off.
+// Timing costs two clock reads and a branch in the timed loop, so it is opt-in to keep the throughput numbers comparable.
+inline uint32_t GetLatencySamplePeriod()
+{
+    static const uint32_t s_samplePeriod = static_cast<uint32_t>(GetBenchmarkSettingU64("PKLE_BENCH_LATENCY_SAMPLE_PERIOD", 0));
+    return s_samplePeriod;
+}
+
+// Cost of the two steady_clock reads around a timed operation, subtracted from every sample.
+// Median of back to back reads, measured once per process.
+inline uint64_t GetTimerOverheadNs()
+{
+    static const uint64_t s_overheadNs = []()
+    {
+        constexpr uint32_t c_numCalibrationRuns = 10001;
+        std::vector<int64_t> pairCosts(c_numCalibrationRuns);
+        for(int64_t& pairCost : pairCosts)
+        {
+            auto start = std::chrono::steady_clock::now();
+            auto end = std::chrono::steady_clock::now();
+            pairCost = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        }
+        std::nth_element(pairCosts.begin(), pairCosts.begin() + (c_numCalibrationRuns / 2), pairCosts.end());
+        return static_cast<uint64_t>(std::max<int64_t>(0, pairCosts[c_numCalibrationRuns / 2]));
+    }();
+    return s_overheadNs;
+}
+
+// HDR style latency histogram in ns.
+// - Values below 2 * c_subBucketCount are counted exactly. Above that every power of two range is split into
+//   c_subBucketCount linear sub buckets, so a reported value is at most 1 / c_subBucketCount (~1.6%) above the recorded one.
+// - Fixed size, Record() does not allocate. Keep one per thread and Merge() them after the run.
+class LatencyHistogram
+{
+public:
+    static constexpr uint32_t c_subBucketBits = 6;
+    static constexpr uint32_t c_subBucketCount = 1u << c_subBucketBits;
+    static constexpr uint32_t c_numBuckets = (64 - c_subBucketBits + 1) * c_subBucketCount;
+
+private:
+    std::vector<uint64_t> counts;
+    uint64_t numSamples = 0;
+    uint64_t maxNs = 0;
+
+    static uint32_t GetBucketIndex(uint64_t valueNs)
+    {
+        const int shift = std::max(0, static_cast<int>(std::bit_width(valueNs)) - static_cast<int>(c_subBucketBits + 1));
+        return static_cast<uint32_t>(shift) * c_subBucketCount + static_cast<uint32_t>(valueNs >> shift);
+    }
+
+    // Largest value that lands in bucketIndex
+    static uint64_t GetBucketHighestValue(uint32_t bucketIndex)
+    {
+        if(bucketIndex < 2 * c_subBucketCount)
+        {
+            return bucketIndex;
+        }
+        const uint32_t shift = (bucketIndex / c_subBucketCount) - 1;
+        const uint64_t subBucket = bucketIndex - (shift * c_subBucketCount);
+        return (subBucket << shift) + ((1ULL << shift) - 1);
+    }
+
+public:
+    LatencyHistogram() : counts(c_numBuckets, 0) {}
+
+    void Record(uint64_t valueNs)
+    {
+        ++counts[GetBucketIndex(valueNs)];
+        ++numSamples;
+        maxNs = std::max(maxNs, valueNs);
+    }
+
+    void Merge(const LatencyHistogram& other)
+    {
+        for(uint32_t i = 0; i < c_numBuckets; ++i)
+        {
+            counts[i] += other.counts[i];
+        }
+        numSamples += other.numSamples;
+        maxNs = std::max(maxNs, other.maxNs);
+    }
+
+    uint64_t GetNumSamples() const { return numSamples; }
+    uint64_t GetMaxNs() const { return maxNs; }
+
+    // Smallest bucket value that at least percentile % of the samples are at or below, 0 when empty
+    uint64_t GetValueAtPercentile(double percentile) const
+    {
+        if(numSamples == 0)
+        {
+            return 0;
+        }
+        const uint64_t targetCount = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil((percentile / 100.0) * numSamples)));
+        uint64_t seenCount = 0;
+        for(uint32_t i = 0; i < c_numBuckets; ++i)
+        {
+            seenCount += counts[i];
+            if(seenCount >= targetCount)
+            {
+                return std::min(GetBucketHighestValue(i), maxNs);
+            }
+        }
+        return maxNs;
+    }
+};
+
+// Per thread latency histograms for one RunWithThreadCount run. A thread claims a histogram on its first
+// operation, threads beyond the number of histograms run their operations untimed.
+class LatencyRecorder
+{
+    struct ThreadState
+    {
+        uint64_t runId = 0;
+        LatencyHistogram* pHistogram = nullptr;
+        uint32_t numUntilSample = 0;
+    };
+
+    static uint64_t GetNextRunId()
+    {
+        static std::atomic<uint64_t> s_nextRunId{1};
+        return s_nextRunId.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::vector<LatencyHistogram> histograms;
+    std::atomic<uint32_t> numClaimedHistograms{0};
+    const uint64_t runId;
+    const uint32_t samplePeriod;
+    const uint64_t timerOverheadNs;
+
+public:
+    LatencyRecorder(uint32_t numThreads, uint32_t samplePeriod_)
+        : histograms((samplePeriod_ > 0) ? numThreads : 0)
+        , runId(GetNextRunId())
+        , samplePeriod(samplePeriod_)
+        , timerOverheadNs((samplePeriod_ > 0) ? GetTimerOverheadNs() : 0)
+    {
+    }
+
+    bool IsEnabled() const { return samplePeriod > 0; }
+
+    template<typename Func_T>
+    void Run(Func_T&& func, uint32_t index)
+    {
+        thread_local ThreadState t_state;
+        if(t_state.runId != runId)
+        {
+            const uint32_t histogramIndex = numClaimedHistograms.fetch_add(1, std::memory_order_relaxed);
+            t_state.runId = runId;
+            t_state.pHistogram = (histogramIndex < histograms.size()) ? &histograms[histogramIndex] : nullptr;
+            t_state.numUntilSample = 1;
+        }
+        if(t_state.pHistogram == nullptr || --t_state.numUntilSample != 0)
+        {
+            func(index);
+            return;
+        }
+        t_state.numUntilSample = samplePeriod;
+
+        auto start = std::chrono::steady_clock::now();
+        func(index);
+        auto end = std::chrono::steady_clock::now();
+        const uint64_t elapsedNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        t_state.pHistogram->Record((elapsedNs > timerOverheadNs) ? (elapsedNs - timerOverheadNs) : 0);
+    }
+
+    // Only once the run finished
+    LatencyHistogram GetMerged() const
+    {
+        LatencyHistogram merged;
+        for(const LatencyHistogram& histogram : histograms)
+        {
+            merged.Merge(histogram);
+        }
+        return merged;
+    }
+};
+
+// Hardware events PerfCounterRecorder collects, in group order. The first one leads the group.
+enum class PerfEvent : uint32_t
+{
+    Cycles,
+    Instructions,
+    L1dMisses,
+    LlcMisses,
+    DtlbMisses,
+    BranchMisses,
+    Count
+};
+
+inline constexpr uint32_t c_numPerfEvents = static_cast<uint32_t>(PerfEvent::Count);
+
+inline const char* GetPerfEventName(PerfEvent event)
+{
+    static const char* const s_names[c_numPerfEvents] = {"cycles", "instructions", "L1d misses", "LLC misses", "dTLB misses", "branch misses"};
+    return s_names[static_cast<uint32_t>(event)];
+}
+
+// Summed event counts of one run. An event is valid when every thread could count it.
+struct PerfCounterTotals
+{
+    double counts[c_numPerfEvents] = {};
+    uint32_t validEventMask = 0;
+
+    bool IsValid(PerfEvent event) const
+    {
+        return (validEventMask & (1u << static_cast<uint32_t>(event))) != 0;
+    }
+};
+
+// Collection is on with PKLE_BENCH_PERF_COUNTERS=1. Turned off for the rest of the process, with one warning,
+// when the cycles counter cannot be opened, e.g. in a container or with a restrictive perf_event_paranoid.
+inline std::atomic<bool>& GetPerfCountersEnabledFlag()
+{
+    static std::atomic<bool> s_bEnabled{GetBenchmarkSettingU64("PKLE_BENCH_PERF_COUNTERS", 0) != 0};
+    return s_bEnabled;
+}
+
+// Per thread perf_event_open counter groups for one RunWithThreadCount run: every pool thread claims and opens its
+// group before the pass is timed (see HashmapBenchmarkTest::RunPass) and counts only itself (user space, pid 0, any cpu).
+// Groups are enabled while a pass runs, Pause() stops them between passes so setup work is not counted.
+// Counts are scaled by time enabled / time running when the kernel had to multiplex the group.
+class PerfCounterRecorder
+{
+    struct CounterGroup
+    {
+        int fds[c_numPerfEvents] = {-1, -1, -1, -1, -1, -1};
+        uint32_t openEventMask = 0;
+    };
+
+    struct ThreadState
+    {
+        uint64_t runId = 0;
+    };
+
+    static uint64_t GetNextRunId()
+    {
+        static std::atomic<uint64_t> s_nextRunId{1};
+        return s_nextRunId.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void SetEventConfig(PerfEvent event, perf_event_attr& attr)
+    {
+        auto cacheConfig = [](uint64_t cache) { return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16); };
+        switch(event)
+        {
+            case PerfEvent::Cycles:       attr.type = PERF_TYPE_HARDWARE; attr.config = PERF_COUNT_HW_CPU_CYCLES; break;
+            case PerfEvent::Instructions: attr.type = PERF_TYPE_HARDWARE; attr.config = PERF_COUNT_HW_INSTRUCTIONS; break;
+            case PerfEvent::L1dMisses:    attr.type = PERF_TYPE_HW_CACHE; attr.config = cacheConfig(PERF_COUNT_HW_CACHE_L1D); break;
+            case PerfEvent::LlcMisses:    attr.type = PERF_TYPE_HW_CACHE; attr.config = cacheConfig(PERF_COUNT_HW_CACHE_LL); break;
+            case PerfEvent::DtlbMisses:   attr.type = PERF_TYPE_HW_CACHE; attr.config = cacheConfig(PERF_COUNT_HW_CACHE_DTLB); break;
+            default:                      attr.type = PERF_TYPE_HARDWARE; attr.config = PERF_COUNT_HW_BRANCH_MISSES; break;
+        }
+    }
+
+    static int OpenEvent(PerfEvent event, int groupFd)
+    {
+        perf_event_attr attr = {};
+        attr.size = sizeof(attr);
+        SetEventConfig(event, attr);
+        attr.disabled = (groupFd == -1) ? 1 : 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING | PERF_FORMAT_ID;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, PERF_FLAG_FD_CLOEXEC));
+    }
+
+    std::vector<CounterGroup> groups;
+    std::atomic<uint32_t> numClaimedGroups{0};
+    const uint64_t runId;
+
+    void OpenGroup(CounterGroup& group)
+    {
+        group.fds[0] = OpenEvent(PerfEvent::Cycles, -1);
+        if(group.fds[0] < 0)
+        {
+            if(GetPerfCountersEnabledFlag().exchange(false))
+            {
+                printf("Perf counters unavailable (%s), running without them\n", strerror(errno));
+            }
+            return;
+        }
+        group.openEventMask = 1;
+        for(uint32_t i = 1; i < c_numPerfEvents; ++i)
+        {
+            group.fds[i] = OpenEvent(static_cast<PerfEvent>(i), group.fds[0]);
+            group.openEventMask |= (group.fds[i] >= 0) ? (1u << i) : 0;
+        }
+    }
+
+    void SetGroupsEnabled(bool bEnable)
+    {
+        const uint32_t numGroups = std::min<uint32_t>(numClaimedGroups.load(std::memory_order_acquire), static_cast<uint32_t>(groups.size()));
+        for(uint32_t i = 0; i < numGroups; ++i)
+        {
+            if(groups[i].fds[0] >= 0)
+            {
+                ioctl(groups[i].fds[0], bEnable ? PERF_EVENT_IOC_ENABLE : PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+            }
+        }
+    }
+
+public:
+    PerfCounterRecorder(uint32_t numThreads, bool bEnable)
+        : groups((bEnable && GetPerfCountersEnabledFlag().load(std::memory_order_relaxed)) ? numThreads : 0)
+        , runId(GetNextRunId())
+    {
+    }
+
+    ~PerfCounterRecorder()
+    {
+        for(CounterGroup& group : groups)
+        {
+            for(int fd : group.fds)
+            {
+                if(fd >= 0)
+                {
+                    close(fd);
+                }
+            }
+        }
+    }
+
+    PerfCounterRecorder(const PerfCounterRecorder&) = delete;
+    PerfCounterRecorder& operator=(const PerfCounterRecorder&) = delete;
+
+    bool IsEnabled() const { return !groups.empty(); }
+
+    // Opens the calling thread's group the first time it is called on that thread. Call on every thread that runs
+    // the pass, before Resume(), so the syscalls stay out of the timed window.
+    void ClaimThread()
+    {
+        thread_local ThreadState t_state;
+        if(t_state.runId == runId)
+        {
+            return;
+        }
+        t_state.runId = runId;
+        const uint32_t groupIndex = numClaimedGroups.fetch_add(1, std::memory_order_acq_rel);
+        if(groupIndex < groups.size())
+        {
+            OpenGroup(groups[groupIndex]);
+        }
+    }
+
+    void Resume()
+    {
+        SetGroupsEnabled(true);
+    }
+
+    void Pause()
+    {
+        SetGroupsEnabled(false);
+    }
+
+    // Only once the run finished
+    PerfCounterTotals Read() const
+    {
+        struct GroupReadBuffer
+        {
+            uint64_t numEvents;
+            uint64_t timeEnabled;
+            uint64_t timeRunning;
+            struct { uint64_t value; uint64_t id; } events[c_numPerfEvents];
+        };
+
+        PerfCounterTotals totals;
+        uint32_t validMask = ~0u;
+        bool bAnyGroup = false;
+        const uint32_t numGroups = std::min<uint32_t>(numClaimedGroups.load(std::memory_order_acquire), static_cast<uint32_t>(groups.size()));
+        for(uint32_t i = 0; i < numGroups; ++i)
+        {
+            const CounterGroup& group = groups[i];
+            GroupReadBuffer buffer = {};
+            if(group.fds[0] < 0 || read(group.fds[0], &buffer, sizeof(buffer)) <= 0)
+            {
+                continue;
+            }
+            uint64_t ids[c_numPerfEvents] = {};
+            for(uint32_t event = 0; event < c_numPerfEvents; ++event)
+            {
+                if(group.fds[event] >= 0)
+                {
+                    ioctl(group.fds[event], PERF_EVENT_IOC_ID, &ids[event]);
+                }
+            }
+            const double scale = (buffer.timeRunning > 0) ? static_cast<double>(buffer.timeEnabled) / static_cast<double>(buffer.timeRunning) : 0.0;
+            for(uint64_t entry = 0; entry < buffer.numEvents && entry < c_numPerfEvents; ++entry)
+            {
+                for(uint32_t event = 0; event < c_numPerfEvents; ++event)
+                {
+                    if(group.fds[event] >= 0 && ids[event] == buffer.events[entry].id)
+                    {
+                        totals.counts[event] += static_cast<double>(buffer.events[entry].value) * scale;
+                    }
+                }
+            }
+            validMask &= group.openEventMask;
+            bAnyGroup = true;
+        }
+        totals.validEventMask = bAnyGroup ? validMask : 0;
+        return totals;
+    }
+};
+
+// Repeated, time based mode of RunThreadScalingBenchmark, on when PKLE_BENCH_REPETITIONS > 1.
+// Every configuration first runs passes over its operation range for warmupNs, then numRepetitions repetitions,
+// each running passes until they took minRunNs together. Results whose coefficient of variation
+// is above maxStableCvPercent are flagged unstable.
+struct BenchmarkRunSettings
+{
+    uint32_t numRepetitions = 1;
+    uint64_t warmupNs = 0;
+    uint64_t minRunNs = 0;
+    double maxStableCvPercent = 0.0;
+
+    bool IsRepeated() const { return numRepetitions > 1; }
+};
+
+inline const BenchmarkRunSettings& GetBenchmarkRunSettings()
+{
+    static const BenchmarkRunSettings s_settings = []()
+    {
+        BenchmarkRunSettings settings;
+        settings.numRepetitions = std::max<uint32_t>(1, static_cast<uint32_t>(GetBenchmarkSettingU64("PKLE_BENCH_REPETITIONS", 1)));
+        settings.warmupNs = GetBenchmarkSettingU64("PKLE_BENCH_WARMUP_MS", 100) * 1000000ULL;
+        settings.minRunNs = GetBenchmarkSettingU64("PKLE_BENCH_MIN_RUN_MS", 200) * 1000000ULL;
+        settings.maxStableCvPercent = static_cast<double>(GetBenchmarkSettingU64("PKLE_BENCH_MAX_STABLE_CV_PERCENT", 5));
+        return settings;
+    }();
+    return s_settings;
+}
+
+struct RepetitionStatistics
+{
+    double median = 0.0;
+    double ciLow = 0.0; //95% confidence interval of the median
+    double ciHigh = 0.0;
+    double mean = 0.0;
+    double cvPercent = 0.0; //Sample standard deviation over the mean
+};
+
+// The confidence interval of the median is distribution free: the true median lies in [x(j), x(n + 1 - j)]
+// of the sorted samples with probability 1 - 2 * P(Binomial(n, 0.5) < j). Takes the narrowest interval with at
+// least 95%. Below 6 samples none reaches 95% and the interval is [min, max].
+inline RepetitionStatistics ComputeRepetitionStatistics(std::vector<double> samples)
+{
+    RepetitionStatistics stats;
+    const size_t n = samples.size();
+    if(n == 0)
+    {
+        return stats;
+    }
+    std::sort(samples.begin(), samples.end());
+    stats.median = (n % 2 == 1) ? samples[n / 2] : 0.5 * (samples[(n / 2) - 1] + samples[n / 2]);
+
+    size_t rank = 1;
+    double pointProbability = std::pow(0.5, static_cast<double>(n)); //P(X = 0)
+    double cumulativeProbability = pointProbability; //P(X < rank)
+    while(rank < (n + 1) / 2)
+    {
+        pointProbability *= static_cast<double>(n - rank + 1) / static_cast<double>(rank);
+        if(2.0 * (cumulativeProbability + pointProbability) > 0.05)
+        {
+            break;
+        }
+        cumulativeProbability += pointProbability;
+        ++rank;
+    }
+    stats.ciLow = samples[rank - 1];
+    stats.ciHigh = samples[n - rank];
+
+    double sum = 0.0;
+    for(double sample : samples)
+    {
+        sum += sample;
+    }
+    stats.mean = sum / static_cast<double>(n);
+    if(n > 1 && stats.mean > 0.0)
+    {
+        double squaredDeviations = 0.0;
+        for(double sample : samples)
+        {
+            squaredDeviations += (sample - stats.mean) * (sample - stats.mean);
+        }
+        stats.cvPercent = 100.0 * std::sqrt(squaredDeviations / static_cast<double>(n - 1)) / stats.mean;
+    }
+    return stats;
+}
+
+// Counters of the malloc family interposer in hashmap_benchmark.cpp, which sees every heap allocation of the process:
+// operator new, the containers' pool pages and bucket tables, and the third party maps alike.
+// - Allocations and frees are always counted, into striped counters so the timed runs do not contend on them
+// - Live and peak bytes are only tracked between BeginPeakTracking() and EndPeakTracking(), an untimed phase such as the preload
+struct HeapHookState
+{
+    PklE::Util::StripedCounter<64> numAllocations;
+    PklE::Util::StripedCounter<64> numFrees;
+    std::atomic<bool> bTrackBytes{false};
+    std::atomic<int64_t> liveBytes{0};
+    std::atomic<int64_t> peakBytes{0};
+    std::atomic<int64_t> baselineBytes{0};
+};
+
+// Constant initialized, the interposer may run before any dynamic initializer
+inline constinit HeapHookState s_heapHookState;
+
+inline void CountHeapAllocation(void* pBlock)
+{
+    if(pBlock == nullptr)
+    {
+        return;
+    }
+    s_heapHookState.numAllocations.Increment();
+    if(s_heapHookState.bTrackBytes.load(std::memory_order_relaxed))
+    {
+        const int64_t blockBytes = static_cast<int64_t>(malloc_usable_size(pBlock));
+        const int64_t liveBytes = s_heapHookState.liveBytes.fetch_add(blockBytes, std::memory_order_relaxed) + blockBytes;
+        int64_t peakBytes = s_heapHookState.peakBytes.load(std::memory_order_relaxed);
+        while(liveBytes > peakBytes && !s_heapHookState.peakBytes.compare_exchange_weak(peakBytes, liveBytes, std::memory_order_relaxed))
+        {
+        }
+    }
+}
+
+inline void CountHeapFree(void* pBlock)
+{
+    if(pBlock == nullptr)
+    {
+        return;
+    }
+    s_heapHookState.numFrees.Increment();
+    if(s_heapHookState.bTrackBytes.load(std::memory_order_relaxed))
+    {
+        s_heapHookState.liveBytes.fetch_sub(static_cast<int64_t>(malloc_usable_size(pBlock)), std::memory_order_relaxed);
+    }
+}
+
+struct HeapAllocationCounts
+{
+    uint64_t numAllocations = 0;
+    uint64_t numFrees = 0;
+};
+
+inline HeapAllocationCounts GetHeapAllocationCounts()
+{
+    HeapAllocationCounts counts;
+    counts.numAllocations = static_cast<uint64_t>(s_heapHookState.numAllocations.Read());
+    counts.numFrees = static_cast<uint64_t>(s_heapHookState.numFrees.Read());
+    return counts;
+}
+
+// Bytes the allocator has handed out and not got back, from mallinfo2(): arena chunks in use plus mmapped chunks
+inline uint64_t GetAllocatorInUseBytes()
+{
+    const struct mallinfo2 info = mallinfo2();
+    return static_cast<uint64_t>(info.uordblks) + static_cast<uint64_t>(info.hblkhd);
+}
+
+// Live bytes start from the allocator's in use bytes, so frees of blocks allocated before tracking began
+// lower them from there instead of below zero. The peak is reported relative to that baseline.
+inline void BeginPeakTracking()
+{
+    const int64_t baselineBytes = static_cast<int64_t>(GetAllocatorInUseBytes());
+    s_heapHookState.baselineBytes.store(baselineBytes, std::memory_order_relaxed);
+    s_heapHookState.liveBytes.store(baselineBytes, std::memory_order_relaxed);
+    s_heapHookState.peakBytes.store(baselineBytes, std::memory_order_relaxed);
+    s_heapHookState.bTrackBytes.store(true, std::memory_order_release);
+}
+
+inline uint64_t EndPeakTracking()
+{
+    s_heapHookState.bTrackBytes.store(false, std::memory_order_release);
+    return static_cast<uint64_t>(std::max<int64_t>(0, s_heapHookState.peakBytes.load(std::memory_order_relaxed) -
+                                                      s_heapHookState.baselineBytes.load(std::memory_order_relaxed)));
+}
+
+// Memory a map holds after the setup of a benchmark, see HashmapBenchmarkTest::MeasureMapFootprint
+struct MapFootprint
+{
+    uint64_t numEntries = 0; // 0 when the setup left nothing to measure
+    double allocatedBytesPerEntry = 0.0;
+    double rssBytesPerEntry = 0.0;
+    uint64_t peakSetupBytes = 0; // Highest heap growth during the setup, includes the transient memory of resizes
+
+    // Set while the setup left the map empty (insert workloads): the first pass run with this footprint fills it in
+    // from the map that pass left behind, see HashmapBenchmarkTest::RunPass
+    uint64_t (*pCountEntries)(void* pMap) = nullptr;
+    void* pMap = nullptr;
+
+    bool IsPending() const { return pCountEntries != nullptr; }
+};
+
+struct HashmapBenchmarkResult;
+
+// Adds a printed result to the machine readable output, see BenchmarkRecord
+void LogBenchmarkResult(const HashmapBenchmarkResult& result);
+
 // Benchmark result structure
 struct HashmapBenchmarkResult
 {
-    const char* testName;
-    uint64_t durationNs;
-    uint64_t operationCount;
-    double opsPerSecond;
-    double avgLatencyNs;
-    uint32_t threadCount;
-    const char* operationType;
+    const char* testName;
+    uint64_t durationNs;
+    uint64_t operationCount;
+    double opsPerSecond;
+    double avgLatencyNs;
+    uint32_t threadCount;
+    const char* operationType;
+    const char* placement = "none"; // ThreadPlacement of the benchmark threads
+
+    // Repeated mode only (numRepetitions > 0): opsPerSecond is the median of the repetitions
+    uint32_t numRepetitions = 0;
+    double ciLowOpsPerSecond = 0.0;
+    double ciHighOpsPerSecond = 0.0;
+    double cvPercent = 0.0;
+    bool bUnstable = false;
+
+    // Per operation latency percentiles, only valid when numLatencySamples > 0
+    uint64_t numLatencySamples = 0;
+    uint64_t p50LatencyNs = 0;
+    uint64_t p90LatencyNs = 0;
+    uint64_t p99LatencyNs = 0;
+    uint64_t p999LatencyNs = 0;
+    uint64_t maxLatencyNs = 0;
+
+    // Memory footprint of the map, only valid when footprintEntries > 0
+    uint64_t footprintEntries = 0;
+    double allocatedBytesPerEntry = 0.0;
+    double rssBytesPerEntry = 0.0;
+    uint64_t peakSetupBytes = 0;
+
+    // Heap allocations and frees per operation during the timed runs, pool and task bookkeeping included
+    double allocationsPerOp = 0.0;
+    double freesPerOp = 0.0;
+
+    // Hardware events per operation (PKLE_BENCH_PERF_COUNTERS=1), event i is only valid when bit i of perfEventMask is set
+    uint32_t perfEventMask = 0;
+    double perfEventsPerOp[c_numPerfEvents] = {};
+
+    void SetRepetitions(uint32_t numRepetitions_, const RepetitionStatistics& stats, double maxStableCvPercent)
+    {
+        numRepetitions = numRepetitions_;
+        opsPerSecond = stats.median;
+        avgLatencyNs = (stats.median > 0.0) ? (1e9 / stats.median) : 0.0;
+        ciLowOpsPerSecond = stats.ciLow;
+        ciHighOpsPerSecond = stats.ciHigh;
+        cvPercent = stats.cvPercent;
+        bUnstable = stats.cvPercent > maxStableCvPercent;
+    }
+
+    void SetLatencies(const LatencyHistogram& histogram)
+    {
+        numLatencySamples = histogram.GetNumSamples();
+        p50LatencyNs = histogram.GetValueAtPercentile(50.0);
+        p90LatencyNs = histogram.GetValueAtPercentile(90.0);
+        p99LatencyNs = histogram.GetValueAtPercentile(99.0);
+        p999LatencyNs = histogram.GetValueAtPercentile(99.9);
+        maxLatencyNs = histogram.GetMaxNs();
+    }
+
+    void SetFootprint(const MapFootprint& footprint)
+    {
+        footprintEntries = footprint.numEntries;
+        allocatedBytesPerEntry = footprint.allocatedBytesPerEntry;
+        rssBytesPerEntry = footprint.rssBytesPerEntry;
+        peakSetupBytes = footprint.peakSetupBytes;
+    }
+
+    void SetPerfCounters(const PerfCounterTotals& totals)
+    {
+        perfEventMask = (operationCount > 0) ? totals.validEventMask : 0;
+        for(uint32_t event = 0; event < c_numPerfEvents; ++event)
+        {
+            perfEventsPerOp[event] = (operationCount > 0) ? totals.counts[event] / static_cast<double>(operationCount) : 0.0;
+        }
+    }
+
+    double GetPerfEventsPerOp(PerfEvent event) const
+    {
+        return (perfEventMask & (1u << static_cast<uint32_t>(event))) ? perfEventsPerOp[static_cast<uint32_t>(event)] : 0.0;
+    }
+
+    void SetAllocationCounts(const HeapAllocationCounts& before, const HeapAllocationCounts& after)
+    {
+        if(operationCount > 0)
+        {
+            allocationsPerOp = static_cast<double>(after.numAllocations - before.numAllocations) / static_cast<double>(operationCount);
+            freesPerOp = static_cast<double>(after.numFrees - before.numFrees) / static_cast<double>(operationCount);
+        }
+    }
+
+    void Print() const
+    {
+        printf("%-70s [%2d threads, %s] [%s]: %10llu ns, %10llu ops, %12.2f ops/sec, %.2f ns/op",
+               testName,
+               threadCount,
+               placement,
+               operationType,
+               (unsigned long long)durationNs,
+               (unsigned long long)operationCount,
+               opsPerSecond,
+               avgLatencyNs);
+        if(numRepetitions > 0)
+        {
+            printf(", median of %u reps, 95%% CI [%.2f, %.2f] ops/sec, CV %.2f%%%s",
+                   numRepetitions,
+                   ciLowOpsPerSecond,
+                   ciHighOpsPerSecond,
+                   cvPercent,
+                   bUnstable ? " UNSTABLE" : "");
+        }
+        if(numLatencySamples > 0)
+        {
+            printf(", p50 %llu ns, p90 %llu ns, p99 %llu ns, p99.9 %llu ns, max %llu ns (%llu samples)",
+                   (unsigned long long)p50LatencyNs,
+                   (unsigned long long)p90LatencyNs,
+                   (unsigned long long)p99LatencyNs,
+                   (unsigned long long)p999LatencyNs,
+                   (unsigned long long)maxLatencyNs,
+                   (unsigned long long)numLatencySamples);
+        }
+        for(uint32_t event = 0; event < c_numPerfEvents; ++event)
+        {
+            if(perfEventMask & (1u << event))
+            {
+                printf(", %.2f %s/op", perfEventsPerOp[event], GetPerfEventName(static_cast<PerfEvent>(event)));
+            }
+        }
+        printf(", %.3f allocs/op, %.3f frees/op", allocationsPerOp, freesPerOp);
+        if(footprintEntries > 0)
+        {
+            printf(", %.1f B/entry allocated, %.1f B/entry RSS, peak %llu B during setup (%llu entries)",
+                   allocatedBytesPerEntry,
+                   rssBytesPerEntry,
+                   (unsigned long long)peakSetupBytes,
+                   (unsigned long long)footprintEntries);
+        }
+        printf("\n");
+        LogBenchmarkResult(*this);
+    }
+};
+
+// Key generation strategy
+class KeyGenerator
+{
+inline static constexpr uint64_t MAX_RNG_KEY_NUMBER = 120000;
+
+// Precomputed samples of the skewed key distributions over [0, MAX_RNG_KEY_NUMBER), so a skewed key costs one load.
+// - Zipfian: key k is drawn with probability proportional to 1 / (k + 1)^exponent (PKLE_BENCH_ZIPF_EXPONENT, default 0.99)
+// - Scrambled Zipfian: the same popularity spread over a fixed random permutation of the keys, hot keys are not adjacent
+// - Hot set: PKLE_BENCH_HOT_OPS_PERCENT (default 90) of the draws hit the first PKLE_BENCH_HOT_KEYS_PERCENT (default 10) of the keys
+struct SkewedKeySamples
+{
+    static constexpr uint32_t c_numSamples = 1u << 18;
+    static constexpr uint32_t c_sampleMask = c_numSamples - 1;
+
+    std::vector<uint32_t> zipfian;
+    std::vector<uint32_t> scrambledZipfian;
+    std::vector<uint32_t> hotSet;
+    uint32_t numHotKeys = 1;
+
+    SkewedKeySamples()
+    {
+        const double exponent = GetBenchmarkSettingDouble("PKLE_BENCH_ZIPF_EXPONENT", 0.99);
+        const double hotOpsFraction = static_cast<double>(std::min<uint64_t>(100, GetBenchmarkSettingU64("PKLE_BENCH_HOT_OPS_PERCENT", 90))) / 100.0;
+        const uint64_t hotKeysPercent = std::clamp<uint64_t>(GetBenchmarkSettingU64("PKLE_BENCH_HOT_KEYS_PERCENT", 10), 1, 100);
+        numHotKeys = static_cast<uint32_t>(std::max<uint64_t>(1, (MAX_RNG_KEY_NUMBER * hotKeysPercent) / 100));
+
+        std::mt19937_64 rng(0x5eed5eed);
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+        std::vector<double> cumulativeWeights(MAX_RNG_KEY_NUMBER);
+        double totalWeight = 0.0;
+        for(uint64_t key = 0; key < MAX_RNG_KEY_NUMBER; ++key)
+        {
+            totalWeight += std::pow(static_cast<double>(key + 1), -exponent);
+            cumulativeWeights[key] = totalWeight;
+        }
+        std::vector<uint32_t> permutation(MAX_RNG_KEY_NUMBER);
+        for(uint32_t key = 0; key < MAX_RNG_KEY_NUMBER; ++key)
+        {
+            permutation[key] = key;
+        }
+        std::shuffle(permutation.begin(), permutation.end(), rng);
+
+        zipfian.resize(c_numSamples);
+        scrambledZipfian.resize(c_numSamples);
+        hotSet.resize(c_numSamples);
+        const uint64_t numColdKeys = MAX_RNG_KEY_NUMBER - numHotKeys;
+        for(uint32_t i = 0; i < c_numSamples; ++i)
+        {
+            const double target = uniform(rng) * totalWeight;
+            const uint64_t key = std::min<uint64_t>(MAX_RNG_KEY_NUMBER - 1,
+                std::lower_bound(cumulativeWeights.begin(), cumulativeWeights.end(), target) - cumulativeWeights.begin());
+            zipfian[i] = static_cast<uint32_t>(key);
+            scrambledZipfian[i] = permutation[key];
+
+            const bool bHot = (numColdKeys == 0) || (uniform(rng) < hotOpsFraction);
+            hotSet[i] = static_cast<uint32_t>(bHot ? (rng() % numHotKeys) : (numHotKeys + (rng() % numColdKeys)));
+        }
+    }
+};
+
+// Built during static initialization, so the first timed run does not pay for it
+inline static const SkewedKeySamples s_skewedKeySamples;
+
+public:
+    // Size of the key range the Random and skewed generators draw from
+    static constexpr uint64_t KEY_RANGE = MAX_RNG_KEY_NUMBER;
+
+    // Operations between moves of the MovingHotSpot hot set
+    static constexpr uint32_t HOT_SPOT_PHASE_OPERATIONS = 10000;
+
+    // Sequential keys (good for cache, predictable)
+    static uint64_t Sequential(uint32_t threadId, uint32_t iteration, uint32_t totalThreads)
+    {
+        return threadId * 1000000ULL + iteration;
+    }
+
+    // Random keys (realistic workload)
+    static uint64_t Random(uint32_t threadId, uint32_t iteration, uint32_t totalThreads)
+    {
+        // Use thread-local random generator
+        static thread_local std::mt19937_64 rng(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+        return rng() % MAX_RNG_KEY_NUMBER;
+    }
+
+    // Contended keys (high collision scenario)
+    static uint64_t Contended(uint32_t threadId, uint32_t iteration, uint32_t totalThreads)
+    {
+        // Map to a smaller key space to create contention
+        return iteration % 100;
+    }
+
+    // Strided keys (spread across threads)
+    static uint64_t Strided(uint32_t threadId, uint32_t iteration, uint32_t totalThreads)
+    {
+        return threadId + (iteration * totalThreads);
+    }
+
+    // Name of the first key generator that appears in a test label, "" if none does
+    static const char* FindKeyGenName(const char* pLabel)
+    {
+        //ScrambledZipfian before Zipfian, which it contains
+        for(const char* pName : {"Sequential", "Random", "Contended", "Strided", "ScrambledZipfian", "Zipfian", "HotSet", "MovingHotSpot", "Latest"})
+        {
+            if(strstr(pLabel, pName) != nullptr)
+            {
+                return pName;
+            }
+        }
+        return "";
+    }
+
+    // The skewed generators pick their precomputed sample by iteration, so an operation index maps to the same key
+    // in every run and in the preload.
+
+    // Zipfian popularity, the hottest keys are 0, 1, 2...
+    static uint64_t Zipfian(uint32_t threadId, uint32_t iteration, uint32_t totalThreads)
+    {
+        return s_skewedKeySamples.zipfian[iteration & SkewedKeySamples::c_sampleMask];
+    }
+
+    // Zipfian popularity with the hot keys scattered over the key space
+    static uint64_t ScrambledZipfian(uint32_t threadId, uint32_t iteration, uint32_t totalThreads)
+    {
+        return s_skewedKeySamples.scrambledZipfian[iteration & SkewedKeySamples::c_sampleMask];
+    }
+
+    // Most operations on a small fixed set of keys
+    static uint64_t HotSet(uint32_t threadId, uint32_t iteration, uint32_t totalThreads)
+    {
+        return s_skewedKeySamples.hotSet[iteration & SkewedKeySamples::c_sampleMask];
+    }
+
+    // HotSet whose hot keys shift to the next range every HOT_SPOT_PHASE_OPERATIONS operations
+    static uint64_t MovingHotSpot(uint32_t threadId, uint32_t iteration, uint32_t totalThreads)
+    {
+        const uint64_t offset = static_cast<uint64_t>(iteration / HOT_SPOT_PHASE_OPERATIONS) * s_skewedKeySamples.numHotKeys;
+        return (s_skewedKeySamples.hotSet[iteration & SkewedKeySamples::c_sampleMask] + offset) % MAX_RNG_KEY_NUMBER;
+    }
+
+    template<typename FuncType>
+    static const char* GetKeyGenName(const FuncType& func)
+    {
+        if (func == Sequential)
+            return "Sequential";
+        else if (func == Random)
+            return "Random";
+        else if (func == Contended)
+            return "Contended";
+        else if (func == Strided)
+            return "Strided";
+        else if (func == Zipfian)
+            return "Zipfian";
+        else if (func == ScrambledZipfian)
+            return "ScrambledZipfian";
+        else if (func == HotSet)
+            return "HotSet";
+        else if (func == MovingHotSpot)
+            return "MovingHotSpot";
+        return "Unknown";
+    }
+
+};
+
+// Machine the results were measured on, repeated in every record so a row stands on its own
+struct BenchmarkHostInfo
+{
+    std::string cpuModel;
+    uint32_t hardwareThreads = 0;
+    std::string compiler;
+    std::string kernel;
+};
+
+inline const BenchmarkHostInfo& GetBenchmarkHostInfo()
+{
+    static const BenchmarkHostInfo s_hostInfo = []()
+    {
+        BenchmarkHostInfo hostInfo;
+        hostInfo.hardwareThreads = std::thread::hardware_concurrency();
+        hostInfo.compiler = __VERSION__;
+
+        FILE* pCpuInfo = fopen("/proc/cpuinfo", "r");
+        if(pCpuInfo)
+        {
+            char line[512];
+            while(fgets(line, sizeof(line), pCpuInfo))
+            {
+                const char* pSeparator = strchr(line, ':');
+                if(strncmp(line, "model name", 10) == 0 && pSeparator != nullptr)
+                {
+                    hostInfo.cpuModel = pSeparator + 1;
+                    break;
+                }
+            }
+            fclose(pCpuInfo);
+        }
+
+        utsname systemName;
+        if(uname(&systemName) == 0)
+        {
+            hostInfo.kernel = std::string(systemName.sysname) + " " + systemName.release;
+        }
+
+        auto trim = [](std::string& value)
+        {
+            const size_t first = value.find_first_not_of(" \t\n");
+            const size_t last = value.find_last_not_of(" \t\n");
+            value = (first == std::string::npos) ? std::string() : value.substr(first, last - first + 1);
+        };
+        trim(hostInfo.cpuModel);
+        trim(hostInfo.compiler);
+        return hostInfo;
+    }();
+    return s_hostInfo;
+}
+
+// One result row of the machine readable output (PKLE_BENCH_OUTPUT, JSON or CSV by file extension).
+// Map type, key pattern and value size come from the "<MapType>_<label>" test name convention: the label names
+// the KeyGenerator and ends in "BigValue" for the large value type. The workload is the result's operation type.
+struct BenchmarkRecord
+{
+    std::string testName;
+    std::string mapType;
+    std::string workload;
+    std::string keyPattern;
+    std::string valueSize;
+    uint32_t threads = 0;
+    std::string placement = "none"; // Rows of older files without the field ran unpinned
+    uint64_t durationNs = 0;
+    uint64_t operations = 0;
+    double opsPerSecond = 0.0;
+    double nsPerOp = 0.0;
+    uint32_t repetitions = 0;
+    double ciLowOpsPerSecond = 0.0;
+    double ciHighOpsPerSecond = 0.0;
+    double cvPercent = 0.0;
+    bool bUnstable = false;
+    uint64_t latencySamples = 0;
+    uint64_t p50Ns = 0;
+    uint64_t p90Ns = 0;
+    uint64_t p99Ns = 0;
+    uint64_t p999Ns = 0;
+    uint64_t maxNs = 0;
+    double allocationsPerOp = 0.0;
+    double freesPerOp = 0.0;
+    uint64_t footprintEntries = 0;
+    double allocatedBytesPerEntry = 0.0;
+    double rssBytesPerEntry = 0.0;
+    uint64_t peakSetupBytes = 0;
+    double cyclesPerOp = 0.0; // Hardware events per operation, 0 when they were not collected
+    double instructionsPerOp = 0.0;
+    double l1dMissesPerOp = 0.0;
+    double llcMissesPerOp = 0.0;
+    double dtlbMissesPerOp = 0.0;
+    double branchMissesPerOp = 0.0;
+    std::string cpuModel;
+    uint32_t hardwareThreads = 0;
+    std::string compiler;
+    std::string kernel;
+
+    // visitor(fieldName, field) for every field, in output order. Shared by the writers and the parser
+    template<typename Self_T, typename Visitor_T>
+    static void VisitFields(Self_T& record, Visitor_T&& visitor)
+    {
+        visitor("testName", record.testName);
+        visitor("mapType", record.mapType);
+        visitor("workload", record.workload);
+        visitor("keyPattern", record.keyPattern);
+        visitor("valueSize", record.valueSize);
+        visitor("threads", record.threads);
+        visitor("placement", record.placement);
+        visitor("durationNs", record.durationNs);
+        visitor("operations", record.operations);
+        visitor("opsPerSecond", record.opsPerSecond);
+        visitor("nsPerOp", record.nsPerOp);
+        visitor("repetitions", record.repetitions);
+        visitor("ciLowOpsPerSecond", record.ciLowOpsPerSecond);
+        visitor("ciHighOpsPerSecond", record.ciHighOpsPerSecond);
+        visitor("cvPercent", record.cvPercent);
+        visitor("unstable", record.bUnstable);
+        visitor("latencySamples", record.latencySamples);
+        visitor("p50Ns", record.p50Ns);
+        visitor("p90Ns", record.p90Ns);
+        visitor("p99Ns", record.p99Ns);
+        visitor("p999Ns", record.p999Ns);
+        visitor("maxNs", record.maxNs);
+        visitor("allocationsPerOp", record.allocationsPerOp);
+        visitor("freesPerOp", record.freesPerOp);
+        visitor("footprintEntries", record.footprintEntries);
+        visitor("allocatedBytesPerEntry", record.allocatedBytesPerEntry);
+        visitor("rssBytesPerEntry", record.rssBytesPerEntry);
+        visitor("peakSetupBytes", record.peakSetupBytes);
+        visitor("cyclesPerOp", record.cyclesPerOp);
+        visitor("instructionsPerOp", record.instructionsPerOp);
+        visitor("l1dMissesPerOp", record.l1dMissesPerOp);
+        visitor("llcMissesPerOp", record.llcMissesPerOp);
+        visitor("dtlbMissesPerOp", record.dtlbMissesPerOp);
+        visitor("branchMissesPerOp", record.branchMissesPerOp);
+        visitor("cpuModel", record.cpuModel);
+        visitor("hardwareThreads", record.hardwareThreads);
+        visitor("compiler", record.compiler);
+        visitor("kernel", record.kernel);
+    }
+
+    static BenchmarkRecord FromResult(const HashmapBenchmarkResult& result)
+    {
+        BenchmarkRecord record;
+        record.testName = result.testName;
+        record.workload = result.operationType;
+        const size_t separator = record.testName.find('_');
+        record.mapType = record.testName.substr(0, separator);
+        const std::string label = (separator == std::string::npos) ? std::string() : record.testName.substr(separator + 1);
+        record.keyPattern = KeyGenerator::FindKeyGenName(label.c_str());
+        record.valueSize = (label.find("BigValue") != std::string::npos) ? "big" : "small";
+        record.threads = result.threadCount;
+        record.placement = result.placement;
+        record.durationNs = result.durationNs;
+        record.operations = result.operationCount;
+        record.opsPerSecond = result.opsPerSecond;
+        record.nsPerOp = result.avgLatencyNs;
+        record.repetitions = result.numRepetitions;
+        record.ciLowOpsPerSecond = result.ciLowOpsPerSecond;
+        record.ciHighOpsPerSecond = result.ciHighOpsPerSecond;
+        record.cvPercent = result.cvPercent;
+        record.bUnstable = result.bUnstable;
+        record.latencySamples = result.numLatencySamples;
+        record.p50Ns = result.p50LatencyNs;
+        record.p90Ns = result.p90LatencyNs;
+        record.p99Ns = result.p99LatencyNs;
+        record.p999Ns = result.p999LatencyNs;
+        record.maxNs = result.maxLatencyNs;
+        record.allocationsPerOp = result.allocationsPerOp;
+        record.freesPerOp = result.freesPerOp;
+        record.footprintEntries = result.footprintEntries;
+        record.allocatedBytesPerEntry = result.allocatedBytesPerEntry;
+        record.rssBytesPerEntry = result.rssBytesPerEntry;
+        record.peakSetupBytes = result.peakSetupBytes;
+        record.cyclesPerOp = result.GetPerfEventsPerOp(PerfEvent::Cycles);
+        record.instructionsPerOp = result.GetPerfEventsPerOp(PerfEvent::Instructions);
+        record.l1dMissesPerOp = result.GetPerfEventsPerOp(PerfEvent::L1dMisses);
+        record.llcMissesPerOp = result.GetPerfEventsPerOp(PerfEvent::LlcMisses);
+        record.dtlbMissesPerOp = result.GetPerfEventsPerOp(PerfEvent::DtlbMisses);
+        record.branchMissesPerOp = result.GetPerfEventsPerOp(PerfEvent::BranchMisses);
+        const BenchmarkHostInfo& hostInfo = GetBenchmarkHostInfo();
+        record.cpuModel = hostInfo.cpuModel;
+        record.hardwareThreads = hostInfo.hardwareThreads;
+        record.compiler = hostInfo.compiler;
+        record.kernel = hostInfo.kernel;
+        return record;
+    }
+
+    // Rows match across runs by test name, workload, thread count and placement
+    std::string GetRowKey() const
+    {
+        return testName + "|" + workload + "|" + std::to_string(threads) + "|" + placement;
+    }
+};
+
+// Text form of one field value. CSV has no quoting, separators inside strings become spaces
+template<typename Field_T>
+std::string FormatBenchmarkField(const Field_T& field, bool bJson)
+{
+    if constexpr (std::is_same_v<Field_T, std::string>)
+    {
+        std::string text = bJson ? "\"" : "";
+        for(char c : field)
+        {
+            if(bJson && (c == '"' || c == '\\'))
+            {
+                text += '\\';
+            }
+            text += (!bJson && (c == ',' || c == '\n')) ? ' ' : c;
+        }
+        return bJson ? (text + "\"") : text;
+    }
+    else if constexpr (std::is_same_v<Field_T, bool>)
+    {
+        return field ? "true" : "false";
+    }
+    else if constexpr (std::is_floating_point_v<Field_T>)
+    {
+        char buffer[64];
+        snprintf(buffer, sizeof(buffer), "%.3f", field);
+        return buffer;
+    }
+    else
+    {
+        return std::to_string(field);
+    }
+}
+
+template<typename Field_T>
+void ParseBenchmarkField(const std::string& text, Field_T& outField)
+{
+    if constexpr (std::is_same_v<Field_T, std::string>)
+    {
+        outField = text;
+    }
+    else if constexpr (std::is_same_v<Field_T, bool>)
+    {
+        outField = (text == "true" || text == "1");
+    }
+    else if constexpr (std::is_floating_point_v<Field_T>)
+    {
+        outField = strtod(text.c_str(), nullptr);
+    }
+    else
+    {
+        outField = static_cast<Field_T>(strtoull(text.c_str(), nullptr, 10));
+    }
+}
+
+inline bool IsCsvBenchmarkFile(const std::string& path)
+{
+    return path.size() >= 4 && path.compare(path.size() - 4, 4, ".csv") == 0;
+}
+
+// Writes the records as {"results": [...]} with one flat object per line, or as CSV with a header row
+inline bool WriteBenchmarkRecords(const std::string& path, const std::vector<BenchmarkRecord>& records)
+{
+    FILE* pFile = fopen(path.c_str(), "w");
+    if(pFile == nullptr)
+    {
+        return false;
+    }
+    const bool bCsv = IsCsvBenchmarkFile(path);
+    if(bCsv)
+    {
+        std::string header;
+        const BenchmarkRecord headerRecord;
+        BenchmarkRecord::VisitFields(headerRecord, [&header](const char* pName, const auto&)
+        {
+            header += header.empty() ? "" : ",";
+            header += pName;
+        });
+        fprintf(pFile, "%s\n", header.c_str());
+    }
+    else
+    {
+        fprintf(pFile, "{\n  \"results\": [\n");
+    }
+
+    for(size_t i = 0; i < records.size(); ++i)
+    {
+        std::string row;
+        BenchmarkRecord::VisitFields(records[i], [&row, bCsv](const char* pName, const auto& field)
+        {
+            if(bCsv)
+            {
+                row += row.empty() ? "" : ",";
+            }
+            else
+            {
+                row += row.empty() ? "{" : ", ";
+                row += std::string("\"") + pName + "\": ";
+            }
+            row += FormatBenchmarkField(field, !bCsv);
+        });
+        if(bCsv)
+        {
+            fprintf(pFile, "%s\n", row.c_str());
+        }
+        else
+        {
+            fprintf(pFile, "    %s}%s\n", row.c_str(), (i + 1 < records.size()) ? "," : "");
+        }
+    }
+
+    if(!bCsv)
+    {
+        fprintf(pFile, "  ]\n}\n");
+    }
+    fclose(pFile);
+    return true;
+}
+
+// Flat JSON objects ("key": string/number/bool) anywhere in text. Objects holding arrays or objects are skipped,
+// their flat children are still found. Enough for the files WriteBenchmarkRecords produces.
+inline std::vector<std::map<std::string, std::string>> ParseFlatJsonObjects(const std::string& text)
+{
+    std::vector<std::map<std::string, std::string>> objects;
+    size_t pos = 0;
+
+    auto skipSpace = [&text](size_t& cursor)
+    {
+        while(cursor < text.size() && isspace(static_cast<unsigned char>(text[cursor])))
+        {
+            ++cursor;
+        }
+    };
+    auto parseString = [&text](size_t& cursor, std::string& outString)
+    {
+        if(cursor >= text.size() || text[cursor] != '"')
+        {
+            return false;
+        }
+        outString.clear();
+        for(++cursor; cursor < text.size() && text[cursor] != '"'; ++cursor)
+        {
+            if(text[cursor] == '\\' && cursor + 1 < text.size())
+            {
+                ++cursor;
+            }
+            outString += text[cursor];
+        }
+        return cursor++ < text.size();
+    };
+
+    while((pos = text.find('{', pos)) != std::string::npos)
+    {
+        size_t cursor = pos + 1;
+        std::map<std::string, std::string> object;
+        bool bFlat = true;
+        skipSpace(cursor);
+        while(cursor < text.size() && text[cursor] != '}')
+        {
+            std::string key;
+            std::string value;
+            skipSpace(cursor);
+            if(!parseString(cursor, key))
+            {
+                bFlat = false;
+                break;
+            }
+            skipSpace(cursor);
+            if(cursor >= text.size() || text[cursor++] != ':')
+            {
+                bFlat = false;
+                break;
+            }
+            skipSpace(cursor);
+            if(cursor < text.size() && text[cursor] == '"')
+            {
+                parseString(cursor, value);
+            }
+            else
+            {
+                const size_t valueEnd = text.find_first_of(",}{[", cursor);
+                if(valueEnd == std::string::npos || text[valueEnd] == '{' || text[valueEnd] == '[')
+                {
+                    bFlat = false;
+                    break;
+                }
+                value = text.substr(cursor, valueEnd - cursor);
+                while(!value.empty() && isspace(static_cast<unsigned char>(value.back())))
+                {
+                    value.pop_back();
+                }
+                cursor = valueEnd;
+            }
+            object[key] = value;
+            skipSpace(cursor);
+            if(cursor < text.size() && text[cursor] == ',')
+            {
+                ++cursor;
+                skipSpace(cursor);
+            }
+        }
+        if(bFlat && cursor < text.size())
+        {
+            objects.push_back(std::move(object));
+            pos = cursor + 1;
+        }
+        else
+        {
+            ++pos;
+        }
+    }
+    return objects;
+}
+
+// Loads a file written by WriteBenchmarkRecords, empty if it cannot be read
+inline std::vector<BenchmarkRecord> ReadBenchmarkRecords(const std::string& path)
+{
+    std::vector<BenchmarkRecord> records;
+    FILE* pFile = fopen(path.c_str(), "r");
+    if(pFile == nullptr)
+    {
+        return records;
+    }
+    std::string text;
+    char buffer[4096];
+    size_t numRead = 0;
+    while((numRead = fread(buffer, 1, sizeof(buffer), pFile)) > 0)
+    {
+        text.append(buffer, numRead);
+    }
+    fclose(pFile);
+
+    std::vector<std::map<std::string, std::string>> rows;
+    if(IsCsvBenchmarkFile(path))
+    {
+        auto split = [](const std::string& line)
+        {
+            std::vector<std::string> cells;
+            size_t cellBegin = 0;
+            for(size_t comma; (comma = line.find(',', cellBegin)) != std::string::npos; cellBegin = comma + 1)
+            {
+                cells.push_back(line.substr(cellBegin, comma - cellBegin));
+            }
+            cells.push_back(line.substr(cellBegin));
+            return cells;
+        };
+        std::vector<std::string> header;
+        size_t lineBegin = 0;
+        while(lineBegin < text.size())
+        {
+            size_t lineEnd = text.find('\n', lineBegin);
+            lineEnd = (lineEnd == std::string::npos) ? text.size() : lineEnd;
+            const std::vector<std::string> cells = split(text.substr(lineBegin, lineEnd - lineBegin));
+            lineBegin = lineEnd + 1;
+            if(header.empty())
+            {
+                header = cells;
+                continue;
+            }
+            std::map<std::string, std::string> row;
+            for(size_t i = 0; i < cells.size() && i < header.size(); ++i)
+            {
+                row[header[i]] = cells[i];
+            }
+            rows.push_back(std::move(row));
+        }
+    }
+    else
+    {
+        rows = ParseFlatJsonObjects(text);
+    }
+
+    for(const std::map<std::string, std::string>& row : rows)
+    {
+        if(row.find("testName") == row.end())
+        {
+            continue;
+        }
+        BenchmarkRecord record;
+        BenchmarkRecord::VisitFields(record, [&row](const char* pName, auto& field)
+        {
+            auto it = row.find(pName);
+            if(it != row.end())
+            {
+                ParseBenchmarkField(it->second, field);
+            }
+        });
+        records.push_back(std::move(record));
+    }
+    return records;
+}
+
+enum class BenchmarkChange
+{
+    Unchanged,
+    Improvement,
+    Regression
+};
 
-    void Print() const
+// Throughput change of one row against its baseline. When both sides ran in the repeated mode the change is
+// significant if the 95% confidence intervals of the medians do not overlap, otherwise if it exceeds thresholdPercent.
+inline BenchmarkChange ClassifyBenchmarkChange(const BenchmarkRecord& baseline, const BenchmarkRecord& current, double thresholdPercent)
+{
+    if(baseline.repetitions > 0 && current.repetitions > 0)
     {
-        printf("%-70s [%2d threads] [%s]: %10llu ns, %10llu ops, %12.2f ops/sec, %.2f ns/op\n",
-               testName,
-               threadCount,
-               operationType,
-               (unsigned long long)durationNs,
-               (unsigned long long)operationCount,
-               opsPerSecond,
-               avgLatencyNs);
+        if(current.ciHighOpsPerSecond < baseline.ciLowOpsPerSecond)
+        {
+            return BenchmarkChange::Regression;
+        }
+        if(current.ciLowOpsPerSecond > baseline.ciHighOpsPerSecond)
+        {
+            return BenchmarkChange::Improvement;
+        }
+        return BenchmarkChange::Unchanged;
+    }
+    if(baseline.opsPerSecond <= 0.0)
+    {
+        return BenchmarkChange::Unchanged;
+    }
+    const double changePercent = 100.0 * (current.opsPerSecond - baseline.opsPerSecond) / baseline.opsPerSecond;
+    if(changePercent < -thresholdPercent)
+    {
+        return BenchmarkChange::Regression;
+    }
+    return (changePercent > thresholdPercent) ? BenchmarkChange::Improvement : BenchmarkChange::Unchanged;
+}
+
+// Prints every row of current that the baseline also has, returns the number of regressions
+inline uint32_t CompareBenchmarkRecords(const std::vector<BenchmarkRecord>& baseline, const std::vector<BenchmarkRecord>& current, double thresholdPercent)
+{
+    std::map<std::string, const BenchmarkRecord*> baselineRows;
+    for(const BenchmarkRecord& record : baseline)
+    {
+        baselineRows[record.GetRowKey()] = &record;
+    }
+    if(!baseline.empty() && !current.empty() && baseline.front().cpuModel != current.front().cpuModel)
+    {
+        printf("Baseline was measured on a different CPU: '%s' versus '%s'\n", baseline.front().cpuModel.c_str(), current.front().cpuModel.c_str());
+    }
+
+    uint32_t numCompared = 0;
+    uint32_t numRegressions = 0;
+    uint32_t numImprovements = 0;
+    for(const BenchmarkRecord& record : current)
+    {
+        auto it = baselineRows.find(record.GetRowKey());
+        if(it == baselineRows.end())
+        {
+            continue;
+        }
+        const BenchmarkRecord& baselineRecord = *it->second;
+        const BenchmarkChange change = ClassifyBenchmarkChange(baselineRecord, record, thresholdPercent);
+        const double changePercent = (baselineRecord.opsPerSecond > 0.0) ? (100.0 * (record.opsPerSecond - baselineRecord.opsPerSecond) / baselineRecord.opsPerSecond) : 0.0;
+        ++numCompared;
+        numRegressions += (change == BenchmarkChange::Regression) ? 1 : 0;
+        numImprovements += (change == BenchmarkChange::Improvement) ? 1 : 0;
+        printf("%-70s [%2u threads] [%s]: %12.2f -> %12.2f ops/sec (%+.1f%%)%s\n",
+               record.testName.c_str(),
+               record.threads,
+               record.workload.c_str(),
+               baselineRecord.opsPerSecond,
+               record.opsPerSecond,
+               changePercent,
+               (change == BenchmarkChange::Regression) ? " REGRESSION" : ((change == BenchmarkChange::Improvement) ? " IMPROVEMENT" : ""));
+    }
+    printf("Compared %u of %zu results against the baseline: %u regressions, %u improvements\n",
+           numCompared, current.size(), numRegressions, numImprovements);
+    return numRegressions;
+}
+
+// Every result printed by this process, written out and compared once all tests ran
+class BenchmarkResultLog
+{
+    std::mutex mutex;
+    std::vector<BenchmarkRecord> records;
+
+public:
+    static BenchmarkResultLog& Get()
+    {
+        static BenchmarkResultLog s_log;
+        return s_log;
+    }
+
+    void Add(BenchmarkRecord record)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        records.push_back(std::move(record));
+    }
+
+    std::vector<BenchmarkRecord> GetRecords()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return records;
     }
 };
 
-// Key generation strategy
-class KeyGenerator
+inline void LogBenchmarkResult(const HashmapBenchmarkResult& result)
 {
-inline static constexpr uint64_t MAX_RNG_KEY_NUMBER = 120000;
+    BenchmarkResultLog::Get().Add(BenchmarkRecord::FromResult(result));
+}
 
+// Writes PKLE_BENCH_OUTPUT and compares against PKLE_BENCH_BASELINE after the last test.
+// Regressions fail the run when PKLE_BENCH_FAIL_ON_REGRESSION is 1.
+class BenchmarkOutputEnvironment : public ::testing::Environment
+{
 public:
-    // Sequential keys (good for cache, predictable)
-    static uint64_t Sequential(uint32_t threadId, uint32_t iteration, uint32_t totalThreads)
+    void TearDown() override
     {
-        return threadId * 1000000ULL + iteration;
+        const std::vector<BenchmarkRecord> records = BenchmarkResultLog::Get().GetRecords();
+        if(const char* pOutputPath = GetBenchmarkSettingString("PKLE_BENCH_OUTPUT"))
+        {
+            if(WriteBenchmarkRecords(pOutputPath, records))
+            {
+                printf("Wrote %zu results to %s\n", records.size(), pOutputPath);
+            }
+            else
+            {
+                ADD_FAILURE() << "Could not write benchmark results to " << pOutputPath;
+            }
+        }
+
+        if(const char* pBaselinePath = GetBenchmarkSettingString("PKLE_BENCH_BASELINE"))
+        {
+            const std::vector<BenchmarkRecord> baseline = ReadBenchmarkRecords(pBaselinePath);
+            if(baseline.empty())
+            {
+                ADD_FAILURE() << "No benchmark results in baseline " << pBaselinePath;
+                return;
+            }
+            const double thresholdPercent = static_cast<double>(GetBenchmarkSettingU64("PKLE_BENCH_COMPARE_THRESHOLD_PERCENT", 10));
+            const uint32_t numRegressions = CompareBenchmarkRecords(baseline, records, thresholdPercent);
+            if(numRegressions > 0 && GetBenchmarkSettingU64("PKLE_BENCH_FAIL_ON_REGRESSION", 0) == 1)
+            {
+                ADD_FAILURE() << numRegressions << " benchmark regressions against " << pBaselinePath;
+            }
+        }
     }
+};
 
-    // Random keys (realistic workload)
-    static uint64_t Random(uint32_t threadId, uint32_t iteration, uint32_t totalThreads)
+// Fixed length string key for the string key benchmarks. The scrambled id is hex encoded up front,
+// so keys already differ within their first 8 bytes, then repeated to fill the length.
+inline std::string MakeFixedLengthStringKey(uint64_t id, uint32_t length)
+{
+    char idBuffer[17];
+    snprintf(idBuffer, sizeof(idBuffer), "%08x%08x", static_cast<uint32_t>(id * 2654435761ULL), static_cast<uint32_t>(id));
+
+    std::string key;
+    key.reserve(length);
+    while(key.size() < length)
     {
-        // Use thread-local random generator
-        static thread_local std::mt19937_64 rng(std::hash<std::thread::id>{}(std::this_thread::get_id()));
-        return rng() % MAX_RNG_KEY_NUMBER;
+        key.append(idBuffer, std::min<size_t>(16, length - key.size()));
     }
+    return key;
+}
 
-    // Contended keys (high collision scenario)
-    static uint64_t Contended(uint32_t threadId, uint32_t iteration, uint32_t totalThreads)
+template<typename KeyType>
+const char* GetStringKeyTypeName()
+{
+    return std::is_same_v<KeyType, PklE::ThreadsafeContainers::ArenaStringKey> ? "ArenaStringKey" : "StdStringKey";
+}
+
+// Resident set size of this process in bytes, from /proc/self/statm. 0 if it cannot be read
+inline uint64_t GetResidentSetBytes()
+{
+    uint64_t numTotalPages = 0;
+    uint64_t numResidentPages = 0;
+    FILE* pStatm = fopen("/proc/self/statm", "r");
+    if(pStatm)
     {
-        // Map to a smaller key space to create contention
-        return iteration % 100;
+        if(fscanf(pStatm, "%lu %lu", &numTotalPages, &numResidentPages) != 2)
+        {
+            numResidentPages = 0;
+        }
+        fclose(pStatm);
     }
+    return numResidentPages * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+}
 
-    // Strided keys (spread across threads)
-    static uint64_t Strided(uint32_t threadId, uint32_t iteration, uint32_t totalThreads)
+// MemAvailable from /proc/meminfo in bytes, 0 if it cannot be read
+inline uint64_t GetAvailableMemoryBytes()
+{
+    uint64_t availableKb = 0;
+    FILE* pMeminfo = fopen("/proc/meminfo", "r");
+    if(pMeminfo)
     {
-        return threadId + (iteration * totalThreads);
+        char line[256];
+        while(fgets(line, sizeof(line), pMeminfo))
+        {
+            if(sscanf(line, "MemAvailable: %lu kB", &availableKb) == 1)
+            {
+                break;
+            }
+        }
+        fclose(pMeminfo);
     }
+    return availableKb * 1024;
+}
 
-    template<typename FuncType>
-    static const char* GetKeyGenName(const FuncType& func)
+// Comma separated list of numbers from the environment, defaultValues if it is unset or has no numbers
+inline std::vector<uint64_t> GetBenchmarkSettingU64List(const char* name, std::vector<uint64_t> defaultValues)
+{
+    const char* pValue = GetBenchmarkSettingString(name);
+    if(pValue == nullptr)
     {
-        if (func == Sequential)
-            return "Sequential";
-        else if (func == Random)
-            return "Random";
-        else if (func == Contended)
-            return "Contended";
-        else if (func == Strided)
-            return "Strided";
-        return "Unknown";
+        return defaultValues;
+    }
+    std::vector<uint64_t> values;
+    while(*pValue != '\0')
+    {
+        char* pEnd = nullptr;
+        const unsigned long long value = strtoull(pValue, &pEnd, 10);
+        if(pEnd == pValue)
+        {
+            ++pValue;
+            continue;
+        }
+        values.push_back(static_cast<uint64_t>(value));
+        pValue = pEnd;
+    }
+    return values.empty() ? defaultValues : values;
+}
+
+struct TestValueStruct
+{
+    uint64_t data[4] = {0};
+    std::string info;
+    std::vector<uint8_t> blob;
+
+    TestValueStruct() = default;
+    TestValueStruct(uint64_t val)
+    {
+        data[0] = val;
+        info = "Value_" + std::to_string(val);
+        blob.resize(64, static_cast<uint8_t>(val % 256));
+    }
+};
+
+// Base class for hashmap benchmarks
+// ============================================================================
+// THREAD PLACEMENT
+// Benchmark threads are pinned to CPUs by a placement policy. The topology comes from sysfs and is limited to
+// the CPUs this process may run on. Thread counts beyond the CPUs of a placement wrap around (oversubscription).
+// ============================================================================
+
+enum class ThreadPlacement : uint32_t
+{
+    None,        // Not pinned, the OS scheduler decides
+    Compact,     // Fill one socket before the next, physical cores before their SMT siblings
+    Scatter,     // Round robin over the sockets, one thread per physical core before any SMT sibling
+    SmtSiblings, // All hardware threads of a core before the next core, threads share cores
+    OneSocket,   // Only the first socket's CPUs, physical cores before SMT siblings
+    Count
+};
+
+inline const char* GetThreadPlacementName(ThreadPlacement placement)
+{
+    static const char* const s_names[] = {"none", "compact", "scatter", "smt", "socket"};
+    return s_names[static_cast<uint32_t>(placement)];
+}
+
+struct BenchmarkCpu
+{
+    int cpu = 0;
+    int core = 0;
+    int socket = 0;
+    uint32_t smtRank = 0;  // Index among the hardware threads of its core
+    uint32_t coreRank = 0; // Index of its core within the socket
+};
+
+// CPUs in the affinity mask of the process when this is first called, with their core and socket
+inline const std::vector<BenchmarkCpu>& GetBenchmarkCpus()
+{
+    static const std::vector<BenchmarkCpu> s_cpus = []()
+    {
+        auto readTopologyValue = [](int cpu, const char* pName, int fallback)
+        {
+            char path[128];
+            snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/%s", cpu, pName);
+            int value = fallback;
+            FILE* pFile = fopen(path, "r");
+            if(pFile)
+            {
+                if(fscanf(pFile, "%d", &value) != 1)
+                {
+                    value = fallback;
+                }
+                fclose(pFile);
+            }
+            return value;
+        };
+
+        std::vector<BenchmarkCpu> cpus;
+        cpu_set_t mask;
+        CPU_ZERO(&mask);
+        if(sched_getaffinity(0, sizeof(mask), &mask) == 0)
+        {
+            for(int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+            {
+                if(CPU_ISSET(cpu, &mask))
+                {
+                    BenchmarkCpu entry;
+                    entry.cpu = cpu;
+                    entry.core = readTopologyValue(cpu, "core_id", cpu);
+                    entry.socket = readTopologyValue(cpu, "physical_package_id", 0);
+                    cpus.push_back(entry);
+                }
+            }
+        }
+
+        // Ranks in (socket, core, cpu) order
+        std::sort(cpus.begin(), cpus.end(), [](const BenchmarkCpu& lhs, const BenchmarkCpu& rhs)
+        {
+            return std::tie(lhs.socket, lhs.core, lhs.cpu) < std::tie(rhs.socket, rhs.core, rhs.cpu);
+        });
+        for(size_t i = 0; i < cpus.size(); ++i)
+        {
+            const bool bSameSocket = (i > 0) && (cpus[i - 1].socket == cpus[i].socket);
+            const bool bSameCore = bSameSocket && (cpus[i - 1].core == cpus[i].core);
+            cpus[i].smtRank = bSameCore ? cpus[i - 1].smtRank + 1 : 0;
+            cpus[i].coreRank = bSameCore ? cpus[i - 1].coreRank : (bSameSocket ? cpus[i - 1].coreRank + 1 : 0);
+        }
+        return cpus;
+    }();
+    return s_cpus;
+}
+
+// CPU of every benchmark thread under the placement, empty for ThreadPlacement::None or an unknown topology
+inline std::vector<int> GetPlacementCpus(ThreadPlacement placement, uint32_t numThreads)
+{
+    std::vector<BenchmarkCpu> order = GetBenchmarkCpus();
+    if(placement == ThreadPlacement::None || order.empty())
+    {
+        return {};
+    }
+
+    auto sortBy = [&order](auto&& keyOf)
+    {
+        std::sort(order.begin(), order.end(), [&keyOf](const BenchmarkCpu& lhs, const BenchmarkCpu& rhs)
+        {
+            return keyOf(lhs) < keyOf(rhs);
+        });
+    };
+    switch(placement)
+    {
+        case ThreadPlacement::Compact:
+            sortBy([](const BenchmarkCpu& cpu) { return std::make_tuple(cpu.socket, cpu.smtRank, cpu.coreRank); });
+            break;
+        case ThreadPlacement::Scatter:
+            sortBy([](const BenchmarkCpu& cpu) { return std::make_tuple(cpu.smtRank, cpu.coreRank, cpu.socket); });
+            break;
+        case ThreadPlacement::SmtSiblings:
+            sortBy([](const BenchmarkCpu& cpu) { return std::make_tuple(cpu.socket, cpu.coreRank, cpu.smtRank); });
+            break;
+        default:
+        {
+            const int firstSocket = order.front().socket;
+            order.erase(std::remove_if(order.begin(), order.end(), [firstSocket](const BenchmarkCpu& cpu) { return cpu.socket != firstSocket; }), order.end());
+            sortBy([](const BenchmarkCpu& cpu) { return std::make_tuple(cpu.smtRank, cpu.coreRank); });
+            break;
+        }
+    }
+
+    std::vector<int> cpus(numThreads);
+    for(uint32_t thread = 0; thread < numThreads; ++thread)
+    {
+        cpus[thread] = order[thread % order.size()].cpu;
+    }
+    return cpus;
+}
+
+inline bool PinThreadToCpu(pthread_t thread, int cpu)
+{
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    CPU_SET(cpu, &mask);
+    return pthread_setaffinity_np(thread, sizeof(mask), &mask) == 0;
+}
+
+// Thread counts RunThreadScalingBenchmark runs, largest first: PKLE_BENCH_THREAD_COUNTS, or by default every
+// power of two up to 2x hardware_concurrency plus hardware_concurrency and 2x hardware_concurrency themselves
+inline const std::vector<uint64_t>& GetBenchmarkThreadCounts()
+{
+    static const std::vector<uint64_t> s_threadCounts = []()
+    {
+        const uint64_t numHardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+        std::vector<uint64_t> defaultCounts = {numHardwareThreads, 2 * numHardwareThreads};
+        for(uint64_t count = 1; count < 2 * numHardwareThreads; count *= 2)
+        {
+            defaultCounts.push_back(count);
+        }
+        std::vector<uint64_t> counts = GetBenchmarkSettingU64List("PKLE_BENCH_THREAD_COUNTS", defaultCounts);
+        counts.erase(std::remove(counts.begin(), counts.end(), 0u), counts.end());
+        std::sort(counts.begin(), counts.end(), std::greater<uint64_t>());
+        counts.erase(std::unique(counts.begin(), counts.end()), counts.end());
+        return counts.empty() ? std::vector<uint64_t>{1} : counts;
+    }();
+    return s_threadCounts;
+}
+
+// Placements RunThreadScalingBenchmark runs every thread count with: PKLE_BENCH_PLACEMENTS, a comma separated
+// list of placement names, "none" by default
+inline const std::vector<ThreadPlacement>& GetBenchmarkPlacements()
+{
+    static const std::vector<ThreadPlacement> s_placements = []()
+    {
+        std::vector<ThreadPlacement> placements;
+        const char* pValue = GetBenchmarkSettingString("PKLE_BENCH_PLACEMENTS");
+        const std::string value = pValue ? pValue : "none";
+        size_t begin = 0;
+        while(begin <= value.size())
+        {
+            size_t end = value.find(',', begin);
+            end = (end == std::string::npos) ? value.size() : end;
+            const std::string name = value.substr(begin, end - begin);
+            for(uint32_t i = 0; i < static_cast<uint32_t>(ThreadPlacement::Count); ++i)
+            {
+                if(name == GetThreadPlacementName(static_cast<ThreadPlacement>(i)))
+                {
+                    placements.push_back(static_cast<ThreadPlacement>(i));
+                }
+            }
+            begin = end + 1;
+        }
+        return placements.empty() ? std::vector<ThreadPlacement>{ThreadPlacement::None} : placements;
+    }();
+    return s_placements;
+}
+
+// numThreads threads that run the operations of a benchmark pass. The calling thread is thread 0 and is pinned
+// while the pool exists, threads 1..numThreads-1 spin briefly and then sleep between passes. Operations are handed
+// out in chunks of elementsPerTask from a shared index.
+class BenchmarkThreadPool
+{
+    using ChunkFunc = void (*)(void* pContext, uint64_t begin, uint64_t end);
+
+    static constexpr uint32_t c_spinsBeforeWait = 500;
+
+    std::vector<std::thread> threads;
+    const ThreadPlacement placement;
+    cpu_set_t callerMask;
+    bool bCallerPinned = false;
+
+    std::atomic<uint64_t> generation{0};
+    std::atomic<uint32_t> numFinished{0};
+    std::atomic<bool> bStop{false};
+    ChunkFunc pChunkFunc = nullptr;
+    void* pChunkContext = nullptr;
+    bool bOncePerThread = false;
+    std::atomic<uint64_t> nextIndex{0};
+    uint64_t endIndex = 0;
+    uint64_t elementsPerChunk = 1;
+
+    void RunChunks()
+    {
+        for(uint64_t begin = nextIndex.fetch_add(elementsPerChunk, std::memory_order_relaxed); begin < endIndex;
+            begin = nextIndex.fetch_add(elementsPerChunk, std::memory_order_relaxed))
+        {
+            pChunkFunc(pChunkContext, begin, std::min(begin + elementsPerChunk, endIndex));
+        }
+    }
+
+    void RunTask()
+    {
+        if(bOncePerThread)
+        {
+            pChunkFunc(pChunkContext, 0, 0);
+        }
+        else
+        {
+            RunChunks();
+        }
+    }
+
+    void RunOnAllThreads()
+    {
+        numFinished.store(0, std::memory_order_relaxed);
+        generation.fetch_add(1, std::memory_order_acq_rel);
+        generation.notify_all();
+        RunTask();
+        while(numFinished.load(std::memory_order_acquire) < threads.size())
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    void WorkerLoop()
+    {
+        uint64_t seenGeneration = 0;
+        while(true)
+        {
+            for(uint32_t spin = 0; spin < c_spinsBeforeWait && generation.load(std::memory_order_acquire) == seenGeneration; ++spin)
+            {
+                std::this_thread::yield();
+            }
+            generation.wait(seenGeneration, std::memory_order_acquire);
+            seenGeneration = generation.load(std::memory_order_acquire);
+            if(bStop.load(std::memory_order_acquire))
+            {
+                return;
+            }
+            RunTask();
+            numFinished.fetch_add(1, std::memory_order_acq_rel);
+        }
+    }
+
+public:
+    BenchmarkThreadPool(uint32_t numThreads, ThreadPlacement placement_)
+        : placement(placement_)
+    {
+        numThreads = std::max(1u, numThreads);
+        const std::vector<int> cpus = GetPlacementCpus(placement, numThreads);
+        if(!cpus.empty())
+        {
+            CPU_ZERO(&callerMask);
+            bCallerPinned = (pthread_getaffinity_np(pthread_self(), sizeof(callerMask), &callerMask) == 0) && PinThreadToCpu(pthread_self(), cpus[0]);
+        }
+        threads.reserve(numThreads - 1);
+        for(uint32_t thread = 1; thread < numThreads; ++thread)
+        {
+            threads.emplace_back([this]() { WorkerLoop(); });
+            if(!cpus.empty())
+            {
+                PinThreadToCpu(threads.back().native_handle(), cpus[thread]);
+            }
+        }
+    }
+
+    ~BenchmarkThreadPool()
+    {
+        bStop.store(true, std::memory_order_release);
+        generation.fetch_add(1, std::memory_order_acq_rel);
+        generation.notify_all();
+        for(std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        if(bCallerPinned)
+        {
+            pthread_setaffinity_np(pthread_self(), sizeof(callerMask), &callerMask);
+        }
+    }
+
+    BenchmarkThreadPool(const BenchmarkThreadPool&) = delete;
+    BenchmarkThreadPool& operator=(const BenchmarkThreadPool&) = delete;
+
+    uint32_t GetNumThreads() const { return static_cast<uint32_t>(threads.size()) + 1; }
+    ThreadPlacement GetPlacement() const { return placement; }
+
+    // Runs func(index) for every index in [begin, end) on all threads, returns once all of them finished
+    template<typename Func_T>
+    void RunParallelFor(uint64_t begin, uint64_t end, Func_T& func, uint64_t elementsPerTask)
+    {
+        pChunkContext = &func;
+        pChunkFunc = [](void* pContext, uint64_t chunkBegin, uint64_t chunkEnd)
+        {
+            Func_T& chunkFunc = *static_cast<Func_T*>(pContext);
+            for(uint64_t index = chunkBegin; index < chunkEnd; ++index)
+            {
+                chunkFunc(static_cast<uint32_t>(index));
+            }
+        };
+        nextIndex.store(begin, std::memory_order_relaxed);
+        endIndex = end;
+        elementsPerChunk = std::max<uint64_t>(1, elementsPerTask);
+        bOncePerThread = false;
+        RunOnAllThreads();
     }
 
+    // Runs func() exactly once on every thread of the pool, the calling thread included, returns once all of them finished
+    template<typename Func_T>
+    void RunOnEachThread(Func_T& func)
+    {
+        pChunkContext = &func;
+        pChunkFunc = [](void* pContext, uint64_t, uint64_t)
+        {
+            (*static_cast<Func_T*>(pContext))();
+        };
+        bOncePerThread = true;
+        RunOnAllThreads();
+    }
 };
 
-struct TestValueStruct
+// Runs threadFunc(threadIndex) on numThreads fresh threads released together once all of them started, for tests
+// that give each thread its own role or slice instead of a parallel for. Returns the time from the release until the
+// last thread finished; pOutStart receives the release time before any threadFunc runs.
+template<typename ThreadFunc_T>
+std::chrono::nanoseconds RunOnBenchmarkThreads(uint32_t numThreads, ThreadFunc_T&& threadFunc, std::chrono::steady_clock::time_point* pOutStart = nullptr)
 {
-    uint64_t data[4] = {0};
-    std::string info;
-    std::vector<uint8_t> blob;
+    std::atomic<uint32_t> numReady{0};
+    std::atomic<bool> bStart{false};
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    for(uint32_t threadIndex = 0; threadIndex < numThreads; ++threadIndex)
+    {
+        threads.emplace_back([&numReady, &bStart, &threadFunc, threadIndex]()
+        {
+            numReady.fetch_add(1, std::memory_order_release);
+            while(!bStart.load(std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+            threadFunc(threadIndex);
+        });
+    }
+    while(numReady.load(std::memory_order_acquire) < numThreads)
+    {
+        std::this_thread::yield();
+    }
 
-    TestValueStruct() = default;
-    TestValueStruct(uint64_t val)
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if(pOutStart != nullptr)
     {
-        data[0] = val;
-        info = "Value_" + std::to_string(val);
-        blob.resize(64, static_cast<uint8_t>(val % 256));
+        *pOutStart = start;
     }
-};
+    bStart.store(true, std::memory_order_release);
+    for(std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+}
 
-// Base class for hashmap benchmarks
 class HashmapBenchmarkTest : public ::testing::Test
 {
 public:
@@ -163,38 +2159,253 @@ public:
         return result;
     }
 
-    // Templated helper to run a test with a specific number of threads
-    template<uint32_t NUM_THREADS>
-    static void RunWithThreadCount(
-        const char* testName,
+    // Sets the per entry growth of the allocator's in use bytes and RSS since the given baselines
+    static void SetFootprintGrowth(MapFootprint& footprint, uint64_t numEntries, uint64_t allocatedBefore, uint64_t rssBefore)
+    {
+        const uint64_t allocatedAfter = GetAllocatorInUseBytes();
+        const uint64_t rssAfter = GetResidentSetBytes();
+        if(numEntries > 0 && allocatedAfter > allocatedBefore)
+        {
+            footprint.numEntries = numEntries;
+            footprint.allocatedBytesPerEntry = static_cast<double>(allocatedAfter - allocatedBefore) / static_cast<double>(numEntries);
+            footprint.rssBytesPerEntry = static_cast<double>((rssAfter > rssBefore) ? (rssAfter - rssBefore) : 0) / static_cast<double>(numEntries);
+        }
+    }
+
+    // One pass of testLogic over [0, expectedCount) on the pool, returns how long it took.
+    // A pending footprint is measured around the pass, outside the timed window.
+    static std::chrono::nanoseconds RunPass(
+        BenchmarkThreadPool& pool,
         auto&& testLogic,
         uint64_t expectedCount,
-        const char* operationType = "mixed")
+        LatencyRecorder& latencyRecorder,
+        PerfCounterRecorder& perfRecorder,
+        MapFootprint* pFootprint = nullptr)
     {
-        using ThreadPoolType = PklE::MultiThreader::WorkerThreadPool<1, NUM_THREADS, 1, 500, 64>;
-        ThreadPoolType pool;
-        typename ThreadPoolType::ThreadDistribution distribution;
-        distribution[0] = NUM_THREADS;
-        typename ThreadPoolType::ThreadDistribution balanced = pool.DistributeThreads(distribution);
-        pool.StartThreads(balanced);
+        const bool bMeasureFootprint = (pFootprint != nullptr) && pFootprint->IsPending();
+        uint64_t allocatedBefore = 0;
+        uint64_t rssBefore = 0;
+        if(bMeasureFootprint)
+        {
+            malloc_trim(0);
+            allocatedBefore = GetAllocatorInUseBytes();
+            rssBefore = GetResidentSetBytes();
+        }
 
-        auto start = std::chrono::high_resolution_clock::now();
+        auto timedLogic = [&latencyRecorder, &testLogic](uint32_t index)
+        {
+            latencyRecorder.Run(testLogic, index);
+        };
 
-        const uint32_t c_maxTasks = 64;
         const uint32_t c_elementsPerTask = 25;
-        const bool bCallingExternally = true;
+        auto runInPool = [&pool, expectedCount](auto& logic)
+        {
+            pool.RunParallelFor(0, expectedCount, logic, c_elementsPerTask);
+        };
+
+        if(perfRecorder.IsEnabled())
+        {
+            //Open every pool thread's counter group before the clock starts
+            auto claimThread = [&perfRecorder]() { perfRecorder.ClaimThread(); };
+            pool.RunOnEachThread(claimThread);
+            perfRecorder.Resume();
+        }
+        auto start = std::chrono::high_resolution_clock::now();
 
-        pool.template RunParallelForInRangeInQueue<c_maxTasks>(
-            0, expectedCount, 0, testLogic, c_elementsPerTask, bCallingExternally);
+        if(latencyRecorder.IsEnabled())
+        {
+            runInPool(timedLogic);
+        }
+        else
+        {
+            runInPool(testLogic);
+        }
 
         auto end = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+        if(perfRecorder.IsEnabled())
+        {
+            perfRecorder.Pause();
+        }
+
+        if(bMeasureFootprint)
+        {
+            const uint64_t numEntries = pFootprint->pCountEntries(pFootprint->pMap);
+            pFootprint->pCountEntries = nullptr;
+            pFootprint->pMap = nullptr;
+            SetFootprintGrowth(*pFootprint, numEntries, allocatedBefore, rssBefore);
+        }
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+    }
+
+    // Run a test once with numThreads threads, the calling thread included, pinned by placement
+    static void RunWithThreadCount(
+        uint32_t numThreads,
+        ThreadPlacement placement,
+        const char* testName,
+        auto&& testLogic,
+        uint64_t expectedCount,
+        const char* operationType = "mixed",
+        MapFootprint* pFootprint = nullptr)
+    {
+        BenchmarkThreadPool pool(numThreads, placement);
+
+        LatencyRecorder latencyRecorder(pool.GetNumThreads(), GetLatencySamplePeriod());
+        PerfCounterRecorder perfRecorder(pool.GetNumThreads(), true);
+        const HeapAllocationCounts allocationsBefore = GetHeapAllocationCounts();
+        const std::chrono::nanoseconds duration = RunPass(pool, testLogic, expectedCount, latencyRecorder, perfRecorder, pFootprint);
+        const HeapAllocationCounts allocationsAfter = GetHeapAllocationCounts();
 
-        auto result = CreateResult(testName, duration, expectedCount, NUM_THREADS, operationType);
+        auto result = CreateResult(testName, duration, expectedCount, pool.GetNumThreads(), operationType);
+        result.placement = GetThreadPlacementName(placement);
+        if(latencyRecorder.IsEnabled())
+        {
+            result.SetLatencies(latencyRecorder.GetMerged());
+        }
+        result.SetAllocationCounts(allocationsBefore, allocationsAfter);
+        if(perfRecorder.IsEnabled())
+        {
+            result.SetPerfCounters(perfRecorder.Read());
+        }
+        if(pFootprint)
+        {
+            result.SetFootprint(*pFootprint);
+        }
+        result.Print();
+    }
+
+    // Repeated, time based run of one configuration, see BenchmarkRunSettings.
+    // setupFunc runs before every pass and is not timed. Reports the median throughput of the repetitions
+    // with its 95% confidence interval, and flags the result unstable when their spread is too wide.
+    template<typename HashmapType>
+    static void RunRepeatedWithThreadCount(
+        uint32_t numThreads,
+        ThreadPlacement placement,
+        const char* testName,
+        HashmapType& hashmap,
+        auto&& setupFunc,
+        auto&& testLogic,
+        uint64_t expectedCount,
+        const char* operationType = "mixed",
+        MapFootprint* pFootprint = nullptr)
+    {
+        const BenchmarkRunSettings& settings = GetBenchmarkRunSettings();
+        BenchmarkThreadPool pool(numThreads, placement);
+
+        // Passes until they took minDurationNs together, at least one. Counts the heap allocations of the timed passes only.
+        HeapAllocationCounts timedAllocations;
+        auto runPasses = [&](uint64_t minDurationNs, LatencyRecorder& latencyRecorder, PerfCounterRecorder& perfRecorder, uint64_t& outNumOperations)
+        {
+            std::chrono::nanoseconds totalDuration{0};
+            outNumOperations = 0;
+            do
+            {
+                setupFunc(hashmap);
+                const HeapAllocationCounts allocationsBefore = GetHeapAllocationCounts();
+                totalDuration += RunPass(pool, testLogic, expectedCount, latencyRecorder, perfRecorder, pFootprint);
+                const HeapAllocationCounts allocationsAfter = GetHeapAllocationCounts();
+                timedAllocations.numAllocations += allocationsAfter.numAllocations - allocationsBefore.numAllocations;
+                timedAllocations.numFrees += allocationsAfter.numFrees - allocationsBefore.numFrees;
+                outNumOperations += expectedCount;
+            } while(static_cast<uint64_t>(totalDuration.count()) < minDurationNs);
+            return totalDuration;
+        };
+
+        uint64_t numOperations = 0;
+        if(settings.warmupNs > 0)
+        {
+            LatencyRecorder untimedRecorder(0, 0);
+            PerfCounterRecorder uncountedRecorder(0, false);
+            runPasses(settings.warmupNs, untimedRecorder, uncountedRecorder, numOperations);
+            timedAllocations = HeapAllocationCounts();
+        }
+
+        LatencyRecorder latencyRecorder(pool.GetNumThreads(), GetLatencySamplePeriod());
+        PerfCounterRecorder perfRecorder(pool.GetNumThreads(), true);
+        std::vector<double> repetitionOpsPerSecond(settings.numRepetitions);
+        std::chrono::nanoseconds totalDuration{0};
+        uint64_t totalOperations = 0;
+        for(double& opsPerSecond : repetitionOpsPerSecond)
+        {
+            const std::chrono::nanoseconds duration = runPasses(settings.minRunNs, latencyRecorder, perfRecorder, numOperations);
+            opsPerSecond = (numOperations * 1e9) / duration.count();
+            totalDuration += duration;
+            totalOperations += numOperations;
+        }
+
+        auto result = CreateResult(testName, totalDuration, totalOperations, pool.GetNumThreads(), operationType);
+        result.placement = GetThreadPlacementName(placement);
+        result.SetRepetitions(settings.numRepetitions, ComputeRepetitionStatistics(repetitionOpsPerSecond), settings.maxStableCvPercent);
+        if(latencyRecorder.IsEnabled())
+        {
+            result.SetLatencies(latencyRecorder.GetMerged());
+        }
+        result.SetAllocationCounts(HeapAllocationCounts(), timedAllocations);
+        if(perfRecorder.IsEnabled())
+        {
+            result.SetPerfCounters(perfRecorder.Read());
+        }
+        if(pFootprint)
+        {
+            result.SetFootprint(*pFootprint);
+        }
         result.Print();
     }
 
-    // Run a benchmark across multiple thread counts
+    // One thread count and placement of RunThreadScalingBenchmark: a single pass, or the repeated mode when it is enabled
+    template<typename HashmapType>
+    static void RunScalingConfiguration(
+        uint32_t numThreads,
+        ThreadPlacement placement,
+        const char* testName,
+        HashmapType& hashmap,
+        auto&& setupFunc,
+        auto&& testLogic,
+        uint64_t expectedCount,
+        const char* operationType,
+        MapFootprint* pFootprint)
+    {
+        if(GetBenchmarkRunSettings().IsRepeated())
+        {
+            RunRepeatedWithThreadCount(numThreads, placement, testName, hashmap, setupFunc, testLogic, expectedCount, operationType, pFootprint);
+        }
+        else
+        {
+            setupFunc(hashmap);
+            RunWithThreadCount(numThreads, placement, testName, testLogic, expectedCount, operationType, pFootprint);
+        }
+    }
+
+    // Heap and RSS growth of one setupFunc run on the map, per entry it leaves in the map. When the setup leaves the map
+    // empty (insert workloads), the footprint stays pending and the first pass measures it from the map it filled.
+    // No footprint for wrappers without size(), or when the map did not grow (a setup that keeps an already loaded map).
+    template<typename HashmapType>
+    static MapFootprint MeasureMapFootprint(HashmapType& hashmap, auto&& setupFunc)
+    {
+        MapFootprint footprint;
+        if constexpr (requires { hashmap.size(); })
+        {
+            //Hand freed pages back so RSS follows what the map holds, as in the tiered storage test
+            malloc_trim(0);
+            const uint64_t allocatedBefore = GetAllocatorInUseBytes();
+            const uint64_t rssBefore = GetResidentSetBytes();
+            BeginPeakTracking();
+            setupFunc(hashmap);
+            const uint64_t peakBytes = EndPeakTracking();
+
+            const uint64_t numEntries = hashmap.size();
+            if(numEntries == 0)
+            {
+                footprint.pCountEntries = [](void* pMap) { return static_cast<uint64_t>(static_cast<HashmapType*>(pMap)->size()); };
+                footprint.pMap = &hashmap;
+                return footprint;
+            }
+            SetFootprintGrowth(footprint, numEntries, allocatedBefore, rssBefore);
+            footprint.peakSetupBytes = (footprint.numEntries > 0) ? peakBytes : 0;
+        }
+        return footprint;
+    }
+
+    // Run a benchmark across the configured thread counts and placements
     template<typename HashmapType>
     static void RunThreadScalingBenchmark(
         const char* baseName,
@@ -206,23 +2417,17 @@ public:
         bool bSingleThreadedOnly = false
     )
     {
+        MapFootprint footprint = MeasureMapFootprint(hashmap, setupFunc);
         if(!bSingleThreadedOnly)
         {
-            // Run with varying thread counts
-            setupFunc(hashmap);
-            RunWithThreadCount<16>(baseName, testLogic, expectedCount, operationType);
-            
-            setupFunc(hashmap);
-            RunWithThreadCount<8>(baseName, testLogic, expectedCount, operationType);
-            
-            setupFunc(hashmap);
-            RunWithThreadCount<4>(baseName, testLogic, expectedCount, operationType);
-            
-            setupFunc(hashmap);
-            RunWithThreadCount<2>(baseName, testLogic, expectedCount, operationType);
-            
-            setupFunc(hashmap);
-            RunWithThreadCount<1>(baseName, testLogic, expectedCount, operationType);
+            // Every placement with every thread count, see GetBenchmarkPlacements() and GetBenchmarkThreadCounts()
+            for(ThreadPlacement placement : GetBenchmarkPlacements())
+            {
+                for(uint64_t numThreads : GetBenchmarkThreadCounts())
+                {
+                    RunScalingConfiguration(static_cast<uint32_t>(numThreads), placement, baseName, hashmap, setupFunc, testLogic, expectedCount, operationType, &footprint);
+                }
+            }
         }
         else
         {
@@ -230,7 +2435,7 @@ public:
             {
                 // Single-threaded only
                 setupFunc(hashmap);
-                RunWithThreadCount<1>(baseName, testLogic, expectedCount, operationType);
+                RunWithThreadCount(1, ThreadPlacement::None, baseName, testLogic, expectedCount, operationType, &footprint);
             }
         }
     }
@@ -274,6 +2479,60 @@ class HashmapRekeyTest : public HashmapBenchmarkTest {};
 // Test fixture for iterator workloads
 class HashmapIteratorTest : public HashmapBenchmarkTest {};
 
+// Test fixture for variable length (string) key workloads
+class HashmapStringKeyTest : public HashmapBenchmarkTest {};
+
+// Test fixture for change feed (change data capture) writer overhead
+class HashmapChangeFeedTest : public HashmapBenchmarkTest {};
+
+// Test fixture for hot key sketch (sampling profiler) overhead
+class HashmapHotKeySketchTest : public HashmapBenchmarkTest {};
+
+// Test fixture for tiered (RAM + memory mapped file) value storage
+class HashmapTieredStorageTest : public HashmapBenchmarkTest {};
+
+// Test fixture for incremental checkpoint cost and writer slowdown
+class HashmapCheckpointTest : public HashmapBenchmarkTest {};
+
+// Test fixture for the parallel hash join build and probe
+class HashmapHashJoinTest : public HashmapBenchmarkTest {};
+
+// Test fixture for replacing a whole map under live readers
+class HashmapPublishedMapTest : public HashmapBenchmarkTest {};
+
+// Test fixture for PagingObjectPool reserve/release contention
+class HashmapObjectPoolTest : public HashmapBenchmarkTest {};
+
+// Test fixture for write scaling of the container element counters
+class HashmapWriteScalingTest : public HashmapBenchmarkTest {};
+
+// Test fixture for insert tail latency with and without fixed capacity
+class HashmapFixedCapacityTest : public HashmapBenchmarkTest {};
+
+// Test fixture for clear and teardown time versus map size
+class HashmapClearTest : public HashmapBenchmarkTest {};
+
+// Test fixture for HashMap Clone and Merge against insert loops
+class HashmapCloneMergeTest : public HashmapBenchmarkTest {};
+
+// Test fixture for every key pattern workload under skewed key distributions
+class HashmapSkewedKeyTest : public HashmapBenchmarkTest {};
+
+// Test fixture for the YCSB core workloads A-F
+class HashmapYcsbTest : public HashmapBenchmarkTest {};
+
+// Test fixture for replaying recorded operation traces
+class HashmapTraceReplayTest : public HashmapBenchmarkTest {};
+
+// Test fixture for lookup/insert/mixed/iteration over working sets from 10K up to 1B keys
+class HashmapWorkingSetTest : public HashmapBenchmarkTest {};
+
+// Test fixture for cross-process (fork based) SharedMemoryHashMap workloads
+class HashmapSharedMemoryTest : public HashmapBenchmarkTest {};
+
+// Test fixture for SimpleLinkedList stress tests and single bucket microbenchmarks
+class SimpleLinkedListStressTest : public HashmapBenchmarkTest {};
+
 // ============================================================================
 // HASHMAP WRAPPER TEMPLATES
 // These wrappers provide a consistent interface for different hashmap types
@@ -399,13 +2658,13 @@ public:
 };
 
 // Wrapper for PklE::ThreadsafeContainers::HashMap
-template<typename KeyType, typename ValueType, bool UseLockless = false>
+template<typename KeyType, typename ValueType, bool UseLockless = false, bool UseUnrolledBuckets = false>
 class PklEHashMap
 {
 private:
     inline static constexpr uint32_t c_pageSize = 8;
     inline static constexpr uint32_t c_numInnerMaps = (UseLockless) ? 1 : 2;
-    using MapType = PklE::ThreadsafeContainers::HashMap<KeyType, ValueType, c_pageSize, c_numInnerMaps>;
+    using MapType = PklE::ThreadsafeContainers::HashMap<KeyType, ValueType, c_pageSize, c_numInnerMaps, UseUnrolledBuckets>;
 
     mutable PklE::CoreTypes::CountingSpinlock spinLock_;
     MapType map_;
@@ -417,11 +2676,11 @@ public:
     {
         if(UseLockless)
         {
-            return "PklEHashMapLocked";
+            return (UseUnrolledBuckets) ? "PklEHashMapUnrolledLocked" : "PklEHashMapLocked";
         }
         else
         {
-            return "PklEHashMap";
+            return (UseUnrolledBuckets) ? "PklEHashMapUnrolled" : "PklEHashMap";
         }
     }
 
@@ -457,57 +2716,229 @@ public:
             PklE::CoreTypes::ScopedWriteSpinLock lock(spinLock_);
             return map_.erase_lockless(key);
         }
-        return map_.erase(key);
-    }
+        return map_.erase(key);
+    }
+
+    bool rekey(const KeyType& oldKey, const KeyType& newKey)
+    {
+        if(UseLockless)
+        {
+            PklE::CoreTypes::ScopedWriteSpinLock lock(spinLock_);
+            return map_.rekey_lockless(oldKey, newKey);
+        }
+        return map_.rekey(oldKey, newKey);
+    }
+
+    void reserve(size_t numElements)
+    {
+        map_.reserve(numElements);
+    }
+
+    template<typename... Args>
+    bool insert_batched(const KeyType& key, Args&&... args)
+    {
+        if(UseLockless)
+        {
+            PklE::CoreTypes::ScopedWriteSpinLock lock(spinLock_);
+            return map_.Insert_Lockless(key, std::forward<Args>(args)...);
+        }
+        return map_.Insert_Concurrent(key, std::forward<Args>(args)...);
+    }
+
+    bool find_batched(const KeyType& key, const ValueType*& outValue) const
+    {
+        return map_.find_lockless(key, outValue);
+    }
+
+    void clear()
+    {
+        //Give the memory back rather than Clear_Lockless(), so every run starts from an empty map like the other wrappers
+        map_.ReleaseMemory_Parallel(std::thread::hardware_concurrency());
+    }
+
+    size_t size() const
+    {
+        return map_.size();
+    }
+
+    // Direct access for features the wrapper interface does not cover (e.g. the change feed)
+    MapType& GetMap()
+    {
+        return map_;
+    }
+
+    template<typename CallbackType_T>
+    void for_each(CallbackType_T&& callback)
+    {
+        for(auto& pair : map_)
+        {
+            callback(pair.key, pair.value);
+        }
+    }
+};
+
+// Wrapper for a single bucket list, i.e. one fully contended bucket
+// UseLockFree switches between the write-locked SimpleLinkedList and the Harris-Michael LockFreeLinkedList
+template<typename KeyType, typename ValueType, bool UseLockFree = false>
+class SimpleLinkedListBucket
+{
+public:
+    struct Node
+    {
+        KeyType key;
+        ValueType value;
+        Node* pNext = nullptr;
+        Node* pRetiredNext = nullptr;
+
+        template<typename... Args>
+        Node(const KeyType& inKey, Args&&... args) : key(inKey), value(std::forward<Args>(args)...)
+        {
+        }
+    };
+
+private:
+    struct KeyComparator
+    {
+        static int Compare(const KeyType& a, const KeyType& b)
+        {
+            return (a < b) ? -1 : ((a > b) ? 1 : 0);
+        }
+    };
+
+    using ListType = std::conditional_t<UseLockFree, PklE::ThreadsafeContainers::LockFreeLinkedList<Node>, PklE::ThreadsafeContainers::SimpleLinkedList<Node>>;
+    using PoolType = PklE::CoreTypes::PagingObjectPool<Node, 8>;
+
+    PoolType pool_;
+    ListType list_;
+    std::atomic<int64_t> count_{0};
+    std::atomic<uint64_t> numReclaimed_{0};
+
+public:
+    using HashMapValueType = ValueType;
+
+    static const char* GetMapTypeName()
+    {
+        return (UseLockFree) ? "SimpleLinkedListBucketLockFree" : "SimpleLinkedListBucketLocked";
+    }
+
+    ~SimpleLinkedListBucket()
+    {
+        ReclaimAll();
+    }
+
+    template<typename... Args>
+    bool insert(const KeyType& key, Args&&... args)
+    {
+        Node* pNode = pool_.Reserve(key, std::forward<Args>(args)...);
+        const bool bInserted = list_.template InsertUnique<KeyType, KeyComparator>(pNode);
+        if(bInserted)
+        {
+            count_.fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+            pool_.Release(pNode);
+        }
+        return bInserted;
+    }
+
+    bool find(const KeyType& key, const ValueType*& outValue)
+    {
+        Node* pNode = list_.template Find<KeyType, KeyComparator>(key);
+        if(pNode)
+        {
+            outValue = &pNode->value;
+            return true;
+        }
+        return false;
+    }
+
+    bool erase(const KeyType& key)
+    {
+        bool bErased = false;
+        if constexpr (UseLockFree)
+        {
+            bErased = list_.template Erase<KeyType, KeyComparator>(key, [this](Node* pNode)
+            {
+                numReclaimed_.fetch_add(1, std::memory_order_relaxed);
+                pool_.Release(pNode);
+            });
+        }
+        else
+        {
+            Node* pNode = list_.template Erase<KeyType, KeyComparator>(key);
+            if(pNode)
+            {
+                numReclaimed_.fetch_add(1, std::memory_order_relaxed);
+                pool_.Release(pNode);
+                bErased = true;
+            }
+        }
 
-    bool rekey(const KeyType& oldKey, const KeyType& newKey)
-    {
-        if(UseLockless)
+        if(bErased)
         {
-            PklE::CoreTypes::ScopedWriteSpinLock lock(spinLock_);
-            return map_.rekey_lockless(oldKey, newKey);
+            count_.fetch_sub(1, std::memory_order_relaxed);
         }
-        return map_.rekey(oldKey, newKey);
+        return bErased;
     }
 
     void reserve(size_t numElements)
     {
-        map_.reserve(numElements);
+        pool_.PreallocateSpace(static_cast<uint32_t>(numElements));
     }
 
     template<typename... Args>
     bool insert_batched(const KeyType& key, Args&&... args)
     {
-        if(UseLockless)
-        {
-            PklE::CoreTypes::ScopedWriteSpinLock lock(spinLock_);
-            return map_.Insert_Lockless(key, std::forward<Args>(args)...);
-        }
-        return map_.Insert_Concurrent(key, std::forward<Args>(args)...);
+        return insert(key, std::forward<Args>(args)...);
     }
 
-    bool find_batched(const KeyType& key, const ValueType*& outValue) const
+    bool find_batched(const KeyType& key, const ValueType*& outValue)
     {
-        return map_.find_lockless(key, outValue);
+        return find(key, outValue);
+    }
+
+    // Hands every retired node back to the pool. Requires exclusive access.
+    void ReclaimAll()
+    {
+        if constexpr (UseLockFree)
+        {
+            list_.ReclaimRetired_Unsafe([this](Node* pNode)
+            {
+                numReclaimed_.fetch_add(1, std::memory_order_relaxed);
+                pool_.Release(pNode);
+            });
+        }
     }
 
     void clear()
     {
-        map_.~MapType();
-        new (&map_) MapType();
+        ReclaimAll();
+        list_.Reset_Unsafe();
+        pool_.Clear();
+        count_.store(0, std::memory_order_relaxed);
+        numReclaimed_.store(0, std::memory_order_relaxed);
     }
 
     size_t size() const
     {
-        return map_.size();
+        return static_cast<size_t>(count_.load(std::memory_order_relaxed));
+    }
+
+    uint64_t GetNumReclaimed() const
+    {
+        return numReclaimed_.load(std::memory_order_relaxed);
     }
 
+    // Walk the live nodes. Requires exclusive access.
     template<typename CallbackType_T>
     void for_each(CallbackType_T&& callback)
     {
-        for(auto& pair : map_)
+        Node* pNode = list_.GetHead_Unsafe();
+        while(pNode)
         {
-            callback(pair.key, pair.value);
+            callback(pNode->key, pNode->value);
+            pNode = pNode->pNext;
         }
     }
 };
@@ -1657,3 +4088,531 @@ auto CreateIteratorOperation(
         });
     };
 }
+
+// ============================================================================
+// YCSB CORE WORKLOADS
+// The YCSB core workloads A-F as a driver over the common wrapper interface. The load phase inserts
+// YCSB_RECORD_COUNT records, the run phase draws keys from the scrambled Zipfian generator, or from
+// the most recently inserted records for the "latest" distribution of workload D.
+// - Updates replace the record through erase() + insert(), the wrappers have no insert-or-assign
+// - Scans have no ordered iteration to use, they read a run of consecutive keys instead
+// ============================================================================
+
+inline static constexpr uint64_t YCSB_RECORD_COUNT = KeyGenerator::KEY_RANGE;
+inline static constexpr uint32_t YCSB_MAX_SCAN_LENGTH = 100;
+
+enum class YcsbWorkload
+{
+    A, // 50% read, 50% update
+    B, // 95% read, 5% update
+    C, // 100% read
+    D, // 95% read latest, 5% insert
+    E, // 95% scan, 5% insert
+    F, // 50% read, 50% read-modify-write
+};
+
+// Operation mix of one workload, percentages add up to 100
+struct YcsbWorkloadSpec
+{
+    const char* name;
+    uint32_t readPercent;
+    uint32_t updatePercent;
+    uint32_t insertPercent;
+    uint32_t scanPercent;
+    uint32_t readModifyWritePercent;
+    bool bReadLatest;
+};
+
+inline const YcsbWorkloadSpec& GetYcsbWorkloadSpec(YcsbWorkload workload)
+{
+    static const YcsbWorkloadSpec s_specs[] =
+    {
+        {"ycsbA", 50, 50, 0, 0, 0, false},
+        {"ycsbB", 95, 5, 0, 0, 0, false},
+        {"ycsbC", 100, 0, 0, 0, 0, false},
+        {"ycsbD", 95, 0, 5, 0, 0, true},
+        {"ycsbE", 0, 0, 5, 95, 0, false},
+        {"ycsbF", 50, 0, 0, 0, 50, false},
+    };
+    return s_specs[static_cast<uint32_t>(workload)];
+}
+
+// Per run counters of the YCSB driver, nextInsertKey hands out the keys of new records
+struct YcsbRunState
+{
+    std::atomic<uint64_t> nextInsertKey{YCSB_RECORD_COUNT};
+    std::atomic<uint64_t> readHits{0};
+    std::atomic<uint64_t> updates{0};
+    std::atomic<uint64_t> inserts{0};
+    std::atomic<uint64_t> scannedRecords{0};
+
+    void Reset()
+    {
+        nextInsertKey = YCSB_RECORD_COUNT;
+        readHits = 0;
+        updates = 0;
+        inserts = 0;
+        scannedRecords = 0;
+    }
+};
+
+// Load phase, inserts records [0, YCSB_RECORD_COUNT)
+template<typename HashmapType>
+void LoadYcsbRecords(HashmapType& hashmap)
+{
+    hashmap.reserve(YCSB_RECORD_COUNT);
+    for(uint64_t key = 0; key < YCSB_RECORD_COUNT; ++key)
+    {
+        hashmap.insert(key, key * 2);
+    }
+}
+
+// Run phase operation of one YCSB workload
+template<typename KeyType, typename ValueType, typename HashmapType>
+auto CreateYcsbOperation(HashmapType& hashmap, const YcsbWorkloadSpec& spec, uint32_t threadCount, YcsbRunState& state)
+{
+    return [&hashmap, &spec, threadCount, &state](uint32_t index)
+    {
+        uint32_t threadId = index % threadCount;
+        uint32_t opSelector = index % 100;
+
+        KeyType key;
+        if(spec.bReadLatest)
+        {
+            // Zipfian distance back from the newest record
+            const uint64_t latestKey = state.nextInsertKey.load(std::memory_order_relaxed) - 1;
+            key = latestKey - std::min<uint64_t>(latestKey, KeyGenerator::Zipfian(threadId, index, threadCount));
+        }
+        else
+        {
+            key = KeyGenerator::ScrambledZipfian(threadId, index, threadCount);
+        }
+
+        const ValueType* pValue = nullptr;
+        if(opSelector < spec.readPercent)
+        {
+            if(hashmap.find(key, pValue))
+            {
+                state.readHits.fetch_add(1, std::memory_order_relaxed);
+            }
+            return;
+        }
+        opSelector -= spec.readPercent;
+
+        if(opSelector < spec.updatePercent)
+        {
+            hashmap.erase(key);
+            if(hashmap.insert(key, key * 2 + index))
+            {
+                state.updates.fetch_add(1, std::memory_order_relaxed);
+            }
+            return;
+        }
+        opSelector -= spec.updatePercent;
+
+        if(opSelector < spec.insertPercent)
+        {
+            const KeyType newKey = state.nextInsertKey.fetch_add(1, std::memory_order_relaxed);
+            if(hashmap.insert(newKey, newKey * 2))
+            {
+                state.inserts.fetch_add(1, std::memory_order_relaxed);
+            }
+            return;
+        }
+        opSelector -= spec.insertPercent;
+
+        if(opSelector < spec.scanPercent)
+        {
+            // Uniform scan length in [1, YCSB_MAX_SCAN_LENGTH], as in YCSB
+            const uint32_t scanLength = 1 + static_cast<uint32_t>((static_cast<uint64_t>(index) * 0x9E3779B97F4A7C15ull) >> 32) % YCSB_MAX_SCAN_LENGTH;
+            uint64_t numFound = 0;
+            for(uint32_t i = 0; i < scanLength; ++i)
+            {
+                numFound += hashmap.find(key + i, pValue) ? 1 : 0;
+            }
+            state.scannedRecords.fetch_add(numFound, std::memory_order_relaxed);
+            return;
+        }
+
+        // Read-modify-write. The wrappers drop their lock when find() returns and other threads erase and
+        // re-insert the same hot keys, so the value is not read back through pValue. The new value comes
+        // from the key and index like an update, the read still decides whether the write happens.
+        if(hashmap.find(key, pValue))
+        {
+            hashmap.erase(key);
+            if(hashmap.insert(key, key * 2 + index + 1))
+            {
+                state.updates.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    };
+}
+
+// ============================================================================
+// OPERATION TRACES
+// Binary trace of wrapper operations: a TraceFileHeader followed by numRecords TraceRecords sorted by
+// timestamp. TraceRecordingMap wraps any wrapper type and captures its operations, ReplayTrace drives
+// any wrapper type with a memory mapped trace, as fast as possible or at the recorded pacing.
+// Records flagged TRACE_FLAG_LOAD_PHASE (e.g. a preload) are applied untimed before the replay starts.
+// ============================================================================
+
+inline static constexpr uint64_t TRACE_FILE_MAGIC = 0x31454341525445ull; // "ETRACE1"
+inline static constexpr uint32_t TRACE_FILE_VERSION = 1;
+inline static constexpr uint8_t TRACE_FLAG_LOAD_PHASE = 1;
+
+enum class TraceOp : uint8_t
+{
+    Insert,
+    Find,
+    Erase,
+    Rekey,
+    ForEach,
+};
+
+struct TraceFileHeader
+{
+    uint64_t magic;
+    uint32_t version;
+    uint32_t numThreads;
+    uint64_t numRecords;
+};
+
+struct TraceRecord
+{
+    uint64_t timestampNs; // Since the recording started
+    uint64_t key;
+    uint64_t newKey;      // Rekey target, 0 for the other operations
+    uint32_t valueSize;   // Inserted value size, 0 for the other operations
+    uint16_t threadId;    // Dense over the threads that recorded workload operations
+    TraceOp op;
+    uint8_t flags;        // TRACE_FLAG_*
+};
+static_assert(sizeof(TraceRecord) == 32, "TraceRecord is the on disk layout");
+
+// Wrapper around another wrapper type that records every operation into per thread buffers.
+// A thread claims a buffer on its first operation; threads beyond MAX_THREADS are not recorded.
+// Operations between SetLoadPhase(true) and SetLoadPhase(false) are flagged as load phase.
+template<typename HashmapType>
+class TraceRecordingMap
+{
+public:
+    static constexpr uint32_t MAX_THREADS = 256;
+
+private:
+    struct ThreadState
+    {
+        uint64_t recorderId = 0;
+        uint32_t threadId = 0;
+        std::vector<TraceRecord>* pBuffer = nullptr;
+    };
+
+    static uint64_t GetNextRecorderId()
+    {
+        static std::atomic<uint64_t> s_nextRecorderId{1};
+        return s_nextRecorderId.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    HashmapType map_;
+    mutable std::vector<std::vector<TraceRecord>> buffers_;
+    mutable std::atomic<uint32_t> numClaimedBuffers_{0};
+    mutable std::atomic<uint64_t> numDroppedRecords_{0};
+    std::atomic<bool> bLoadPhase_{false};
+    const uint64_t recorderId_;
+    const std::chrono::steady_clock::time_point start_;
+
+    void Record(TraceOp op, uint64_t key, uint64_t newKey = 0, uint32_t valueSize = 0) const
+    {
+        thread_local ThreadState t_state;
+        if(t_state.recorderId != recorderId_)
+        {
+            const uint32_t bufferIndex = numClaimedBuffers_.fetch_add(1, std::memory_order_relaxed);
+            t_state.recorderId = recorderId_;
+            t_state.threadId = bufferIndex;
+            t_state.pBuffer = (bufferIndex < MAX_THREADS) ? &buffers_[bufferIndex] : nullptr;
+        }
+        if(t_state.pBuffer == nullptr)
+        {
+            numDroppedRecords_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        TraceRecord record = {};
+        record.timestampNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count());
+        record.key = key;
+        record.newKey = newKey;
+        record.valueSize = valueSize;
+        record.threadId = static_cast<uint16_t>(t_state.threadId);
+        record.op = op;
+        record.flags = bLoadPhase_.load(std::memory_order_relaxed) ? TRACE_FLAG_LOAD_PHASE : 0;
+        t_state.pBuffer->push_back(record);
+    }
+
+public:
+    using HashMapValueType = typename HashmapType::HashMapValueType;
+
+    TraceRecordingMap()
+        : buffers_(MAX_THREADS)
+        , recorderId_(GetNextRecorderId())
+        , start_(std::chrono::steady_clock::now())
+    {
+    }
+
+    static const char* GetMapTypeName()
+    {
+        return HashmapType::GetMapTypeName();
+    }
+
+    template<typename KeyType, typename... Args>
+    bool insert(const KeyType& key, Args&&... args)
+    {
+        Record(TraceOp::Insert, key, 0, sizeof(HashMapValueType));
+        return map_.insert(key, std::forward<Args>(args)...);
+    }
+
+    template<typename KeyType>
+    bool find(const KeyType& key, const HashMapValueType*& outValue) const
+    {
+        Record(TraceOp::Find, key);
+        return map_.find(key, outValue);
+    }
+
+    template<typename KeyType>
+    bool erase(const KeyType& key)
+    {
+        Record(TraceOp::Erase, key);
+        return map_.erase(key);
+    }
+
+    template<typename KeyType>
+    bool rekey(const KeyType& oldKey, const KeyType& newKey)
+    {
+        Record(TraceOp::Rekey, oldKey, newKey);
+        return map_.rekey(oldKey, newKey);
+    }
+
+    void reserve(size_t numElements)
+    {
+        map_.reserve(numElements);
+    }
+
+    template<typename KeyType, typename... Args>
+    bool insert_batched(const KeyType& key, Args&&... args)
+    {
+        Record(TraceOp::Insert, key, 0, sizeof(HashMapValueType));
+        return map_.insert_batched(key, std::forward<Args>(args)...);
+    }
+
+    template<typename KeyType>
+    bool find_batched(const KeyType& key, const HashMapValueType*& outValue) const
+    {
+        Record(TraceOp::Find, key);
+        return map_.find_batched(key, outValue);
+    }
+
+    void clear()
+    {
+        map_.clear();
+    }
+
+    size_t size() const
+    {
+        return map_.size();
+    }
+
+    template<typename CallbackType_T>
+    void for_each(CallbackType_T&& callback)
+    {
+        Record(TraceOp::ForEach, 0);
+        map_.for_each(std::forward<CallbackType_T>(callback));
+    }
+
+    uint64_t GetNumDroppedRecords() const
+    {
+        return numDroppedRecords_.load(std::memory_order_relaxed);
+    }
+
+    // Only switch while no other thread is recording
+    void SetLoadPhase(bool bLoadPhase)
+    {
+        bLoadPhase_.store(bLoadPhase, std::memory_order_relaxed);
+    }
+
+    // Only once the recorded threads are done. Merges the thread buffers by timestamp and writes the trace.
+    // Threads that only recorded load phase operations do not count as trace threads.
+    bool Save(const std::string& path) const
+    {
+        std::vector<TraceRecord> records;
+        uint32_t numWorkloadThreads = 0;
+        const uint32_t numBuffers = std::min(numClaimedBuffers_.load(std::memory_order_relaxed), MAX_THREADS);
+        for(uint32_t bufferIndex = 0; bufferIndex < numBuffers; ++bufferIndex)
+        {
+            bool bHasWorkload = false;
+            for(TraceRecord record : buffers_[bufferIndex])
+            {
+                if((record.flags & TRACE_FLAG_LOAD_PHASE) == 0)
+                {
+                    record.threadId = static_cast<uint16_t>(numWorkloadThreads);
+                    bHasWorkload = true;
+                }
+                records.push_back(record);
+            }
+            numWorkloadThreads += bHasWorkload ? 1 : 0;
+        }
+        std::stable_sort(records.begin(), records.end(), [](const TraceRecord& lhs, const TraceRecord& rhs)
+        {
+            return lhs.timestampNs < rhs.timestampNs;
+        });
+
+        FILE* pFile = fopen(path.c_str(), "wb");
+        if(pFile == nullptr)
+        {
+            return false;
+        }
+        TraceFileHeader header = {};
+        header.magic = TRACE_FILE_MAGIC;
+        header.version = TRACE_FILE_VERSION;
+        header.numThreads = numWorkloadThreads;
+        header.numRecords = records.size();
+        bool bWritten = fwrite(&header, sizeof(header), 1, pFile) == 1;
+        bWritten = bWritten && (records.empty() || fwrite(records.data(), sizeof(TraceRecord), records.size(), pFile) == records.size());
+        return (fclose(pFile) == 0) && bWritten;
+    }
+};
+
+// Read only memory mapping of a trace file
+class MappedTrace
+{
+    void* pMapped_ = MAP_FAILED;
+    size_t mappedBytes_ = 0;
+    const TraceFileHeader* pHeader_ = nullptr;
+
+public:
+    MappedTrace() = default;
+    MappedTrace(const MappedTrace&) = delete;
+    MappedTrace& operator=(const MappedTrace&) = delete;
+
+    ~MappedTrace()
+    {
+        Close();
+    }
+
+    // False when the file cannot be mapped or is not a complete trace
+    bool Open(const char* pPath)
+    {
+        Close();
+        const int fd = open(pPath, O_RDONLY);
+        if(fd < 0)
+        {
+            return false;
+        }
+        struct stat fileStat = {};
+        if((fstat(fd, &fileStat) == 0) && (static_cast<size_t>(fileStat.st_size) >= sizeof(TraceFileHeader)))
+        {
+            mappedBytes_ = static_cast<size_t>(fileStat.st_size);
+            pMapped_ = mmap(nullptr, mappedBytes_, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        close(fd);
+        if(pMapped_ == MAP_FAILED)
+        {
+            mappedBytes_ = 0;
+            return false;
+        }
+
+        const TraceFileHeader* pHeader = static_cast<const TraceFileHeader*>(pMapped_);
+        const uint64_t maxRecords = (mappedBytes_ - sizeof(TraceFileHeader)) / sizeof(TraceRecord);
+        if(pHeader->magic != TRACE_FILE_MAGIC || pHeader->version != TRACE_FILE_VERSION || pHeader->numRecords > maxRecords)
+        {
+            Close();
+            return false;
+        }
+        madvise(pMapped_, mappedBytes_, MADV_SEQUENTIAL);
+        pHeader_ = pHeader;
+        return true;
+    }
+
+    void Close()
+    {
+        if(pMapped_ != MAP_FAILED)
+        {
+            munmap(pMapped_, mappedBytes_);
+        }
+        pMapped_ = MAP_FAILED;
+        mappedBytes_ = 0;
+        pHeader_ = nullptr;
+    }
+
+    uint32_t GetNumThreads() const { return pHeader_ ? pHeader_->numThreads : 0; }
+    uint64_t GetNumRecords() const { return pHeader_ ? pHeader_->numRecords : 0; }
+
+    const TraceRecord* GetRecords() const
+    {
+        return pHeader_ ? reinterpret_cast<const TraceRecord*>(pHeader_ + 1) : nullptr;
+    }
+};
+
+// Applies one trace record to hashmap, returns whether the operation succeeded
+template<typename KeyType, typename HashmapType>
+bool ApplyTraceRecord(HashmapType& hashmap, const TraceRecord& record)
+{
+    using ValueType = typename HashmapType::HashMapValueType;
+    const KeyType key = static_cast<KeyType>(record.key);
+    const ValueType* pValue = nullptr;
+    switch(record.op)
+    {
+        case TraceOp::Insert:
+            return hashmap.insert(key, key * 2);
+        case TraceOp::Find:
+            return hashmap.find(key, pValue);
+        case TraceOp::Erase:
+            return hashmap.erase(key);
+        case TraceOp::Rekey:
+            return hashmap.rekey(key, static_cast<KeyType>(record.newKey));
+        case TraceOp::ForEach:
+            hashmap.for_each([](const KeyType&, const ValueType&) {});
+            return true;
+    }
+    return false;
+}
+
+// Replays a trace on numThreads threads, recorded thread t runs on replay thread t % numThreads in recorded order.
+// Load phase records are applied on the calling thread first, and the records are split by replay thread,
+// both before the timer starts. When bPaced, every operation waits until its recorded time relative to the
+// first workload record. Returns how long the replay took, outNumReplayed receives the number of timed records.
+template<typename KeyType, typename HashmapType>
+std::chrono::nanoseconds ReplayTrace(HashmapType& hashmap, const MappedTrace& trace, uint32_t numThreads, bool bPaced, std::atomic<uint64_t>& successCounter, uint64_t& outNumReplayed)
+{
+    const TraceRecord* pRecords = trace.GetRecords();
+    const uint64_t numRecords = trace.GetNumRecords();
+
+    std::vector<std::vector<uint64_t>> threadRecords(numThreads);
+    uint64_t firstTimestampNs = UINT64_MAX;
+    outNumReplayed = 0;
+    for(uint64_t i = 0; i < numRecords; ++i)
+    {
+        const TraceRecord& record = pRecords[i];
+        if((record.flags & TRACE_FLAG_LOAD_PHASE) != 0)
+        {
+            ApplyTraceRecord<KeyType>(hashmap, record);
+            continue;
+        }
+        threadRecords[record.threadId % numThreads].push_back(i);
+        firstTimestampNs = std::min(firstTimestampNs, record.timestampNs);
+        ++outNumReplayed;
+    }
+
+    std::chrono::steady_clock::time_point start;
+    return RunOnBenchmarkThreads(numThreads, [&, pRecords, bPaced, firstTimestampNs](uint32_t replayThreadId)
+    {
+        uint64_t numSucceeded = 0;
+        for(const uint64_t recordIndex : threadRecords[replayThreadId])
+        {
+            const TraceRecord& record = pRecords[recordIndex];
+            if(bPaced)
+            {
+                std::this_thread::sleep_until(start + std::chrono::nanoseconds(record.timestampNs - firstTimestampNs));
+            }
+            numSucceeded += ApplyTraceRecord<KeyType>(hashmap, record) ? 1 : 0;
+        }
+        successCounter.fetch_add(numSucceeded, std::memory_order_relaxed);
+    }, &start);
+}
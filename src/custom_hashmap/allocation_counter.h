@@ -0,0 +1,43 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "atomic_util.h"
+
+namespace PklE
+{
+namespace Util
+{
+    // Test hook counting the heap allocations the containers make for themselves: pool pages and page lists,
+    // bucket arrays, key arena chunks and checkpoint page copies. Allocations made by value types are not seen.
+    // Read it before and after a steady state phase, e.g. to check a fixed capacity map did not allocate.
+    struct ContainerAllocationCounters
+    {
+        uint64_t numAllocations = 0;
+        uint64_t numBytes = 0;
+    };
+
+    inline ContainerAllocationCounters& GetContainerAllocationCountersStorage()
+    {
+        static ContainerAllocationCounters s_counters;
+        return s_counters;
+    }
+
+    inline void CountContainerAllocation(const size_t numBytes)
+    {
+        ContainerAllocationCounters& counters = GetContainerAllocationCountersStorage();
+        AtomicIncrementU64(counters.numAllocations);
+        AtomicAddU64(counters.numBytes, static_cast<uint64_t>(numBytes));
+    }
+
+    inline ContainerAllocationCounters GetContainerAllocationCounters()
+    {
+        ContainerAllocationCounters& counters = GetContainerAllocationCountersStorage();
+        ContainerAllocationCounters snapshot;
+        snapshot.numAllocations = AtomicLoadU64(counters.numAllocations, MemoryOrder::ACQUIRE);
+        snapshot.numBytes = AtomicLoadU64(counters.numBytes, MemoryOrder::ACQUIRE);
+        return snapshot;
+    }
+
+}; //end namespace Util
+}; //end namespace PklE
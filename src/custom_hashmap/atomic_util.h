@@ -12,6 +12,7 @@
 #if (ATOMIC_UTIL_BUILD_TOOLSET == ATOMIC_UTIL_BUILD_TOOLSET_MSVC)
 #define PKLE_ATOMIC_MEMORDER_IGNORE_MEMORY_BARRIERS 0
 #define PKLE_ATOMIC_MEMORDER_ENFORCE_MEMORY_BARRIERS 1
+#include <intrin.h>
 #endif
 
 namespace PklE
@@ -564,6 +565,135 @@ namespace Util
     template<>
     inline void AtomicStore<void*>(void*& value, void* newValue, MemoryOrder order) {AtomicStorePtr(reinterpret_cast<void**>(&value), newValue, order);}
 
+    //128 bit (double width) atomics. All operations are sequentially consistent.
+    //x86-64 uses lock cmpxchg16b, other targets use a portable fallback that serializes through a small table of
+    //spinlocks picked by address. A location that is accessed with these functions must only be accessed with them.
+    struct alignas(16) AtomicU128
+    {
+        uint64_t low = 0;
+        uint64_t high = 0;
+    };
+
+    #if defined(__x86_64__) || defined(_M_X64)
+    #define PKLE_ATOMIC_128_IS_LOCK_FREE 1
+    #else
+    #define PKLE_ATOMIC_128_IS_LOCK_FREE 0
+
+    inline uint32_t& GetAtomic128FallbackLock(const void* pAddress)
+    {
+        struct alignas(64) FallbackLock
+        {
+            uint32_t lock = 0;
+        };
+        static FallbackLock s_locks[64];
+        return s_locks[(reinterpret_cast<uintptr_t>(pAddress) >> 4) & 63].lock;
+    }
+    #endif
+
+    //Returns true if successful. On failure comparand receives the current value, so a retry loop does not need to reload it.
+    inline bool AtomicCompareExchange128(AtomicU128& value, const AtomicU128 newValue, AtomicU128& comparand)
+    {
+        #if (ATOMIC_UTIL_BUILD_TOOLSET == ATOMIC_UTIL_BUILD_TOOLSET_MSVC) && defined(_M_X64)
+        return _InterlockedCompareExchange128(reinterpret_cast<volatile int64_t*>(&value), static_cast<int64_t>(newValue.high), static_cast<int64_t>(newValue.low), reinterpret_cast<int64_t*>(&comparand)) != 0;
+        #elif defined(__x86_64__)
+        bool bExchanged;
+        __asm__ __volatile__("lock cmpxchg16b %1"
+            : "=@ccz"(bExchanged), "+m"(value), "+a"(comparand.low), "+d"(comparand.high)
+            : "b"(newValue.low), "c"(newValue.high)
+            : "memory");
+        return bExchanged;
+        #else
+        uint32_t& lock = GetAtomic128FallbackLock(&value);
+        while(!AtomicCompareExchangeU32(lock, 1, 0, MemoryOrder::ACQUIRE, MemoryOrder::RELAXED))
+        {
+        }
+        const bool bExchanged = (value.low == comparand.low) && (value.high == comparand.high);
+        if(bExchanged)
+        {
+            value = newValue;
+        }
+        else
+        {
+            comparand = value;
+        }
+        AtomicStoreU32(lock, 0, MemoryOrder::RELEASE);
+        return bExchanged;
+        #endif
+    }
+
+    //cmpxchg16b has no plain 128 bit load, so this is a compare exchange that writes back the value it found.
+    //It needs writable memory and costs as much as a write.
+    inline AtomicU128 AtomicLoad128(const AtomicU128& value)
+    {
+        AtomicU128 current;
+        AtomicCompareExchange128(const_cast<AtomicU128&>(value), current, current);
+        return current;
+    }
+
+    inline void AtomicStore128(AtomicU128& value, const AtomicU128 newValue)
+    {
+        AtomicU128 current;
+        while(!AtomicCompareExchange128(value, newValue, current))
+        {
+        }
+    }
+
+    //Pointer plus 64 bit version tag, swapped as one 128 bit unit. Every successful exchange bumps the tag, so a
+    //compare exchange against a stale snapshot fails even when the pointer was changed and then changed back (ABA).
+    template<typename T>
+    class AtomicTaggedPtr
+    {
+        AtomicU128 bits;
+
+    public:
+        struct Snapshot
+        {
+            T* pointer = nullptr;
+            uint64_t tag = 0;
+        };
+
+        AtomicTaggedPtr() = default;
+
+        explicit AtomicTaggedPtr(T* pointer)
+        {
+            bits.low = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(pointer));
+        }
+
+        Snapshot Load() const
+        {
+            const AtomicU128 current = AtomicLoad128(bits);
+            return Snapshot{reinterpret_cast<T*>(static_cast<uintptr_t>(current.low)), current.high};
+        }
+
+        //Replaces expected with newPointer and expected.tag + 1. On failure expected receives the current snapshot.
+        bool CompareExchange(Snapshot& expected, T* newPointer)
+        {
+            AtomicU128 comparand;
+            comparand.low = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(expected.pointer));
+            comparand.high = expected.tag;
+            AtomicU128 newValue;
+            newValue.low = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(newPointer));
+            newValue.high = expected.tag + 1;
+            const bool bExchanged = AtomicCompareExchange128(bits, newValue, comparand);
+            if(!bExchanged)
+            {
+                expected.pointer = reinterpret_cast<T*>(static_cast<uintptr_t>(comparand.low));
+                expected.tag = comparand.high;
+            }
+            return bExchanged;
+        }
+
+        //Not for use while other threads may access the pointer, the tag keeps counting
+        void Reset(T* pointer)
+        {
+            AtomicU128 current = AtomicLoad128(bits);
+            AtomicU128 newValue;
+            newValue.low = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(pointer));
+            newValue.high = current.high + 1;
+            AtomicStore128(bits, newValue);
+        }
+    };
+
 
     template<const size_t Alignment_T>
     struct AtomicAlignasHelper
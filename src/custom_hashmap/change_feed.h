@@ -0,0 +1,218 @@
+#pragma once
+
+#include <stdint.h>
+#include <type_traits>
+#include "atomic_util.h"
+
+namespace PklE
+{
+namespace ThreadsafeContainers
+{
+    inline constexpr uint32_t c_defaultChangeFeedCapacity = 4096; //Records per shard
+
+    enum class ChangeType : uint32_t
+    {
+        Insert = 0,
+        Remove = 1,
+        ReKey = 2,
+        Clear = 3, //Whole shard was cleared, key is unset
+    };
+
+    // One mutation as seen by a subscriber. Records carry keys only, read the current value from the map if needed.
+    template<typename Key_T>
+    struct ChangeRecord
+    {
+        uint64_t sequence = 0; //Per shard, consecutive records of a shard have consecutive sequence numbers
+        uint32_t shardIndex = 0;
+        ChangeType type = ChangeType::Insert;
+        Key_T key;
+        Key_T newKey; //ReKey only
+    };
+
+    // Fixed size multi producer ring buffer of change records for one shard (inner map).
+    //
+    // - Writers never block or wait on subscribers, the oldest records are overwritten when the ring is full.
+    // - A writer claims a position with one atomic add, then publishes the slot seqlock style:
+    //   the slot sequence is 0 while it is being written and position + 1 once the record is complete.
+    // - Readers copy a slot and re-check its sequence, a changed sequence means the slot was overwritten
+    //   while reading, which is reported as an overflow.
+    template<typename Key_T, uint32_t Capacity_T>
+    class ChangeFeedRing
+    {
+        static_assert((Capacity_T & (Capacity_T - 1)) == 0, "ChangeFeedRing: Capacity_T must be a power of two.");
+        static_assert(std::is_trivially_copyable_v<Key_T>, "ChangeFeedRing: Key_T must be trivially copyable.");
+
+    public:
+        inline static constexpr uint64_t c_capacity = Capacity_T;
+        inline static constexpr uint64_t c_indexMask = c_capacity - 1;
+
+        enum class ReadStatus : uint32_t
+        {
+            Success = 0,
+            Empty = 1, //Nothing published at this sequence yet
+            Overflow = 2, //The record at this sequence was overwritten
+        };
+
+    private:
+        struct Slot
+        {
+            uint64_t sequence = 0;
+            ChangeType type = ChangeType::Insert;
+            Key_T key;
+            Key_T newKey;
+        };
+
+        alignas(64) uint64_t writePosition = 0;
+        alignas(64) Slot slots[Capacity_T];
+
+    public:
+        void Append(const ChangeType type, const Key_T& key, const Key_T& newKey)
+        {
+            const uint64_t position = Util::AtomicIncrementU64(writePosition) - 1;
+            Slot& slot = slots[position & c_indexMask];
+
+            Util::AtomicStoreU64(slot.sequence, 0, Util::MemoryOrder::RELAXED);
+            Util::AtomicThreadFence(Util::MemoryOrder::RELEASE);
+            slot.type = type;
+            slot.key = key;
+            slot.newKey = newKey;
+            Util::AtomicStoreU64(slot.sequence, position + 1, Util::MemoryOrder::RELEASE);
+        }
+
+        // Sequence the next appended record will get
+        uint64_t GetWritePosition() const
+        {
+            return Util::AtomicLoadU64(writePosition, Util::MemoryOrder::ACQUIRE);
+        }
+
+        // Oldest sequence that has not been overwritten yet
+        uint64_t GetOldestSequence() const
+        {
+            const uint64_t position = GetWritePosition();
+            return (position > c_capacity) ? (position - c_capacity) : 0;
+        }
+
+        ReadStatus Read(const uint64_t sequence, ChangeType& outType, Key_T& outKey, Key_T& outNewKey) const
+        {
+            const uint64_t position = GetWritePosition();
+            if(sequence >= position)
+            {
+                return ReadStatus::Empty;
+            }
+            if((position - sequence) > c_capacity)
+            {
+                return ReadStatus::Overflow;
+            }
+
+            const Slot& slot = slots[sequence & c_indexMask];
+            const uint64_t slotSequence = Util::AtomicLoadU64(slot.sequence, Util::MemoryOrder::ACQUIRE);
+            if(slotSequence != (sequence + 1))
+            {
+                //Either still being written (or not started) for this sequence, or already reused for a later one
+                return (slotSequence > (sequence + 1)) ? ReadStatus::Overflow : ReadStatus::Empty;
+            }
+
+            outType = slot.type;
+            outKey = slot.key;
+            outNewKey = slot.newKey;
+
+            Util::AtomicThreadFence(Util::MemoryOrder::ACQUIRE);
+            if(Util::AtomicLoadU64(slot.sequence, Util::MemoryOrder::RELAXED) != slotSequence)
+            {
+                return ReadStatus::Overflow;
+            }
+            return ReadStatus::Success;
+        }
+    };
+
+    // Change data capture stream for a HashMap: one ChangeFeedRing per inner map (shard).
+    //
+    // - Attach with HashMap::SetChangeFeed(), the map then appends a record for every successful
+    //   Insert_*, Remove_* and ReKey_* (and Clear) while holding the shard's lock, so records of
+    //   one shard are in the order the shard applied them.
+    // - A ReKey across shards is recorded as a Remove in the old shard and an Insert in the new one.
+    // - There is no order between shards, records of one key always land in the same shard.
+    // - Subscribers are passive, each keeps its own Cursor and polls. Any number of subscribers can poll concurrently.
+    template<typename Key_T, uint32_t NumShards_T, uint32_t Capacity_T = c_defaultChangeFeedCapacity>
+    class HashMapChangeFeed
+    {
+    public:
+        using RingType = ChangeFeedRing<Key_T, Capacity_T>;
+        using RecordType = ChangeRecord<Key_T>;
+        inline static constexpr uint32_t c_numShards = NumShards_T;
+
+        // Read position of one subscriber
+        struct Cursor
+        {
+            uint64_t nextSequence[NumShards_T] = {0};
+            uint64_t numLost = 0; //Records overwritten before this subscriber read them. Non zero means the subscriber has to resync.
+        };
+
+    private:
+        RingType shards[NumShards_T];
+
+    public:
+        RingType& GetShard(const uint32_t shardIndex)
+        {
+            return shards[shardIndex];
+        }
+
+        // Cursor that starts at the current end of every shard, so it only sees changes made from now on
+        Cursor Subscribe() const
+        {
+            Cursor cursor;
+            for(uint32_t i = 0; i < NumShards_T; ++i)
+            {
+                cursor.nextSequence[i] = shards[i].GetWritePosition();
+            }
+            return cursor;
+        }
+
+        // Read up to maxRecords published records, walking the shards in turn.
+        // Overwritten records are skipped and counted in cursor.numLost.
+        // Returns the number of records written to pOutRecords
+        uint32_t Poll(Cursor& cursor, RecordType* pOutRecords, const uint32_t maxRecords) const
+        {
+            uint32_t numRead = 0;
+            for(uint32_t shardIndex = 0; (shardIndex < NumShards_T) && (numRead < maxRecords); ++shardIndex)
+            {
+                const RingType& shard = shards[shardIndex];
+                uint64_t& nextSequence = cursor.nextSequence[shardIndex];
+                bool bShardHasRecords = true;
+                while(bShardHasRecords && (numRead < maxRecords))
+                {
+                    RecordType& record = pOutRecords[numRead];
+                    const typename RingType::ReadStatus status = shard.Read(nextSequence, record.type, record.key, record.newKey);
+                    if(status == RingType::ReadStatus::Success)
+                    {
+                        record.sequence = nextSequence;
+                        record.shardIndex = shardIndex;
+                        ++nextSequence;
+                        ++numRead;
+                    }
+                    else if(status == RingType::ReadStatus::Overflow)
+                    {
+                        //Skip ahead to the oldest record that is still in the ring
+                        const uint64_t oldestSequence = shard.GetOldestSequence();
+                        if(oldestSequence > nextSequence)
+                        {
+                            cursor.numLost += oldestSequence - nextSequence;
+                            nextSequence = oldestSequence;
+                        }
+                        else
+                        {
+                            bShardHasRecords = false;
+                        }
+                    }
+                    else
+                    {
+                        bShardHasRecords = false;
+                    }
+                }
+            }
+            return numRead;
+        }
+    };
+
+}; //end namespace ThreadsafeContainers
+}; //end namespace PklE
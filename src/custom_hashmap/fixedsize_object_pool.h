@@ -350,6 +350,19 @@ namespace CoreTypes
             return pSelectedNode;
         }
 
+        // Constructs an object in the free slot nodeIndex, e.g. to copy another pool slot by slot. Returns nullptr if the slot is taken.
+        template<typename... Args_T>
+        T* ReserveAt(const IndexType nodeIndex, Args_T&&... args)
+        {
+            T* pSelectedNode = nullptr;
+            if(SetAllocated(nodeIndex))
+            {
+                pSelectedNode = Util::Construct<T>(nodes[nodeIndex].data, std::forward<Args_T>(args)...);
+                Util::AtomicIncrement<IndexType>(numAllocated);
+            }
+            return pSelectedNode;
+        }
+
         void* ReserveRaw()
         {
             void* pSelectedNode = nullptr;            
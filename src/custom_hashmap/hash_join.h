@@ -0,0 +1,279 @@
+#pragma once
+
+#include <stdint.h>
+#include <thread>
+#include <type_traits>
+#include "atomic_util.h"
+#include "logging_util.h"
+#include "memory_util.h"
+#include "hash_map.h"
+#include "worker_threads.h"
+
+namespace PklE
+{
+namespace ThreadsafeContainers
+{
+    // One join result, row indices into the build and probe inputs
+    struct JoinMatch
+    {
+        uint32_t buildRow;
+        uint64_t probeRow;
+    };
+
+    // Parallel in-memory equi-join with a HashMap as the hash table of the build side.
+    //
+    // - Build() radix partitions the build rows by their inner map index (the shard bits of the hash),
+    //   then each worker inserts whole partitions with HashMap::InsertPartitioned_Lockless, so no locks are taken.
+    // - Duplicate build keys share one multi entry: the map value is the head of a chain of build rows
+    //   linked through a row array, so a key costs one node however many rows carry it.
+    // - Probe() hands out chunks of probe rows to workers and probes each chunk in batches:
+    //   hash the whole batch, look the whole batch up, then walk the chains of the hits.
+    //   Matches are passed to a consumer in blocks, the operator does not materialize the result.
+    template<typename Key_T, uint32_t NumPartitions_T = 16, uint32_t PageSize_T = 8>
+    class HashJoin
+    {
+    public:
+        inline static constexpr uint32_t c_invalidRow = UINT32_MAX;
+        inline static constexpr uint32_t c_maxThreads = 64;
+        inline static constexpr uint32_t c_probeBatchSize = 32;
+        inline static constexpr uint32_t c_matchBlockSize = 1024; //Matches a worker buffers before calling the consumer
+        inline static constexpr uint64_t c_probeChunkSize = 16384; //Probe rows a worker takes at a time
+
+        struct MultiEntry
+        {
+            uint32_t headRow = c_invalidRow; //Latest build row with this key, older rows follow through the row chain
+            uint32_t numRows = 0;
+        };
+        using BuildMapType = HashMap<Key_T, MultiEntry, PageSize_T, NumPartitions_T>;
+
+    private:
+        struct PartitionedRow
+        {
+            uint64_t hash;
+            uint32_t row;
+        };
+
+        BuildMapType buildMap;
+        uint32_t* pNextRow = nullptr; //Per build row, the next older build row with the same key
+        uint32_t numBuildRows = 0;
+
+        // Runs func(workerIndex) on numThreads workers, the calling thread is worker 0
+        template<typename Func_T>
+        static void RunOnWorkers(const uint32_t numThreads, Func_T&& func)
+        {
+            Util::RunOnWorkerThreads(numThreads, std::forward<Func_T>(func));
+        }
+
+        static uint32_t ClampThreads(const uint32_t numThreads)
+        {
+            if(numThreads == 0)
+            {
+                return 1;
+            }
+            return (numThreads > c_maxThreads) ? c_maxThreads : numThreads;
+        }
+
+    public:
+        HashJoin() = default;
+        HashJoin(const HashJoin&) = delete;
+        HashJoin& operator=(const HashJoin&) = delete;
+
+        ~HashJoin()
+        {
+            Util::Free(pNextRow);
+        }
+
+        // Builds the hash table from numRows build keys, row i is keys[i]. Replaces any previous build.
+        // keys only has to stay valid during the call.
+        void Build(const Key_T* keys, const uint32_t numRows, const uint32_t numThreads)
+        {
+            const uint32_t numWorkers = ClampThreads(numThreads);
+
+            buildMap.Clear_Lockless();
+            buildMap.Reserve(numRows);
+            Util::Free(pNextRow);
+            pNextRow = static_cast<uint32_t*>(Util::Malloc(sizeof(uint32_t) * ((numRows > 0) ? numRows : 1)));
+            numBuildRows = numRows;
+
+            uint64_t* pHashes = static_cast<uint64_t*>(Util::Malloc(sizeof(uint64_t) * ((numRows > 0) ? numRows : 1)));
+            PartitionedRow* pPartitioned = static_cast<PartitionedRow*>(Util::Malloc(sizeof(PartitionedRow) * ((numRows > 0) ? numRows : 1)));
+            uint32_t histograms[c_maxThreads][NumPartitions_T] = {};
+            uint32_t partitionStarts[NumPartitions_T + 1] = {};
+
+            const uint32_t rowsPerWorker = (numRows + numWorkers - 1) / numWorkers;
+            auto GetWorkerRows = [&](const uint32_t workerIndex, uint32_t& outBegin, uint32_t& outEnd)
+            {
+                const uint64_t begin = static_cast<uint64_t>(workerIndex) * rowsPerWorker;
+                const uint64_t end = begin + rowsPerWorker;
+                outBegin = static_cast<uint32_t>((begin < numRows) ? begin : numRows);
+                outEnd = static_cast<uint32_t>((end < numRows) ? end : numRows);
+            };
+
+            //Pass 1: hash and count rows per partition, each worker over its own slice of the input
+            RunOnWorkers(numWorkers, [&](const uint32_t workerIndex)
+            {
+                uint32_t begin, end;
+                GetWorkerRows(workerIndex, begin, end);
+                uint32_t* pHistogram = histograms[workerIndex];
+                for(uint32_t row = begin; row < end; ++row)
+                {
+                    const uint64_t hash = BuildMapType::HashKey(keys[row]);
+                    pHashes[row] = hash;
+                    ++pHistogram[buildMap.GetInnerMapIndex(hash)];
+                }
+            });
+
+            //Turn the histograms into write offsets: partition major, then worker, so each partition is contiguous
+            uint32_t offset = 0;
+            for(uint32_t partition = 0; partition < NumPartitions_T; ++partition)
+            {
+                partitionStarts[partition] = offset;
+                for(uint32_t workerIndex = 0; workerIndex < numWorkers; ++workerIndex)
+                {
+                    const uint32_t numInPartition = histograms[workerIndex][partition];
+                    histograms[workerIndex][partition] = offset;
+                    offset += numInPartition;
+                }
+            }
+            partitionStarts[NumPartitions_T] = offset;
+
+            //Pass 2: scatter, every worker writes to its own ranges
+            RunOnWorkers(numWorkers, [&](const uint32_t workerIndex)
+            {
+                uint32_t begin, end;
+                GetWorkerRows(workerIndex, begin, end);
+                uint32_t* pOffsets = histograms[workerIndex];
+                for(uint32_t row = begin; row < end; ++row)
+                {
+                    const uint64_t hash = pHashes[row];
+                    PartitionedRow& out = pPartitioned[pOffsets[buildMap.GetInnerMapIndex(hash)]++];
+                    out.hash = hash;
+                    out.row = row;
+                }
+            });
+
+            //Pass 3: build, a partition is one inner map and is owned by exactly one worker.
+            //Rows of a partition are in input order, so each chain lists a key's rows newest first.
+            RunOnWorkers(numWorkers, [&](const uint32_t workerIndex)
+            {
+                for(uint32_t partition = workerIndex; partition < NumPartitions_T; partition += numWorkers)
+                {
+                    for(uint32_t i = partitionStarts[partition]; i < partitionStarts[partition + 1]; ++i)
+                    {
+                        const PartitionedRow& partitionedRow = pPartitioned[i];
+                        const Key_T& key = keys[partitionedRow.row];
+                        typename BuildMapType::KeyValuePair* pPair = buildMap.FindWithHash_Lockless(partitionedRow.hash, key);
+                        if(pPair)
+                        {
+                            pNextRow[partitionedRow.row] = pPair->value.headRow;
+                            pPair->value.headRow = partitionedRow.row;
+                            ++pPair->value.numRows;
+                        }
+                        else
+                        {
+                            pNextRow[partitionedRow.row] = c_invalidRow;
+                            buildMap.InsertPartitioned_Lockless(partitionedRow.hash, key, MultiEntry{partitionedRow.row, 1});
+                        }
+                    }
+                }
+            });
+
+            Util::Free(pPartitioned);
+            Util::Free(pHashes);
+        }
+
+        // Probes numRows probe keys against the last Build().
+        // consumer(workerIndex, const JoinMatch* pMatches, uint32_t numMatches) is called concurrently from
+        // the workers, each call with matches of that worker only. Matches have no particular order.
+        // Returns the total number of matches.
+        template<typename Consumer_T>
+        uint64_t Probe(const Key_T* keys, const uint64_t numRows, const uint32_t numThreads, Consumer_T&& consumer) const
+        {
+            const uint32_t numWorkers = ClampThreads(numThreads);
+            uint64_t nextChunk = 0;
+            uint64_t totalMatches = 0;
+
+            RunOnWorkers(numWorkers, [&](const uint32_t workerIndex)
+            {
+                JoinMatch matches[c_matchBlockSize];
+                uint32_t numMatches = 0;
+                uint64_t numWorkerMatches = 0;
+                uint64_t hashes[c_probeBatchSize];
+                const typename BuildMapType::KeyValuePair* pFound[c_probeBatchSize];
+
+                for(;;)
+                {
+                    const uint64_t chunkBegin = Util::AtomicAddU64(nextChunk, c_probeChunkSize) - c_probeChunkSize;
+                    if(chunkBegin >= numRows)
+                    {
+                        break;
+                    }
+                    const uint64_t chunkEnd = ((numRows - chunkBegin) > c_probeChunkSize) ? (chunkBegin + c_probeChunkSize) : numRows;
+
+                    for(uint64_t batchBegin = chunkBegin; batchBegin < chunkEnd; batchBegin += c_probeBatchSize)
+                    {
+                        const uint32_t batchSize = static_cast<uint32_t>(((chunkEnd - batchBegin) > c_probeBatchSize) ? c_probeBatchSize : (chunkEnd - batchBegin));
+                        const Key_T* pBatchKeys = keys + batchBegin;
+
+                        //Split hashing from the lookups so the independent hash computations and
+                        //bucket loads of a batch can overlap instead of running one key at a time
+                        for(uint32_t i = 0; i < batchSize; ++i)
+                        {
+                            hashes[i] = BuildMapType::HashKey(pBatchKeys[i]);
+                        }
+                        for(uint32_t i = 0; i < batchSize; ++i)
+                        {
+                            pFound[i] = buildMap.FindWithHash_Lockless(hashes[i], pBatchKeys[i]);
+                        }
+                        for(uint32_t i = 0; i < batchSize; ++i)
+                        {
+                            if(!pFound[i])
+                            {
+                                continue;
+                            }
+                            for(uint32_t row = pFound[i]->value.headRow; row != c_invalidRow; row = pNextRow[row])
+                            {
+                                if(numMatches == c_matchBlockSize)
+                                {
+                                    consumer(workerIndex, static_cast<const JoinMatch*>(matches), numMatches);
+                                    numWorkerMatches += numMatches;
+                                    numMatches = 0;
+                                }
+                                matches[numMatches].buildRow = row;
+                                matches[numMatches].probeRow = batchBegin + i;
+                                ++numMatches;
+                            }
+                        }
+                    }
+                }
+
+                if(numMatches > 0)
+                {
+                    consumer(workerIndex, static_cast<const JoinMatch*>(matches), numMatches);
+                    numWorkerMatches += numMatches;
+                }
+                Util::AtomicAddU64(totalMatches, numWorkerMatches);
+            });
+
+            return totalMatches;
+        }
+
+        uint32_t GetNumBuildRows() const
+        {
+            return numBuildRows;
+        }
+
+        // Distinct build keys
+        uint32_t GetNumBuildKeys() const
+        {
+            return buildMap.Size();
+        }
+
+        const BuildMapType& GetBuildMap() const
+        {
+            return buildMap;
+        }
+    };
+
+}; //end namespace ThreadsafeContainers
+}; //end namespace PklE
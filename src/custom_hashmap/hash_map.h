@@ -5,21 +5,79 @@
 #include "spin_lock.h"
 #include "hash_type.h"
 #include "magic_num_util.h"
+#include "striped_counter.h"
 
 #include "simple_linked_list.h"
+#include "unrolled_linked_list.h"
+#include "string_key_arena.h"
+#include "change_feed.h"
+#include "hot_key_sketch.h"
+#include "worker_threads.h"
 
 namespace PklE
 {
 namespace ThreadsafeContainers
 {
-    template<typename Key_T, typename Value_T, uint32_t PageSize_T = 8, uint32_t NumInnerMaps_T = 4>
+    // UnrolledBuckets_T stores bucket chains as cache-line blocks of (hash tag, node pointer) slots
+    // instead of following one node pointer per hop. See unrolled_linked_list.h.
+    template<typename Key_T, typename Value_T, uint32_t PageSize_T = 8, uint32_t NumInnerMaps_T = 4, bool UnrolledBuckets_T = false>
     class HashMap
     {
         // static assert that NumInnerMaps_T is a power of two
         static_assert((NumInnerMaps_T & (NumInnerMaps_T - 1)) == 0, "HashMap: NumInnerMaps_T must be a power of two.");
 
         public:
-        using ThisHashMapType = HashMap<Key_T, Value_T, PageSize_T, NumInnerMaps_T>;
+        using ThisHashMapType = HashMap<Key_T, Value_T, PageSize_T, NumInnerMaps_T, UnrolledBuckets_T>;
+
+        enum class InsertStatus : uint32_t
+        {
+            Inserted = 0,
+            KeyExists = 1,
+            CapacityExhausted = 2, //Fixed capacity mode only, see SetFixedCapacity()
+        };
+
+        // What Merge() does with a donor entry whose key is already in the map
+        enum class MergeConflictPolicy : uint32_t
+        {
+            KeepExisting = 0,
+            Overwrite = 1, //Move the donor's value over the existing one
+        };
+
+        // Change records copy keys, so only trivially copyable keys that own their bytes can be fed.
+        // Arena stored keys only point at their bytes, which a record could outlive.
+        inline static constexpr bool c_supportsChangeFeed = std::is_trivially_copyable_v<Key_T> && std::is_same_v<typename HashMapKeyStorage<Key_T>::ArenaType, NoKeyArena>;
+        using ChangeFeedType = HashMapChangeFeed<Key_T, NumInnerMaps_T, c_defaultChangeFeedCapacity>;
+        using ChangeFeedRingType = ChangeFeedRing<Key_T, c_defaultChangeFeedCapacity>;
+
+        // The hot key sketch keeps copies of sampled keys, same restriction as the change feed
+        inline static constexpr bool c_supportsHotKeySketch = c_supportsChangeFeed;
+        using HotKeySketchType = HotKeySketch<Key_T, NumInnerMaps_T>;
+
+        // Checkpoint stream layout, all fields in native byte order:
+        //   CheckpointHeader, then numPages x (CheckpointPageHeader, numEntries x CheckpointEntry)
+        // A page record replaces everything earlier checkpoints recorded for that page index.
+        // A full checkpoint (bFullCheckpoint) replaces all pages.
+        inline static constexpr uint32_t c_checkpointMagic = 0x504B4C43; //"PKLC"
+        struct CheckpointHeader
+        {
+            uint32_t magic = c_checkpointMagic;
+            uint32_t bFullCheckpoint = 0;
+            uint64_t checkpointIndex = 0;
+            uint32_t numPages = 0;
+            uint32_t totalCount = 0; //Entries in the map when the checkpoint began
+        };
+
+        struct CheckpointPageHeader
+        {
+            uint32_t pageIndex = 0;
+            uint32_t numEntries = 0;
+        };
+
+        struct CheckpointEntry
+        {
+            Key_T key;
+            Value_T value;
+        };
         struct KeyValuePair
         {
             const Key_T key;
@@ -40,6 +98,9 @@ namespace ThreadsafeContainers
 
         private:
 
+        using KeyStorage = HashMapKeyStorage<Key_T>;
+        using KeyArenaType = typename KeyStorage::ArenaType;
+
         struct Node : KeyValuePair
         {
             inline static constexpr uint32_t c_invalidBucket = 0xFFFFFFFF;
@@ -59,25 +120,21 @@ namespace ThreadsafeContainers
         {
             static int Compare(const Key_T& a, const Comparable_T& b)
             {
-                if(a < b)
-                {
-                    return -1;
-                }
-                else if(a > b)
-                {
-                    return 1;
-                }
-                return 0;
+                return KeyStorage::Compare(a, b);
             }
         };
 
-        struct Bucket
+        using UnrolledListType = UnrolledLinkedList<Node>;
+        using BlockPoolType = CoreTypes::PagingObjectPool<typename UnrolledListType::Block, PageSize_T, UnrolledListType::c_blockAlignment>;
+
+        struct ChainedBucket
         {
             mutable SimpleLinkedList<Node> list;
+            uint32_t generation = 0; //See InnerMap::GetBucketForWrite()
 
-            Bucket() = default;
+            ChainedBucket() = default;
 
-            bool Insert_Lockless(Node* pNewNode)
+            bool Insert_Lockless(Node* pNewNode, const uint64_t /*hash*/, BlockPoolType& /*blockPool*/)
             {
                 return list.Insert_Unsafe(pNewNode);
             }
@@ -87,9 +144,9 @@ namespace ThreadsafeContainers
                 return list.Insert(pNewNode);
             }
 
-            bool InsertUnique_Lockless(Node* pNewNode)
+            bool InsertUnique_Lockless(Node* pNewNode, const uint64_t hash, BlockPoolType& blockPool)
             {
-                const Node* pExistingNode = Find_Lockless(pNewNode->key);
+                const Node* pExistingNode = Find_Lockless(hash, pNewNode->key);
                 if(!pExistingNode)
                 {
                     return list.Insert_Unsafe(pNewNode);
@@ -115,7 +172,7 @@ namespace ThreadsafeContainers
             }
 
             template<typename Comparable_T>
-            const Node* Find_Lockless(const Comparable_T& key) const
+            const Node* Find_Lockless(const uint64_t /*hash*/, const Comparable_T& key) const
             {
                 return list.template Find_Unsafe<Comparable_T, KeyComparator<Comparable_T>>(key);
             }
@@ -127,7 +184,7 @@ namespace ThreadsafeContainers
             }
 
             template<typename Comparable_T>
-            Node* Find_Lockless(const Comparable_T& key)
+            Node* Find_Lockless(const uint64_t /*hash*/, const Comparable_T& key)
             {
                 return list.template Find_Unsafe<Comparable_T, KeyComparator<Comparable_T>>(key);
             }
@@ -139,7 +196,7 @@ namespace ThreadsafeContainers
             }
 
             template<typename Comparable_T>
-            Node* Erase_Lockless(const Comparable_T& key)
+            Node* Erase_Lockless(const uint64_t /*hash*/, const Comparable_T& key, BlockPoolType& /*blockPool*/)
             {
                 return list.template Erase_Unsafe<Comparable_T, KeyComparator<Comparable_T>>(key);
             }
@@ -150,28 +207,130 @@ namespace ThreadsafeContainers
                 return list.template Erase<Comparable_T, KeyComparator<Comparable_T>>(key);
             }
 
+            // Visits every node, reading the next link before the callback so the node can be re-linked
+            template<typename Func_T>
+            void ForEachNode_Lockless(Func_T&& func)
+            {
+                Node* pNode = list.GetHead();
+                while(pNode)
+                {
+                    Node* pNextNode = pNode->pNext;
+                    pNode->pNext = nullptr;
+                    func(pNode);
+                    pNode = pNextNode;
+                }
+            }
+
             // Resets the bucket list to an empty state without cleaning up nodes
-            void Reset_Lockless()
+            void Reset_Lockless(BlockPoolType& /*blockPool*/)
+            {
+                list.Reset_Unsafe();
+            }
+
+            // Reset_Lockless() for a bucket whose nodes and blocks went away with a cleared pool
+            void Forget_Lockless()
             {
                 list.Reset_Unsafe();
             }
+
+            // Link the copies of source's nodes into the same chain, see HashMap::Clone()
+            template<typename TranslateNode_T, typename TranslateBlock_T>
+            void CopyLinks_Lockless(const ChainedBucket& source, TranslateNode_T&& translateNode, TranslateBlock_T&& /*translateBlock*/)
+            {
+                list.CopyLinks_Unsafe(source.list, translateNode);
+            }
+        };
+
+        // Bucket made of cache-line blocks of (tag, node pointer) slots. Nodes stay in the shared pool,
+        // only the blocks are reserved from the block pool.
+        struct UnrolledBucket
+        {
+            UnrolledListType list;
+            uint32_t generation = 0; //See InnerMap::GetBucketForWrite()
+
+            UnrolledBucket() = default;
+
+            bool Insert_Lockless(Node* pNewNode, const uint64_t hash, BlockPoolType& blockPool)
+            {
+                return list.Insert_Unsafe(pNewNode, hash, blockPool);
+            }
+
+            bool InsertUnique_Lockless(Node* pNewNode, const uint64_t hash, BlockPoolType& blockPool)
+            {
+                const Node* pExistingNode = Find_Lockless(hash, pNewNode->key);
+                if(!pExistingNode)
+                {
+                    return list.Insert_Unsafe(pNewNode, hash, blockPool);
+                }
+                return false;
+            }
+
+            template<typename Comparable_T>
+            const Node* Find_Lockless(const uint64_t hash, const Comparable_T& key) const
+            {
+                return list.template Find_Unsafe<Comparable_T, KeyComparator<Comparable_T>>(hash, key);
+            }
+
+            template<typename Comparable_T>
+            Node* Find_Lockless(const uint64_t hash, const Comparable_T& key)
+            {
+                return list.template Find_Unsafe<Comparable_T, KeyComparator<Comparable_T>>(hash, key);
+            }
+
+            template<typename Comparable_T>
+            Node* Erase_Lockless(const uint64_t hash, const Comparable_T& key, BlockPoolType& blockPool)
+            {
+                return list.template Erase_Unsafe<Comparable_T, KeyComparator<Comparable_T>>(hash, key, blockPool);
+            }
+
+            template<typename Func_T>
+            void ForEachNode_Lockless(Func_T&& func)
+            {
+                list.ForEach_Unsafe(std::forward<Func_T>(func));
+            }
+
+            // Releases the blocks without cleaning up nodes
+            void Reset_Lockless(BlockPoolType& blockPool)
+            {
+                list.Reset_Unsafe(blockPool);
+            }
+
+            // Reset_Lockless() for a bucket whose nodes and blocks went away with a cleared pool
+            void Forget_Lockless()
+            {
+                list.Forget_Unsafe();
+            }
+
+            // Link the copies of source's blocks and nodes into the same chain, see HashMap::Clone()
+            template<typename TranslateNode_T, typename TranslateBlock_T>
+            void CopyLinks_Lockless(const UnrolledBucket& source, TranslateNode_T&& translateNode, TranslateBlock_T&& translateBlock)
+            {
+                list.CopyLinks_Unsafe(source.list, translateBlock, translateNode);
+            }
         };
 
+        using Bucket = std::conditional_t<UnrolledBuckets_T, UnrolledBucket, ChainedBucket>;
+
         inline static constexpr uint64_t c_numInnerMaps = NumInnerMaps_T;
         inline static constexpr uint64_t c_innerMapIndexMask = c_numInnerMaps - 1;
         using PoolType = CoreTypes::PagingObjectPool<Node, PageSize_T>;
         PoolType sharedPool;
+        BlockPoolType sharedBlockPool;
 
         struct InnerMap
         {
             PoolType& pool;
+            BlockPoolType& blockPool;
+            KeyArenaType keyArena; //Key bytes for arena stored keys (ArenaStringKey)
+            ChangeFeedRingType* pChangeFeed = nullptr; //Optional, see SetChangeFeed()
             Bucket* buckets = nullptr;
             uint32_t count = 0;
             uint32_t fillCapacity = 0;
             uint32_t numBuckets = 0;
+            uint32_t generation = 0; //Bumped by Clear_Lockless(), buckets stamped with an older one are empty
             mutable CoreTypes::CountingSpinlock lock;
 
-            InnerMap(PoolType& sharedPool) : pool(sharedPool)
+            InnerMap(PoolType& sharedPool, BlockPoolType& sharedBlockPool) : pool(sharedPool), blockPool(sharedBlockPool)
             {
 
             }
@@ -183,7 +342,10 @@ namespace ThreadsafeContainers
                     for(uint32_t i = 0; i < numBuckets; ++i)
                     {
                         //Destroy old buckets
-                        buckets[i].Reset_Lockless();
+                        if(buckets[i].generation == generation)
+                        {
+                            buckets[i].Reset_Lockless(blockPool);
+                        }
                     }
                     Util::Free(buckets);
                     buckets = nullptr;
@@ -191,6 +353,39 @@ namespace ThreadsafeContainers
                 }
             }
 
+            // Bucket about to be written. A bucket from before the last Clear_Lockless() is reset here on first use,
+            // its nodes and blocks went away with the cleared pools.
+            Bucket& GetBucketForWrite(const uint32_t bucketIndex)
+            {
+                Bucket& bucket = buckets[bucketIndex];
+                if(bucket.generation != generation)
+                {
+                    bucket.Forget_Lockless();
+                    bucket.generation = generation;
+                }
+                return bucket;
+            }
+
+            // Bucket to read, nullptr if it has not been used since the last Clear_Lockless().
+            // Readers only hold the read lock, so they leave stale buckets to the next writer.
+            const Bucket* GetBucketForRead(const uint32_t bucketIndex) const
+            {
+                const Bucket& bucket = buckets[bucketIndex];
+                return (bucket.generation == generation) ? &bucket : nullptr;
+            }
+
+            // Callers hold the inner map's write lock (or exclusive access), which keeps the records in apply order
+            inline void PublishChange(const ChangeType type, const Key_T& key, const Key_T& newKey)
+            {
+                if constexpr (c_supportsChangeFeed)
+                {
+                    if(pChangeFeed)
+                    {
+                        pChangeFeed->Append(type, key, newKey);
+                    }
+                }
+            }
+
             uint32_t GetIndex(const uint64_t hash) const
             {
                 //Table is always power of two sized, so we can use bitmasking
@@ -200,31 +395,35 @@ namespace ThreadsafeContainers
             void Resize(const uint32_t newNumBuckets)
             {   
                 Bucket* pNewBuckets = Util::NewArray<Bucket>(newNumBuckets);
+                Util::CountContainerAllocation(sizeof(Bucket) * newNumBuckets);
+                for(uint32_t i = 0; i < newNumBuckets; ++i)
+                {
+                    pNewBuckets[i].generation = generation;
+                }
 
                 //Iterate through the buckets and move nodes to the new buckets
                 const uint32_t oldNumBuckets = numBuckets;
                 numBuckets = newNumBuckets;
                 for(uint32_t i = 0; i < oldNumBuckets; ++i)
                 {
-                    Bucket& oldBucket = buckets[i];
-                    Node* pNode = oldBucket.list.GetHead();
-                    while(pNode)
+                    if(buckets[i].generation != generation)
                     {
-                        Node* pNextNode = pNode->pNext;
-                        pNode->pNext = nullptr;
-
-                        const uint64_t hash = Util::HashType::Hash64(pNode->key);
+                        //Empty since the last Clear_Lockless(), its blocks went away with the block pool
+                        buckets[i].Forget_Lockless();
+                        continue;
+                    }
+                    buckets[i].ForEachNode_Lockless([this, pNewBuckets](Node* pNode)
+                    {
+                        const uint64_t hash = KeyStorage::Hash(pNode->key);
                         const uint32_t newBucketIndex = GetIndex(hash);
 
                         pNode->bucket = newBucketIndex;
-                        bool bInserted = pNewBuckets[newBucketIndex].Insert_Lockless(pNode);
+                        bool bInserted = pNewBuckets[newBucketIndex].Insert_Lockless(pNode, hash, blockPool);
                         if(!bInserted)
                         {
                             PKLE_ASSERT_SYSTEM_ERROR_MSG(false, "HashMap::Resize: Insertion into new bucket failed during resize. This should never happen.");
                         }
-
-                        pNode = pNextNode;
-                    }
+                    });
                 }
 
                 if(buckets)
@@ -232,7 +431,7 @@ namespace ThreadsafeContainers
                     for(uint32_t i = 0; i < oldNumBuckets; ++i)
                     {
                         //Destroy old buckets
-                        buckets[i].Reset_Lockless();
+                        buckets[i].Reset_Lockless(blockPool);
                     }
                     Util::Free(buckets);
                 }
@@ -242,36 +441,74 @@ namespace ThreadsafeContainers
             }
 
             template<typename... Args>
-            KeyValuePair* Insert_Lockless(const uint64_t hash, const Key_T& key, Args&&... args)
+            KeyValuePair* InsertWithStatus_Lockless(const uint64_t hash, const Key_T& key, InsertStatus& outStatus, Args&&... args)
             {
+                //In fixed capacity mode the bucket table keeps its size, chains just get longer past the fill capacity
+                const bool bFixedCapacity = pool.IsFixedCapacity();
+                if(bFixedCapacity && (numBuckets == 0))
+                {
+                    outStatus = InsertStatus::CapacityExhausted;
+                    return nullptr;
+                }
+
                 ++count;
-                if(count > fillCapacity)
+                if((count > fillCapacity) && !bFixedCapacity)
                 {
                     const uint32_t newNumBuckets = PklE::Util::GetNextPowerOfTwo(count * 2);
                     Resize(newNumBuckets);
                 }
 
                 const uint32_t bucket = GetIndex(hash);
+                Bucket& insertBucket = GetBucketForWrite(bucket);
 
                 Node* pNewNode = nullptr;
-                bool bHasExisting = buckets[bucket].Find_Lockless(key) != nullptr;
+                outStatus = InsertStatus::KeyExists;
+                bool bHasExisting = insertBucket.Find_Lockless(hash, key) != nullptr;
                 if(!bHasExisting)
                 {
-                    pNewNode = pool.Reserve(key, std::forward<Args>(args)...);
+                    pNewNode = pool.Reserve(KeyStorage::Persist(keyArena, key), std::forward<Args>(args)...);
+                    if(!pNewNode)
+                    {
+                        //Only in fixed capacity mode, the pool is full
+                        --count;
+                        outStatus = InsertStatus::CapacityExhausted;
+                        return nullptr;
+                    }
+
                     pNewNode->bucket = bucket;
-                    bool bInserted = buckets[bucket].Insert_Lockless(pNewNode);
+                    bool bInserted = insertBucket.Insert_Lockless(pNewNode, hash, blockPool);
                     if(!bInserted)
                     {
-                        //Insertion failed for some reason, free the node and return nullptr
+                        //Insertion failed, in fixed capacity mode because the unrolled block pool is full. Free the node and return nullptr.
                         pool.Release(pNewNode);
                         --count;
                         pNewNode = nullptr;
+                        outStatus = InsertStatus::CapacityExhausted;
+                    }
+                    else
+                    {
+                        PublishChange(ChangeType::Insert, pNewNode->key, pNewNode->key);
+                        outStatus = InsertStatus::Inserted;
                     }
                 }
 
                 return static_cast<KeyValuePair*>(pNewNode);
             }
 
+            template<typename... Args>
+            KeyValuePair* Insert_Lockless(const uint64_t hash, const Key_T& key, Args&&... args)
+            {
+                InsertStatus status;
+                return InsertWithStatus_Lockless(hash, key, status, std::forward<Args>(args)...);
+            }
+
+            template<typename... Args>
+            KeyValuePair* InsertWithStatus_Concurrent(const uint64_t hash, const Key_T& key, InsertStatus& outStatus, Args&&... args)
+            {
+                CoreTypes::ScopedWriteSpinLock writeLock(lock);
+                return InsertWithStatus_Lockless(hash, key, outStatus, std::forward<Args>(args)...);
+            }
+
             template<typename... Args>
             KeyValuePair* Insert_Concurrent(const uint64_t hash, const Key_T& key, Args&&... args)
             {
@@ -282,9 +519,9 @@ namespace ThreadsafeContainers
             template<typename Comparable_T>
             inline KeyValuePair* Find_Lockless(const uint64_t hash,const Comparable_T& key)
             {
-                const uint32_t bucket = GetIndex(hash);
-                Node* pFoundNode = buckets[bucket].Find_Lockless(key);
-                return static_cast<KeyValuePair*>(pFoundNode);
+                const Bucket* pBucket = GetBucketForRead(GetIndex(hash));
+                const Node* pFoundNode = pBucket ? pBucket->Find_Lockless(hash, key) : nullptr;
+                return static_cast<KeyValuePair*>(const_cast<Node*>(pFoundNode));
             }
 
             template<typename Comparable_T>
@@ -297,8 +534,8 @@ namespace ThreadsafeContainers
             template<typename Comparable_T>
             inline const KeyValuePair* Find_Lockless(const uint64_t hash, const Comparable_T& key) const
             {
-                const uint32_t bucket = GetIndex(hash);
-                const Node* pFoundNode = buckets[bucket].Find_Lockless(key);
+                const Bucket* pBucket = GetBucketForRead(GetIndex(hash));
+                const Node* pFoundNode = pBucket ? pBucket->Find_Lockless(hash, key) : nullptr;
                 return static_cast<const KeyValuePair*>(pFoundNode);
             }
 
@@ -309,15 +546,36 @@ namespace ThreadsafeContainers
                 return Find_Lockless(hash, key);
             }
 
+            template<typename Comparable_T, typename Modifier_T>
+            bool Modify_Lockless(const uint64_t hash, const Comparable_T& key, Modifier_T&& modifier)
+            {
+                KeyValuePair* pPair = Find_Lockless(hash, key);
+                if(pPair)
+                {
+                    pool.MarkDirty(static_cast<Node*>(pPair));
+                    modifier(pPair->value);
+                    return true;
+                }
+                return false;
+            }
+
+            template<typename Comparable_T, typename Modifier_T>
+            bool Modify_Concurrent(const uint64_t hash, const Comparable_T& key, Modifier_T&& modifier)
+            {
+                CoreTypes::ScopedWriteSpinLock writeLock(lock);
+                return Modify_Lockless(hash, key, std::forward<Modifier_T>(modifier));
+            }
+
             template<typename Comparable_T>
             bool Remove_Lockless(const uint64_t hash, const Comparable_T& key)
             {
                 bool bRemoved = false;
                 const uint32_t bucket = GetIndex(hash);
 
-                Node* pNode = buckets[bucket].Erase_Lockless(key);
+                Node* pNode = GetBucketForWrite(bucket).Erase_Lockless(hash, key, blockPool);
                 if(pNode)
                 {
+                    PublishChange(ChangeType::Remove, pNode->key, pNode->key);
                     if(pNode->bucket != Node::c_reassigningBucket)
                     {
                         pool.Release(pNode);
@@ -343,9 +601,10 @@ namespace ThreadsafeContainers
                 const uint32_t bucket = pNode->bucket;
                 if(bucket < numBuckets)
                 {
-                    Node* pRemovedNode = buckets[bucket].Erase_Lockless(pNode->key);
+                    Node* pRemovedNode = GetBucketForWrite(bucket).Erase_Lockless(hash, pNode->key, blockPool);
                     if(pRemovedNode)
                     {
+                        PublishChange(ChangeType::Remove, pRemovedNode->key, pRemovedNode->key);
                         if(pRemovedNode->bucket != Node::c_reassigningBucket)
                         {
                             pool.Release(pRemovedNode);
@@ -374,16 +633,22 @@ namespace ThreadsafeContainers
 
                 if((oldBucket < numBuckets))
                 {
-                    if(oldBucket != newBucket)
+                    //Unrolled buckets tag slots with the hash, so the node has to be re-inserted even within the same bucket
+                    if((oldBucket != newBucket) || UnrolledBuckets_T)
                     {
                         pNode->bucket = Node::c_reassigningBucket; //Mark the node as being reassigned to prevent destruction during removal
-                        Node* pRemovedNode = buckets[oldBucket].Erase_Lockless(pNode->key);
-                        pNode->ForceChangeKey(newKey);
+                        Node* pRemovedNode = GetBucketForWrite(oldBucket).Erase_Lockless(hash, pNode->key, blockPool);
+                        if(pRemovedNode)
+                        {
+                            PublishChange(ChangeType::ReKey, pNode->key, newKey);
+                        }
+                        pool.MarkDirty(pNode);
+                        pNode->ForceChangeKey(KeyStorage::Persist(keyArena, newKey));
                         if(pRemovedNode)
                         {
                             pNode->bucket = newBucket;
 
-                            bRekeyed = buckets[newBucket].Insert_Lockless(pNode);
+                            bRekeyed = GetBucketForWrite(newBucket).Insert_Lockless(pNode, newHash, blockPool);
                             if(!bRekeyed)
                             {
                                 PKLE_ASSERT_SYSTEM_ERROR_MSG(false, "ReKey_Lockless: Insertion into new bucket failed during rekeying. The node has been lost. This should never happen.");
@@ -393,7 +658,9 @@ namespace ThreadsafeContainers
                     else
                     {
                         //Same bucket, just change the key
-                        pNode->ForceChangeKey(newKey);
+                        PublishChange(ChangeType::ReKey, pNode->key, newKey);
+                        pool.MarkDirty(pNode);
+                        pNode->ForceChangeKey(KeyStorage::Persist(keyArena, newKey));
                         bRekeyed = true;
                     }
                 }
@@ -418,15 +685,17 @@ namespace ThreadsafeContainers
                             bAttemptedReKey = Util::AtomicCompareExchangeU32(pNode->bucket, Node::c_reassigningBucket, oldBucket);
                             if(bAttemptedReKey)
                             {
-                                if(oldBucket != newBucket)
+                                if((oldBucket != newBucket) || UnrolledBuckets_T)
                                 {
                                     CoreTypes::ScopedWriteSpinLock writeLock(std::move(readLock));
-                                    Node* pRemovedNode = buckets[oldBucket].Erase_Lockless(pNode->key);
+                                    Node* pRemovedNode = GetBucketForWrite(oldBucket).Erase_Lockless(hash, pNode->key, blockPool);
                                     if(pRemovedNode)
                                     {
-                                        pNode->ForceChangeKey(newKey);
+                                        PublishChange(ChangeType::ReKey, pNode->key, newKey);
+                                        pool.MarkDirty(pNode);
+                                        pNode->ForceChangeKey(KeyStorage::Persist(keyArena, newKey));
                                         pNode->bucket = newBucket;
-                                        bRekeyed = buckets[newBucket].Insert_Lockless(pNode);
+                                        bRekeyed = GetBucketForWrite(newBucket).Insert_Lockless(pNode, newHash, blockPool);
                                         if(!bRekeyed)
                                         {
                                             PKLE_ASSERT_SYSTEM_ERROR_MSG(false, "ReKey_Concurrent: Insertion into new bucket failed during rekeying. The node has been lost. This should never happen.");
@@ -436,7 +705,9 @@ namespace ThreadsafeContainers
                                 else
                                 {
                                     //Same bucket, just change the key
-                                    pNode->ForceChangeKey(newKey);
+                                    PublishChange(ChangeType::ReKey, pNode->key, newKey);
+                                    pool.MarkDirty(pNode);
+                                    pNode->ForceChangeKey(KeyStorage::Persist(keyArena, newKey));
                                     pNode->bucket = newBucket;
                                     bRekeyed = true;
                                 }
@@ -467,19 +738,141 @@ namespace ThreadsafeContainers
                 return false;
             }
 
+            // O(1), buckets are reset on their next write by GetBucketForWrite(). The pools have to be cleared along with it.
             void Clear_Lockless()
             {
                 count = 0;
+                ++generation;
+                if(generation == 0)
+                {
+                    //Wrapped around, restamp so that no bucket can match a later generation by accident
+                    for(uint32_t i = 0; i < numBuckets; ++i)
+                    {
+                        buckets[i].generation = 0;
+                    }
+                    generation = 1;
+                }
+                keyArena.Clear();
+                if constexpr (c_supportsChangeFeed)
+                {
+                    if(pChangeFeed)
+                    {
+                        pChangeFeed->Append(ChangeType::Clear, Key_T(), Key_T());
+                    }
+                }
+            }
+
+            // Clear_Lockless() that also frees the bucket table, back to the state of a new inner map.
+            // The pools have to be freed along with it, the buckets are dropped without handing back their blocks.
+            void ReleaseMemory_Lockless()
+            {
+                Clear_Lockless();
+                if(buckets)
+                {
+                    Util::Free(buckets);
+                    buckets = nullptr;
+                }
+                numBuckets = 0;
+                fillCapacity = 0;
+            }
+
+            // Rebuild source's bucket table over copies of its pools, this inner map has to be empty.
+            // translateNode and translateBlock map source's nodes and blocks to their copies.
+            template<typename TranslateNode_T, typename TranslateBlock_T>
+            void CloneFrom_Lockless(const InnerMap& source, TranslateNode_T&& translateNode, TranslateBlock_T&& translateBlock)
+            {
+                if(source.numBuckets > 0)
+                {
+                    buckets = Util::NewArray<Bucket>(source.numBuckets);
+                    Util::CountContainerAllocation(sizeof(Bucket) * source.numBuckets);
+                }
+                numBuckets = source.numBuckets;
+                fillCapacity = source.fillCapacity;
+                count = source.count;
                 for(uint32_t i = 0; i < numBuckets; ++i)
                 {
-                    buckets[i].Reset_Lockless();
+                    buckets[i].generation = generation;
+                    if(source.buckets[i].generation == source.generation)
+                    {
+                        buckets[i].CopyLinks_Lockless(source.buckets[i], translateNode, translateBlock);
+                    }
+                }
+            }
+
+            // Link every node of donorMap into this inner map, the node pool has to own them already (see AdoptPages()).
+            // Donor nodes whose key exists are released. Returns the number of keys added, donorMap's buckets are left stale.
+            uint32_t MergeFrom_Lockless(InnerMap& donorMap, const MergeConflictPolicy policy)
+            {
+                const uint32_t maxCount = count + donorMap.count;
+                if((numBuckets == 0) || ((maxCount > fillCapacity) && !pool.IsFixedCapacity()))
+                {
+                    Resize(PklE::Util::GetNextPowerOfTwo(maxCount * 2));
+                }
+
+                uint32_t numAdded = 0;
+                for(uint32_t i = 0; i < donorMap.numBuckets; ++i)
+                {
+                    if(donorMap.buckets[i].generation != donorMap.generation)
+                    {
+                        continue;
+                    }
+                    donorMap.buckets[i].ForEachNode_Lockless([this, policy, &numAdded](Node* pNode)
+                    {
+                        const uint64_t hash = KeyStorage::Hash(pNode->key);
+                        const uint32_t bucket = GetIndex(hash);
+                        Bucket& mergeBucket = GetBucketForWrite(bucket);
+                        Node* pExistingNode = mergeBucket.Find_Lockless(hash, pNode->key);
+                        if(pExistingNode)
+                        {
+                            if(policy == MergeConflictPolicy::Overwrite)
+                            {
+                                pool.MarkDirty(pExistingNode);
+                                pExistingNode->value = std::move(pNode->value);
+                            }
+                            pool.Release(pNode);
+                            return;
+                        }
+
+                        pNode->bucket = bucket;
+                        if(mergeBucket.Insert_Lockless(pNode, hash, blockPool))
+                        {
+                            PublishChange(ChangeType::Insert, pNode->key, pNode->key);
+                            ++count;
+                            ++numAdded;
+                        }
+                        else
+                        {
+                            PKLE_ASSERT_SYSTEM_ERROR_MSG(false, "HashMap::Merge: Insertion into bucket failed, the fixed capacity block pool is full. The entry has been dropped.");
+                            pool.Release(pNode);
+                        }
+                    });
                 }
+                return numAdded;
             }
         };
 
-        uint32_t totalCount = 0;
+        Util::ContainerCounter totalCount;
         InnerMap innerMaps[c_numInnerMaps];
 
+        CoreTypes::CountingSpinlock checkpointLock; //One checkpoint at a time
+        uint64_t numCheckpoints = 0;
+        bool bNeedsFullCheckpoint = true; //Pages emptied by a clear are not dirty, so the next checkpoint has to be full
+
+        HotKeySketchType* pHotKeySketch = nullptr; //Optional, see SetHotKeySketch()
+
+        template<typename Comparable_T>
+        inline void SampleHotKey(const uint64_t hash, const Comparable_T& key, const uint32_t mapIndex) const
+        {
+            //Lookups through another comparable type (e.g. a string_view) are not sampled
+            if constexpr (c_supportsHotKeySketch && std::is_same_v<Comparable_T, Key_T>)
+            {
+                if(pHotKeySketch)
+                {
+                    pHotKeySketch->Sample(hash, key, mapIndex);
+                }
+            }
+        }
+
     public:
 
         struct Iterator
@@ -547,7 +940,7 @@ namespace ThreadsafeContainers
 
     private:
         template<std::size_t... Is>
-        HashMap(std::index_sequence<Is...>) : sharedPool(), innerMaps { (static_cast<void>(Is), InnerMap(sharedPool))... }
+        HashMap(std::index_sequence<Is...>) : sharedPool(), sharedBlockPool(), innerMaps { (static_cast<void>(Is), InnerMap(sharedPool, sharedBlockPool))... }
         {
         }
 
@@ -564,12 +957,13 @@ namespace ThreadsafeContainers
         template<typename... Args>
         KeyValuePair* Insert_Lockless(const Key_T& key, Args&&... args)
         {
-            const uint64_t hash = Util::HashType::Hash64(key);
+            const uint64_t hash = KeyStorage::Hash(key);
             const uint32_t mapIndex = GetInnerMapIndex(hash);
+            SampleHotKey(hash, key, mapIndex);
             KeyValuePair* pAdded = innerMaps[mapIndex].Insert_Lockless(hash, key, std::forward<Args>(args)...);
             if(pAdded)
             {
-                ++totalCount;
+                totalCount.Add_Lockless(1);
             }
             return pAdded;
         }
@@ -577,57 +971,127 @@ namespace ThreadsafeContainers
         template<typename... Args>
         KeyValuePair* Insert_Concurrent(const Key_T& key, Args&&... args)
         {
-            const uint64_t hash = Util::HashType::Hash64(key);
+            const uint64_t hash = KeyStorage::Hash(key);
             const uint32_t mapIndex = GetInnerMapIndex(hash);
+            SampleHotKey(hash, key, mapIndex);
             KeyValuePair* pAdded = innerMaps[mapIndex].Insert_Concurrent(hash, key, std::forward<Args>(args)...);
             if(pAdded)
             {
-                Util::AtomicIncrementU32(totalCount);
+                totalCount.Increment();
             }
             return pAdded;
         }
 
+        // Insert that reports why nothing was inserted. pOutPair is the new entry, nullptr unless Inserted.
+        template<typename... Args>
+        InsertStatus TryInsert_Lockless(const Key_T& key, KeyValuePair*& pOutPair, Args&&... args)
+        {
+            const uint64_t hash = KeyStorage::Hash(key);
+            const uint32_t mapIndex = GetInnerMapIndex(hash);
+            SampleHotKey(hash, key, mapIndex);
+            InsertStatus status;
+            pOutPair = innerMaps[mapIndex].InsertWithStatus_Lockless(hash, key, status, std::forward<Args>(args)...);
+            if(pOutPair)
+            {
+                totalCount.Add_Lockless(1);
+            }
+            return status;
+        }
+
+        template<typename... Args>
+        InsertStatus TryInsert_Concurrent(const Key_T& key, KeyValuePair*& pOutPair, Args&&... args)
+        {
+            const uint64_t hash = KeyStorage::Hash(key);
+            const uint32_t mapIndex = GetInnerMapIndex(hash);
+            SampleHotKey(hash, key, mapIndex);
+            InsertStatus status;
+            pOutPair = innerMaps[mapIndex].InsertWithStatus_Concurrent(hash, key, status, std::forward<Args>(args)...);
+            if(pOutPair)
+            {
+                totalCount.Increment();
+            }
+            return status;
+        }
+
         template<typename Comparable_T>
         KeyValuePair* Find_Lockless(const Comparable_T& key)
         {
-            const uint64_t hash = Util::HashType::Hash64(key);
+            const uint64_t hash = KeyStorage::Hash(key);
             const uint32_t mapIndex = GetInnerMapIndex(hash);
+            SampleHotKey(hash, key, mapIndex);
             return innerMaps[mapIndex].Find_Lockless(hash, key);
         }
 
         template<typename Comparable_T>
         KeyValuePair* Find_Concurrent(const Comparable_T& key)
         {
-            const uint64_t hash = Util::HashType::Hash64(key);
+            const uint64_t hash = KeyStorage::Hash(key);
             const uint32_t mapIndex = GetInnerMapIndex(hash);
+            SampleHotKey(hash, key, mapIndex);
             return innerMaps[mapIndex].Find_Concurrent(hash, key);
         }
 
         template<typename Comparable_T>
         const KeyValuePair* Find_Lockless(const Comparable_T& key) const
         {
-            const uint64_t hash = Util::HashType::Hash64(key);
+            const uint64_t hash = KeyStorage::Hash(key);
             const uint32_t mapIndex = GetInnerMapIndex(hash);
+            SampleHotKey(hash, key, mapIndex);
             return innerMaps[mapIndex].Find_Lockless(hash, key);
         }
 
         template<typename Comparable_T>
         const KeyValuePair* Find_Concurrent(const Comparable_T& key) const
         {
-            const uint64_t hash = Util::HashType::Hash64(key);
+            const uint64_t hash = KeyStorage::Hash(key);
             const uint32_t mapIndex = GetInnerMapIndex(hash);
+            SampleHotKey(hash, key, mapIndex);
             return innerMaps[mapIndex].Find_Concurrent(hash, key);
         }
 
+        // Hash of a key as used by this map, GetInnerMapIndex() of it is the inner map the key lives in
+        template<typename Comparable_T>
+        static uint64_t HashKey(const Comparable_T& key)
+        {
+            return KeyStorage::Hash(key);
+        }
+
+        // Insert with a hash from HashKey(). Several threads may call this at the same time without locking
+        // as long as no two of them insert into the same inner map, e.g. after partitioning keys by GetInnerMapIndex().
+        template<typename... Args>
+        KeyValuePair* InsertPartitioned_Lockless(const uint64_t hash, const Key_T& key, Args&&... args)
+        {
+            const uint32_t mapIndex = GetInnerMapIndex(hash);
+            KeyValuePair* pAdded = innerMaps[mapIndex].Insert_Lockless(hash, key, std::forward<Args>(args)...);
+            if(pAdded)
+            {
+                totalCount.Increment();
+            }
+            return pAdded;
+        }
+
+        // Find with a hash from HashKey(), for callers that hash a batch of keys up front
+        template<typename Comparable_T>
+        KeyValuePair* FindWithHash_Lockless(const uint64_t hash, const Comparable_T& key)
+        {
+            return innerMaps[GetInnerMapIndex(hash)].Find_Lockless(hash, key);
+        }
+
+        template<typename Comparable_T>
+        const KeyValuePair* FindWithHash_Lockless(const uint64_t hash, const Comparable_T& key) const
+        {
+            return innerMaps[GetInnerMapIndex(hash)].Find_Lockless(hash, key);
+        }
+
         template<typename Comparable_T>
         bool Remove_Lockless(const Comparable_T& key)
         {
-            const uint64_t hash = Util::HashType::Hash64(key);
+            const uint64_t hash = KeyStorage::Hash(key);
             const uint32_t mapIndex = GetInnerMapIndex(hash);
             bool bRemoved = innerMaps[mapIndex].Remove_Lockless(hash, key);
             if(bRemoved)
             {
-                --totalCount;
+                totalCount.Add_Lockless(-1);
             }
             return bRemoved;
         }
@@ -635,12 +1099,12 @@ namespace ThreadsafeContainers
         template<typename Comparable_T>
         bool Remove_Concurrent(const Comparable_T& key)
         {
-            const uint64_t hash = Util::HashType::Hash64(key);
+            const uint64_t hash = KeyStorage::Hash(key);
             const uint32_t mapIndex = GetInnerMapIndex(hash);
             bool bRemoved = innerMaps[mapIndex].Remove_Concurrent(hash, key);
             if(bRemoved)
             {
-                Util::AtomicDecrementU32(totalCount);
+                totalCount.Decrement();
             }
             return bRemoved;
         }
@@ -649,12 +1113,12 @@ namespace ThreadsafeContainers
         bool Remove_Lockless<KeyValuePair>(const KeyValuePair& value)
         {
             const Node* pNode = reinterpret_cast<const Node*>(&value);
-            const uint64_t hash = Util::HashType::Hash64(pNode->key);
+            const uint64_t hash = KeyStorage::Hash(pNode->key);
             const uint32_t mapIndex = GetInnerMapIndex(hash);
             bool bRemoved = innerMaps[mapIndex].Remove_Lockless(hash, value);
             if(bRemoved)
             {
-                --totalCount;
+                totalCount.Add_Lockless(-1);
             }
             return bRemoved;
         }
@@ -663,12 +1127,12 @@ namespace ThreadsafeContainers
         bool Remove_Concurrent<KeyValuePair>(const KeyValuePair& value)
         {
             const Node* pNode = reinterpret_cast<const Node*>(&value);
-            const uint64_t hash = Util::HashType::Hash64(pNode->key);
+            const uint64_t hash = KeyStorage::Hash(pNode->key);
             const uint32_t mapIndex = GetInnerMapIndex(hash);
             bool bRemoved = innerMaps[mapIndex].Remove_Concurrent(hash, value);
             if(bRemoved)
             {
-                Util::AtomicDecrementU32(totalCount);
+                totalCount.Decrement();
             }
             return bRemoved;
         }
@@ -677,10 +1141,10 @@ namespace ThreadsafeContainers
         {
             bool bRekeyed = false;
             Node* pNode = reinterpret_cast<Node*>(const_cast<KeyValuePair*>(&value));
-            const uint64_t oldHash = Util::HashType::Hash64(pNode->key);
+            const uint64_t oldHash = KeyStorage::Hash(pNode->key);
             const uint32_t oldMapIndex = GetInnerMapIndex(oldHash);
 
-            const uint64_t newHash = Util::HashType::Hash64(newKey);
+            const uint64_t newHash = KeyStorage::Hash(newKey);
             const uint32_t newMapIndex = GetInnerMapIndex(newHash);
 
             if(oldMapIndex == newMapIndex)
@@ -694,13 +1158,14 @@ namespace ThreadsafeContainers
                 bool bRemovedNode = innerMaps[oldMapIndex].Remove_Lockless(oldHash, value);
                 if(bRemovedNode)
                 {
+                    sharedPool.MarkDirty(pNode);
                     pNode->ForceChangeKey(newKey);
                     pNode->bucket = Node::c_invalidBucket; //Reset bucket before re-insert
                     bRekeyed = innerMaps[newMapIndex].Insert_Lockless(newHash, pNode->key, std::move(pNode->value));
                     if(!bRekeyed)
                     {
                         PKLE_ASSERT_SYSTEM_ERROR_MSG(false, "ReKey_Lockless: Insertion into new inner map failed during rekeying. The node has been lost. This should never happen.");
-                        --totalCount; //Adjust total count since the node is lost
+                        totalCount.Add_Lockless(-1); //Adjust total count since the node is lost
                     }
                 }
             }
@@ -711,10 +1176,10 @@ namespace ThreadsafeContainers
         {
             bool bRekeyed = false;
             Node* pNode = reinterpret_cast<Node*>(const_cast<KeyValuePair*>(&value));
-            const uint64_t oldHash = Util::HashType::Hash64(pNode->key);
+            const uint64_t oldHash = KeyStorage::Hash(pNode->key);
             const uint32_t oldMapIndex = GetInnerMapIndex(oldHash);
 
-            const uint64_t newHash = Util::HashType::Hash64(newKey);
+            const uint64_t newHash = KeyStorage::Hash(newKey);
             const uint32_t newMapIndex = GetInnerMapIndex(newHash);
 
             if(oldMapIndex == newMapIndex)
@@ -728,13 +1193,14 @@ namespace ThreadsafeContainers
                 bool bRemovedNode = innerMaps[oldMapIndex].Remove_Concurrent(oldHash, value);
                 if(bRemovedNode)
                 {
+                    sharedPool.MarkDirty(pNode);
                     pNode->ForceChangeKey(newKey);
                     pNode->bucket = Node::c_invalidBucket; //Reset bucket before re-insert
                     bRekeyed = innerMaps[newMapIndex].Insert_Concurrent(newHash, pNode->key, std::move(pNode->value));
                     if(!bRekeyed)
                     {
                         PKLE_ASSERT_SYSTEM_ERROR_MSG(false, "ReKey_Lockless: Insertion into new inner map failed during rekeying. The node has been lost. This should never happen.");
-                        Util::AtomicDecrementU32(totalCount); //Adjust total count since the node is lost
+                        totalCount.Decrement(); //Adjust total count since the node is lost
                     }
                 }
             }
@@ -761,26 +1227,232 @@ namespace ThreadsafeContainers
             return false;
         }
 
+        // Run modifier(Value_T&) on the value of key under the inner map's write lock, tracking the change for checkpoints
+        template<typename Comparable_T, typename Modifier_T>
+        bool Modify_Lockless(const Comparable_T& key, Modifier_T&& modifier)
+        {
+            const uint64_t hash = KeyStorage::Hash(key);
+            const uint32_t mapIndex = GetInnerMapIndex(hash);
+            return innerMaps[mapIndex].Modify_Lockless(hash, key, std::forward<Modifier_T>(modifier));
+        }
+
+        template<typename Comparable_T, typename Modifier_T>
+        bool Modify_Concurrent(const Comparable_T& key, Modifier_T&& modifier)
+        {
+            const uint64_t hash = KeyStorage::Hash(key);
+            const uint32_t mapIndex = GetInnerMapIndex(hash);
+            return innerMaps[mapIndex].Modify_Concurrent(hash, key, std::forward<Modifier_T>(modifier));
+        }
+
+        // Values changed in place through a pointer from Find_* are not seen by checkpoints unless marked first
+        void MarkDirty(const KeyValuePair& value)
+        {
+            sharedPool.MarkDirty(static_cast<const Node*>(&value));
+        }
+
+        // Write the pages of entries changed since the last checkpoint to stream (anything with write(const char*, size)).
+        // The first checkpoint, and the first one after Clear, writes every page.
+        // Writers are only paused while the changed pages are captured. Pages written to while the checkpoint
+        // is still streaming are copied on their first write, so the checkpoint is a consistent cut.
+        // Returns the number of pages written.
+        template<typename Stream_T>
+        uint32_t Checkpoint(Stream_T& stream, bool bFullCheckpoint = false)
+        {
+            static_assert(std::is_trivially_copyable_v<Key_T> && std::is_trivially_copyable_v<Value_T>, "HashMap::Checkpoint: Key_T and Value_T must be trivially copyable.");
+            static_assert(std::is_same_v<KeyArenaType, NoKeyArena>, "HashMap::Checkpoint: Arena stored keys would only write pointers into the arena.");
+
+            CoreTypes::ScopedWriteSpinLock checkpointWriteLock(checkpointLock);
+            bFullCheckpoint = bFullCheckpoint || bNeedsFullCheckpoint;
+
+            CheckpointHeader header;
+            header.bFullCheckpoint = bFullCheckpoint ? 1 : 0;
+            header.checkpointIndex = numCheckpoints++;
+            {
+                //Pause writers for the cut
+                for(uint32_t i = 0; i < c_numInnerMaps; ++i)
+                {
+                    innerMaps[i].lock.AcquireReadAndWriteAccess();
+                }
+                header.numPages = sharedPool.BeginCheckpoint(bFullCheckpoint);
+                header.totalCount = totalCount.ReadU32();
+                bNeedsFullCheckpoint = false;
+                for(uint32_t i = c_numInnerMaps; i > 0; --i)
+                {
+                    innerMaps[i - 1].lock.ReleaseReadAndWriteAccess();
+                }
+            }
+
+            stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            sharedPool.FinishCheckpoint([&stream](const uint32_t pageIndex, const Node** ppNodes, const uint32_t numNodes)
+            {
+                CheckpointPageHeader pageHeader;
+                pageHeader.pageIndex = pageIndex;
+                pageHeader.numEntries = numNodes;
+                stream.write(reinterpret_cast<const char*>(&pageHeader), sizeof(pageHeader));
+                for(uint32_t i = 0; i < numNodes; ++i)
+                {
+                    //Padding bytes go to the stream as well, so they are zeroed instead of leaking whatever was on the stack
+                    CheckpointEntry entry;
+                    memset(&entry, 0, sizeof(entry));
+                    entry.key = ppNodes[i]->key;
+                    entry.value = ppNodes[i]->value;
+                    stream.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+                }
+            });
+            return header.numPages;
+        }
+
+        // Attach (or detach with nullptr) a change feed. The feed must outlive the map or be detached first.
+        // WARNING: Only use when external synchronization guarantees exclusive access
+        void SetChangeFeed(ChangeFeedType* pFeed)
+        {
+            static_assert(c_supportsChangeFeed, "HashMap::SetChangeFeed: Key_T must be trivially copyable and not arena stored to be recorded in a change feed.");
+            for(uint32_t i = 0; i < c_numInnerMaps; ++i)
+            {
+                innerMaps[i].pChangeFeed = pFeed ? &pFeed->GetShard(i) : nullptr;
+            }
+        }
+
+        // Attach (or detach with nullptr) a hot key sketch that samples Find_* and Insert_* calls.
+        // The sketch must outlive the map or be detached first.
+        // WARNING: Only use when external synchronization guarantees exclusive access
+        void SetHotKeySketch(HotKeySketchType* pSketch)
+        {
+            static_assert(c_supportsHotKeySketch, "HashMap::SetHotKeySketch: Key_T must be trivially copyable and not arena stored to be sampled.");
+            pHotKeySketch = pSketch;
+        }
+
+        // Hottest sampled keys, hottest first, see HotKeySketch::GetHotKeys(). Returns 0 without a sketch
+        uint32_t GetHotKeys(HotKey<Key_T>* pOutKeys, const uint32_t maxKeys) const
+        {
+            return pHotKeySketch ? pHotKeySketch->GetHotKeys(pOutKeys, maxKeys) : 0;
+        }
+
         bool IsEmpty() const
         {
-            return totalCount == 0;
+            return totalCount.Read() <= 0;
         }
 
         uint32_t Size() const
         {
-            return totalCount;
+            return totalCount.ReadU32();
         }
 
+        // Empties the map in O(1) and keeps its memory for the entries inserted next. Buckets and pool pages are
+        // stamped with a generation and reset on first reuse, the old values are destroyed then (or with the map).
+        // Use ReleaseMemory_Parallel() to give the memory back instead.
         void Clear_Lockless()
         {
-            totalCount = 0;
+            totalCount.Reset();
+            bNeedsFullCheckpoint = true;
             
             for(uint32_t i = 0; i < c_numInnerMaps; ++i)
             {
                 innerMaps[i].Clear_Lockless();
             }
 
-            sharedPool.Clear();
+            sharedPool.ClearLazy();
+            sharedBlockPool.ClearLazy();
+        }
+
+        // Empties the map and frees its pages and bucket tables, destroying the values on numThreads threads
+        // (the calling thread included). Tearing down tens of millions of entries on one thread takes seconds,
+        // call this before destroying such a map, the destructor itself is single threaded.
+        // WARNING: Only use when external synchronization guarantees exclusive access
+        void ReleaseMemory_Parallel(const uint32_t numThreads)
+        {
+            totalCount.Reset();
+            bNeedsFullCheckpoint = true;
+
+            for(uint32_t i = 0; i < c_numInnerMaps; ++i)
+            {
+                innerMaps[i].ReleaseMemory_Lockless();
+            }
+
+            sharedPool.Clear_Parallel(numThreads);
+            sharedBlockPool.Clear();
+        }
+
+        // Makes outClone a copy of this map on numThreads threads (the calling thread included). The pool pages are
+        // copied page by page and the bucket tables inner map by inner map, chains are relinked to the copied nodes,
+        // so nothing is hashed or inserted. Whatever outClone held is released first. Change feed and hot key sketch
+        // attachments are not copied.
+        // WARNING: Only use when no thread writes to either map
+        void Clone(ThisHashMapType& outClone, const uint32_t numThreads)
+        {
+            static_assert(std::is_same_v<KeyArenaType, NoKeyArena>, "HashMap::Clone: Arena stored keys would be shared with the clone.");
+            if(&outClone == this)
+            {
+                return;
+            }
+
+            outClone.ReleaseMemory_Parallel(numThreads);
+            outClone.sharedPool.CloneFrom(sharedPool, numThreads);
+            outClone.sharedBlockPool.CloneFrom(sharedBlockPool, numThreads);
+
+            auto translateNode = [this, &outClone](const Node* pNode)
+            {
+                return outClone.sharedPool.GetCloneOf(sharedPool, pNode);
+            };
+            auto translateBlock = [this, &outClone](const typename UnrolledListType::Block* pBlock)
+            {
+                return outClone.sharedBlockPool.GetCloneOf(sharedBlockPool, pBlock);
+            };
+            const uint32_t numWorkers = Util::GetNumWorkers(numThreads, c_numInnerMaps, 1);
+            Util::RunOnWorkerThreads(numWorkers, [&](const uint32_t workerIndex)
+            {
+                for(uint32_t i = workerIndex; i < c_numInnerMaps; i += numWorkers)
+                {
+                    outClone.innerMaps[i].CloneFrom_Lockless(innerMaps[i], translateNode, translateBlock);
+                }
+            });
+
+            outClone.totalCount.Add_Lockless(totalCount.Read());
+            outClone.SetFixedCapacity(IsFixedCapacity());
+        }
+
+        // Moves every entry of donor into this map and leaves donor empty. donor's pool pages are taken over as they are
+        // and its nodes are linked into the matching inner maps on numThreads threads, so no entry is copied or allocated.
+        // Bucket tables may grow. Keys in both maps are resolved with policy. Both maps must be of the same type,
+        // which guarantees the inner map of a key is the same in both.
+        // WARNING: Only use when external synchronization guarantees exclusive access to both maps
+        void Merge(ThisHashMapType& donor, const MergeConflictPolicy policy, const uint32_t numThreads)
+        {
+            static_assert(std::is_same_v<KeyArenaType, NoKeyArena>, "HashMap::Merge: Arena stored keys would still point into the donor's arena.");
+            if(&donor == this)
+            {
+                return;
+            }
+
+            sharedPool.AdoptPages(donor.sharedPool, numThreads);
+            if(IsFixedCapacity())
+            {
+                //Top up the unrolled blocks for the adopted nodes
+                SetFixedCapacity(true);
+            }
+
+            uint32_t numAdded[c_numInnerMaps] = {};
+            const uint32_t numWorkers = Util::GetNumWorkers(numThreads, c_numInnerMaps, 1);
+            Util::RunOnWorkerThreads(numWorkers, [&](const uint32_t workerIndex)
+            {
+                for(uint32_t i = workerIndex; i < c_numInnerMaps; i += numWorkers)
+                {
+                    numAdded[i] = innerMaps[i].MergeFrom_Lockless(donor.innerMaps[i], policy);
+                }
+            });
+            for(uint32_t i = 0; i < c_numInnerMaps; ++i)
+            {
+                totalCount.Add_Lockless(numAdded[i]);
+            }
+
+            //The donor's buckets still point at nodes this map owns now
+            for(uint32_t i = 0; i < c_numInnerMaps; ++i)
+            {
+                donor.innerMaps[i].ReleaseMemory_Lockless();
+            }
+            donor.sharedBlockPool.Clear();
+            donor.totalCount.Reset();
+            donor.bNeedsFullCheckpoint = true;
         }
 
         void Reserve(uint32_t numElements)
@@ -793,6 +1465,49 @@ namespace ThreadsafeContainers
                 innerMaps[i].Resize(PklE::Util::GetNextPowerOfTwo(numElementsPerInnerMap));
             }
             sharedPool.PreallocateSpace(numElements);
+            if constexpr (UnrolledBuckets_T)
+            {
+                sharedBlockPool.PreallocateSpace((numElements + UnrolledListType::c_numSlotsPerBlock - 1) / UnrolledListType::c_numSlotsPerBlock);
+            }
+        }
+
+        // Fixed capacity mode for latency critical inserts: Reserve(n) first, from then on no operation allocates.
+        // Bucket tables stop resizing and inserts fail with InsertStatus::CapacityExhausted once the node pool is full,
+        // at least n entries fit. Arena stored (string) keys and checkpoints still allocate.
+        // Not safe against concurrent inserts, switch modes while the map is idle.
+        void SetFixedCapacity(const bool bFixed)
+        {
+            if constexpr (UnrolledBuckets_T)
+            {
+                if(bFixed)
+                {
+                    //Every bucket can have a partly filled head block on top of the packed blocks
+                    uint32_t numBuckets = 0;
+                    for(uint32_t i = 0; i < c_numInnerMaps; ++i)
+                    {
+                        numBuckets += innerMaps[i].numBuckets;
+                    }
+                    const uint32_t numBlocksNeeded = numBuckets + ((sharedPool.GetCapacity() + UnrolledListType::c_numSlotsPerBlock - 1) / UnrolledListType::c_numSlotsPerBlock);
+                    const uint32_t blockCapacity = sharedBlockPool.GetCapacity();
+                    if(blockCapacity < numBlocksNeeded)
+                    {
+                        sharedBlockPool.PreallocateSpace(numBlocksNeeded - sharedBlockPool.Size());
+                    }
+                }
+            }
+            sharedPool.SetFixedCapacity(bFixed);
+            sharedBlockPool.SetFixedCapacity(bFixed);
+        }
+
+        bool IsFixedCapacity() const
+        {
+            return sharedPool.IsFixedCapacity();
+        }
+
+        // Entries the node pool has room for without allocating
+        uint32_t GetCapacity() const
+        {
+            return sharedPool.GetCapacity();
         }
 
         // std::map-like interface wrappers
@@ -860,6 +1575,18 @@ namespace ThreadsafeContainers
             return Remove_Lockless(key);
         }
 
+        template<typename Modifier_T>
+        bool modify(const Key_T& key, Modifier_T&& modifier)
+        {
+            return Modify_Concurrent(key, std::forward<Modifier_T>(modifier));
+        }
+
+        template<typename Stream_T>
+        uint32_t checkpoint(Stream_T& stream)
+        {
+            return Checkpoint(stream);
+        }
+
         bool rekey(const Key_T& key, const Key_T& newKey)
         {
             return ReKey_Concurrent(key, newKey);
@@ -0,0 +1,337 @@
+#pragma once
+
+#include <stdint.h>
+#include <type_traits>
+#include "memory_util.h"
+#include "atomic_util.h"
+#include "logging_util.h"
+
+namespace PklE
+{
+namespace ThreadsafeContainers
+{
+    inline constexpr uint32_t c_defaultHotKeySamplingInterval = 1024;
+
+    // One heavy hitter as reported by HotKeySketch::GetHotKeys()
+    template<typename Key_T>
+    struct HotKey
+    {
+        Key_T key;
+        uint64_t estimatedCount = 0; //Estimated calls for this key, already scaled by the sampling interval
+        uint32_t shardIndex = 0;
+    };
+
+    // Index of the calling thread in every HotKeySketch, handed out on first use
+    inline uint32_t GetHotKeySketchThreadIndex()
+    {
+        static uint32_t s_nextThreadIndex = 0;
+        thread_local const uint32_t t_threadIndex = Util::AtomicIncrementU32(s_nextThreadIndex) - 1;
+        return t_threadIndex;
+    }
+
+    // Sampling profiler of the keys a HashMap is called with: count-min sketch plus a top-K heavy hitter list.
+    //
+    // - Attach with HashMap::SetHotKeySketch(), the map then offers every Find_* and Insert_* call to Sample().
+    // - 1 in samplingInterval calls per thread is recorded on average, the others only count down a per thread counter.
+    //   The gaps between samples are random, a fixed gap would alias with periodic access patterns.
+    // - Every thread records into its own slot, so sampled calls never share cache lines.
+    //   More than MaxThreads_T threads share slots, which can lose a few samples but never corrupts the sketch.
+    // - GetHotKeys() and GetShardLoad() merge the slots on demand and may run concurrently with sampling.
+    template<typename Key_T, uint32_t NumShards_T, uint32_t TopK_T = 16, uint32_t Width_T = 2048, uint32_t MaxThreads_T = 64>
+    class HotKeySketch
+    {
+        static_assert(std::is_trivially_copyable_v<Key_T>, "HotKeySketch: Key_T must be trivially copyable.");
+        static_assert((Width_T & (Width_T - 1)) == 0, "HotKeySketch: Width_T must be a power of two.");
+        static_assert((MaxThreads_T & (MaxThreads_T - 1)) == 0, "HotKeySketch: MaxThreads_T must be a power of two.");
+
+    public:
+        using HotKeyType = HotKey<Key_T>;
+        inline static constexpr uint32_t c_depth = 4;
+        inline static constexpr uint32_t c_width = Width_T;
+        inline static constexpr uint32_t c_topK = TopK_T;
+        inline static constexpr uint32_t c_numShards = NumShards_T;
+
+    private:
+        struct TopKEntry
+        {
+            Key_T key;
+            uint64_t hash = 0; //Map hash of key, locates its counters when merging
+            uint32_t estimate = 0; //Sampled count estimate when the entry was last updated
+            uint32_t shardIndex = 0;
+        };
+
+        struct alignas(64) ThreadSlot
+        {
+            uint32_t countdown = 0;
+            uint32_t randomState = 0; //xorshift state for the sampling gaps, 0 until the slot is first used
+            uint32_t version = 0; //Odd while a thread updates the top-K list
+            uint32_t numTopK = 0;
+            uint64_t numSamples = 0;
+            TopKEntry topK[TopK_T];
+            uint32_t shardSamples[NumShards_T] = {0};
+            uint32_t counters[c_depth][Width_T] = {{0}};
+        };
+
+        uint32_t samplingInterval = c_defaultHotKeySamplingInterval;
+        ThreadSlot slots[MaxThreads_T];
+
+        static uint32_t GetCounterIndex(const uint64_t hash, const uint32_t row)
+        {
+            //Independent enough rows from one 64 bit hash: remix it with a different odd constant per row
+            constexpr uint64_t c_rowMultipliers[c_depth] = {0x9E3779B97F4A7C15ULL, 0xC2B2AE3D27D4EB4FULL, 0x165667B19E3779F9ULL, 0xD6E8FEB86659FD93ULL};
+            const uint64_t mixed = (hash ^ (hash >> 29)) * c_rowMultipliers[row];
+            return static_cast<uint32_t>(mixed >> 32) & (Width_T - 1);
+        }
+
+        static uint32_t LoadCounter(const uint32_t& counter)
+        {
+            return Util::AtomicLoadU32(counter, Util::MemoryOrder::RELAXED);
+        }
+
+        static void IncrementCounter(uint32_t& counter)
+        {
+            //Single writer per slot, a plain add is enough and keeps sampled calls cheap
+            Util::AtomicStoreU32(counter, LoadCounter(counter) + 1, Util::MemoryOrder::RELAXED);
+        }
+
+        // Calls until the next sample, uniform in [1, 2 * interval - 1] so the mean is the sampling interval
+        uint32_t NextSamplingGap(ThreadSlot& slot) const
+        {
+            uint32_t state = Util::AtomicLoadU32(slot.randomState, Util::MemoryOrder::RELAXED);
+            if(state == 0)
+            {
+                state = (GetHotKeySketchThreadIndex() * 2654435761U) | 1;
+            }
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            Util::AtomicStoreU32(slot.randomState, state, Util::MemoryOrder::RELAXED);
+
+            const uint64_t interval = GetSamplingInterval();
+            return 1 + static_cast<uint32_t>(state % ((2 * interval) - 1));
+        }
+
+        void Record(ThreadSlot& slot, const uint64_t hash, const Key_T& key, const uint32_t shardIndex)
+        {
+            uint32_t estimate = UINT32_MAX;
+            for(uint32_t row = 0; row < c_depth; ++row)
+            {
+                uint32_t& counter = slot.counters[row][GetCounterIndex(hash, row)];
+                IncrementCounter(counter);
+                const uint32_t count = LoadCounter(counter);
+                estimate = (count < estimate) ? count : estimate;
+            }
+            IncrementCounter(slot.shardSamples[shardIndex]);
+            Util::AtomicStoreU64(slot.numSamples, Util::AtomicLoadU64(slot.numSamples, Util::MemoryOrder::RELAXED) + 1, Util::MemoryOrder::RELAXED);
+
+            //Top-K update is exclusive, a thread that shares this slot and finds it busy drops this sample from the list
+            const uint32_t version = Util::AtomicLoadU32(slot.version, Util::MemoryOrder::RELAXED);
+            if(((version & 1) != 0) || !Util::AtomicCompareExchangeU32(slot.version, version + 1, version, Util::MemoryOrder::ACQUIRE, Util::MemoryOrder::RELAXED))
+            {
+                return;
+            }
+            Util::AtomicThreadFence(Util::MemoryOrder::RELEASE);
+
+            //Refresh the key if it is listed, otherwise replace the smallest entry if this key is larger
+            uint32_t updateIndex = TopK_T;
+            uint32_t minIndex = 0;
+            const uint32_t numTopK = slot.numTopK;
+            for(uint32_t i = 0; i < numTopK; ++i)
+            {
+                if(slot.topK[i].key == key)
+                {
+                    updateIndex = i;
+                    break;
+                }
+                if(slot.topK[i].estimate < slot.topK[minIndex].estimate)
+                {
+                    minIndex = i;
+                }
+            }
+            if(updateIndex == TopK_T)
+            {
+                if(numTopK < TopK_T)
+                {
+                    updateIndex = numTopK;
+                }
+                else if(estimate > slot.topK[minIndex].estimate)
+                {
+                    updateIndex = minIndex;
+                }
+            }
+
+            if(updateIndex != TopK_T)
+            {
+                slot.topK[updateIndex].key = key;
+                slot.topK[updateIndex].hash = hash;
+                slot.topK[updateIndex].estimate = estimate;
+                slot.topK[updateIndex].shardIndex = shardIndex;
+                slot.numTopK = (updateIndex == numTopK) ? (numTopK + 1) : numTopK;
+            }
+            Util::AtomicStoreU32(slot.version, version + 2, Util::MemoryOrder::RELEASE);
+        }
+
+        // Seqlock style copy of a slot's top-K list, returns the number of entries copied
+        static uint32_t CopyTopK(const ThreadSlot& slot, TopKEntry* pOutEntries)
+        {
+            while(true)
+            {
+                const uint32_t version = Util::AtomicLoadU32(slot.version, Util::MemoryOrder::ACQUIRE);
+                if((version & 1) == 0)
+                {
+                    const uint32_t numTopK = slot.numTopK;
+                    for(uint32_t i = 0; i < numTopK; ++i)
+                    {
+                        pOutEntries[i] = slot.topK[i];
+                    }
+                    Util::AtomicThreadFence(Util::MemoryOrder::ACQUIRE);
+                    if(Util::AtomicLoadU32(slot.version, Util::MemoryOrder::RELAXED) == version)
+                    {
+                        return numTopK;
+                    }
+                }
+            }
+        }
+
+    public:
+        // Record 1 in interval calls per thread, interval must be at least 1
+        void SetSamplingInterval(const uint32_t interval)
+        {
+            Util::AtomicStoreU32(samplingInterval, (interval > 0) ? interval : 1, Util::MemoryOrder::RELAXED);
+        }
+
+        uint32_t GetSamplingInterval() const
+        {
+            return Util::AtomicLoadU32(samplingInterval, Util::MemoryOrder::RELAXED);
+        }
+
+        // Called by the map for every profiled call, hash is the key's map hash
+        inline void Sample(const uint64_t hash, const Key_T& key, const uint32_t shardIndex)
+        {
+            ThreadSlot& slot = slots[GetHotKeySketchThreadIndex() & (MaxThreads_T - 1)];
+            const uint32_t countdown = Util::AtomicLoadU32(slot.countdown, Util::MemoryOrder::RELAXED);
+            if(countdown > 1)
+            {
+                Util::AtomicStoreU32(slot.countdown, countdown - 1, Util::MemoryOrder::RELAXED);
+                return;
+            }
+            Util::AtomicStoreU32(slot.countdown, NextSamplingGap(slot), Util::MemoryOrder::RELAXED);
+            Record(slot, hash, key, shardIndex);
+        }
+
+        // Number of recorded samples over all threads
+        uint64_t GetNumSamples() const
+        {
+            uint64_t numSamples = 0;
+            for(uint32_t i = 0; i < MaxThreads_T; ++i)
+            {
+                numSamples += Util::AtomicLoadU64(slots[i].numSamples, Util::MemoryOrder::RELAXED);
+            }
+            return numSamples;
+        }
+
+        // Estimated calls per shard (scaled by the sampling interval), pOutLoad has NumShards_T entries
+        void GetShardLoad(uint64_t* pOutLoad) const
+        {
+            const uint64_t interval = GetSamplingInterval();
+            for(uint32_t shardIndex = 0; shardIndex < NumShards_T; ++shardIndex)
+            {
+                uint64_t numSamples = 0;
+                for(uint32_t i = 0; i < MaxThreads_T; ++i)
+                {
+                    numSamples += LoadCounter(slots[i].shardSamples[shardIndex]);
+                }
+                pOutLoad[shardIndex] = numSamples * interval;
+            }
+        }
+
+        // Merge the per thread sketches and write up to maxKeys of the hottest keys to pOutKeys, hottest first.
+        // Candidates are the union of the per thread top-K lists, estimated against the merged count-min sketch.
+        // Returns the number of keys written
+        uint32_t GetHotKeys(HotKeyType* pOutKeys, const uint32_t maxKeys) const
+        {
+            uint64_t* pMergedCounters = static_cast<uint64_t*>(Util::Malloc(sizeof(uint64_t) * c_depth * Width_T));
+            TopKEntry* pCandidates = static_cast<TopKEntry*>(Util::Malloc(sizeof(TopKEntry) * TopK_T * MaxThreads_T));
+            PKLE_ASSERT_SYSTEM_ERROR_MSG((pMergedCounters != nullptr) && (pCandidates != nullptr), "HotKeySketch::GetHotKeys: Failed to allocate merge buffers.");
+
+            for(uint32_t cell = 0; cell < (c_depth * Width_T); ++cell)
+            {
+                pMergedCounters[cell] = 0;
+            }
+            uint32_t numCandidates = 0;
+            for(uint32_t i = 0; i < MaxThreads_T; ++i)
+            {
+                const ThreadSlot& slot = slots[i];
+                if(Util::AtomicLoadU64(slot.numSamples, Util::MemoryOrder::RELAXED) == 0)
+                {
+                    continue;
+                }
+                for(uint32_t row = 0; row < c_depth; ++row)
+                {
+                    for(uint32_t column = 0; column < Width_T; ++column)
+                    {
+                        pMergedCounters[(row * Width_T) + column] += LoadCounter(slot.counters[row][column]);
+                    }
+                }
+                numCandidates += CopyTopK(slot, pCandidates + numCandidates);
+            }
+
+            //Insertion sort of the distinct candidates into the output by merged estimate
+            const uint64_t interval = GetSamplingInterval();
+            uint32_t numOut = 0;
+            for(uint32_t i = 0; i < numCandidates; ++i)
+            {
+                const TopKEntry& candidate = pCandidates[i];
+                bool bDuplicate = false;
+                for(uint32_t j = 0; (j < i) && !bDuplicate; ++j)
+                {
+                    bDuplicate = (pCandidates[j].key == candidate.key);
+                }
+                if(bDuplicate)
+                {
+                    continue;
+                }
+
+                uint64_t estimate = UINT64_MAX;
+                for(uint32_t row = 0; row < c_depth; ++row)
+                {
+                    const uint64_t count = pMergedCounters[(row * Width_T) + GetCounterIndex(candidate.hash, row)];
+                    estimate = (count < estimate) ? count : estimate;
+                }
+                estimate *= interval;
+
+                uint32_t position = (numOut < maxKeys) ? numOut : maxKeys;
+                while((position > 0) && (pOutKeys[position - 1].estimatedCount < estimate))
+                {
+                    if(position < maxKeys)
+                    {
+                        pOutKeys[position] = pOutKeys[position - 1];
+                    }
+                    --position;
+                }
+                if(position < maxKeys)
+                {
+                    pOutKeys[position].key = candidate.key;
+                    pOutKeys[position].estimatedCount = estimate;
+                    pOutKeys[position].shardIndex = candidate.shardIndex;
+                    numOut = (numOut < maxKeys) ? (numOut + 1) : numOut;
+                }
+            }
+
+            Util::Free(pCandidates);
+            Util::Free(pMergedCounters);
+            return numOut;
+        }
+
+        // Forget all samples, only call while nothing is sampling
+        void Reset()
+        {
+            for(uint32_t i = 0; i < MaxThreads_T; ++i)
+            {
+                slots[i] = ThreadSlot();
+            }
+        }
+    };
+
+}; //end namespace ThreadsafeContainers
+}; //end namespace PklE
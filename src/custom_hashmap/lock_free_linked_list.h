@@ -0,0 +1,386 @@
+#pragma once
+
+#include <stdint.h>
+#include <utility>
+#include "atomic_util.h"
+
+namespace PklE
+{
+namespace ThreadsafeContainers
+{
+    // Node_T must have the following members:
+    // - Node_T* pNext = nullptr; (pointer to next node, the low bit is used as the deletion mark)
+    // - Node_T* pRetiredNext = nullptr; (link on the retired lists after an erase)
+    // - A key member that can be compared for equality
+    //
+    // Unsorted Harris-Michael linked list, the lock-free counterpart of SimpleLinkedList:
+    // - New nodes are always inserted at the front
+    // - Erase first marks the low bit of the node's pNext (logical delete), then unlinks it with a CAS
+    // - Any traversal that runs into a marked node helps unlinking it
+    // - Whoever unlinks a node retires it. Reclamation is epoch based: every operation registers in the
+    //   current epoch, and the epoch only advances once nobody is left in the previous one. Nodes retired
+    //   two epochs back can no longer be referenced and are handed to the caller's reclaim function, so
+    //   the retired lists stay bounded by the work of two epochs even if the list is never quiescent.
+    // - External systems handle node allocation/deallocation
+    template<typename Node_T>
+    class LockFreeLinkedList
+    {
+    public:
+        using ThisLinkedListType = LockFreeLinkedList<Node_T>;
+
+    private:
+        inline static constexpr uintptr_t c_markBit = 1;
+        inline static constexpr uint32_t c_numEpochSlots = 3;
+
+        PKLE_DECLARE_ATOMIC_ALIGNED(Node_T*, pHead) = nullptr;
+
+        PKLE_DECLARE_ATOMIC_ALIGNED(uint32_t, epoch) = 0;
+        PKLE_DECLARE_ATOMIC_ALIGNED(uint32_t, advancingEpoch) = 0; //Only one thread advances the epoch at a time
+        uint32_t numActiveOperations[c_numEpochSlots] = {};
+        Node_T* pRetiredHeads[c_numEpochSlots] = {};
+
+        // Registers an operation in the current epoch for its lifetime
+        struct ScopedOperation
+        {
+            ThisLinkedListType& list;
+            uint32_t slot;
+
+            ScopedOperation(ThisLinkedListType& inList) : list(inList)
+            {
+                while(true)
+                {
+                    const uint32_t currentEpoch = Util::AtomicLoadU32(list.epoch, Util::MemoryOrder::SEQ_CST);
+                    slot = currentEpoch % c_numEpochSlots;
+                    Util::AtomicIncrementU32(list.numActiveOperations[slot]);
+                    if(Util::AtomicLoadU32(list.epoch, Util::MemoryOrder::SEQ_CST) == currentEpoch)
+                    {
+                        return;
+                    }
+                    //The epoch moved on while registering, the advancing thread may not have seen us
+                    Util::AtomicDecrementU32(list.numActiveOperations[slot]);
+                }
+            }
+
+            ~ScopedOperation()
+            {
+                Util::AtomicDecrementU32(list.numActiveOperations[slot]);
+            }
+        };
+
+        static bool IsMarked(const Node_T* pLink)
+        {
+            return (reinterpret_cast<uintptr_t>(pLink) & c_markBit) != 0;
+        }
+
+        static Node_T* GetMarked(Node_T* pLink)
+        {
+            return reinterpret_cast<Node_T*>(reinterpret_cast<uintptr_t>(pLink) | c_markBit);
+        }
+
+        static Node_T* GetUnmarked(Node_T* pLink)
+        {
+            return reinterpret_cast<Node_T*>(reinterpret_cast<uintptr_t>(pLink) & ~c_markBit);
+        }
+
+        static Node_T* LoadLink(Node_T* const& link)
+        {
+            return Util::AtomicLoadPtrT(link, Util::MemoryOrder::ACQUIRE);
+        }
+
+        static bool CASLink(Node_T*& link, Node_T* expected, Node_T* desired)
+        {
+            return Util::AtomicCompareExchangePtrT(link, desired, expected, Util::MemoryOrder::ACQ_REL, Util::MemoryOrder::ACQUIRE);
+        }
+
+        // Push a chain of nodes (linked through pRetiredNext) onto the retired list of an epoch slot
+        void PushRetired(uint32_t slot, Node_T* pFirst, Node_T* pLast)
+        {
+            while(true)
+            {
+                Node_T* pCurrentRetired = Util::AtomicLoadPtrT(pRetiredHeads[slot], Util::MemoryOrder::ACQUIRE);
+                pLast->pRetiredNext = pCurrentRetired;
+                if(Util::AtomicCompareExchangePtrT(pRetiredHeads[slot], pFirst, pCurrentRetired, Util::MemoryOrder::SEQ_CST, Util::MemoryOrder::ACQUIRE))
+                {
+                    return;
+                }
+            }
+        }
+
+        Node_T* TakeRetired(uint32_t slot)
+        {
+            Node_T* pRetired = nullptr;
+            do
+            {
+                pRetired = Util::AtomicLoadPtrT(pRetiredHeads[slot], Util::MemoryOrder::ACQUIRE);
+            } while(pRetired && !Util::AtomicCompareExchangePtrT(pRetiredHeads[slot], static_cast<Node_T*>(nullptr), pRetired, Util::MemoryOrder::SEQ_CST, Util::MemoryOrder::ACQUIRE));
+            return pRetired;
+        }
+
+        template<typename Reclaim_T>
+        static uint32_t ReclaimChain(Node_T* pRetired, Reclaim_T& reclaimFunc)
+        {
+            uint32_t numReclaimed = 0;
+            while(pRetired)
+            {
+                Node_T* pNextRetired = pRetired->pRetiredNext;
+                pRetired->pRetiredNext = nullptr;
+                pRetired->pNext = nullptr;
+                reclaimFunc(pRetired);
+                ++numReclaimed;
+                pRetired = pNextRetired;
+            }
+            return numReclaimed;
+        }
+
+        // Harris-Michael search. Returns the first unmarked node accepted by matchFunc (or nullptr) and the link pointing to it.
+        // Marked nodes passed on the way are unlinked and retired into the operation's epoch by whoever wins the unlinking CAS.
+        // outHead receives the head the successful pass started from.
+        template<typename MatchFunc_T>
+        Node_T* Search(const ScopedOperation& operation, MatchFunc_T&& matchFunc, Node_T**& pOutPrevLink, Node_T*& outHead)
+        {
+            while(true)
+            {
+                bool bRestart = false;
+                Node_T** pPrevLink = &pHead;
+                Node_T* pCurrent = LoadLink(pHead);
+                outHead = pCurrent;
+
+                while(pCurrent != nullptr)
+                {
+                    Node_T* pNextLink = LoadLink(pCurrent->pNext);
+                    if(IsMarked(pNextLink))
+                    {
+                        //Logically deleted, help unlinking it
+                        Node_T* pNextNode = GetUnmarked(pNextLink);
+                        if(!CASLink(*pPrevLink, pCurrent, pNextNode))
+                        {
+                            //The previous node changed or got deleted itself, start over
+                            bRestart = true;
+                            break;
+                        }
+                        PushRetired(operation.slot, pCurrent, pCurrent);
+                        pCurrent = pNextNode;
+                        continue;
+                    }
+
+                    if(matchFunc(pCurrent))
+                    {
+                        pOutPrevLink = pPrevLink;
+                        return pCurrent;
+                    }
+
+                    pPrevLink = &pCurrent->pNext;
+                    pCurrent = pNextLink;
+                }
+
+                if(!bRestart)
+                {
+                    pOutPrevLink = pPrevLink;
+                    return nullptr;
+                }
+            }
+        }
+
+    public:
+        LockFreeLinkedList() = default;
+
+        // Destructor - does NOT delete nodes, external system manages memory
+        ~LockFreeLinkedList()
+        {
+            pHead = nullptr;
+        }
+
+        // Insert a new node at the front of the list
+        // Returns true on success, false on failure
+        bool Insert(Node_T* newNode)
+        {
+            if (!newNode)
+            {
+                return false;
+            }
+
+            do
+            {
+                Node_T* currentHead = LoadLink(pHead);
+                newNode->pNext = currentHead;
+
+                if (CASLink(pHead, currentHead, newNode))
+                {
+                    return true;
+                }
+            } while (true);
+
+            return false; // Should never reach here
+        }
+
+        // Insert a new node at the front of the list if no live node has the same key
+        // The head only changes through inserts and unlinks, so a successful CAS on the head the search
+        // started from proves no node with this key was added in the meantime.
+        template<typename Key_T, typename Predicate_T>
+        bool InsertUnique(Node_T* newNode)
+        {
+            if (!newNode)
+            {
+                return false;
+            }
+
+            ScopedOperation operation(*this);
+
+            const Key_T& searchKey = newNode->key;
+            auto matchFunc = [&searchKey](const Node_T* pNode) { return Predicate_T::Compare(pNode->key, searchKey) == 0; };
+            while (true)
+            {
+                Node_T** pPrevLink = nullptr;
+                Node_T* pSearchHead = nullptr;
+                Node_T* pExistingNode = Search(operation, matchFunc, pPrevLink, pSearchHead);
+                if (pExistingNode)
+                {
+                    return false;
+                }
+
+                newNode->pNext = pSearchHead;
+                if (CASLink(pHead, pSearchHead, newNode))
+                {
+                    return true;
+                }
+            }
+        }
+
+        // Find a live node with the given key
+        // The returned node stays valid until it is erased and reclaimed
+        template<typename Key_T, typename Predicate_T>
+        Node_T* Find(const Key_T& searchKey)
+        {
+            ScopedOperation operation(*this);
+
+            Node_T* current = LoadLink(pHead);
+            while (current != nullptr)
+            {
+                Node_T* nextLink = LoadLink(current->pNext);
+                if (!IsMarked(nextLink) && (Predicate_T::Compare(current->key, searchKey) == 0))
+                {
+                    return current;
+                }
+                current = GetUnmarked(nextLink);
+            }
+
+            return nullptr;
+        }
+
+        // Erase a node with the given key
+        // The node is retired, reclaimFunc(Node_T*) is called for every retired node that became safe to reuse
+        // (possibly none, they are picked up by a later erase or ReclaimRetired).
+        // Returns true if this call erased the node
+        template<typename Key_T, typename Predicate_T, typename Reclaim_T>
+        bool Erase(const Key_T& searchKey, Reclaim_T&& reclaimFunc)
+        {
+            bool bErased = false;
+            {
+                ScopedOperation operation(*this);
+
+                auto matchFunc = [&searchKey](const Node_T* pNode) { return Predicate_T::Compare(pNode->key, searchKey) == 0; };
+                while (true)
+                {
+                    Node_T** pPrevLink = nullptr;
+                    Node_T* pSearchHead = nullptr;
+                    Node_T* pFound = Search(operation, matchFunc, pPrevLink, pSearchHead);
+                    if (!pFound)
+                    {
+                        break;
+                    }
+
+                    Node_T* pNextLink = LoadLink(pFound->pNext);
+                    if (IsMarked(pNextLink) || !CASLink(pFound->pNext, pNextLink, GetMarked(pNextLink)))
+                    {
+                        //Someone else erased it or inserted behind it, search again
+                        continue;
+                    }
+
+                    //Logically deleted, now try to unlink it
+                    bErased = true;
+                    if (CASLink(*pPrevLink, pFound, pNextLink))
+                    {
+                        PushRetired(operation.slot, pFound, pFound);
+                    }
+                    else
+                    {
+                        //Let a search unlink it, it can not return the marked node itself
+                        auto matchNodeFunc = [pFound](const Node_T* pNode) { return pNode == pFound; };
+                        Search(operation, matchNodeFunc, pPrevLink, pSearchHead);
+                    }
+                    break;
+                }
+            }
+
+            if (bErased)
+            {
+                ReclaimRetired(reclaimFunc);
+            }
+            return bErased;
+        }
+
+        // Advance the epoch if nobody is left in the previous one, and hand the nodes retired two epochs back
+        // to reclaimFunc(Node_T*). Every operation that could still reference them has finished by then.
+        // Returns the number of reclaimed nodes
+        template<typename Reclaim_T>
+        uint32_t ReclaimRetired(Reclaim_T&& reclaimFunc)
+        {
+            if (!Util::AtomicCompareExchangeU32(advancingEpoch, 1, 0, Util::MemoryOrder::ACQUIRE, Util::MemoryOrder::RELAXED))
+            {
+                return 0;
+            }
+
+            Node_T* pReclaimable = nullptr;
+            const uint32_t currentEpoch = Util::AtomicLoadU32(epoch, Util::MemoryOrder::SEQ_CST);
+            const uint32_t previousSlot = (currentEpoch + c_numEpochSlots - 1) % c_numEpochSlots;
+            if (Util::AtomicLoadU32(numActiveOperations[previousSlot], Util::MemoryOrder::SEQ_CST) == 0)
+            {
+                //The slot of the epoch before the previous one becomes the next epoch's slot. Nobody retires into it
+                //while the epoch does not move, so it can be emptied before advancing.
+                const uint32_t nextSlot = (currentEpoch + 1) % c_numEpochSlots;
+                pReclaimable = TakeRetired(nextSlot);
+                Util::AtomicStoreU32(epoch, currentEpoch + 1, Util::MemoryOrder::SEQ_CST);
+            }
+            Util::AtomicStoreU32(advancingEpoch, 0, Util::MemoryOrder::RELEASE);
+
+            return ReclaimChain(pReclaimable, reclaimFunc);
+        }
+
+        // Hand all retired nodes to reclaimFunc(Node_T*)
+        // WARNING: Only use when external synchronization guarantees exclusive access
+        template<typename Reclaim_T>
+        uint32_t ReclaimRetired_Unsafe(Reclaim_T&& reclaimFunc)
+        {
+            uint32_t numReclaimed = 0;
+            for (uint32_t slot = 0; slot < c_numEpochSlots; ++slot)
+            {
+                Node_T* pRetired = pRetiredHeads[slot];
+                pRetiredHeads[slot] = nullptr;
+                numReclaimed += ReclaimChain(pRetired, reclaimFunc);
+            }
+            return numReclaimed;
+        }
+
+        // Check if the list is empty
+        bool IsEmpty() const
+        {
+            return pHead == nullptr;
+        }
+
+        // Reset the list without deallocating nodes
+        // WARNING: Only use when external synchronization guarantees exclusive access
+        void Reset_Unsafe()
+        {
+            pHead = nullptr;
+        }
+
+        // Get the head pointer (for iteration or debugging)
+        // WARNING: Use with caution in concurrent scenarios
+        Node_T* GetHead_Unsafe() const
+        {
+            return pHead;
+        }
+    };
+
+} // end namespace ThreadsafeContainers
+} // end namespace PklE
@@ -78,5 +78,21 @@ namespace Util
         return index;
     }
 
+    // Index of the lowest set bit. Result is undefined for a value of 0.
+    inline uint32_t CountTrailingZeros64(uint64_t value)
+    {
+        #if defined(__GNUC__) || defined(__clang__)
+        return static_cast<uint32_t>(__builtin_ctzll(value));
+        #else
+        uint32_t count = 0;
+        while((value & 1) == 0)
+        {
+            value >>= 1;
+            ++count;
+        }
+        return count;
+        #endif
+    }
+
 }; //end namespace Util
 }; //end namespace PklE
\ No newline at end of file
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace PklE
+{
+namespace CoreTypes
+{
+    // Self-relative pointer: stores the distance from its own address to the target.
+    //
+    // Stays valid in every process that maps the containing segment, at whatever base address,
+    // as long as the pointer and its target live in the same mapping.
+    // An offset of 0 is null, a pointer never targets itself.
+    template<typename T>
+    class OffsetPtr
+    {
+        int64_t offset = 0;
+
+        static int64_t GetOffset(const void* pFrom, const T* pTarget)
+        {
+            if(!pTarget)
+            {
+                return 0;
+            }
+            return reinterpret_cast<intptr_t>(pTarget) - reinterpret_cast<intptr_t>(pFrom);
+        }
+
+    public:
+        OffsetPtr() = default;
+
+        OffsetPtr(T* pTarget) : offset(GetOffset(this, pTarget))
+        {
+        }
+
+        // Copies re-derive the offset for the new address
+        OffsetPtr(const OffsetPtr& other) : offset(GetOffset(this, other.Get()))
+        {
+        }
+
+        OffsetPtr& operator=(const OffsetPtr& other)
+        {
+            offset = GetOffset(this, other.Get());
+            return *this;
+        }
+
+        OffsetPtr& operator=(T* pTarget)
+        {
+            offset = GetOffset(this, pTarget);
+            return *this;
+        }
+
+        T* Get() const
+        {
+            if(offset == 0)
+            {
+                return nullptr;
+            }
+            return reinterpret_cast<T*>(reinterpret_cast<intptr_t>(this) + offset);
+        }
+
+        T* operator->() const
+        {
+            return Get();
+        }
+
+        T& operator*() const
+        {
+            return *Get();
+        }
+
+        explicit operator bool() const
+        {
+            return offset != 0;
+        }
+    };
+
+}; //end namespace CoreTypes
+}; //end namespace PklE
@@ -6,8 +6,12 @@
 #include "sized_byte_type.h"
 #include "memory_util.h"
 #include "fixedsize_object_pool.h"
+#include "striped_counter.h"
+#include "allocation_counter.h"
+#include "worker_threads.h"
 
 #include <utility>
+#include <thread>
 
 namespace PklE
 {
@@ -18,22 +22,7 @@ namespace CoreTypes
     {
     public:
         static inline constexpr uint32_t c_PageSize = static_cast<uint32_t>(PageSize_T);
-        inline static constexpr uint32_t c_InvalidPageIndex = 0x0FFFFFFF;  // 28-bit max value
-        inline static constexpr uint32_t c_TailPageIndex = 0x0FFFFFFE;    // 28-bit sentinel
-        inline static constexpr uint32_t c_SwappingPageIndex = 0x0FFFFFFD; // Sentinel for double-push prevention
-        inline static constexpr uint32_t c_MaxPages = c_TailPageIndex - 1;
-
         static inline constexpr uint64_t c_PageAlignment = PageAlignment_T;
-
-        // Bit layout for 64-bit free list head (ABA-safe)
-        inline static constexpr uint64_t c_bitIndexHeadPageIndex = 0;
-        inline static constexpr uint64_t c_bitIndexHeadNextIndex = 28;
-        inline static constexpr uint64_t c_bitIndexHeadCounter = 56;
-        inline static constexpr uint64_t c_headPageIndexMask = (0x0FFFFFFFull << c_bitIndexHeadPageIndex);  // 28 bits
-        inline static constexpr uint64_t c_headNextIndexMask = (0x0FFFFFFFull << c_bitIndexHeadNextIndex);  // 28 bits
-        inline static constexpr uint64_t c_headCounterMask = (0xFFull << c_bitIndexHeadCounter);            // 8 bits
-
-        inline static constexpr uint64_t c_emptyFreeListHeadIndex = ((static_cast<uint64_t>(c_TailPageIndex) << c_bitIndexHeadNextIndex) | static_cast<uint64_t>(c_TailPageIndex));
     private:
         struct Page;
         struct Node
@@ -50,125 +39,191 @@ namespace CoreTypes
         using ThisPoolType = PagingObjectPool<T, PageSize_T, PageAlignment_T>;
         using FixedSizeObjectPoolType = FixedSizeObjectPool<Node, PageSize_T, PageAlignment_T>;
 
+        // Checkpoint states of a page, see BeginCheckpoint()
+        inline static constexpr uint32_t c_checkpointIdle = 0;
+        inline static constexpr uint32_t c_checkpointPending = 1;     //Captured by the running checkpoint, not written yet
+        inline static constexpr uint32_t c_checkpointCopying = 2;     //A writer is copying the page before its first write
+        inline static constexpr uint32_t c_checkpointCopied = 3;      //The checkpoint will write the copy, writers may go ahead
+        inline static constexpr uint32_t c_checkpointWriting = 4;     //The checkpoint is reading the live page, writers wait
+
+        // Copy of a page's objects taken on the first write while the page is pending in a checkpoint
+        struct PageSnapshot
+        {
+            uint32_t numObjects = 0;
+            alignas(T) uint8_t objects[c_PageSize][sizeof(T)];
+        };
+
         struct Page
         {
             FixedSizeObjectPoolType data;
             uint32_t pageIndex = 0;
-            uint32_t nextFreeIndex = c_InvalidPageIndex;
+            uint32_t bInFreeList = 0; //Set while the page is in the free list or being pushed, prevents double pushes
+            Page* pNextFree = nullptr;
+            uint32_t bDirty = 1; //Changed since the last checkpoint, new pages start dirty
+            uint32_t checkpointState = c_checkpointIdle;
+            PageSnapshot* pSnapshot = nullptr;
+            uint32_t generation = 0; //Pool generation the objects belong to, older pages were emptied by ClearLazy()
         };
 
         CoreTypes::CountingSpinlock pageListLock;
+        uint32_t numCheckpointPages = 0; //Pages that existed when the running checkpoint began
 
         Page** pPageList = nullptr;
         uint32_t numPages = 0;
         uint32_t pageCapacity = 0;
 
-        PKLE_DECLARE_ATOMIC_ALIGNED(uint32_t, count) = 0;
+        Util::ContainerCounter count;
+        uint32_t bFixedCapacity = 0; //See SetFixedCapacity()
+
+        static constexpr uint32_t c_minPagesPerWorker = 1024; //Bulk operations do not start a thread for fewer pages
+
+        // ClearLazy() state. Pages below numStalePages hold objects of an older generation and are not in the free list,
+        // Reserve hands them out again in order from nextStalePage once the free list runs dry.
+        uint32_t generation = 0;
+        uint32_t numStalePages = 0;
+        uint32_t nextStalePage = 0;
         
-        // Lock-free singly-linked list head with ABA counter (packed 64-bit)
-        uint64_t freeListHeadIndex = c_emptyFreeListHeadIndex;
+        // Lock-free singly-linked list of pages with free space. The head is a page pointer plus a 64-bit version
+        // swapped together, so a pop that read a stale next pointer fails its compare exchange (ABA safe).
+        Util::AtomicTaggedPtr<Page> freeListHead;
 
         void PushPageToFreeList(Page* pPage)
         {
-            if(pPage)
+            if(pPage && Util::AtomicCompareExchangeU32(pPage->bInFreeList, 1, 0, Util::MemoryOrder::ACQUIRE, Util::MemoryOrder::RELAXED))
             {
-                // First, prevent double-push by atomically marking this page as being pushed
-                bool bSetNextIndex = false;
-                while(pPage->nextFreeIndex == c_InvalidPageIndex && !bSetNextIndex)
+                typename Util::AtomicTaggedPtr<Page>::Snapshot head = freeListHead.Load();
+                do
                 {
-                    bSetNextIndex = Util::AtomicCompareExchange<uint32_t>(pPage->nextFreeIndex, c_SwappingPageIndex, c_InvalidPageIndex, Util::MemoryOrder::ACQUIRE, Util::MemoryOrder::RELAXED);
-                } 
+                    Util::AtomicStorePtrT(pPage->pNextFree, head.pointer, Util::MemoryOrder::RELAXED);
+                } while(!freeListHead.CompareExchange(head, pPage));
+            }
+        }
 
-                if(bSetNextIndex)
+        Page* PopPageFromFreeList()
+        {
+            typename Util::AtomicTaggedPtr<Page>::Snapshot head = freeListHead.Load();
+            while(head.pointer)
+            {
+                // Pages are only freed by Clear(), so reading the next pointer of a page another thread popped meanwhile is safe,
+                // the version in the head makes the compare exchange fail in that case
+                Page* pNextPage = Util::AtomicLoadPtrT(head.pointer->pNextFree, Util::MemoryOrder::RELAXED);
+                Page* pPoppedPage = head.pointer;
+                if(freeListHead.CompareExchange(head, pNextPage))
                 {
-                    bool bPushed = false;
-                    do
-                    {
-                        const uint64_t currFreeListHeadIndex = Util::AtomicLoadU64(freeListHeadIndex, Util::MemoryOrder::ACQUIRE);
-                        const uint32_t currFreeListHeadPageIndex = static_cast<uint32_t>((currFreeListHeadIndex & c_headPageIndexMask) >> c_bitIndexHeadPageIndex);
-                        const uint32_t currFreeListHeadNextIndex = static_cast<uint32_t>((currFreeListHeadIndex & c_headNextIndexMask) >> c_bitIndexHeadNextIndex);
-                        const uint8_t currCounter = static_cast<uint8_t>((currFreeListHeadIndex & c_headCounterMask) >> c_bitIndexHeadCounter);
-
-                        const uint32_t nextHeadPageIndex = pPage->pageIndex;
-                        const uint32_t nextHeadNextIndex = currFreeListHeadPageIndex;
-                        const uint8_t nextCounter = static_cast<uint8_t>(currCounter + 1);  // Rolling counter to prevent ABA
-
-                        if((nextHeadPageIndex < numPages) && ((nextHeadNextIndex < numPages) || (nextHeadNextIndex == c_TailPageIndex)))
-                        {
-                            const uint64_t nextFreeListHeadIndex = ((static_cast<uint64_t>(nextCounter) << c_bitIndexHeadCounter) | (static_cast<uint64_t>(nextHeadNextIndex) << c_bitIndexHeadNextIndex) | static_cast<uint64_t>(nextHeadPageIndex));
-                            Util::AtomicStoreU32(pPage->nextFreeIndex, currFreeListHeadPageIndex, Util::MemoryOrder::RELEASE);
-                            bPushed = Util::AtomicCompareExchangeU64(freeListHeadIndex, nextFreeListHeadIndex, currFreeListHeadIndex, Util::MemoryOrder::RELEASE, Util::MemoryOrder::RELAXED);
-                        }
-                        else
-                        {
-                            PKLE_ASSERT_SYSTEM_ERROR_MSG(false, "PagingObjectPool::PushPageToFreeList - Invalid free list head indices");
-                        }
-                    } while (!bPushed);
+                    Util::AtomicStoreU32(pPoppedPage->bInFreeList, 0, Util::MemoryOrder::RELEASE);
+                    return pPoppedPage;
                 }
             }
+            return nullptr;
         }
 
-        Page* PopPageFromFreeList()
+        // Gate every write to a page goes through. Marks the page dirty and, if the page is pending in a
+        // running checkpoint, copies it first so the checkpoint still sees the page as it was when it began.
+        void PrepareWrite(Page* pPage)
         {
-            bool bPopped = false;
-            uint32_t poppedPageIndex = c_InvalidPageIndex;
-            while (!bPopped)
+            uint32_t state = Util::AtomicLoadU32(pPage->checkpointState, Util::MemoryOrder::ACQUIRE);
+            while(state != c_checkpointIdle && state != c_checkpointCopied)
             {
-                const uint64_t currFreeListHeadIndex = Util::AtomicLoadU64(freeListHeadIndex, Util::MemoryOrder::ACQUIRE);
-                const uint32_t currFreeListHeadPageIndex = static_cast<uint32_t>((currFreeListHeadIndex & c_headPageIndexMask) >> c_bitIndexHeadPageIndex);
-                const uint32_t currFreeListHeadNextIndex = static_cast<uint32_t>((currFreeListHeadIndex & c_headNextIndexMask) >> c_bitIndexHeadNextIndex);
-                const uint8_t currCounter = static_cast<uint8_t>((currFreeListHeadIndex & c_headCounterMask) >> c_bitIndexHeadCounter);
-
-                if(currFreeListHeadPageIndex < numPages)
+                if((state == c_checkpointPending) && Util::AtomicCompareExchangeU32(pPage->checkpointState, c_checkpointCopying, c_checkpointPending, Util::MemoryOrder::ACQUIRE, Util::MemoryOrder::RELAXED))
                 {
-                    Page* pNextPage = nullptr;
-                    if(currFreeListHeadNextIndex < numPages)
+                    PageSnapshot* pSnapshot = static_cast<PageSnapshot*>(Util::Malloc(sizeof(PageSnapshot)));
+                    Util::CountContainerAllocation(sizeof(PageSnapshot));
+                    PKLE_ASSERT_SYSTEM_ERROR_MSG(pSnapshot != nullptr, "PagingObjectPool::PrepareWrite: Failed to allocate page snapshot.");
+                    pSnapshot->numObjects = 0;
+                    for(auto it = GetPageBegin(pPage); it != pPage->data.end(); ++it)
                     {
-                        CoreTypes::ScopedReadSpinLock readLock(pageListLock);
-                        pNextPage = pPageList[currFreeListHeadNextIndex];
+                        Node* pNode = *it;
+                        Util::MemCpy(pSnapshot->objects[pSnapshot->numObjects++], &(pNode->data), sizeof(T));
                     }
-                    
-                    const uint32_t nextHeadPageIndex = currFreeListHeadNextIndex;
-                    const uint32_t nextHeadNextIndex = (pNextPage) ? (Util::AtomicLoadU32(pNextPage->nextFreeIndex, Util::MemoryOrder::ACQUIRE)) : (c_TailPageIndex);
-                    const uint8_t nextCounter = static_cast<uint8_t>(currCounter + 1);  // Rolling counter to prevent ABA
+                    pPage->pSnapshot = pSnapshot;
+                    Util::AtomicStoreU32(pPage->checkpointState, c_checkpointCopied, Util::MemoryOrder::RELEASE);
+                    break;
+                }
 
-                    if(nextHeadNextIndex != c_InvalidPageIndex && nextHeadNextIndex != c_SwappingPageIndex)
-                    {
-                        const uint64_t nextFreeListHeadIndex = ((static_cast<uint64_t>(nextCounter) << c_bitIndexHeadCounter) | (static_cast<uint64_t>(nextHeadNextIndex) << c_bitIndexHeadNextIndex) | static_cast<uint64_t>(nextHeadPageIndex));
-                        bPopped = Util::AtomicCompareExchangeU64(freeListHeadIndex, nextFreeListHeadIndex, currFreeListHeadIndex, Util::MemoryOrder::ACQUIRE, Util::MemoryOrder::RELAXED);
-                    }
+                //Another writer is copying the page, or the checkpoint is reading it
+                std::this_thread::yield();
+                state = Util::AtomicLoadU32(pPage->checkpointState, Util::MemoryOrder::ACQUIRE);
+            }
 
-                    if(bPopped)
-                    {
-                        poppedPageIndex = currFreeListHeadPageIndex;
-                    }
-                }
-                else if(currFreeListHeadPageIndex == c_TailPageIndex)
+            if(!pPage->bDirty)
+            {
+                Util::AtomicStoreU32(pPage->bDirty, 1, Util::MemoryOrder::RELAXED);
+            }
+        }
+
+        template<typename Visitor_T>
+        void VisitPage(const uint32_t pageIndex, Page* pPage, Visitor_T& visitor)
+        {
+            const T* pObjects[c_PageSize];
+            uint32_t numObjects = 0;
+            if(pPage->pSnapshot)
+            {
+                for(uint32_t i = 0; i < pPage->pSnapshot->numObjects; ++i)
                 {
-                    // Free list is empty
-                    poppedPageIndex = c_TailPageIndex;
-                    bPopped = true;
+                    pObjects[numObjects++] = reinterpret_cast<const T*>(pPage->pSnapshot->objects[i]);
                 }
-                else
+            }
+            else
+            {
+                for(auto it = GetPageBegin(pPage); it != pPage->data.end(); ++it)
                 {
-                    PKLE_ASSERT_SYSTEM_ERROR_MSG(false, "PagingObjectPool::PopPageFromFreeList - Invalid free list head page index");
+                    Node* pNode = *it;
+                    pObjects[numObjects++] = &(pNode->data);
                 }
             }
+            visitor(pageIndex, pObjects, numObjects);
+        }
+
+        // Objects of a page from before the last ClearLazy() are dead, iterate such a page as empty
+        typename FixedSizeObjectPoolType::Iterator GetPageBegin(Page* pPage)
+        {
+            return (pPage->generation == generation) ? pPage->data.begin() : pPage->data.end();
+        }
+
+        // Hands the next page emptied by ClearLazy() back to the free list, destroying its old objects first.
+        // Returns false once there are none left.
+        bool ReclaimStalePage()
+        {
+            if(Util::AtomicLoadU32(nextStalePage, Util::MemoryOrder::RELAXED) >= numStalePages)
+            {
+                return false;
+            }
+            const uint32_t pageIndex = Util::AtomicIncrementU32(nextStalePage) - 1;
+            if(pageIndex >= numStalePages)
+            {
+                return false;
+            }
 
-            Page* pPoppedPage = nullptr;
-            if(poppedPageIndex < numPages)
+            Page* pPage = nullptr;
             {
                 CoreTypes::ScopedReadSpinLock readLock(pageListLock);
-                pPoppedPage = pPageList[poppedPageIndex];
-                Util::AtomicStoreU32(pPoppedPage->nextFreeIndex, c_InvalidPageIndex, Util::MemoryOrder::RELEASE);
+                pPage = pPageList[pageIndex];
             }
+            PrepareWrite(pPage);
+            pPage->data.Clear();
+            pPage->generation = generation;
+            Util::AtomicStoreU32(pPage->bInFreeList, 0, Util::MemoryOrder::RELEASE);
+            PushPageToFreeList(pPage);
+            return true;
+        }
 
-            return pPoppedPage;
+        // Fixed capacity only: the free list can be empty for a moment while another thread holds the last page
+        // with space, so only report the pool full once the count says so, otherwise wait for the page to come back
+        bool WaitForFreeCapacity() const
+        {
+            if(count.ReadU32() >= GetCapacity())
+            {
+                return false;
+            }
+            std::this_thread::yield();
+            return true;
         }
 
         Page* AllocateNewPage()
         {
             Page* pNewPage = Util::NewAligned<Page>(c_PageAlignment);
+            Util::CountContainerAllocation(sizeof(Page));
+            pNewPage->generation = generation;
             {
                 CoreTypes::ScopedReadSpinLock readLock(pageListLock);
 
@@ -186,6 +241,7 @@ namespace CoreTypes
                         }
 
                         Page** pNewPageList = reinterpret_cast<Page**>(Util::Malloc(sizeof(Page*) * newPageCapacity));
+                        Util::CountContainerAllocation(sizeof(Page*) * newPageCapacity);
                         if(pPageList)
                         {
                             Util::MemSet(reinterpret_cast<uint8_t*>(pNewPageList), static_cast<uint8_t>(0), sizeof(Page*) * newPageCapacity);
@@ -236,7 +292,7 @@ namespace CoreTypes
                 if(pageIndex < pPool->numPages)
                 {
                     Page* pPage = pPool->pPageList[pageIndex];
-                    currPageIterator = pPage->data.begin();
+                    currPageIterator = pPool->GetPageBegin(pPage);
                     endPageIterator = pPage->data.end();
                     
                     while(currPageIterator == endPageIterator)
@@ -245,7 +301,7 @@ namespace CoreTypes
                         {
                             ++pageIndex;
                             Page* pPage = pPool->pPageList[pageIndex];
-                            currPageIterator = pPage->data.begin();
+                            currPageIterator = pPool->GetPageBegin(pPage);
                             endPageIterator = pPage->data.end();
                         }
                         else
@@ -290,7 +346,7 @@ namespace CoreTypes
                     {
                         ++pageIndex;
                         Page* pPage = pPool->pPageList[pageIndex];
-                        currPageIterator = pPage->data.begin();
+                        currPageIterator = pPool->GetPageBegin(pPage);
                         endPageIterator = pPage->data.end();
                     }
                     else
@@ -351,12 +407,33 @@ namespace CoreTypes
             }
         }
 
+        // In fixed capacity mode Reserve() and ReserveRaw() never allocate pages, they return nullptr once
+        // all pages are full. Preallocate with PreallocateSpace() first.
+        void SetFixedCapacity(const bool bFixed)
+        {
+            Util::AtomicStoreU32(bFixedCapacity, bFixed ? 1 : 0, Util::MemoryOrder::RELEASE);
+        }
+
+        bool IsFixedCapacity() const
+        {
+            return bFixedCapacity != 0;
+        }
+
+        // Makes room for numObjects more objects. Free slots already in the pool count towards it, which includes
+        // the pages emptied by ClearLazy() that Reserve has not reclaimed yet, so a clear followed by a preallocate
+        // of the same size reuses the old pages instead of doubling the pool.
         void PreallocateSpace(uint32_t numObjects)
         {
-            uint32_t numPagesNeeded = (numObjects + c_PageSize - 1) / c_PageSize;
-            for(uint32_t i = 0; i < numPagesNeeded; ++i)
+            const uint32_t capacity = GetCapacity();
+            const uint32_t numUsed = count.ReadU32();
+            const uint32_t numFree = (capacity > numUsed) ? (capacity - numUsed) : 0;
+            if(numObjects > numFree)
             {
-                AllocateNewPage();
+                const uint32_t numPagesNeeded = (numObjects - numFree + c_PageSize - 1) / c_PageSize;
+                for(uint32_t i = 0; i < numPagesNeeded; ++i)
+                {
+                    AllocateNewPage();
+                }
             }
         }
         
@@ -369,11 +446,12 @@ namespace CoreTypes
                 Page* pPageWithSpace = PopPageFromFreeList();
                 if(pPageWithSpace)
                 {
+                    PrepareWrite(pPageWithSpace);
                     pSelectedNode = pPageWithSpace->data.Reserve(args...);
                     if(pSelectedNode)
                     {
                         pSelectedNode->pageIndex = pPageWithSpace->pageIndex;
-                        Util::AtomicIncrementU32(count);
+                        count.Increment();
                         //We allocated from the page, so re-add it to the free space list if it's not full
                         if(!pPageWithSpace->data.IsFull())
                         {
@@ -381,9 +459,16 @@ namespace CoreTypes
                         }
                     }
                 }
-                else
+                else if(!ReclaimStalePage())
                 {
-                    AllocateNewPage();
+                    if(!bFixedCapacity)
+                    {
+                        AllocateNewPage();
+                    }
+                    else if(!WaitForFreeCapacity())
+                    {
+                        break;
+                    }
                 }
             } while (pSelectedNode == nullptr);
 
@@ -393,7 +478,7 @@ namespace CoreTypes
                 pObject = &(pSelectedNode->data);
             }
 
-            PKLE_ASSERT_SYSTEM_ERROR_MSG(pObject != nullptr, "PagingObjectPool::Reserve: Failed to reserve object from pool.");
+            PKLE_ASSERT_SYSTEM_ERROR_MSG(pObject != nullptr || bFixedCapacity, "PagingObjectPool::Reserve: Failed to reserve object from pool.");
 
             return pObject;
         }
@@ -406,13 +491,14 @@ namespace CoreTypes
                 Page* pPageWithSpace = PopPageFromFreeList();
                 if(pPageWithSpace)
                 {
+                    PrepareWrite(pPageWithSpace);
                     void* pReservedRawNode = pPageWithSpace->data.ReserveRaw();
                     if(pReservedRawNode)
                     {
                         pSelectedNode = reinterpret_cast<Node*>(pReservedRawNode);
                         pSelectedNode->pageIndex = pPageWithSpace->pageIndex;
 
-                        Util::AtomicIncrementU32(count);
+                        count.Increment();
                         //We allocated from the page, so re-add it to the free space list if it's not full
                         if(!pPageWithSpace->data.IsFull())
                         {
@@ -420,9 +506,16 @@ namespace CoreTypes
                         }
                     }
                 }
-                else
+                else if(!ReclaimStalePage())
                 {
-                    AllocateNewPage();
+                    if(!bFixedCapacity)
+                    {
+                        AllocateNewPage();
+                    }
+                    else if(!WaitForFreeCapacity())
+                    {
+                        break;
+                    }
                 }
             } while (pSelectedNode == nullptr);
 
@@ -432,7 +525,7 @@ namespace CoreTypes
                 pRawMemory = reinterpret_cast<void*>(&(pSelectedNode->data));
             }
 
-            PKLE_ASSERT_SYSTEM_ERROR_MSG(pRawMemory != nullptr, "PagingObjectPool::ReserveRaw: Failed to reserve raw memory from pool.");
+            PKLE_ASSERT_SYSTEM_ERROR_MSG(pRawMemory != nullptr || bFixedCapacity, "PagingObjectPool::ReserveRaw: Failed to reserve raw memory from pool.");
 
             return pRawMemory;
         }
@@ -452,10 +545,11 @@ namespace CoreTypes
                         pPage = pPageList[pageIndex];
                     }
 
+                    PrepareWrite(pPage);
                     bReleased = pPage->data.Release(pNode);
                     if(bReleased)
                     {
-                        Util::AtomicDecrementU32(count);
+                        count.Decrement();
                     }
 
                     // Page has space, so try to add it back to the free space list
@@ -480,10 +574,11 @@ namespace CoreTypes
                         pPage = pPageList[pageIndex];
                     }
 
+                    PrepareWrite(pPage);
                     bReleased = pPage->data.ReleaseRaw(pNode);
                     if(bReleased)
                     {
-                        Util::AtomicDecrementU32(count);
+                        count.Decrement();
                     }
 
                     // Page has space, so try to add it back to the free space list
@@ -493,6 +588,83 @@ namespace CoreTypes
             return bReleased;
         }
 
+        // Call before mutating an object in place, so the page is tracked for the next checkpoint.
+        // Reserve and Release already do this.
+        void MarkDirty(const T* pObject)
+        {
+            const Node* pNode = reinterpret_cast<const Node*>(pObject);
+            if(pNode && (pNode->pageIndex < numPages))
+            {
+                Page* pPage = nullptr;
+                {
+                    CoreTypes::ScopedReadSpinLock readLock(pageListLock);
+                    pPage = pPageList[pNode->pageIndex];
+                }
+                PrepareWrite(pPage);
+            }
+        }
+
+        // Capture the pages changed since the last checkpoint (or all pages when bFullCheckpoint) and clear their dirty flags.
+        // Returns the number of captured pages, write them out with FinishCheckpoint().
+        // WARNING: The caller must make sure no writes are in flight while this runs, writes may resume right after.
+        uint32_t BeginCheckpoint(const bool bFullCheckpoint)
+        {
+            CoreTypes::ScopedReadSpinLock readLock(pageListLock);
+            numCheckpointPages = numPages;
+            uint32_t numCapturedPages = 0;
+            for(uint32_t i = 0; i < numCheckpointPages; ++i)
+            {
+                Page* pPage = pPageList[i];
+                if(bFullCheckpoint || pPage->bDirty)
+                {
+                    pPage->bDirty = 0;
+                    Util::AtomicStoreU32(pPage->checkpointState, c_checkpointPending, Util::MemoryOrder::RELEASE);
+                    ++numCapturedPages;
+                }
+            }
+            return numCapturedPages;
+        }
+
+        // Hand every captured page to visitor(pageIndex, const T** ppObjects, numObjects), concurrently with writers.
+        // Pages a writer touched first are read from the copy it took, all others from the live page.
+        template<typename Visitor_T>
+        void FinishCheckpoint(Visitor_T&& visitor)
+        {
+            for(uint32_t i = 0; i < numCheckpointPages; ++i)
+            {
+                Page* pPage = nullptr;
+                {
+                    CoreTypes::ScopedReadSpinLock readLock(pageListLock);
+                    pPage = pPageList[i];
+                }
+
+                uint32_t state = Util::AtomicLoadU32(pPage->checkpointState, Util::MemoryOrder::ACQUIRE);
+                while(state != c_checkpointIdle)
+                {
+                    if((state == c_checkpointPending) && Util::AtomicCompareExchangeU32(pPage->checkpointState, c_checkpointWriting, c_checkpointPending, Util::MemoryOrder::ACQUIRE, Util::MemoryOrder::RELAXED))
+                    {
+                        VisitPage(i, pPage, visitor);
+                        Util::AtomicStoreU32(pPage->checkpointState, c_checkpointIdle, Util::MemoryOrder::RELEASE);
+                    }
+                    else if(state == c_checkpointCopied)
+                    {
+                        VisitPage(i, pPage, visitor);
+                        PageSnapshot* pSnapshot = pPage->pSnapshot;
+                        pPage->pSnapshot = nullptr;
+                        Util::Free(pSnapshot);
+                        Util::AtomicStoreU32(pPage->checkpointState, c_checkpointIdle, Util::MemoryOrder::RELEASE);
+                    }
+                    else
+                    {
+                        //A writer is copying the page
+                        std::this_thread::yield();
+                    }
+                    state = Util::AtomicLoadU32(pPage->checkpointState, Util::MemoryOrder::ACQUIRE);
+                }
+            }
+            numCheckpointPages = 0;
+        }
+
         uint32_t GetCapacity() const
         {
             return numPages * PageSize_T;
@@ -512,15 +684,195 @@ namespace CoreTypes
             
             numPages = 0;
             pageCapacity = 0;
+            numStalePages = 0;
+            nextStalePage = 0;
             
-            freeListHeadIndex = c_emptyFreeListHeadIndex;
-            count = 0;
+            freeListHead.Reset(nullptr);
+            count.Reset();
+        }
+
+        // Empties the pool without touching the pages: they move to a new generation and keep their memory.
+        // The old objects are destroyed when Reserve reuses their page, or when the pool is cleared or destroyed.
+        // WARNING: Not safe against concurrent use, and pointers to the old objects must not be released afterwards
+        void ClearLazy()
+        {
+            ++generation;
+            if(generation == 0)
+            {
+                //Wrapped around, restamp so that no page can match a later generation by accident
+                for(uint32_t i = 0; i < numPages; ++i)
+                {
+                    pPageList[i]->generation = 0;
+                }
+                generation = 1;
+            }
+
+            numStalePages = numPages;
+            nextStalePage = 0;
+            freeListHead.Reset(nullptr);
+            count.Reset();
+        }
+
+        // Clear() spread over numThreads threads, the calling thread included. Frees the pages in parallel,
+        // which destroys the objects left in them, for pools of millions of non-trivially destructible objects.
+        void Clear_Parallel(const uint32_t numThreads)
+        {
+            const uint32_t numWorkers = Util::GetNumWorkers(numThreads, numPages, c_minPagesPerWorker);
+            if(pPageList && (numWorkers > 1))
+            {
+                Util::RunOnWorkerThreads(numWorkers, [this, numWorkers](const uint32_t workerIndex)
+                {
+                    const uint32_t firstPage = static_cast<uint32_t>(Util::GetWorkerRangeBegin(numPages, numWorkers, workerIndex));
+                    const uint32_t endPage = static_cast<uint32_t>(Util::GetWorkerRangeBegin(numPages, numWorkers, workerIndex + 1));
+                    for(uint32_t i = firstPage; i < endPage; ++i)
+                    {
+                        Util::DeleteAligned<Page>(pPageList[i]);
+                        pPageList[i] = nullptr;
+                    }
+                });
+                numPages = 0;
+            }
+            Clear();
+        }
+
+        // Copies the pages of source into this pool on numThreads threads, replacing what it held. Objects are
+        // copy constructed into the same page and slot, so GetCloneOf() maps a pointer into source to its copy.
+        // WARNING: Not safe against concurrent use of either pool
+        void CloneFrom(PagingObjectPool& source, const uint32_t numThreads)
+        {
+            Clear();
+            const uint32_t numSourcePages = source.numPages;
+            if(numSourcePages == 0)
+            {
+                return;
+            }
+
+            pPageList = reinterpret_cast<Page**>(Util::Malloc(sizeof(Page*) * numSourcePages));
+            Util::CountContainerAllocation(sizeof(Page*) * numSourcePages);
+            pageCapacity = numSourcePages;
+
+            const uint32_t numWorkers = Util::GetNumWorkers(numThreads, numSourcePages, c_minPagesPerWorker);
+            Util::RunOnWorkerThreads(numWorkers, [this, &source, numSourcePages, numWorkers](const uint32_t workerIndex)
+            {
+                const uint32_t firstPage = static_cast<uint32_t>(Util::GetWorkerRangeBegin(numSourcePages, numWorkers, workerIndex));
+                const uint32_t endPage = static_cast<uint32_t>(Util::GetWorkerRangeBegin(numSourcePages, numWorkers, workerIndex + 1));
+                for(uint32_t i = firstPage; i < endPage; ++i)
+                {
+                    Page* pSourcePage = source.pPageList[i];
+                    Page* pPage = Util::NewAligned<Page>(c_PageAlignment);
+                    Util::CountContainerAllocation(sizeof(Page));
+                    pPage->pageIndex = i;
+                    pPage->generation = generation;
+                    for(auto it = source.GetPageBegin(pSourcePage); it != pSourcePage->data.end(); ++it)
+                    {
+                        const Node* pSourceNode = *it;
+                        Node* pNode = pPage->data.ReserveAt(pSourcePage->data.GetIndex(pSourceNode), pSourceNode->data);
+                        pNode->pageIndex = i;
+                    }
+                    pPageList[i] = pPage;
+                }
+            });
+
+            numPages = numSourcePages;
+            for(uint32_t i = 0; i < numPages; ++i)
+            {
+                if(!pPageList[i]->data.IsFull())
+                {
+                    PushPageToFreeList(pPageList[i]);
+                }
+            }
+            count.Add_Lockless(source.count.Read());
+        }
+
+        // The copy CloneFrom(source) made of an object of source
+        T* GetCloneOf(const PagingObjectPool& source, const T* pSourceObject) const
+        {
+            if(!pSourceObject)
+            {
+                return nullptr;
+            }
+            const Node* pSourceNode = reinterpret_cast<const Node*>(pSourceObject);
+            const uintptr_t offsetInPage = reinterpret_cast<uintptr_t>(pSourceNode) - reinterpret_cast<uintptr_t>(source.pPageList[pSourceNode->pageIndex]);
+            Node* pNode = reinterpret_cast<Node*>(reinterpret_cast<uintptr_t>(pPageList[pSourceNode->pageIndex]) + offsetInPage);
+            return &(pNode->data);
+        }
+
+        // Moves every page of donor to the end of this pool, the objects stay where they are. Pointers to them
+        // stay valid and have to be released through this pool from now on. Leaves donor empty.
+        // Renumbering the moved objects is spread over numThreads threads.
+        // WARNING: Not safe against concurrent use of either pool
+        void AdoptPages(PagingObjectPool& donor, const uint32_t numThreads)
+        {
+            const uint32_t numDonorPages = donor.numPages;
+            if((numDonorPages == 0) || (&donor == this))
+            {
+                return;
+            }
+
+            const uint32_t firstPageIndex = numPages;
+            const uint32_t newNumPages = numPages + numDonorPages;
+            if(newNumPages > pageCapacity)
+            {
+                Page** pNewPageList = reinterpret_cast<Page**>(Util::Malloc(sizeof(Page*) * newNumPages));
+                Util::CountContainerAllocation(sizeof(Page*) * newNumPages);
+                if(pPageList)
+                {
+                    Util::MemCpy(pNewPageList, pPageList, sizeof(Page*) * numPages);
+                    Util::Free(pPageList);
+                }
+                pPageList = pNewPageList;
+                pageCapacity = newNumPages;
+            }
+
+            const uint32_t numWorkers = Util::GetNumWorkers(numThreads, numDonorPages, c_minPagesPerWorker);
+            Util::RunOnWorkerThreads(numWorkers, [this, &donor, firstPageIndex, numDonorPages, numWorkers](const uint32_t workerIndex)
+            {
+                const uint32_t firstPage = static_cast<uint32_t>(Util::GetWorkerRangeBegin(numDonorPages, numWorkers, workerIndex));
+                const uint32_t endPage = static_cast<uint32_t>(Util::GetWorkerRangeBegin(numDonorPages, numWorkers, workerIndex + 1));
+                for(uint32_t i = firstPage; i < endPage; ++i)
+                {
+                    Page* pPage = donor.pPageList[i];
+                    if(pPage->generation != donor.generation)
+                    {
+                        //Emptied by a ClearLazy() of the donor
+                        pPage->data.Clear();
+                    }
+                    const uint32_t pageIndex = firstPageIndex + i;
+                    pPage->pageIndex = pageIndex;
+                    pPage->generation = generation;
+                    pPage->bInFreeList = 0;
+                    pPage->pNextFree = nullptr;
+                    pPage->bDirty = 1;
+                    for(auto it = pPage->data.begin(); it != pPage->data.end(); ++it)
+                    {
+                        Node* pNode = *it;
+                        pNode->pageIndex = pageIndex;
+                    }
+                    pPageList[pageIndex] = pPage;
+                }
+            });
+
+            numPages = newNumPages;
+            for(uint32_t i = firstPageIndex; i < newNumPages; ++i)
+            {
+                if(!pPageList[i]->data.IsFull())
+                {
+                    PushPageToFreeList(pPageList[i]);
+                }
+            }
+            count.Add_Lockless(donor.count.Read());
+
+            //The pages belong to this pool now, only drop the donor's list
+            Util::Free(donor.pPageList);
+            donor.pPageList = nullptr;
+            donor.numPages = 0;
+            donor.Clear();
         }
 
 
         uint32_t Size() const
         {
-            return count;
+            return count.ReadU32();
         }
 
     };
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <stdint.h>
+#include <thread>
+#include "atomic_util.h"
+#include "spin_lock.h"
+
+namespace PklE
+{
+namespace ThreadsafeContainers
+{
+    // Index of the calling thread's reader counters in every PublishedHashMap, handed out on first use
+    inline uint32_t GetPublishedHashMapReaderIndex()
+    {
+        static uint32_t s_nextReaderIndex = 0;
+        thread_local const uint32_t t_readerIndex = Util::AtomicIncrementU32(s_nextReaderIndex) - 1;
+        return t_readerIndex;
+    }
+
+    // Holder of a read-mostly map that is replaced as a whole, e.g. reference data refreshed from a nightly load.
+    //
+    // - Readers take a ReadGuard, which pins the version that was current when it was taken. The map of a guard
+    //   never changes and is never freed while the guard lives, so readers use the lockless map calls.
+    // - The writer fills the next version from BeginNextVersion() privately, e.g. with Insert_Lockless,
+    //   and PublishNextVersion() swaps it in with one atomic store. Readers never wait for the writer.
+    // - Two version slots (double buffered): the current one and the one being built. Publishing waits until the
+    //   guards of the version it replaces are gone, then frees that version.
+    // - Reader counts are striped per thread over cache line sized slots, so taking a guard does not bounce
+    //   a shared line between reader threads.
+    template<typename Map_T, uint32_t NumReaderStripes_T = 64>
+    class PublishedHashMap
+    {
+        static_assert((NumReaderStripes_T & (NumReaderStripes_T - 1)) == 0, "PublishedHashMap: NumReaderStripes_T must be a power of two.");
+
+        struct alignas(64) ReaderStripe
+        {
+            uint64_t numReaders[2] = {0, 0}; //Guards per version slot
+        };
+
+        ReaderStripe readerStripes[NumReaderStripes_T];
+        alignas(64) uint64_t publishedVersion = 0; //Number of published versions, the current map is in slot publishedVersion & 1
+        Map_T* pVersions[2] = {nullptr, nullptr};
+        CoreTypes::CountingSpinlock writerLock;
+
+        uint64_t GetNumReaders(const uint32_t slot) const
+        {
+            uint64_t numReaders = 0;
+            for(uint32_t i = 0; i < NumReaderStripes_T; ++i)
+            {
+                numReaders += Util::AtomicLoadU64(readerStripes[i].numReaders[slot], Util::MemoryOrder::SEQ_CST);
+            }
+            return numReaders;
+        }
+
+    public:
+        // Pins one published version of the map. Move only, release it early with Release().
+        class ReadGuard
+        {
+            uint64_t* pReaderCount = nullptr;
+            const Map_T* pMap = nullptr;
+            uint64_t version = 0;
+
+        public:
+            ReadGuard() = default;
+
+            ReadGuard(uint64_t* pCount, const Map_T* pPinnedMap, const uint64_t pinnedVersion)
+                : pReaderCount(pCount), pMap(pPinnedMap), version(pinnedVersion)
+            {
+            }
+
+            ReadGuard(const ReadGuard&) = delete;
+            ReadGuard& operator=(const ReadGuard&) = delete;
+
+            ReadGuard(ReadGuard&& other) : pReaderCount(other.pReaderCount), pMap(other.pMap), version(other.version)
+            {
+                other.pReaderCount = nullptr;
+                other.pMap = nullptr;
+            }
+
+            ReadGuard& operator=(ReadGuard&& other)
+            {
+                if(this != &other)
+                {
+                    Release();
+                    pReaderCount = other.pReaderCount;
+                    pMap = other.pMap;
+                    version = other.version;
+                    other.pReaderCount = nullptr;
+                    other.pMap = nullptr;
+                }
+                return *this;
+            }
+
+            ~ReadGuard()
+            {
+                Release();
+            }
+
+            void Release()
+            {
+                if(pReaderCount)
+                {
+                    Util::AtomicDecrementU64(*pReaderCount);
+                    pReaderCount = nullptr;
+                    pMap = nullptr;
+                }
+            }
+
+            // Null when nothing has been published yet
+            const Map_T* Get() const
+            {
+                return pMap;
+            }
+
+            const Map_T& operator*() const
+            {
+                return *pMap;
+            }
+
+            const Map_T* operator->() const
+            {
+                return pMap;
+            }
+
+            explicit operator bool() const
+            {
+                return pMap != nullptr;
+            }
+
+            // Number of publishes before this version, 0 for an empty guard
+            uint64_t GetVersion() const
+            {
+                return version;
+            }
+        };
+
+        PublishedHashMap() = default;
+        PublishedHashMap(const PublishedHashMap&) = delete;
+        PublishedHashMap& operator=(const PublishedHashMap&) = delete;
+
+        // All guards have to be released before the holder is destroyed
+        ~PublishedHashMap()
+        {
+            delete pVersions[0];
+            delete pVersions[1];
+        }
+
+        ReadGuard Acquire()
+        {
+            uint64_t* pStripeCounts = readerStripes[GetPublishedHashMapReaderIndex() & (NumReaderStripes_T - 1)].numReaders;
+            for(;;)
+            {
+                const uint64_t version = Util::AtomicLoadU64(publishedVersion, Util::MemoryOrder::ACQUIRE);
+                if(version == 0)
+                {
+                    return ReadGuard();
+                }
+
+                //Announce the reader first, then check the version is still current. A writer that published
+                //in between may already have counted this slot's readers, so back off and retry.
+                const uint32_t slot = static_cast<uint32_t>(version & 1);
+                Util::AtomicIncrementU64(pStripeCounts[slot]);
+                if(Util::AtomicLoadU64(publishedVersion, Util::MemoryOrder::SEQ_CST) == version)
+                {
+                    return ReadGuard(&pStripeCounts[slot], pVersions[slot], version);
+                }
+                Util::AtomicDecrementU64(pStripeCounts[slot]);
+            }
+        }
+
+        // Empty map the next publish will make current. Only the writer may touch it until it is published.
+        // Calling it again before publishing returns the same map.
+        Map_T& BeginNextVersion()
+        {
+            CoreTypes::ScopedWriteSpinLock writeLock(writerLock);
+            const uint32_t nextSlot = static_cast<uint32_t>((publishedVersion + 1) & 1);
+            if(!pVersions[nextSlot])
+            {
+                pVersions[nextSlot] = new Map_T();
+            }
+            return *pVersions[nextSlot];
+        }
+
+        // Makes the map from BeginNextVersion() current, then waits for the guards of the version it replaced
+        // and frees that version. Returns the number of the new version.
+        uint64_t PublishNextVersion()
+        {
+            CoreTypes::ScopedWriteSpinLock writeLock(writerLock);
+            const uint64_t oldVersion = publishedVersion;
+            const uint32_t nextSlot = static_cast<uint32_t>((oldVersion + 1) & 1);
+            if(!pVersions[nextSlot])
+            {
+                pVersions[nextSlot] = new Map_T();
+            }
+
+            const uint64_t newVersion = Util::AtomicIncrementU64(publishedVersion);
+            if(oldVersion != 0)
+            {
+                const uint32_t oldSlot = static_cast<uint32_t>(oldVersion & 1);
+                while(GetNumReaders(oldSlot) != 0)
+                {
+                    std::this_thread::yield();
+                }
+                delete pVersions[oldSlot];
+                pVersions[oldSlot] = nullptr;
+            }
+            return newVersion;
+        }
+
+        // Number of publishes so far
+        uint64_t GetVersion() const
+        {
+            return Util::AtomicLoadU64(publishedVersion, Util::MemoryOrder::ACQUIRE);
+        }
+    };
+
+}; //end namespace ThreadsafeContainers
+}; //end namespace PklE
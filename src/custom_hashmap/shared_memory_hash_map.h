@@ -0,0 +1,499 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <type_traits>
+#include <new>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "atomic_util.h"
+#include "logging_util.h"
+#include "magic_num_util.h"
+#include "spin_lock.h"
+#include "offset_ptr.h"
+#include "string_key_arena.h"
+
+namespace PklE
+{
+namespace ThreadsafeContainers
+{
+    // Hash map that lives entirely inside one POSIX shared memory (shm_open) or memfd segment.
+    //
+    // - One process creates and populates the segment, any number of processes attach to it and
+    //   query it in place, no copies.
+    // - Every link inside the segment is an OffsetPtr, so the segment can be mapped at a different
+    //   address in each process.
+    // - Nodes come from a fixed capacity slab inside the segment (the in-segment stand-in for
+    //   PagingObjectPool's heap allocated pages), freed nodes go to an in-segment free list.
+    // - The locks are CountingSpinlocks inside the segment. They are plain atomics on shared memory,
+    //   so they synchronize across processes as well as threads.
+    // - Keys and values are stored by value and must be trivially copyable, and hold no pointers.
+    // - Attaching read only skips all locking, use the _Lockless finds once the writer is done.
+    template<typename Key_T, typename Value_T, uint32_t NumInnerMaps_T = 4>
+    class SharedMemoryHashMap
+    {
+        static_assert((NumInnerMaps_T & (NumInnerMaps_T - 1)) == 0, "SharedMemoryHashMap: NumInnerMaps_T must be a power of two.");
+        static_assert(std::is_trivially_copyable_v<Key_T>, "SharedMemoryHashMap: Key_T must be trivially copyable to be shared across processes.");
+        static_assert(std::is_trivially_copyable_v<Value_T>, "SharedMemoryHashMap: Value_T must be trivially copyable to be shared across processes.");
+
+    public:
+        using ThisHashMapType = SharedMemoryHashMap<Key_T, Value_T, NumInnerMaps_T>;
+        using KeyStorage = HashMapKeyStorage<Key_T>;
+        static_assert(std::is_same_v<typename KeyStorage::ArenaType, NoKeyArena>, "SharedMemoryHashMap: Key_T must be stored by value.");
+
+        inline static constexpr uint64_t c_segmentMagic = 0x504B4C45534D484Dull; //"PKLESMHM"
+        inline static constexpr uint32_t c_layoutVersion = 1;
+        inline static constexpr uint64_t c_numInnerMaps = NumInnerMaps_T;
+        inline static constexpr uint64_t c_innerMapIndexMask = c_numInnerMaps - 1;
+        inline static constexpr uint64_t c_segmentAlignment = 64;
+
+    private:
+        // Bucket selection skips the bits used to pick the inner map
+        inline static constexpr uint32_t c_innerMapIndexBits = []()
+        {
+            uint32_t numBits = 0;
+            while((1ull << numBits) < c_numInnerMaps)
+            {
+                ++numBits;
+            }
+            return numBits;
+        }();
+
+        struct Node
+        {
+            CoreTypes::OffsetPtr<Node> pNext;
+            uint64_t hash = 0;
+            Key_T key;
+            Value_T value;
+        };
+
+        using BucketType = CoreTypes::OffsetPtr<Node>;
+
+        struct alignas(c_segmentAlignment) InnerMapHeader
+        {
+            CoreTypes::CountingSpinlock lock;
+            uint32_t numBuckets = 0;
+            uint64_t count = 0;
+            CoreTypes::OffsetPtr<BucketType> pBuckets;
+        };
+
+        struct alignas(c_segmentAlignment) SegmentHeader
+        {
+            uint64_t magic = 0;
+            uint32_t layoutVersion = 0;
+            uint32_t bReady = 0; //Set last by the creator, attach refuses segments that are not ready
+            uint64_t segmentSize = 0;
+            uint32_t keySize = 0;
+            uint32_t valueSize = 0;
+            uint32_t numInnerMaps = 0;
+            uint32_t nodeCapacity = 0;
+
+            CoreTypes::CountingSpinlock nodeLock;
+            uint32_t numSlabNodesUsed = 0;
+            CoreTypes::OffsetPtr<Node> pNodeSlab;
+            CoreTypes::OffsetPtr<Node> pFreeList;
+            uint64_t totalCount = 0;
+
+            InnerMapHeader innerMaps[NumInnerMaps_T];
+        };
+
+        SegmentHeader* pHeader = nullptr;
+        uint64_t mappedSize = 0;
+        int segmentFd = -1;
+        bool bReadOnly = false;
+        bool bOwner = false;
+        std::string segmentName;
+
+        static uint64_t AlignUp(const uint64_t value, const uint64_t alignment)
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        inline uint32_t GetInnerMapIndex(const uint64_t hash) const
+        {
+            return static_cast<uint32_t>(hash & c_innerMapIndexMask);
+        }
+
+        inline BucketType& GetBucket(InnerMapHeader& innerMap, const uint64_t hash) const
+        {
+            const uint32_t bucketIndex = static_cast<uint32_t>((hash >> c_innerMapIndexBits) & (static_cast<uint64_t>(innerMap.numBuckets) - 1));
+            return innerMap.pBuckets.Get()[bucketIndex];
+        }
+
+        Node* ReserveNode()
+        {
+            CoreTypes::ScopedWriteSpinLock writeLock(pHeader->nodeLock);
+            Node* pNode = pHeader->pFreeList.Get();
+            if(pNode)
+            {
+                pHeader->pFreeList = pNode->pNext.Get();
+                return pNode;
+            }
+
+            if(pHeader->numSlabNodesUsed < pHeader->nodeCapacity)
+            {
+                return pHeader->pNodeSlab.Get() + pHeader->numSlabNodesUsed++;
+            }
+            return nullptr;
+        }
+
+        void ReleaseNode(Node* pNode)
+        {
+            CoreTypes::ScopedWriteSpinLock writeLock(pHeader->nodeLock);
+            pNode->pNext = pHeader->pFreeList.Get();
+            pHeader->pFreeList = pNode;
+        }
+
+        Node* FindNode(InnerMapHeader& innerMap, const uint64_t hash, const Key_T& key) const
+        {
+            Node* pNode = GetBucket(innerMap, hash).Get();
+            while(pNode)
+            {
+                if((pNode->hash == hash) && (KeyStorage::Compare(pNode->key, key) == 0))
+                {
+                    return pNode;
+                }
+                pNode = pNode->pNext.Get();
+            }
+            return nullptr;
+        }
+
+        bool MapSegment(const int fd, const uint64_t size, const bool bInReadOnly)
+        {
+            const int protection = bInReadOnly ? PROT_READ : (PROT_READ | PROT_WRITE);
+            void* pMapped = mmap(nullptr, size, protection, MAP_SHARED, fd, 0);
+            if(pMapped == MAP_FAILED)
+            {
+                return false;
+            }
+            pHeader = static_cast<SegmentHeader*>(pMapped);
+            mappedSize = size;
+            segmentFd = fd;
+            bReadOnly = bInReadOnly;
+            return true;
+        }
+
+        bool ValidateHeader() const
+        {
+            return (pHeader->magic == c_segmentMagic) &&
+                   (pHeader->layoutVersion == c_layoutVersion) &&
+                   (Util::AtomicLoadU32(pHeader->bReady, Util::MemoryOrder::ACQUIRE) != 0) &&
+                   (pHeader->segmentSize == mappedSize) &&
+                   (pHeader->keySize == sizeof(Key_T)) &&
+                   (pHeader->valueSize == sizeof(Value_T)) &&
+                   (pHeader->numInnerMaps == NumInnerMaps_T);
+        }
+
+    public:
+        SharedMemoryHashMap() = default;
+        SharedMemoryHashMap(const SharedMemoryHashMap&) = delete;
+        SharedMemoryHashMap& operator=(const SharedMemoryHashMap&) = delete;
+
+        ~SharedMemoryHashMap()
+        {
+            Detach();
+        }
+
+        // Size in bytes of a segment holding up to capacity entries
+        static uint64_t GetSegmentSizeForCapacity(const uint32_t capacity, uint64_t& outBucketsOffset, uint64_t& outNodesOffset, uint32_t& outNumBucketsPerMap)
+        {
+            //Same 87.5% fill target as HashMap
+            const uint64_t entriesPerMap = ((static_cast<uint64_t>(capacity) * 8) / 7 + c_numInnerMaps - 1) / c_numInnerMaps;
+            outNumBucketsPerMap = Util::GetNextPowerOfTwo(static_cast<uint32_t>(entriesPerMap > 0 ? entriesPerMap : 1));
+
+            outBucketsOffset = AlignUp(sizeof(SegmentHeader), c_segmentAlignment);
+            const uint64_t bucketBytes = c_numInnerMaps * outNumBucketsPerMap * sizeof(BucketType);
+            outNodesOffset = AlignUp(outBucketsOffset + bucketBytes, c_segmentAlignment);
+            const uint64_t pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+            return AlignUp(outNodesOffset + (static_cast<uint64_t>(capacity) * sizeof(Node)), pageSize);
+        }
+
+        // Create and map a new segment with room for capacity entries.
+        // With a name the segment is a POSIX shm object (/dev/shm) that unrelated processes can attach to by name,
+        // and is unlinked when the creator detaches. Without a name it is an anonymous memfd, share it through GetFd() (fork, SCM_RIGHTS).
+        bool Create(const uint32_t capacity, const char* pName = nullptr)
+        {
+            Detach();
+
+            int fd = -1;
+            if(pName)
+            {
+                fd = shm_open(pName, O_CREAT | O_EXCL | O_RDWR, 0600);
+            }
+            else
+            {
+                fd = memfd_create("pkle_shared_hash_map", MFD_CLOEXEC);
+            }
+            if(fd < 0)
+            {
+                PKLE_ASSERT_SYSTEM_WARNING_MSG(false, "SharedMemoryHashMap::Create: Failed to create the shared memory segment.");
+                return false;
+            }
+
+            uint64_t bucketsOffset = 0;
+            uint64_t nodesOffset = 0;
+            uint32_t numBucketsPerMap = 0;
+            const uint64_t segmentSize = GetSegmentSizeForCapacity(capacity, bucketsOffset, nodesOffset, numBucketsPerMap);
+
+            //A freshly sized segment reads as zeroes, which is an empty bucket (null OffsetPtr) everywhere
+            if((ftruncate(fd, static_cast<off_t>(segmentSize)) != 0) || !MapSegment(fd, segmentSize, false))
+            {
+                PKLE_ASSERT_SYSTEM_WARNING_MSG(false, "SharedMemoryHashMap::Create: Failed to size or map the shared memory segment.");
+                close(fd);
+                if(pName)
+                {
+                    shm_unlink(pName);
+                }
+                return false;
+            }
+
+            bOwner = true;
+            segmentName = pName ? pName : "";
+
+            char* pBase = reinterpret_cast<char*>(pHeader);
+            new (pHeader) SegmentHeader();
+            pHeader->magic = c_segmentMagic;
+            pHeader->layoutVersion = c_layoutVersion;
+            pHeader->segmentSize = segmentSize;
+            pHeader->keySize = sizeof(Key_T);
+            pHeader->valueSize = sizeof(Value_T);
+            pHeader->numInnerMaps = NumInnerMaps_T;
+            pHeader->nodeCapacity = capacity;
+            pHeader->pNodeSlab = reinterpret_cast<Node*>(pBase + nodesOffset);
+
+            BucketType* pBuckets = reinterpret_cast<BucketType*>(pBase + bucketsOffset);
+            for(uint32_t i = 0; i < NumInnerMaps_T; ++i)
+            {
+                pHeader->innerMaps[i].numBuckets = numBucketsPerMap;
+                pHeader->innerMaps[i].pBuckets = pBuckets + (static_cast<uint64_t>(i) * numBucketsPerMap);
+            }
+
+            Util::AtomicStoreU32(pHeader->bReady, 1, Util::MemoryOrder::RELEASE);
+            return true;
+        }
+
+        // Map an existing segment. The map keeps its own duplicate of fd, the caller keeps ownership of fd.
+        bool Attach(const int fd, const bool bInReadOnly)
+        {
+            Detach();
+
+            struct stat segmentStat;
+            if((fd < 0) || (fstat(fd, &segmentStat) != 0) || (static_cast<uint64_t>(segmentStat.st_size) < sizeof(SegmentHeader)))
+            {
+                return false;
+            }
+
+            const int ownFd = dup(fd);
+            if((ownFd < 0) || !MapSegment(ownFd, static_cast<uint64_t>(segmentStat.st_size), bInReadOnly))
+            {
+                if(ownFd >= 0)
+                {
+                    close(ownFd);
+                }
+                return false;
+            }
+
+            if(!ValidateHeader())
+            {
+                PKLE_ASSERT_SYSTEM_WARNING_MSG(false, "SharedMemoryHashMap::Attach: Segment layout does not match this map type or is not ready.");
+                Detach();
+                return false;
+            }
+            return true;
+        }
+
+        // Map an existing named (shm_open) segment
+        bool Attach(const char* pName, const bool bInReadOnly)
+        {
+            const int fd = shm_open(pName, bInReadOnly ? O_RDONLY : O_RDWR, 0);
+            if(fd < 0)
+            {
+                return false;
+            }
+            const bool bAttached = Attach(fd, bInReadOnly);
+            close(fd);
+            return bAttached;
+        }
+
+        // Unmap the segment. The creator of a named segment also unlinks it, attached processes keep their mapping.
+        void Detach()
+        {
+            if(pHeader)
+            {
+                munmap(pHeader, mappedSize);
+                pHeader = nullptr;
+                mappedSize = 0;
+            }
+            if(segmentFd >= 0)
+            {
+                close(segmentFd);
+                segmentFd = -1;
+            }
+            if(bOwner && !segmentName.empty())
+            {
+                shm_unlink(segmentName.c_str());
+            }
+            bOwner = false;
+            bReadOnly = false;
+            segmentName.clear();
+        }
+
+        bool IsAttached() const
+        {
+            return pHeader != nullptr;
+        }
+
+        int GetFd() const
+        {
+            return segmentFd;
+        }
+
+        uint64_t GetSegmentSize() const
+        {
+            return mappedSize;
+        }
+
+        uint32_t GetCapacity() const
+        {
+            return pHeader ? pHeader->nodeCapacity : 0;
+        }
+
+        uint64_t Size() const
+        {
+            return pHeader ? Util::AtomicLoadU64(pHeader->totalCount, Util::MemoryOrder::RELAXED) : 0;
+        }
+
+        // Insert or overwrite. Returns the value inside the segment, or nullptr when the segment is full.
+        // WARNING: Only use when external synchronization guarantees exclusive access
+        Value_T* Insert_Lockless(const Key_T& key, const Value_T& value)
+        {
+            PKLE_ASSERT_SYSTEM_ERROR_MSG(pHeader && !bReadOnly, "SharedMemoryHashMap::Insert_Lockless: Segment is not attached for writing.");
+            const uint64_t hash = KeyStorage::Hash(key);
+            InnerMapHeader& innerMap = pHeader->innerMaps[GetInnerMapIndex(hash)];
+
+            Node* pNode = FindNode(innerMap, hash, key);
+            if(pNode)
+            {
+                pNode->value = value;
+                return &pNode->value;
+            }
+
+            pNode = ReserveNode();
+            if(!pNode)
+            {
+                return nullptr;
+            }
+            pNode->hash = hash;
+            pNode->key = key;
+            pNode->value = value;
+
+            BucketType& bucket = GetBucket(innerMap, hash);
+            pNode->pNext = bucket.Get();
+            bucket = pNode;
+
+            ++innerMap.count;
+            Util::AtomicIncrementU64(pHeader->totalCount);
+            return &pNode->value;
+        }
+
+        // WARNING: Only use when no other process or thread is writing
+        const Value_T* Find_Lockless(const Key_T& key) const
+        {
+            if(!pHeader)
+            {
+                return nullptr;
+            }
+            const uint64_t hash = KeyStorage::Hash(key);
+            Node* pNode = FindNode(pHeader->innerMaps[GetInnerMapIndex(hash)], hash, key);
+            return pNode ? &pNode->value : nullptr;
+        }
+
+        // WARNING: Only use when external synchronization guarantees exclusive access
+        bool Remove_Lockless(const Key_T& key)
+        {
+            PKLE_ASSERT_SYSTEM_ERROR_MSG(pHeader && !bReadOnly, "SharedMemoryHashMap::Remove_Lockless: Segment is not attached for writing.");
+            const uint64_t hash = KeyStorage::Hash(key);
+            InnerMapHeader& innerMap = pHeader->innerMaps[GetInnerMapIndex(hash)];
+
+            BucketType* pLink = &GetBucket(innerMap, hash);
+            Node* pNode = pLink->Get();
+            while(pNode)
+            {
+                if((pNode->hash == hash) && (KeyStorage::Compare(pNode->key, key) == 0))
+                {
+                    *pLink = pNode->pNext.Get();
+                    --innerMap.count;
+                    Util::AtomicDecrementU64(pHeader->totalCount);
+                    ReleaseNode(pNode);
+                    return true;
+                }
+                pLink = &pNode->pNext;
+                pNode = pLink->Get();
+            }
+            return false;
+        }
+
+        // Insert or overwrite under the inner map's write lock, safe across processes
+        bool Insert_Concurrent(const Key_T& key, const Value_T& value)
+        {
+            PKLE_ASSERT_SYSTEM_ERROR_MSG(pHeader && !bReadOnly, "SharedMemoryHashMap::Insert_Concurrent: Segment is not attached for writing.");
+            const uint64_t hash = KeyStorage::Hash(key);
+            CoreTypes::ScopedWriteSpinLock writeLock(pHeader->innerMaps[GetInnerMapIndex(hash)].lock);
+            return Insert_Lockless(key, value) != nullptr;
+        }
+
+        // Copies the value out under the inner map's read lock, safe across processes.
+        // Needs a writable mapping, the lock word lives in the segment.
+        bool Find_Concurrent(const Key_T& key, Value_T& outValue) const
+        {
+            PKLE_ASSERT_SYSTEM_ERROR_MSG(pHeader && !bReadOnly, "SharedMemoryHashMap::Find_Concurrent: Read only mappings must use Find_Lockless.");
+            const uint64_t hash = KeyStorage::Hash(key);
+            CoreTypes::ScopedReadSpinLock readLock(pHeader->innerMaps[GetInnerMapIndex(hash)].lock);
+            const Value_T* pValue = Find_Lockless(key);
+            if(pValue)
+            {
+                outValue = *pValue;
+                return true;
+            }
+            return false;
+        }
+
+        bool Remove_Concurrent(const Key_T& key)
+        {
+            PKLE_ASSERT_SYSTEM_ERROR_MSG(pHeader && !bReadOnly, "SharedMemoryHashMap::Remove_Concurrent: Segment is not attached for writing.");
+            const uint64_t hash = KeyStorage::Hash(key);
+            CoreTypes::ScopedWriteSpinLock writeLock(pHeader->innerMaps[GetInnerMapIndex(hash)].lock);
+            return Remove_Lockless(key);
+        }
+
+        //std like wrappers
+        bool insert(const Key_T& key, const Value_T& value)
+        {
+            return Insert_Concurrent(key, value);
+        }
+
+        bool find(const Key_T& key, Value_T& outValue) const
+        {
+            return Find_Concurrent(key, outValue);
+        }
+
+        const Value_T* find_lockless(const Key_T& key) const
+        {
+            return Find_Lockless(key);
+        }
+
+        bool erase(const Key_T& key)
+        {
+            return Remove_Concurrent(key);
+        }
+
+        uint64_t size() const
+        {
+            return Size();
+        }
+    };
+
+}; //end namespace ThreadsafeContainers
+}; //end namespace PklE
@@ -413,6 +413,20 @@ namespace ThreadsafeContainers
             pHead = nullptr;
         }
 
+        // Make this list a copy of the links of source, for when source's nodes were copied elsewhere:
+        // translate(const Node_T*) returns the copy of a source node (nullptr for nullptr), and the copies
+        // still hold source's next pointers, which are translated in place.
+        // WARNING: Only use when external synchronization guarantees exclusive access
+        template<typename Translate_T>
+        void CopyLinks_Unsafe(const SimpleLinkedList& source, Translate_T&& translate)
+        {
+            pHead = translate(source.pHead);
+            for(Node_T* pNode = pHead; pNode != nullptr; pNode = pNode->pNext)
+            {
+                pNode->pNext = translate(pNode->pNext);
+            }
+        }
+
         // Get the head pointer (for iteration or debugging)
         // WARNING: Use with caution in concurrent scenarios
         Node_T* GetHead_Unsafe() const
@@ -0,0 +1,320 @@
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <string_view>
+#include "memory_util.h"
+#include "allocation_counter.h"
+#include "hash_type.h"
+#include "spin_lock.h"
+
+namespace PklE
+{
+namespace ThreadsafeContainers
+{
+    // String key for HashMap that keeps its bytes in a StringKeyArena instead of a heap allocation per key.
+    //
+    // - The first 8 bytes are packed into prefix (big endian, zero padded), so most mismatches are
+    //   decided without touching the key bytes at all.
+    // - A key built from a std::string / std::string_view only views the caller's bytes. HashMap copies
+    //   the bytes into the inner map's arena when the key is stored.
+    // - Build the key once and pass it to Find / Remove, so the prefix is not recomputed per comparison.
+    struct ArenaStringKey
+    {
+        inline static constexpr uint32_t c_prefixSize = sizeof(uint64_t);
+
+        uint64_t prefix = 0;
+        const char* pData = nullptr;
+        uint32_t length = 0;
+
+        ArenaStringKey() = default;
+
+        ArenaStringKey(const char* pInData, const uint32_t inLength) : prefix(LoadPrefix(pInData, inLength)), pData(pInData), length(inLength)
+        {
+        }
+
+        ArenaStringKey(const char* pInData, const uint32_t inLength, const uint64_t inPrefix) : prefix(inPrefix), pData(pInData), length(inLength)
+        {
+        }
+
+        ArenaStringKey(std::string_view view) : ArenaStringKey(view.data(), static_cast<uint32_t>(view.size()))
+        {
+        }
+
+        ArenaStringKey(const std::string& str) : ArenaStringKey(str.data(), static_cast<uint32_t>(str.size()))
+        {
+        }
+
+        std::string_view View() const
+        {
+            return std::string_view(pData, length);
+        }
+
+        static uint64_t LoadPrefix(const char* pInData, const uint32_t inLength)
+        {
+            uint64_t packed = 0;
+            const uint32_t numPrefixBytes = (inLength < c_prefixSize) ? inLength : c_prefixSize;
+            for(uint32_t i = 0; i < numPrefixBytes; ++i)
+            {
+                packed |= static_cast<uint64_t>(static_cast<uint8_t>(pInData[i])) << (56 - (i * 8));
+            }
+            return packed;
+        }
+
+        // Lexicographic compare. Only reads the key bytes when both prefixes match and both keys are longer than the prefix.
+        static int Compare(const ArenaStringKey& a, const ArenaStringKey& b)
+        {
+            if(a.prefix != b.prefix)
+            {
+                return (a.prefix < b.prefix) ? -1 : 1;
+            }
+
+            if((a.length > c_prefixSize) && (b.length > c_prefixSize))
+            {
+                const uint32_t minLength = (a.length < b.length) ? a.length : b.length;
+                const int tailResult = memcmp(a.pData + c_prefixSize, b.pData + c_prefixSize, minLength - c_prefixSize);
+                if(tailResult != 0)
+                {
+                    return (tailResult < 0) ? -1 : 1;
+                }
+            }
+
+            if(a.length != b.length)
+            {
+                return (a.length < b.length) ? -1 : 1;
+            }
+            return 0;
+        }
+
+        // 64 bit hash over the key bytes, independent of where the bytes are stored
+        static uint64_t Hash(const ArenaStringKey& key)
+        {
+            constexpr uint64_t c_multiplier = 0x9E3779B97F4A7C15ull;
+            uint64_t hash = c_multiplier ^ key.length;
+
+            uint32_t offset = 0;
+            for(; (offset + sizeof(uint64_t)) <= key.length; offset += sizeof(uint64_t))
+            {
+                uint64_t word = 0;
+                Util::MemCpy(&word, key.pData + offset, sizeof(word));
+                hash = (hash ^ word) * c_multiplier;
+                hash ^= hash >> 29;
+            }
+
+            uint64_t tail = 0;
+            for(uint32_t i = 0; offset < key.length; ++offset, ++i)
+            {
+                tail |= static_cast<uint64_t>(static_cast<uint8_t>(key.pData[offset])) << (i * 8);
+            }
+            hash = (hash ^ tail) * c_multiplier;
+
+            //Final avalanche (murmur3 fmix64)
+            hash ^= hash >> 33;
+            hash *= 0xFF51AFD7ED558CCDull;
+            hash ^= hash >> 33;
+            hash *= 0xC4CEB9FE1A85EC53ull;
+            hash ^= hash >> 33;
+            return hash;
+        }
+
+        friend bool operator==(const ArenaStringKey& a, const ArenaStringKey& b) { return Compare(a, b) == 0; }
+        friend bool operator!=(const ArenaStringKey& a, const ArenaStringKey& b) { return Compare(a, b) != 0; }
+        friend bool operator<(const ArenaStringKey& a, const ArenaStringKey& b) { return Compare(a, b) < 0; }
+        friend bool operator>(const ArenaStringKey& a, const ArenaStringKey& b) { return Compare(a, b) > 0; }
+    };
+
+    // Append-only storage for key bytes. Bytes are only given back by Clear() or destruction,
+    // erased keys keep their bytes until then.
+    class StringKeyArena
+    {
+    public:
+        inline static constexpr uint32_t c_chunkSize = 64 * 1024;
+
+    private:
+        struct Chunk
+        {
+            Chunk* pPrev = nullptr;
+            uint32_t used = 0;
+            uint32_t capacity = 0;
+
+            char* GetData()
+            {
+                return reinterpret_cast<char*>(this + 1);
+            }
+        };
+
+        Chunk* pCurrentChunk = nullptr;
+        uint64_t numBytesStored = 0;
+        mutable CoreTypes::CountingSpinlock lock;
+
+        Chunk* AllocateChunk(const uint32_t capacity)
+        {
+            Chunk* pChunk = static_cast<Chunk*>(Util::Malloc(sizeof(Chunk) + capacity));
+            Util::CountContainerAllocation(sizeof(Chunk) + capacity);
+            PKLE_ASSERT_SYSTEM_ERROR_MSG(pChunk != nullptr, "StringKeyArena::AllocateChunk: Failed to allocate key chunk.");
+            pChunk->pPrev = nullptr;
+            pChunk->used = 0;
+            pChunk->capacity = capacity;
+            return pChunk;
+        }
+
+    public:
+        StringKeyArena() = default;
+        StringKeyArena(const StringKeyArena&) = delete;
+        StringKeyArena& operator=(const StringKeyArena&) = delete;
+
+        ~StringKeyArena()
+        {
+            Clear();
+        }
+
+        // Copy the bytes into the arena and return the stable copy
+        // Safe to call concurrently, appends are serialized with the arena lock
+        const char* Append(const char* pBytes, const uint32_t numBytes)
+        {
+            CoreTypes::ScopedWriteSpinLock writeLock(lock);
+
+            char* pStored = nullptr;
+            if(numBytes > (c_chunkSize / 4))
+            {
+                //Large keys get their own chunk behind the current one, so the current chunk keeps filling up
+                Chunk* pLargeChunk = AllocateChunk(numBytes);
+                if(pCurrentChunk)
+                {
+                    pLargeChunk->pPrev = pCurrentChunk->pPrev;
+                    pCurrentChunk->pPrev = pLargeChunk;
+                }
+                else
+                {
+                    pCurrentChunk = pLargeChunk;
+                }
+                pLargeChunk->used = numBytes;
+                pStored = pLargeChunk->GetData();
+            }
+            else
+            {
+                if(!pCurrentChunk || ((pCurrentChunk->capacity - pCurrentChunk->used) < numBytes))
+                {
+                    Chunk* pNewChunk = AllocateChunk(c_chunkSize);
+                    pNewChunk->pPrev = pCurrentChunk;
+                    pCurrentChunk = pNewChunk;
+                }
+                pStored = pCurrentChunk->GetData() + pCurrentChunk->used;
+                pCurrentChunk->used += numBytes;
+            }
+
+            Util::MemCpy(pStored, pBytes, numBytes);
+            numBytesStored += numBytes;
+            return pStored;
+        }
+
+        uint64_t GetNumBytesStored() const
+        {
+            CoreTypes::ScopedReadSpinLock readLock(lock);
+            return numBytesStored;
+        }
+
+        // Free every chunk. Keys pointing into the arena are invalid afterwards.
+        void Clear()
+        {
+            Chunk* pChunk = pCurrentChunk;
+            while(pChunk)
+            {
+                Chunk* pPrevChunk = pChunk->pPrev;
+                Util::Free(pChunk);
+                pChunk = pPrevChunk;
+            }
+            pCurrentChunk = nullptr;
+            numBytesStored = 0;
+        }
+    };
+
+    // Placeholder arena for keys that are stored by value
+    struct NoKeyArena
+    {
+        void Clear()
+        {
+        }
+    };
+
+    // How HashMap hashes, compares and stores a key type. The default stores keys by value.
+    template<typename Key_T>
+    struct HashMapKeyStorage
+    {
+        using ArenaType = NoKeyArena;
+
+        template<typename Comparable_T>
+        static uint64_t Hash(const Comparable_T& key)
+        {
+            return Util::HashType::Hash64(key);
+        }
+
+        template<typename Comparable_T>
+        static int Compare(const Key_T& a, const Comparable_T& b)
+        {
+            if(a < b)
+            {
+                return -1;
+            }
+            else if(a > b)
+            {
+                return 1;
+            }
+            return 0;
+        }
+
+        static const Key_T& Persist(ArenaType& /*arena*/, const Key_T& key)
+        {
+            return key;
+        }
+    };
+
+    // std::string keys are stored by value, hashed with the same byte hash as ArenaStringKey
+    template<>
+    struct HashMapKeyStorage<std::string>
+    {
+        using ArenaType = NoKeyArena;
+
+        static uint64_t Hash(const std::string& key)
+        {
+            return ArenaStringKey::Hash(ArenaStringKey(key));
+        }
+
+        static int Compare(const std::string& a, const std::string& b)
+        {
+            const int result = a.compare(b);
+            return (result < 0) ? -1 : ((result > 0) ? 1 : 0);
+        }
+
+        static const std::string& Persist(ArenaType& /*arena*/, const std::string& key)
+        {
+            return key;
+        }
+    };
+
+    // ArenaStringKey bytes live in a per inner map StringKeyArena
+    template<>
+    struct HashMapKeyStorage<ArenaStringKey>
+    {
+        using ArenaType = StringKeyArena;
+
+        static uint64_t Hash(const ArenaStringKey& key)
+        {
+            return ArenaStringKey::Hash(key);
+        }
+
+        static int Compare(const ArenaStringKey& a, const ArenaStringKey& b)
+        {
+            return ArenaStringKey::Compare(a, b);
+        }
+
+        static ArenaStringKey Persist(ArenaType& arena, const ArenaStringKey& key)
+        {
+            const char* pStored = arena.Append(key.pData, key.length);
+            return ArenaStringKey(pStored, key.length, key.prefix);
+        }
+    };
+
+} // end namespace ThreadsafeContainers
+} // end namespace PklE
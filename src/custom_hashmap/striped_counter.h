@@ -0,0 +1,110 @@
+#pragma once
+
+#include <stdint.h>
+#include "atomic_util.h"
+
+//Set to 1 to make the containers keep exact single atomic counts instead of striped ones
+#ifndef PKLE_EXACT_CONTAINER_COUNTS
+#define PKLE_EXACT_CONTAINER_COUNTS 0
+#endif
+
+namespace PklE
+{
+namespace Util
+{
+    // Index of the calling thread's cell in every StripedCounter, handed out on first use
+    inline uint32_t GetCounterStripeIndex()
+    {
+        static uint32_t s_nextStripeIndex = 0;
+        thread_local const uint32_t t_stripeIndex = AtomicIncrementU32(s_nextStripeIndex) - 1;
+        return t_stripeIndex;
+    }
+
+    // Counter for sizes that every writer updates but that are read rarely.
+    //
+    // - Each thread adds to its own cache line sized cell, so concurrent writers do not bounce one line between cores.
+    //   Threads beyond NumStripes_T share cells, which stays correct, the adds are atomic.
+    // - Read() sums the cells. While writers are running the sum is not a snapshot of one instant,
+    //   but every update that finished before the read began is included.
+    // - NumStripes_T = 1 is the exact mode: one atomic counter, reads are linearizable.
+    template<uint32_t NumStripes_T>
+    class StripedCounter
+    {
+        static_assert((NumStripes_T & (NumStripes_T - 1)) == 0, "StripedCounter: NumStripes_T must be a power of two.");
+
+        struct alignas(64) Cell
+        {
+            int64_t value = 0; //Signed, a thread may remove what another one added
+        };
+
+        Cell cells[NumStripes_T];
+
+        int64_t& GetCell()
+        {
+            if constexpr (NumStripes_T == 1)
+            {
+                return cells[0].value;
+            }
+            else
+            {
+                return cells[GetCounterStripeIndex() & (NumStripes_T - 1)].value;
+            }
+        }
+
+    public:
+        inline static constexpr uint32_t c_numStripes = NumStripes_T;
+
+        void Add(const int64_t delta)
+        {
+            AtomicAddI64(GetCell(), delta);
+        }
+
+        void Increment()
+        {
+            AtomicIncrementI64(GetCell());
+        }
+
+        void Decrement()
+        {
+            AtomicDecrementI64(GetCell());
+        }
+
+        // For callers that already have exclusive access, e.g. the _Lockless paths of a container
+        void Add_Lockless(const int64_t delta)
+        {
+            cells[0].value += delta;
+        }
+
+        int64_t Read() const
+        {
+            int64_t sum = 0;
+            for(uint32_t i = 0; i < NumStripes_T; ++i)
+            {
+                sum += static_cast<int64_t>(AtomicLoadI64(cells[i].value, MemoryOrder::RELAXED));
+            }
+            return sum;
+        }
+
+        // Read() clamped to uint32_t, for container sizes. A racing remove counted before its insert can make the sum dip below zero.
+        uint32_t ReadU32() const
+        {
+            const int64_t sum = Read();
+            return (sum > 0) ? static_cast<uint32_t>(sum) : 0;
+        }
+
+        // Not safe against concurrent updates
+        void Reset()
+        {
+            for(uint32_t i = 0; i < NumStripes_T; ++i)
+            {
+                cells[i].value = 0;
+            }
+        }
+    };
+
+    // Stripe count the containers use for their element counts
+    inline constexpr uint32_t c_containerCountStripes = (PKLE_EXACT_CONTAINER_COUNTS != 0) ? 1 : 16;
+    using ContainerCounter = StripedCounter<c_containerCountStripes>;
+
+}; //end namespace Util
+}; //end namespace PklE
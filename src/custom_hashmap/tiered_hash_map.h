@@ -0,0 +1,698 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <type_traits>
+#include <new>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "atomic_util.h"
+#include "logging_util.h"
+#include "memory_util.h"
+#include "hash_type.h"
+#include "spin_lock.h"
+#include "hash_map.h"
+
+namespace PklE
+{
+namespace ThreadsafeContainers
+{
+    // What a TieredHashMap node holds in place of the value
+    template<typename Value_T>
+    struct TieredValueStub
+    {
+        Value_T* pValue = nullptr; //Value in RAM while hot, null while the value is in the file
+        uint64_t recordIndex = 0; //File record while cold
+        uint32_t lastAccessEpoch = 0;
+    };
+
+    // Hash map that keeps recently used values in RAM and spills cold values to an append-only memory mapped file.
+    //
+    // - Nodes hold a TieredValueStub instead of the value: a pointer to the heap allocated value while hot,
+    //   the index of its file record while cold.
+    // - Every access stamps the stub with the current epoch. MigrateColdValues() moves values that were not
+    //   accessed for maxIdleEpochs into the file and frees their RAM. Find() faults a cold value back into RAM.
+    // - The file is a log of fixed size records {key, live flag, value}, cut into segments. Faulting a value back,
+    //   updating or erasing it only clears the live flag of its record. Compact() moves the live records of mostly
+    //   dead segments to the tail and punches the emptied segments out of the file.
+    // - The map is striped over NumStripes_T HashMaps with their own locks. Migration scans a stripe under its
+    //   read lock and moves values in small batches under the write lock, compaction locks one key at a time.
+    //   StartBackgroundTiering() runs both on a thread.
+    // - The file is created in a temp directory and unlinked right away, it is gone when the map closes.
+    template<typename Key_T, typename Value_T, uint32_t NumStripes_T = 16, uint32_t PageSize_T = 8>
+    class TieredHashMap
+    {
+        static_assert((NumStripes_T & (NumStripes_T - 1)) == 0, "TieredHashMap: NumStripes_T must be a power of two.");
+        static_assert(std::is_trivially_copyable_v<Key_T> && std::is_trivially_copyable_v<Value_T>, "TieredHashMap: Key_T and Value_T must be trivially copyable.");
+
+    public:
+        using StubType = TieredValueStub<Value_T>;
+        using StripeMapType = HashMap<Key_T, StubType, PageSize_T, 1>;
+        inline static constexpr uint64_t c_defaultMaxFileBytes = 1ULL << 32; //Sparse, only written segments take disk space
+        inline static constexpr uint64_t c_targetSegmentBytes = 1ULL << 20;
+        inline static constexpr uint32_t c_migrationBatchSize = 64; //Values moved per stripe write lock
+
+    private:
+        inline static constexpr uint32_t c_invalidSegment = UINT32_MAX;
+        inline static constexpr uint32_t c_segmentFree = 0;
+        inline static constexpr uint32_t c_segmentActive = 1; //Records are being appended
+        inline static constexpr uint32_t c_segmentSealed = 2;
+
+        struct Record
+        {
+            Key_T key;
+            uint32_t bLive;
+            Value_T value;
+        };
+
+        struct Segment
+        {
+            uint32_t numWritten = 0;
+            uint32_t numLive = 0;
+            uint32_t state = c_segmentFree;
+            uint32_t nextFree = c_invalidSegment;
+        };
+
+        struct alignas(64) Stripe
+        {
+            CoreTypes::CountingSpinlock lock;
+            StripeMapType map;
+        };
+
+        Stripe stripes[NumStripes_T];
+        uint32_t currentEpoch = 1;
+        uint64_t numHotValues = 0;
+        uint64_t numColdValues = 0;
+
+        //File state, segments are only managed by the thread holding maintenanceLock
+        CoreTypes::CountingSpinlock maintenanceLock;
+        int fileFd = -1;
+        uint8_t* pFile = nullptr;
+        uint64_t fileBytes = 0;
+        uint64_t segmentBytes = 0;
+        uint32_t recordsPerSegment = 0;
+        Segment* pSegments = nullptr;
+        uint32_t maxSegments = 0;
+        uint32_t numTouchedSegments = 0; //High water mark
+        uint32_t numFreeSegments = 0;
+        uint32_t freeSegmentHead = c_invalidSegment;
+        uint32_t activeSegment = c_invalidSegment;
+        Key_T* pMigrationKeys = nullptr; //Scratch for MigrateColdValues()
+        uint32_t migrationKeysCapacity = 0;
+
+        std::thread maintenanceThread;
+        uint32_t bStopMaintenance = 0;
+
+        static uint32_t GetStripeIndex(const uint64_t hash)
+        {
+            //The stripe maps bucket by the low bits, so stripe by the high ones
+            return static_cast<uint32_t>(hash >> 48) & (NumStripes_T - 1);
+        }
+
+        Stripe& GetStripe(const Key_T& key)
+        {
+            return stripes[GetStripeIndex(Util::HashType::Hash64(key))];
+        }
+
+        Record* GetRecord(const uint64_t recordIndex) const
+        {
+            const uint64_t segmentIndex = recordIndex / recordsPerSegment;
+            const uint64_t slot = recordIndex % recordsPerSegment;
+            return reinterpret_cast<Record*>(pFile + (segmentIndex * segmentBytes) + (slot * sizeof(Record)));
+        }
+
+        void Touch(StubType& stub) const
+        {
+            const uint32_t epoch = Util::AtomicLoadU32(currentEpoch, Util::MemoryOrder::RELAXED);
+            if(Util::AtomicLoadU32(stub.lastAccessEpoch, Util::MemoryOrder::RELAXED) != epoch)
+            {
+                Util::AtomicStoreU32(stub.lastAccessEpoch, epoch, Util::MemoryOrder::RELAXED);
+            }
+        }
+
+        static Value_T* AllocateValue(const Value_T& value)
+        {
+            Value_T* pValue = static_cast<Value_T*>(Util::Malloc(sizeof(Value_T)));
+            PKLE_ASSERT_SYSTEM_ERROR_MSG(pValue != nullptr, "TieredHashMap::AllocateValue: Out of memory.");
+            Util::MemCpy(pValue, &value, sizeof(Value_T));
+            return pValue;
+        }
+
+        // Clear the live flag of a record, called under the lock of the stripe that owns the record's key
+        void KillRecord(const uint64_t recordIndex)
+        {
+            Util::AtomicStoreU32(GetRecord(recordIndex)->bLive, 0, Util::MemoryOrder::RELAXED);
+            Util::AtomicDecrementU32(pSegments[recordIndex / recordsPerSegment].numLive);
+        }
+
+        // Bring a cold value back into RAM, under the stripe's write lock
+        void FaultIn(StubType& stub)
+        {
+            const Record* pRecord = GetRecord(stub.recordIndex);
+            stub.pValue = AllocateValue(pRecord->value);
+            KillRecord(stub.recordIndex);
+            Util::AtomicDecrementU64(numColdValues);
+            Util::AtomicIncrementU64(numHotValues);
+        }
+
+        uint32_t AcquireSegment()
+        {
+            uint32_t segmentIndex = c_invalidSegment;
+            if(freeSegmentHead != c_invalidSegment)
+            {
+                segmentIndex = freeSegmentHead;
+                freeSegmentHead = pSegments[segmentIndex].nextFree;
+                --numFreeSegments;
+            }
+            else if(numTouchedSegments < maxSegments)
+            {
+                segmentIndex = numTouchedSegments++;
+            }
+            if(segmentIndex != c_invalidSegment)
+            {
+                Segment& segment = pSegments[segmentIndex];
+                segment.numWritten = 0;
+                Util::AtomicStoreU32(segment.numLive, 0, Util::MemoryOrder::RELAXED);
+                segment.state = c_segmentActive;
+                segment.nextFree = c_invalidSegment;
+            }
+            return segmentIndex;
+        }
+
+        // Punch an empty segment out of the file and out of this process' RSS, then reuse it
+        void ReleaseSegment(const uint32_t segmentIndex)
+        {
+            const uint64_t offset = static_cast<uint64_t>(segmentIndex) * segmentBytes;
+            madvise(pFile + offset, segmentBytes, MADV_DONTNEED);
+            //Best effort, file systems without hole punching just keep the blocks until the segment is reused
+            fallocate(fileFd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, static_cast<off_t>(offset), static_cast<off_t>(segmentBytes));
+
+            Segment& segment = pSegments[segmentIndex];
+            segment.state = c_segmentFree;
+            segment.numWritten = 0;
+            segment.nextFree = freeSegmentHead;
+            freeSegmentHead = segmentIndex;
+            ++numFreeSegments;
+        }
+
+        // Append a live record at the tail of the log, under maintenanceLock and the key's stripe lock
+        bool AppendRecord(const Key_T& key, const Value_T& value, uint64_t& outRecordIndex)
+        {
+            if((activeSegment == c_invalidSegment) || (pSegments[activeSegment].numWritten == recordsPerSegment))
+            {
+                if(activeSegment != c_invalidSegment)
+                {
+                    pSegments[activeSegment].state = c_segmentSealed;
+                }
+                activeSegment = AcquireSegment();
+                if(activeSegment == c_invalidSegment)
+                {
+                    return false;
+                }
+            }
+
+            Segment& segment = pSegments[activeSegment];
+            outRecordIndex = (static_cast<uint64_t>(activeSegment) * recordsPerSegment) + segment.numWritten;
+            Record* pRecord = GetRecord(outRecordIndex);
+            Util::MemCpy(&pRecord->key, &key, sizeof(Key_T));
+            Util::MemCpy(&pRecord->value, &value, sizeof(Value_T));
+            Util::AtomicStoreU32(pRecord->bLive, 1, Util::MemoryOrder::RELAXED);
+            ++segment.numWritten;
+            Util::AtomicIncrementU32(segment.numLive);
+            return true;
+        }
+
+        void CloseFile()
+        {
+            if(pFile)
+            {
+                munmap(pFile, fileBytes);
+                pFile = nullptr;
+            }
+            if(fileFd >= 0)
+            {
+                close(fileFd);
+                fileFd = -1;
+            }
+            if(pSegments)
+            {
+                Util::Free(pSegments);
+                pSegments = nullptr;
+            }
+            if(pMigrationKeys)
+            {
+                Util::Free(pMigrationKeys);
+                pMigrationKeys = nullptr;
+                migrationKeysCapacity = 0;
+            }
+            fileBytes = 0;
+            maxSegments = 0;
+            numTouchedSegments = 0;
+            numFreeSegments = 0;
+            freeSegmentHead = c_invalidSegment;
+            activeSegment = c_invalidSegment;
+        }
+
+    public:
+        TieredHashMap()
+        {
+            for(uint32_t i = 0; i < NumStripes_T; ++i)
+            {
+                //Stripes must have buckets before the first lookup
+                stripes[i].map.Reserve(16);
+            }
+        }
+
+        TieredHashMap(const TieredHashMap&) = delete;
+        TieredHashMap& operator=(const TieredHashMap&) = delete;
+
+        ~TieredHashMap()
+        {
+            Close();
+        }
+
+        // Create the backing file in pDirectory (default $TMPDIR or /tmp). maxFileBytes bounds the cold tier,
+        // values that do not fit stay in RAM.
+        bool Open(const char* pDirectory = nullptr, const uint64_t maxFileBytes = c_defaultMaxFileBytes)
+        {
+            CoreTypes::ScopedWriteSpinLock lock(maintenanceLock);
+            CloseFile();
+
+            if(!pDirectory)
+            {
+                pDirectory = getenv("TMPDIR");
+            }
+            std::string path = std::string((pDirectory && pDirectory[0]) ? pDirectory : "/tmp") + "/pkle_tiered_XXXXXX";
+            const int fd = mkstemp(path.data());
+            if(fd < 0)
+            {
+                PKLE_ASSERT_SYSTEM_WARNING_MSG(false, "TieredHashMap::Open: Failed to create the backing file.");
+                return false;
+            }
+            unlink(path.c_str());
+
+            const uint64_t pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+            const uint64_t recordsPerTarget = c_targetSegmentBytes / sizeof(Record);
+            recordsPerSegment = static_cast<uint32_t>((recordsPerTarget > 0) ? recordsPerTarget : 1);
+            segmentBytes = ((static_cast<uint64_t>(recordsPerSegment) * sizeof(Record)) + pageSize - 1) & ~(pageSize - 1);
+            maxSegments = static_cast<uint32_t>(maxFileBytes / segmentBytes);
+            fileBytes = static_cast<uint64_t>(maxSegments) * segmentBytes;
+
+            void* pMapped = MAP_FAILED;
+            if((maxSegments > 0) && (ftruncate(fd, static_cast<off_t>(fileBytes)) == 0))
+            {
+                pMapped = mmap(nullptr, fileBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            }
+            if(pMapped == MAP_FAILED)
+            {
+                PKLE_ASSERT_SYSTEM_WARNING_MSG(false, "TieredHashMap::Open: Failed to size or map the backing file.");
+                close(fd);
+                maxSegments = 0;
+                fileBytes = 0;
+                return false;
+            }
+
+            fileFd = fd;
+            pFile = static_cast<uint8_t*>(pMapped);
+            pSegments = static_cast<Segment*>(Util::Malloc(sizeof(Segment) * maxSegments));
+            PKLE_ASSERT_SYSTEM_ERROR_MSG(pSegments != nullptr, "TieredHashMap::Open: Failed to allocate segment table.");
+            for(uint32_t i = 0; i < maxSegments; ++i)
+            {
+                new (&pSegments[i]) Segment();
+            }
+            return true;
+        }
+
+        // Drop every entry and the backing file
+        void Close()
+        {
+            StopBackgroundTiering();
+            for(uint32_t i = 0; i < NumStripes_T; ++i)
+            {
+                Stripe& stripe = stripes[i];
+                CoreTypes::ScopedWriteSpinLock lock(stripe.lock);
+                for(auto& pair : stripe.map)
+                {
+                    Util::Free(pair.value.pValue);
+                    pair.value.pValue = nullptr;
+                }
+                stripe.map.Clear_Lockless();
+                stripe.map.Reserve(16);
+            }
+            numHotValues = 0;
+            numColdValues = 0;
+
+            CoreTypes::ScopedWriteSpinLock lock(maintenanceLock);
+            CloseFile();
+        }
+
+        bool Insert(const Key_T& key, const Value_T& value)
+        {
+            Stripe& stripe = GetStripe(key);
+            CoreTypes::ScopedWriteSpinLock lock(stripe.lock);
+            if(stripe.map.Find_Lockless(key))
+            {
+                return false;
+            }
+
+            StubType stub;
+            stub.pValue = AllocateValue(value);
+            stub.lastAccessEpoch = Util::AtomicLoadU32(currentEpoch, Util::MemoryOrder::RELAXED);
+            stripe.map.Insert_Lockless(key, stub);
+            Util::AtomicIncrementU64(numHotValues);
+            return true;
+        }
+
+        // Insert or overwrite
+        void Update(const Key_T& key, const Value_T& value)
+        {
+            Stripe& stripe = GetStripe(key);
+            CoreTypes::ScopedWriteSpinLock lock(stripe.lock);
+            typename StripeMapType::KeyValuePair* pPair = stripe.map.Find_Lockless(key);
+            if(!pPair)
+            {
+                StubType stub;
+                stub.pValue = AllocateValue(value);
+                stub.lastAccessEpoch = Util::AtomicLoadU32(currentEpoch, Util::MemoryOrder::RELAXED);
+                stripe.map.Insert_Lockless(key, stub);
+                Util::AtomicIncrementU64(numHotValues);
+                return;
+            }
+
+            StubType& stub = pPair->value;
+            if(stub.pValue)
+            {
+                Util::MemCpy(stub.pValue, &value, sizeof(Value_T));
+            }
+            else
+            {
+                KillRecord(stub.recordIndex);
+                stub.pValue = AllocateValue(value);
+                Util::AtomicDecrementU64(numColdValues);
+                Util::AtomicIncrementU64(numHotValues);
+            }
+            Touch(stub);
+        }
+
+        // Copy the value out, faulting it back into RAM if it is cold
+        bool Find(const Key_T& key, Value_T& outValue)
+        {
+            Stripe& stripe = GetStripe(key);
+            {
+                CoreTypes::ScopedReadSpinLock readLock(stripe.lock);
+                typename StripeMapType::KeyValuePair* pPair = stripe.map.Find_Lockless(key);
+                if(!pPair)
+                {
+                    return false;
+                }
+                StubType& stub = pPair->value;
+                if(stub.pValue)
+                {
+                    Touch(stub);
+                    Util::MemCpy(&outValue, stub.pValue, sizeof(Value_T));
+                    return true;
+                }
+            }
+
+            //Cold, check again under the write lock, another thread may have faulted it in or erased it meanwhile
+            CoreTypes::ScopedWriteSpinLock writeLock(stripe.lock);
+            typename StripeMapType::KeyValuePair* pPair = stripe.map.Find_Lockless(key);
+            if(!pPair)
+            {
+                return false;
+            }
+            StubType& stub = pPair->value;
+            if(!stub.pValue)
+            {
+                FaultIn(stub);
+            }
+            Touch(stub);
+            Util::MemCpy(&outValue, stub.pValue, sizeof(Value_T));
+            return true;
+        }
+
+        bool Erase(const Key_T& key)
+        {
+            Stripe& stripe = GetStripe(key);
+            CoreTypes::ScopedWriteSpinLock lock(stripe.lock);
+            typename StripeMapType::KeyValuePair* pPair = stripe.map.Find_Lockless(key);
+            if(!pPair)
+            {
+                return false;
+            }
+
+            StubType& stub = pPair->value;
+            if(stub.pValue)
+            {
+                Util::Free(stub.pValue);
+                Util::AtomicDecrementU64(numHotValues);
+            }
+            else
+            {
+                KillRecord(stub.recordIndex);
+                Util::AtomicDecrementU64(numColdValues);
+            }
+            return stripe.map.Remove_Lockless(key);
+        }
+
+        // Start the next access epoch, values not touched for a number of epochs are cold
+        void AdvanceEpoch()
+        {
+            Util::AtomicIncrementU32(currentEpoch);
+        }
+
+        // Move hot values not accessed during the last maxIdleEpochs epochs to the file. Returns the number of values moved
+        uint64_t MigrateColdValues(const uint32_t maxIdleEpochs)
+        {
+            CoreTypes::ScopedWriteSpinLock maintenanceWriteLock(maintenanceLock);
+            if(!pFile)
+            {
+                return 0;
+            }
+
+            const uint32_t epoch = Util::AtomicLoadU32(currentEpoch, Util::MemoryOrder::RELAXED);
+            uint64_t numMigrated = 0;
+            bool bFileFull = false;
+            for(uint32_t i = 0; (i < NumStripes_T) && !bFileFull; ++i)
+            {
+                Stripe& stripe = stripes[i];
+
+                //Find the candidates under the read lock, lookups keep going
+                uint32_t numCandidates = 0;
+                {
+                    CoreTypes::ScopedReadSpinLock stripeReadLock(stripe.lock);
+                    const uint32_t stripeSize = static_cast<uint32_t>(stripe.map.size());
+                    if(stripeSize > migrationKeysCapacity)
+                    {
+                        Util::Free(pMigrationKeys);
+                        migrationKeysCapacity = stripeSize * 2;
+                        pMigrationKeys = static_cast<Key_T*>(Util::Malloc(sizeof(Key_T) * migrationKeysCapacity));
+                        PKLE_ASSERT_SYSTEM_ERROR_MSG(pMigrationKeys != nullptr, "TieredHashMap::MigrateColdValues: Failed to allocate candidate list.");
+                    }
+                    for(auto& pair : stripe.map)
+                    {
+                        const StubType& stub = pair.value;
+                        if(stub.pValue && ((epoch - Util::AtomicLoadU32(stub.lastAccessEpoch, Util::MemoryOrder::RELAXED)) >= maxIdleEpochs) && (numCandidates < migrationKeysCapacity))
+                        {
+                            pMigrationKeys[numCandidates++] = pair.key;
+                        }
+                    }
+                }
+
+                //Move them in small batches under the write lock, re-checking each, they may have been used or erased since
+                for(uint32_t batchStart = 0; (batchStart < numCandidates) && !bFileFull; batchStart += c_migrationBatchSize)
+                {
+                    const uint32_t batchEnd = ((batchStart + c_migrationBatchSize) < numCandidates) ? (batchStart + c_migrationBatchSize) : numCandidates;
+                    CoreTypes::ScopedWriteSpinLock stripeWriteLock(stripe.lock);
+                    for(uint32_t candidate = batchStart; candidate < batchEnd; ++candidate)
+                    {
+                        const Key_T& key = pMigrationKeys[candidate];
+                        typename StripeMapType::KeyValuePair* pPair = stripe.map.Find_Lockless(key);
+                        if(!pPair || !pPair->value.pValue || ((epoch - pPair->value.lastAccessEpoch) < maxIdleEpochs))
+                        {
+                            continue;
+                        }
+
+                        StubType& stub = pPair->value;
+                        uint64_t recordIndex = 0;
+                        if(!AppendRecord(key, *stub.pValue, recordIndex))
+                        {
+                            bFileFull = true;
+                            break;
+                        }
+                        Util::Free(stub.pValue);
+                        stub.pValue = nullptr;
+                        stub.recordIndex = recordIndex;
+                        ++numMigrated;
+                    }
+                }
+            }
+            Util::AtomicAddU64(numColdValues, numMigrated);
+            Util::AtomicSubtractU64(numHotValues, numMigrated);
+
+            //The records are in the page cache now, drop them from this process until they are read again
+            //(safe on a shared file mapping, the next access reads the page back from the file)
+            if(numMigrated > 0)
+            {
+                madvise(pFile, static_cast<uint64_t>(numTouchedSegments) * segmentBytes, MADV_DONTNEED);
+            }
+            return numMigrated;
+        }
+
+        // Reclaim file space: release empty segments and move the live records of sealed segments that are at least
+        // minDeadFraction dead to the tail. Returns the number of records moved
+        uint64_t Compact(const double minDeadFraction = 0.5)
+        {
+            CoreTypes::ScopedWriteSpinLock maintenanceWriteLock(maintenanceLock);
+            if(!pFile)
+            {
+                return 0;
+            }
+
+            uint64_t numMoved = 0;
+            const uint32_t numSegmentsToScan = numTouchedSegments;
+            for(uint32_t segmentIndex = 0; segmentIndex < numSegmentsToScan; ++segmentIndex)
+            {
+                Segment& segment = pSegments[segmentIndex];
+                if(segment.state != c_segmentSealed)
+                {
+                    continue;
+                }
+
+                const uint32_t numLive = Util::AtomicLoadU32(segment.numLive, Util::MemoryOrder::RELAXED);
+                const double deadFraction = 1.0 - (static_cast<double>(numLive) / static_cast<double>(segment.numWritten));
+                if((numLive > 0) && (deadFraction < minDeadFraction))
+                {
+                    continue;
+                }
+
+                bool bFileFull = false;
+                const uint64_t firstRecordIndex = static_cast<uint64_t>(segmentIndex) * recordsPerSegment;
+                for(uint32_t slot = 0; (slot < segment.numWritten) && (Util::AtomicLoadU32(segment.numLive, Util::MemoryOrder::RELAXED) > 0); ++slot)
+                {
+                    const uint64_t recordIndex = firstRecordIndex + slot;
+                    const Record* pRecord = GetRecord(recordIndex);
+                    if(Util::AtomicLoadU32(pRecord->bLive, Util::MemoryOrder::RELAXED) == 0)
+                    {
+                        continue;
+                    }
+
+                    //Records are immutable apart from the live flag, which only changes under the key's stripe lock
+                    Stripe& stripe = GetStripe(pRecord->key);
+                    CoreTypes::ScopedWriteSpinLock stripeLock(stripe.lock);
+                    if(Util::AtomicLoadU32(pRecord->bLive, Util::MemoryOrder::RELAXED) == 0)
+                    {
+                        continue;
+                    }
+                    typename StripeMapType::KeyValuePair* pPair = stripe.map.Find_Lockless(pRecord->key);
+                    PKLE_ASSERT_SYSTEM_ERROR_MSG(pPair && !pPair->value.pValue && (pPair->value.recordIndex == recordIndex), "TieredHashMap::Compact: Live record without a matching cold entry.");
+
+                    uint64_t newRecordIndex = 0;
+                    if(!AppendRecord(pRecord->key, pRecord->value, newRecordIndex))
+                    {
+                        bFileFull = true;
+                        break;
+                    }
+                    pPair->value.recordIndex = newRecordIndex;
+                    KillRecord(recordIndex);
+                    ++numMoved;
+                }
+
+                if(Util::AtomicLoadU32(segment.numLive, Util::MemoryOrder::RELAXED) == 0)
+                {
+                    ReleaseSegment(segmentIndex);
+                }
+                if(bFileFull)
+                {
+                    break;
+                }
+            }
+            return numMoved;
+        }
+
+        // Run AdvanceEpoch(), MigrateColdValues() and Compact() every periodMs on a background thread
+        void StartBackgroundTiering(const uint32_t periodMs, const uint32_t maxIdleEpochs, const double minDeadFraction = 0.5)
+        {
+            StopBackgroundTiering();
+            Util::AtomicStoreU32(bStopMaintenance, 0, Util::MemoryOrder::RELAXED);
+            maintenanceThread = std::thread([this, periodMs, maxIdleEpochs, minDeadFraction]()
+            {
+                auto nextRun = std::chrono::steady_clock::now() + std::chrono::milliseconds(periodMs);
+                while(Util::AtomicLoadU32(bStopMaintenance, Util::MemoryOrder::RELAXED) == 0)
+                {
+                    if(std::chrono::steady_clock::now() < nextRun)
+                    {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                        continue;
+                    }
+                    AdvanceEpoch();
+                    MigrateColdValues(maxIdleEpochs);
+                    Compact(minDeadFraction);
+                    nextRun += std::chrono::milliseconds(periodMs);
+                }
+            });
+        }
+
+        void StopBackgroundTiering()
+        {
+            if(maintenanceThread.joinable())
+            {
+                Util::AtomicStoreU32(bStopMaintenance, 1, Util::MemoryOrder::RELAXED);
+                maintenanceThread.join();
+            }
+        }
+
+        uint64_t GetNumHotValues() const
+        {
+            return Util::AtomicLoadU64(numHotValues, Util::MemoryOrder::RELAXED);
+        }
+
+        uint64_t GetNumColdValues() const
+        {
+            return Util::AtomicLoadU64(numColdValues, Util::MemoryOrder::RELAXED);
+        }
+
+        // File bytes held by segments in use (written segments that were not released)
+        uint64_t GetFileBytesInUse() const
+        {
+            return static_cast<uint64_t>(numTouchedSegments - numFreeSegments) * segmentBytes;
+        }
+
+        // File bytes of live records
+        uint64_t GetFileBytesLive() const
+        {
+            return GetNumColdValues() * sizeof(Record);
+        }
+
+        uint64_t Size() const
+        {
+            return GetNumHotValues() + GetNumColdValues();
+        }
+
+        bool insert(const Key_T& key, const Value_T& value)
+        {
+            return Insert(key, value);
+        }
+
+        bool find(const Key_T& key, Value_T& outValue)
+        {
+            return Find(key, outValue);
+        }
+
+        bool erase(const Key_T& key)
+        {
+            return Erase(key);
+        }
+
+        uint64_t size() const
+        {
+            return Size();
+        }
+    };
+
+}; //end namespace ThreadsafeContainers
+}; //end namespace PklE
@@ -0,0 +1,274 @@
+#pragma once
+
+#include <stdint.h>
+#include "memory_util.h"
+#include "magic_num_util.h"
+
+namespace PklE
+{
+namespace ThreadsafeContainers
+{
+    // Unrolled (cache-line) bucket chain.
+    //
+    // Instead of chasing one node per hop, the bucket points to a block holding
+    // several (hash tag, node pointer) slots plus an overflow link. The tags of a
+    // block are compared against the search tag all at once (SWAR on a 64-bit word),
+    // so most lookups resolve with a single block load and one key comparison.
+    //
+    // - Nodes are NOT owned or moved, so node addresses stay stable
+    // - Blocks are reserved from / released to an external pool passed in by the caller
+    // - The head block is the only block that may have free slots. Erasing from an
+    //   older block back-fills the hole from the head block to keep the chain dense.
+    // - All operations are unsafe, external synchronization must guarantee exclusive
+    //   access for writes and shared access for reads.
+    template<typename Node_T>
+    class UnrolledLinkedList
+    {
+    public:
+        using ThisLinkedListType = UnrolledLinkedList<Node_T>;
+
+        inline static constexpr uint32_t c_numSlotsPerBlock = 5;
+        inline static constexpr uint8_t c_emptyTag = 0;
+
+        // 56 bytes, so with the pool's 4 byte page index (padded to 8) every pooled block
+        // fills exactly one 64 byte cache line when the pool is 64 byte aligned.
+        struct Block
+        {
+            uint8_t tags[8] = {0};
+            Node_T* pEntries[c_numSlotsPerBlock] = {nullptr};
+            Block* pOverflow = nullptr;
+        };
+        static_assert(sizeof(Block) == 56, "UnrolledLinkedList: Block must be 56 bytes so a pooled block fills one cache line.");
+
+        inline static constexpr uint64_t c_blockAlignment = 64;
+
+    private:
+        inline static constexpr uint64_t c_tagLowBits = 0x0101010101010101ull;
+        inline static constexpr uint64_t c_tagHighBits = 0x8080808080808080ull;
+        inline static constexpr uint64_t c_usedSlotsMask = (1ull << (c_numSlotsPerBlock * 8)) - 1;
+
+        Block* pHead = nullptr;
+
+        static uint64_t LoadTagWord(const Block* pBlock)
+        {
+            uint64_t tagWord = 0;
+            Util::MemCpy(&tagWord, pBlock->tags, sizeof(tagWord));
+            return tagWord;
+        }
+
+        // Returns a mask with the high bit set in every byte lane whose tag equals the search tag.
+        // May report false positives in the lane right after a true match, callers always verify the key.
+        static uint64_t MatchTags(const uint64_t tagWord, const uint8_t tag)
+        {
+            const uint64_t xored = tagWord ^ (c_tagLowBits * tag);
+            return ((xored - c_tagLowBits) & ~xored & c_tagHighBits) & c_usedSlotsMask;
+        }
+
+        static uint32_t GetSlotIndex(const uint64_t laneMask)
+        {
+            return Util::CountTrailingZeros64(laneMask) >> 3;
+        }
+
+        static uint32_t CountOccupied(const Block* pBlock)
+        {
+            uint32_t numOccupied = 0;
+            for(uint32_t i = 0; i < c_numSlotsPerBlock; ++i)
+            {
+                numOccupied += (pBlock->tags[i] != c_emptyTag) ? 1 : 0;
+            }
+            return numOccupied;
+        }
+
+        template<typename Key_T, typename Predicate_T>
+        Node_T* FindSlot(const uint64_t hash, const Key_T& searchKey, Block*& pOutBlock, uint32_t& outSlot) const
+        {
+            const uint8_t tag = GetTag(hash);
+            Block* pBlock = pHead;
+            while(pBlock)
+            {
+                uint64_t matches = MatchTags(LoadTagWord(pBlock), tag);
+                while(matches)
+                {
+                    const uint32_t slot = GetSlotIndex(matches);
+                    Node_T* pEntry = pBlock->pEntries[slot];
+                    if(pEntry && (pBlock->tags[slot] == tag) && (Predicate_T::Compare(pEntry->key, searchKey) == 0))
+                    {
+                        pOutBlock = pBlock;
+                        outSlot = slot;
+                        return pEntry;
+                    }
+                    matches &= (matches - 1);
+                }
+                pBlock = pBlock->pOverflow;
+            }
+            return nullptr;
+        }
+
+        template<typename BlockPool_T>
+        void RemoveSlot(Block* pBlock, const uint32_t slot, BlockPool_T& blockPool)
+        {
+            // Back-fill the hole with the last occupied slot of the head block so that only the head has free slots
+            const uint32_t numHeadOccupied = CountOccupied(pHead);
+            const uint32_t lastHeadSlot = numHeadOccupied - 1;
+            if((pBlock != pHead) || (slot != lastHeadSlot))
+            {
+                pBlock->tags[slot] = pHead->tags[lastHeadSlot];
+                pBlock->pEntries[slot] = pHead->pEntries[lastHeadSlot];
+            }
+            pHead->tags[lastHeadSlot] = c_emptyTag;
+            pHead->pEntries[lastHeadSlot] = nullptr;
+
+            if(lastHeadSlot == 0)
+            {
+                Block* pEmptyBlock = pHead;
+                pHead = pEmptyBlock->pOverflow;
+                blockPool.Release(pEmptyBlock);
+            }
+        }
+
+    public:
+        UnrolledLinkedList() = default;
+
+        // Blocks must be handed back with Reset_Unsafe() before destruction, the list does not own the pool
+        ~UnrolledLinkedList()
+        {
+            pHead = nullptr;
+        }
+
+        // Top byte of the hash. Bucket and inner map selection use the low bits, so the tag stays independent.
+        // Tag 0 is reserved for empty slots.
+        static uint8_t GetTag(const uint64_t hash)
+        {
+            const uint8_t tag = static_cast<uint8_t>(hash >> 56);
+            return (tag == c_emptyTag) ? 1 : tag;
+        }
+
+        // Insert a node into the first free slot of the head block, or a new head block if it is full
+        // WARNING: Only use when external synchronization guarantees exclusive access
+        template<typename BlockPool_T>
+        bool Insert_Unsafe(Node_T* newNode, const uint64_t hash, BlockPool_T& blockPool)
+        {
+            if(!newNode)
+            {
+                return false;
+            }
+
+            uint32_t freeSlot = c_numSlotsPerBlock;
+            if(pHead)
+            {
+                freeSlot = CountOccupied(pHead);
+            }
+
+            if(freeSlot >= c_numSlotsPerBlock)
+            {
+                Block* pNewBlock = blockPool.Reserve();
+                if(!pNewBlock)
+                {
+                    return false;
+                }
+                pNewBlock->pOverflow = pHead;
+                pHead = pNewBlock;
+                freeSlot = 0;
+            }
+
+            pHead->pEntries[freeSlot] = newNode;
+            pHead->tags[freeSlot] = GetTag(hash);
+            return true;
+        }
+
+        // Find a node with the given key
+        // WARNING: Only use when external synchronization guarantees safe access
+        template<typename Key_T, typename Predicate_T>
+        Node_T* Find_Unsafe(const uint64_t hash, const Key_T& searchKey) const
+        {
+            Block* pBlock = nullptr;
+            uint32_t slot = 0;
+            return FindSlot<Key_T, Predicate_T>(hash, searchKey, pBlock, slot);
+        }
+
+        // Erase a node with the given key, releasing blocks that become empty
+        // WARNING: Only use when external synchronization guarantees exclusive access
+        // Returns pointer to the erased node (caller must handle deallocation)
+        // Returns nullptr if node was not found
+        template<typename Key_T, typename Predicate_T, typename BlockPool_T>
+        Node_T* Erase_Unsafe(const uint64_t hash, const Key_T& searchKey, BlockPool_T& blockPool)
+        {
+            Block* pBlock = nullptr;
+            uint32_t slot = 0;
+            Node_T* pFound = FindSlot<Key_T, Predicate_T>(hash, searchKey, pBlock, slot);
+            if(pFound)
+            {
+                RemoveSlot(pBlock, slot, blockPool);
+            }
+            return pFound;
+        }
+
+        // Visit every node in the chain. The callback may re-link the node elsewhere.
+        // WARNING: Only use when external synchronization guarantees safe access
+        template<typename Func_T>
+        void ForEach_Unsafe(Func_T&& func)
+        {
+            Block* pBlock = pHead;
+            while(pBlock)
+            {
+                Block* pNextBlock = pBlock->pOverflow;
+                for(uint32_t i = 0; i < c_numSlotsPerBlock; ++i)
+                {
+                    if(pBlock->tags[i] != c_emptyTag)
+                    {
+                        func(pBlock->pEntries[i]);
+                    }
+                }
+                pBlock = pNextBlock;
+            }
+        }
+
+        // Check if the list is empty
+        bool IsEmpty() const
+        {
+            return pHead == nullptr;
+        }
+
+        // Release all blocks back to the pool without touching the nodes
+        // WARNING: Only use when external synchronization guarantees exclusive access
+        template<typename BlockPool_T>
+        void Reset_Unsafe(BlockPool_T& blockPool)
+        {
+            Block* pBlock = pHead;
+            while(pBlock)
+            {
+                Block* pNextBlock = pBlock->pOverflow;
+                blockPool.Release(pBlock);
+                pBlock = pNextBlock;
+            }
+            pHead = nullptr;
+        }
+
+        // Make this list a copy of the links of source, for when source's blocks and nodes were copied elsewhere:
+        // translateBlock(const Block*) and translateEntry(const Node_T*) return the copies (nullptr for nullptr).
+        // The block copies still hold source's pointers, which are translated in place.
+        // WARNING: Only use when external synchronization guarantees exclusive access
+        template<typename TranslateBlock_T, typename TranslateEntry_T>
+        void CopyLinks_Unsafe(const UnrolledLinkedList& source, TranslateBlock_T&& translateBlock, TranslateEntry_T&& translateEntry)
+        {
+            pHead = translateBlock(source.pHead);
+            for(Block* pBlock = pHead; pBlock != nullptr; pBlock = pBlock->pOverflow)
+            {
+                for(uint32_t slot = 0; slot < c_numSlotsPerBlock; ++slot)
+                {
+                    pBlock->pEntries[slot] = translateEntry(pBlock->pEntries[slot]);
+                }
+                pBlock->pOverflow = translateBlock(pBlock->pOverflow);
+            }
+        }
+
+        // Drop all blocks without releasing them, for when the block pool itself has been cleared
+        // WARNING: Only use when external synchronization guarantees exclusive access
+        void Forget_Unsafe()
+        {
+            pHead = nullptr;
+        }
+    };
+
+} // end namespace ThreadsafeContainers
+} // end namespace PklE
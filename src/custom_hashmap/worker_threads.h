@@ -0,0 +1,53 @@
+#pragma once
+
+#include <stdint.h>
+#include <thread>
+#include <vector>
+
+namespace PklE
+{
+namespace Util
+{
+    // Runs func(workerIndex) on numWorkers workers, the calling thread is worker 0.
+    // For bulk container operations (teardown, clone, merge) that are not worth a dependency on a thread pool.
+    template<typename Func_T>
+    void RunOnWorkerThreads(const uint32_t numWorkers, Func_T&& func)
+    {
+        std::vector<std::thread> threads;
+        if(numWorkers > 1)
+        {
+            threads.reserve(numWorkers - 1);
+            for(uint32_t i = 1; i < numWorkers; ++i)
+            {
+                threads.emplace_back([&func, i]() { func(i); });
+            }
+        }
+        func(0);
+        for(std::thread& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    // Workers to use for numItems items: at most maxWorkers (0 counts as 1), and few enough that every worker
+    // gets minItemsPerWorker items, starting a thread for less is not worth it. Always at least 1.
+    inline uint32_t GetNumWorkers(const uint32_t maxWorkers, const uint64_t numItems, const uint64_t minItemsPerWorker)
+    {
+        const uint64_t numUsefulWorkers = (minItemsPerWorker > 0) ? (numItems / minItemsPerWorker) : numItems;
+        uint32_t numWorkers = (maxWorkers == 0) ? 1 : maxWorkers;
+        if(numUsefulWorkers < numWorkers)
+        {
+            numWorkers = static_cast<uint32_t>(numUsefulWorkers);
+        }
+        return (numWorkers == 0) ? 1 : numWorkers;
+    }
+
+    // First item of worker workerIndex when numItems are split into numWorkers contiguous ranges,
+    // worker i handles [GetWorkerRangeBegin(i), GetWorkerRangeBegin(i + 1))
+    inline uint64_t GetWorkerRangeBegin(const uint64_t numItems, const uint32_t numWorkers, const uint32_t workerIndex)
+    {
+        return (numItems * workerIndex) / numWorkers;
+    }
+
+}; //end namespace Util
+}; //end namespace PklE